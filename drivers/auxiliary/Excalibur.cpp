@@ -338,7 +338,7 @@ bool Excalibur::sendCommand(const char *command, char *res)
 
     LOGF_DEBUG("CMD <%#02X>", cmd[0]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
     {
@@ -362,7 +362,7 @@ bool Excalibur::sendCommand(const char *command, char *res)
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
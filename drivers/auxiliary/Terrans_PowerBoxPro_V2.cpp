@@ -442,21 +442,21 @@ bool TerransPowerBoxProV2::sendCommand(const char * cmd, char * res)
 
     for (int i = 0; i < 2; i++)
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         snprintf(command, CMD_LEN, "%s", cmd);
         if ( (tty_rc = tty_write_string(PortFD, command, &nbytes_written)) != TTY_OK)
             continue;
 
         if (!res)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
             return true;
         }
 
         if ( (tty_rc = tty_nread_section(PortFD, res, CMD_LEN, '#', TIMEOUT, &nbytes_read)) != TTY_OK || nbytes_read == 1)
             continue;
 
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         res[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES <%s>", res);
         return true;
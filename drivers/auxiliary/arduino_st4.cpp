@@ -249,7 +249,7 @@ bool ArduinoST4::sendCommand(const char *cmd)
 
     if (!isSimulation())
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         if ( (tty_rc = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
             char errorMessage[MAXRBUF];
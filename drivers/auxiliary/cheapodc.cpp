@@ -402,7 +402,7 @@ bool CheapoDC::sendCommand(const char *cmd, char *resp)
     char errstr[MAXRBUF];
 
     LOGF_DEBUG("CMD <%s>", cmd);
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ((rc = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
     {
         tty_error_msg(rc, errstr, MAXRBUF);
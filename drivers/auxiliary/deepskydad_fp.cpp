@@ -609,7 +609,7 @@ bool DeepSkyDadFP::sendCommand(const char *cmd, char *res)
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
@@ -634,7 +634,7 @@ bool DeepSkyDadFP::sendCommand(const char *cmd, char *res)
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -612,7 +612,7 @@ bool FlipFlat::sendCommand(const char *command, char *response)
     char errstr[MAXRBUF] = {0};
     int i = 0;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD <%s>", command);
 
@@ -347,7 +347,7 @@ bool GeminiFlatpanelRev1Adapter::sendCommand(const char *command, char *response
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(portFD, TCIOFLUSH);
+    tty_flush(portFD, TCIOFLUSH);
     if ((rc = tty_write_string(portFD, command, &nbytes_written)) != TTY_OK)
     {
         if (log)
@@ -379,7 +379,7 @@ bool GeminiFlatpanelRev1Adapter::sendCommand(const char *command, char *response
     {
         response[nbytes_read - 1] = '\0';
     }
-    tcflush(portFD, TCIOFLUSH);
+    tty_flush(portFD, TCIOFLUSH);
 
     if (response[0] != '*' || response[1] != command[1])
     {
@@ -799,7 +799,7 @@ bool GeminiFlatpanelRev2Adapter::sendCommand(const char *command, char *response
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(portFD, TCIOFLUSH);
+    tty_flush(portFD, TCIOFLUSH);
     if ((rc = tty_write_string(portFD, command, &nbytes_written)) != TTY_OK)
     {
         if (log)
@@ -831,7 +831,7 @@ bool GeminiFlatpanelRev2Adapter::sendCommand(const char *command, char *response
     {
         response[nbytes_read - 1] = '\0';
     }
-    tcflush(portFD, TCIOFLUSH);
+    tty_flush(portFD, TCIOFLUSH);
 
     if (response[0] != '*' || response[1] != command[1])
     {
@@ -1160,7 +1160,7 @@ bool GeminiFlatpanelLiteAdapter::sendCommand(const char *command, char *response
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(portFD, TCIOFLUSH);
+    tty_flush(portFD, TCIOFLUSH);
     if ((rc = tty_write_string(portFD, command, &nbytes_written)) != TTY_OK)
     {
         if (log)
@@ -1192,7 +1192,7 @@ bool GeminiFlatpanelLiteAdapter::sendCommand(const char *command, char *response
     {
         response[nbytes_read - 1] = '\0';
     }
-    tcflush(portFD, TCIOFLUSH);
+    tty_flush(portFD, TCIOFLUSH);
 
     if (response[0] != '*' || response[1] != command[1])
     {
@@ -784,7 +784,7 @@ bool IndiAstrolink4::sendCommand(const char * cmd, char * res)
     }
     else
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         sprintf(command, "%s\n", cmd);
         LOGF_DEBUG("CMD %s", command);
         if ( (tty_rc = tty_write_string(PortFD, command, &nbytes_written)) != TTY_OK)
@@ -792,7 +792,7 @@ bool IndiAstrolink4::sendCommand(const char * cmd, char * res)
 
         if (!res)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
             return true;
         }
 
@@ -800,7 +800,7 @@ bool IndiAstrolink4::sendCommand(const char * cmd, char * res)
                 || nbytes_read == 1)
             return false;
 
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         res[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES %s", res);
 
@@ -575,7 +575,7 @@ bool IndiAstroLink4mini2::sendCommand(const char *cmd, char *res)
     }
     else
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         sprintf(command, "%s\n", cmd);
         DEBUGF(INDI::Logger::DBG_DEBUG, "CMD %s", cmd);
         if ((tty_rc = tty_write_string(PortFD, command, &nbytes_written)) != TTY_OK)
@@ -583,7 +583,7 @@ bool IndiAstroLink4mini2::sendCommand(const char *cmd, char *res)
 
         if (!res)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
             return true;
         }
 
@@ -591,7 +591,7 @@ bool IndiAstroLink4mini2::sendCommand(const char *cmd, char *res)
                 || nbytes_read == 1)
             return false;
 
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         res[nbytes_read - 1] = '\0';
         DEBUGF(INDI::Logger::DBG_DEBUG, "RES %s", res);
         if (tty_rc != TTY_OK)
@@ -247,7 +247,7 @@ bool myDewControllerPro::sendCommand(const char *cmd, char *resp)
     char errstr[MAXRBUF];
     LOGF_DEBUG("CMD: %s.", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
         tty_error_msg(rc, errstr, MAXRBUF);
@@ -293,7 +293,7 @@ bool myDewControllerPro::Handshake()
 bool myDewControllerPro::Ack()
 {
     char resp[MDCP_RES_LEN] = {};
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sendCommand(MDCP_GET_VERSION, resp))
         return false;
@@ -270,7 +270,7 @@ bool MyDCP4ESP::sendCommand(const char *cmd, char *resp)
     char errstr[MAXRBUF];
 
     LOGF_DEBUG("CMD <%s>", cmd);
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ((rc = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
     {
         tty_error_msg(rc, errstr, MAXRBUF);
@@ -460,7 +460,7 @@ bool MyDCP4ESP::Ack()
     CheckCodeTP.setState(IPS_OK);
     CheckCodeTP.apply();
         
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     memset(resp, '\0', MDCP_RESPONSE_LENGTH);
 
     if (!sendCommand(MDCP_GET_VERSION_CMD, resp))
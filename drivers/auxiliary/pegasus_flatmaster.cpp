@@ -252,7 +252,7 @@ bool PegasusFlatMaster::sendCommand(const char *command, char *res)
 
     LOGF_DEBUG("CMD <%#02X>", cmd[0]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
@@ -276,7 +276,7 @@ bool PegasusFlatMaster::sendCommand(const char *command, char *res)
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -240,7 +240,7 @@ bool PegasusSPB::Handshake()
 
     LOG_DEBUG("CMD <P#>");
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     strncpy(command, "P#\n", PEGASUS_LEN);
     if ( (tty_rc = tty_write_string(PortFD, command, &nbytes_written)) != TTY_OK)
     {
@@ -256,7 +256,7 @@ bool PegasusSPB::Handshake()
         // Try 0xA as the stop character
         if (tty_rc == TTY_OVERFLOW || tty_rc == TTY_TIME_OUT)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
             tty_write_string(PortFD, command, &nbytes_written);
             stopChar = 0xA;
             tty_rc = tty_nread_section(PortFD, response, PEGASUS_LEN, stopChar, 1, &nbytes_read);
@@ -271,7 +271,7 @@ bool PegasusSPB::Handshake()
         }
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     response[nbytes_read - 1] = '\0';
     LOGF_DEBUG("RES <%s>", response);
 
@@ -918,14 +918,14 @@ bool PegasusSPB::sendCommand(const char * cmd, char * res)
 
     for (int i = 0; i < 2; i++)
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         snprintf(command, PEGASUS_LEN, "%s\n", cmd);
         if ( (tty_rc = tty_write_string(PortFD, command, &nbytes_written)) != TTY_OK)
             continue;
 
         if (!res)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
             return true;
         }
 
@@ -933,7 +933,7 @@ bool PegasusSPB::sendCommand(const char * cmd, char * res)
                 || nbytes_read == 1)
             continue;
 
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         res[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES <%s>", res);
         return true;
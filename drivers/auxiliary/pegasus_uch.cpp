@@ -511,7 +511,7 @@ bool PegasusUCH::sendCommand(const char * command, char * res)
 
     LOGF_DEBUG("CMD <%#02X>", cmd[0]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
@@ -535,7 +535,7 @@ bool PegasusUCH::sendCommand(const char * command, char * res)
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
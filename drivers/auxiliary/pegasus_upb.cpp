@@ -513,7 +513,7 @@ bool PegasusUPB::Handshake()
     {
         int tty_rc = 0, nbytes_written = 0;
         char command[PEGASUS_LEN] = {0};
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         strncpy(command, "P#\n", PEGASUS_LEN);
         if ( (tty_rc = tty_write_string(PortFD, command, &nbytes_written)) != TTY_OK)
         {
@@ -529,7 +529,7 @@ bool PegasusUPB::Handshake()
             // Try 0xA as the stop character
             if (tty_rc == TTY_OVERFLOW || tty_rc == TTY_TIME_OUT)
             {
-                tcflush(PortFD, TCIOFLUSH);
+                tty_flush(PortFD, TCIOFLUSH);
                 tty_write_string(PortFD, command, &nbytes_written);
                 stopChar = 0xA;
                 tty_rc = tty_nread_section(PortFD, response, PEGASUS_LEN, stopChar, 1, &nbytes_read);
@@ -545,7 +545,7 @@ bool PegasusUPB::Handshake()
         }
 
         cleanupResponse(response);
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
     }
 
 
@@ -961,14 +961,14 @@ bool PegasusUPB::sendCommand(const char * cmd, char * res)
     for (int i = 0; i < 2; i++)
     {
         char command[PEGASUS_LEN] = {0};
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         snprintf(command, PEGASUS_LEN, "%s\n", cmd);
         if ( (tty_rc = tty_write_string(PortFD, command, &nbytes_written)) != TTY_OK)
             continue;
 
         if (!res)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
             return true;
         }
 
@@ -976,7 +976,7 @@ bool PegasusUPB::sendCommand(const char * cmd, char * res)
                 || nbytes_read == 1)
             continue;
 
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
 
         cleanupResponse(res);
         LOGF_DEBUG("RES <%s>", res);
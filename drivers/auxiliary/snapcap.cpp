@@ -259,7 +259,7 @@ bool SnapCap::sendCommand(const char *command, char *response)
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
     char errstr[MAXRBUF];
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", command);
 
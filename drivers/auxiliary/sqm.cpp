@@ -235,7 +235,7 @@ bool SQM::sendCommand(const char * cmd, char * res, int cmd_len, int res_len)
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -287,7 +287,7 @@ bool SQM::sendCommand(const char * cmd, char * res, int cmd_len, int res_len)
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -355,7 +355,7 @@ std::string UPS::makeNUTRequest(const std::string& command)
             int nbytes_written = 0;
             
             // Flush any lingering data before sending new command
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
             
             int rc = tty_write_string(PortFD, request.c_str(), &nbytes_written);
             
@@ -166,7 +166,7 @@ bool USBDewpoint::sendCommand(const char *cmd, char *resp)
     char errstr[MAXRBUF];
     LOGF_DEBUG("CMD: %s.", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
         tty_error_msg(rc, errstr, MAXRBUF);
@@ -204,7 +204,7 @@ bool USBDewpoint::Resync()
     // Send up to 5 space characters and wait for error
     // response ("ER=1") after which the communication
     // is back in sync
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     for (int resync = 0; resync < UDP_CMD_LEN; resync++)
     {
@@ -253,7 +253,7 @@ bool USBDewpoint::Handshake()
 bool USBDewpoint::Ack()
 {
     char resp[UDP_RES_LEN] = {};
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sendCommand(UDP_IDENTIFY_CMD, resp))
         return false;
@@ -141,7 +141,7 @@ bool WandererCover::Handshake()
         return true;
     }
     PortFD = serialConnection->getPortFD();
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     int nbytes_read_name = 0, nbytes_written = 0, rc = -1;
     char name[64] = {0};
     LOGF_DEBUG("CMD <%s>", HANDSHAKE_COMMAND);
@@ -221,7 +221,7 @@ bool WandererCover::Handshake()
     setLightBoxStatusAsSwitchedOff();
 
     LOGF_INFO("Handshake successful:%s", name);
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     return true;
 }
 
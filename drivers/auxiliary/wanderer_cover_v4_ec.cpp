@@ -528,7 +528,7 @@ bool WandererCoverV4EC::detectProtocol()
         std::lock_guard<std::timed_mutex> lock(serialPortMutex, std::adopt_lock);
 
         PortFD = serialConnection->getPortFD();
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         
         // Read data from the device
         char buffer[512] = {0};
@@ -682,7 +682,7 @@ bool WandererCoverV4EC::getData()
         LOG_DEBUG("Reading data from device...");
         
         PortFD = serialConnection->getPortFD();
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         
         // Read all data from the device as a single line with 'A' separators
         char buffer[512] = {0};
@@ -148,7 +148,7 @@ bool WandererEclipse::getData()
     try
     {
         PortFD = serialConnection->getPortFD();
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
 
 
         const char *command = "1500001\n";
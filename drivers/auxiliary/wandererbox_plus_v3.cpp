@@ -121,7 +121,7 @@ bool WandererBoxPlusV3::getData()
     try
     {
         PortFD = serialConnection->getPortFD();
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         int nbytes_read_name = 0,rc=-1;
         char name[64] = {0};
 
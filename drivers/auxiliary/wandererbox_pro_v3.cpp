@@ -182,7 +182,7 @@ bool WandererBoxProV3::getData()
     try
     {
         PortFD = serialConnection->getPortFD();
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         int nbytes_read_name = 0,rc=-1;
         char name[64] = {0};
 
@@ -270,7 +270,7 @@ bool BaaderDome::Ack()
 
     sim = isSimulation();
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, "d#getflap", DOME_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -315,7 +315,7 @@ bool BaaderDome::UpdateShutterStatus()
     char resp[DOME_BUF];
     char status[DOME_BUF];
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, "d#getshut", DOME_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -396,7 +396,7 @@ bool BaaderDome::UpdatePosition()
     char resp[DOME_BUF];
     unsigned short domeAz = 0;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, "d#getazim", DOME_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -642,7 +642,7 @@ IPState BaaderDome::MoveAbs(double az)
 
     snprintf(cmd, DOME_BUF, "d#azi%04d", MountAzToDomeAz(targetAz));
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, cmd, DOME_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -724,7 +724,7 @@ IPState BaaderDome::ControlShutter(ShutterOperation operation)
         strncpy(cmd, "d#closhut", DOME_CMD + 1);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, cmd, DOME_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -816,7 +816,7 @@ int BaaderDome::ControlDomeFlap(FlapOperation operation)
         strncpy(cmd, "d#cloflap", DOME_CMD + 1);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, cmd, DOME_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -862,7 +862,7 @@ bool BaaderDome::UpdateFlapStatus()
     char resp[DOME_BUF];
     char status[DOME_BUF];
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, "d#getflap", DOME_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -945,7 +945,7 @@ bool BaaderDome::SaveEncoderPosition()
 
     strncpy(cmd, "d#encsave", DOME_CMD + 1);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, cmd, DOME_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -998,7 +998,7 @@ bool DomePro2::sendCommand(const char * cmd, char * res, int cmd_len, int res_le
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -1053,7 +1053,7 @@ bool DomePro2::sendCommand(const char * cmd, char * res, int cmd_len, int res_le
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -682,7 +682,7 @@ bool RigelDome::sendCommand(const char * cmd, char * res, int cmd_len, int res_l
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -737,7 +737,7 @@ bool RigelDome::sendCommand(const char * cmd, char * res, int cmd_len, int res_l
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
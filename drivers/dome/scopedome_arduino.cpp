@@ -152,7 +152,7 @@ bool ScopeDomeArduino::performCommand(const std::string &command, std::string &r
         if (command.length() == 0)
             return false;
 
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
 
         // Write buffer
         LOGF_DEBUG("write cmd: %s", command.c_str());
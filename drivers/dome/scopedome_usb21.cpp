@@ -282,7 +282,7 @@ int ScopeDomeUSB21::writeBuf(Command cmd, uint8_t len, uint8_t *buff)
         cbuf[3]     = CRC(cbuf[3], buff[i]);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     prevcmd = cmd;
 
@@ -302,7 +302,7 @@ int ScopeDomeUSB21::write(Command cmd)
     uint8_t cbuf[4];
     char errstr[MAXRBUF];
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     cbuf[0] = header;
     cbuf[3] = CRC(0, cbuf[0]);
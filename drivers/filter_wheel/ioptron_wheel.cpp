@@ -139,7 +139,7 @@ bool iEFW::getiEFWInfo()
     char resp[16];
     int iefwpos, iefwmodel, iefwlast;
     sleep(2);
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ( (rc = tty_write(PortFD, ":DeviceInfo#", strlen(":DeviceInfo#"), &nbytes_written)) != TTY_OK)
     {
         char errstr[MAXRBUF] = {0};
@@ -155,7 +155,7 @@ bool iEFW::getiEFWInfo()
         LOGF_ERROR( "Init read iEFW deviceinfo error: %s.", errstr);
         return false;
     };
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     resp[nbytes_read] = '\0';
     sscanf(resp, "%6d%2d%4d", &iefwpos, &iefwmodel, &iefwlast);
     if ((iefwmodel == 98) || (iefwmodel == 99))
@@ -194,7 +194,7 @@ bool iEFW::getiEFWfirmwareInfo()
     char errstr[MAXRBUF];
     char resp[16] = {0};
     char iefwfirminfo[16] = {0};
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ( (rc = tty_write(PortFD, ":FW1#", 5, &nbytes_written)) != TTY_OK)
     {
         tty_error_msg(rc, errstr, MAXRBUF);
@@ -206,7 +206,7 @@ bool iEFW::getiEFWfirmwareInfo()
         LOGF_ERROR( "get iEFW FirmwareInfo  error: %s.", errstr);
         return false;
     }
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     resp[nbytes_read] = '\0';
     sscanf(resp, "%12s", iefwfirminfo);
     FirmwareTP.setState(IPS_OK);
@@ -222,7 +222,7 @@ int iEFW::getFilterPos()
     char errstr[MAXRBUF];
     char resp[16] = {0};
     int  iefwpos = 1;
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ( (rc = tty_write(PortFD, ":WP#", 4, &nbytes_written)) != TTY_OK)
     {
         tty_error_msg(rc, errstr, MAXRBUF);
@@ -234,7 +234,7 @@ int iEFW::getFilterPos()
         LOGF_ERROR( "read iEFW filter pos Info  error: %s.", errstr);
         return false;
     }
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     resp[nbytes_read] = '\0';
     LOGF_DEBUG("Success, response from iEFW is : %s", resp);
     rc = sscanf(resp, "%2d", &iefwpos);
@@ -279,14 +279,14 @@ bool iEFW::SelectFilter(int f)
     if (f < 0 || f > (FilterSlotNP[0].getMax() - 1))
         return false;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     snprintf(cmd, 7, ":WM0%d#", f);
     if ( (rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
         tty_error_msg(rc, errstr, MAXRBUF);
         LOGF_ERROR( "select iEFW send pos Info error: %s.", errstr);
     }
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     // check current position  -1  is moving
     do
     {
@@ -238,7 +238,7 @@ int QFW::send_command(int fd, const char* cmd, char *resp)
     dump(dmp, cmd);
     LOGF_DEBUG("CMD <%s>", dmp);
 
-    tcflush(fd, TCIOFLUSH);
+    tty_flush(fd, TCIOFLUSH);
     if ((err = tty_write(fd, cmd, cmd_len, &nbytes)) != TTY_OK)
     {
         tty_error_msg(err, errmsg, MAXRBUF);
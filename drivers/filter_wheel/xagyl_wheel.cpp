@@ -136,7 +136,7 @@ bool XAGYLWheel::Handshake()
 {
     char cmd[DRIVER_LEN] = {0}, res[DRIVER_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     snprintf(cmd, DRIVER_LEN, "I%d", INFO_FIRMWARE_VERSION);
     if (!sendCommand(cmd, res))
@@ -793,7 +793,7 @@ bool XAGYLWheel::sendCommand(const char * cmd, char * res)
 {
     int nbytes_written = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Send
     LOGF_DEBUG("CMD <%s>", cmd);
@@ -109,7 +109,7 @@ bool AAF2::Ack()
     char errstr[MAXRBUF];
     char resp[5] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     int numChecks = 0;
     bool success = false;
@@ -142,7 +142,7 @@ bool AAF2::Ack()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return !strcmp(resp, "OK!#");
 }
@@ -316,7 +316,7 @@ bool AAF2::sendCommand(const char * cmd, char * res)
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
@@ -344,7 +344,7 @@ bool AAF2::sendCommand(const char * cmd, char * res)
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
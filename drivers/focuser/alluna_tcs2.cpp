@@ -210,7 +210,7 @@ bool AllunaTCS2::sendCommandNoLock(const char * cmd, char * res, int cmd_len, in
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
     LOG_DEBUG("sendCommand: Send Command");
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -266,7 +266,7 @@ bool AllunaTCS2::sendCommandNoLock(const char * cmd, char * res, int cmd_len, in
         LOGF_DEBUG("String '%s'", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     LOG_DEBUG("sendCommand: Ende");
     return true;
 }
@@ -281,7 +281,7 @@ bool AllunaTCS2::sendCommandOnly(const char * cmd, int cmd_len)
         return false;
     }
     LOG_DEBUG("sendCommandOnly: Anfang");
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -346,7 +346,7 @@ bool AllunaTCS2::receiveNext(char * res, int res_len)
 void AllunaTCS2::receiveDone()
 {
     LOG_DEBUG("receiveDone");
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     tcs.unlock();
 }
 
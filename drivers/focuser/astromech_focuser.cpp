@@ -234,7 +234,7 @@ uint32_t astromechanics_foc::GetAbsFocuserPosition()
 bool astromechanics_foc::sendCommand(const char * cmd, char * res, int cmd_len, int res_len)
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -289,7 +289,7 @@ bool astromechanics_foc::sendCommand(const char * cmd, char * res, int cmd_len,
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -147,7 +147,7 @@ bool Communicator::sendPacket(int portFD, Target dest, Command cmd, buffer data)
     int ns;
 
     int ttyrc = 0;
-    tcflush(portFD, TCIOFLUSH);
+    tty_flush(portFD, TCIOFLUSH);
     if ( (ttyrc = tty_write(portFD, reinterpret_cast<const char *>(txbuff.data()), txbuff.size(), &ns)) != TTY_OK)
     {
         char errmsg[MAXRBUF];
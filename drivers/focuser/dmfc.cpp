@@ -194,7 +194,7 @@ bool DMFC::ack()
 
     LOGF_DEBUG("CMD <%#02X>", cmd[0]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 2, &nbytes_written)) != TTY_OK)
     {
@@ -218,7 +218,7 @@ bool DMFC::ack()
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if((strstr(res, "OK_DMFCN") != nullptr) || (strstr(res, "OK_SMFC") != nullptr) || (strstr(res, "OK_PRDG") != nullptr))
         return true;
@@ -385,7 +385,7 @@ bool DMFC::updateFocusParams()
 
     LOGF_DEBUG("CMD <%#02X>", cmd[0]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 2, &nbytes_written)) != TTY_OK)
     {
@@ -409,7 +409,7 @@ bool DMFC::updateFocusParams()
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     char *token = std::strtok(res, ":");
 
@@ -619,7 +619,7 @@ bool DMFC::setMaxSpeed(uint16_t speed)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Set Speed
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -644,7 +644,7 @@ bool DMFC::ReverseFocuser(bool enabled)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Reverse
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -670,7 +670,7 @@ bool DMFC::setLedEnabled(bool enable)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Led
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -695,7 +695,7 @@ bool DMFC::setEncodersEnabled(bool enable)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Encoders
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -720,7 +720,7 @@ bool DMFC::SetFocuserBacklash(int32_t steps)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Backlash
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -757,7 +757,7 @@ bool DMFC::setMotorType(uint8_t type)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Motor Type
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -698,7 +698,7 @@ bool FocusLynxF1::getHubConfig()
             return false;
     }
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     configurationComplete = true;
 
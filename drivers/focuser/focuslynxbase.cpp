@@ -1089,7 +1089,7 @@ bool FocusLynxBase::getFocusConfig()
             return false;
     }
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     configurationComplete = true;
 
@@ -1124,7 +1124,7 @@ bool FocusLynxBase::getFocusStatus()
     }
     else
     {
-        //tcflush(PortFD, TCIFLUSH);
+        //tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -1152,7 +1152,7 @@ bool FocusLynxBase::getFocusStatus()
         if (!((!strcmp(response, "STATUS1")) && (!strcmp(getFocusTarget(), "F1"))) && !((!strcmp(response, "STATUS2"))
                 && (!strcmp(getFocusTarget(), "F2"))))
         {
-            tcflush(PortFD, TCIFLUSH);
+            tty_flush(PortFD, TCIFLUSH);
             return false;
         }
 
@@ -1467,7 +1467,7 @@ bool FocusLynxBase::getFocusStatus()
                 return false;
         }
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         return true;
     }
@@ -1955,7 +1955,7 @@ bool FocusLynxBase::getFocusTemp()
                 return false;
         }
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         return true;
     }
@@ -1987,7 +1987,7 @@ bool FocusLynxBase::setDeviceType(int index)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2011,7 +2011,7 @@ bool FocusLynxBase::setDeviceType(int index)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
             return true;
@@ -2049,7 +2049,7 @@ bool FocusLynxBase::setLedLevel(int level)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2073,7 +2073,7 @@ bool FocusLynxBase::setLedLevel(int level)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
             return true;
@@ -2110,7 +2110,7 @@ bool FocusLynxBase::setDeviceNickname(const char *nickname)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2134,7 +2134,7 @@ bool FocusLynxBase::setDeviceNickname(const char *nickname)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
             return true;
@@ -2175,7 +2175,7 @@ bool FocusLynxBase::home()
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2205,7 +2205,7 @@ bool FocusLynxBase::home()
         isHoming = true;
         LOG_INFO("Focuser is homing...");
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         return true;
     }
@@ -2239,7 +2239,7 @@ bool FocusLynxBase::center()
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2269,7 +2269,7 @@ bool FocusLynxBase::center()
         FocusAbsPosNP.setState(IPS_BUSY);
         FocusAbsPosNP.apply();
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         return true;
     }
@@ -2302,7 +2302,7 @@ bool FocusLynxBase::setTemperatureCompensation(bool enable)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2326,7 +2326,7 @@ bool FocusLynxBase::setTemperatureCompensation(bool enable)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
             return true;
@@ -2362,7 +2362,7 @@ bool FocusLynxBase::setTemperatureCompensationMode(char mode)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2386,7 +2386,7 @@ bool FocusLynxBase::setTemperatureCompensationMode(char mode)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         // If OK, the value would be read and update UI properties
         if (!strcmp(response, "SET"))
@@ -2423,7 +2423,7 @@ bool FocusLynxBase::setTemperatureCompensationCoeff(char mode, int16_t coeff)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2447,7 +2447,7 @@ bool FocusLynxBase::setTemperatureCompensationCoeff(char mode, int16_t coeff)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
             return true;
@@ -2484,7 +2484,7 @@ bool FocusLynxBase::setTemperatureInceptions(char mode, int32_t inter)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2508,7 +2508,7 @@ bool FocusLynxBase::setTemperatureInceptions(char mode, int32_t inter)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
             return true;
@@ -2544,7 +2544,7 @@ bool FocusLynxBase::setTemperatureCompensationOnStart(bool enable)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2568,7 +2568,7 @@ bool FocusLynxBase::setTemperatureCompensationOnStart(bool enable)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
             return true;
@@ -2627,7 +2627,7 @@ bool FocusLynxBase::SetFocuserBacklashEnabled(bool enabled)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
             return true;
@@ -2686,7 +2686,7 @@ bool FocusLynxBase::SetFocuserBacklash(int32_t steps)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
             return true;
@@ -2745,7 +2745,7 @@ bool FocusLynxBase::ReverseFocuser(bool enabled)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
             return true;
@@ -2781,7 +2781,7 @@ bool FocusLynxBase::SyncFocuser(uint32_t ticks)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2805,7 +2805,7 @@ bool FocusLynxBase::SyncFocuser(uint32_t ticks)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
         {
@@ -2845,7 +2845,7 @@ bool FocusLynxBase::SetFocuserMaxPosition(uint32_t ticks)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2869,7 +2869,7 @@ bool FocusLynxBase::SetFocuserMaxPosition(uint32_t ticks)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
         {
@@ -2907,7 +2907,7 @@ bool FocusLynxBase::setStepSize(uint16_t stepsize)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2931,7 +2931,7 @@ bool FocusLynxBase::setStepSize(uint16_t stepsize)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
         {
@@ -2969,7 +2969,7 @@ bool FocusLynxBase::resetFactory()
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -2993,7 +2993,7 @@ bool FocusLynxBase::resetFactory()
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
         {
@@ -3087,7 +3087,7 @@ IPState FocusLynxBase::MoveFocuser(FocusDirection dir, int speed, uint16_t durat
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -3122,7 +3122,7 @@ IPState FocusLynxBase::MoveFocuser(FocusDirection dir, int speed, uint16_t durat
             return IPS_OK;
         }
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         return IPS_BUSY;
     }
@@ -3158,7 +3158,7 @@ IPState FocusLynxBase::MoveAbsFocuser(uint32_t targetTicks)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -3185,7 +3185,7 @@ IPState FocusLynxBase::MoveAbsFocuser(uint32_t targetTicks)
 
         FocusAbsPosNP.setState(IPS_BUSY);
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         return IPS_BUSY;
     }
@@ -3340,7 +3340,7 @@ bool FocusLynxBase::AbortFocuser()
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
         {
@@ -3379,7 +3379,7 @@ bool FocusLynxBase::AbortFocuser()
         FocusAbsPosNP.apply();
         IDSetSwitch(&GotoSP, nullptr);
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         return true;
     }
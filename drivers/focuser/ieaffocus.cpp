@@ -134,7 +134,7 @@ bool iEAFFocus::Ack()
     char resp[16];
     int ieafpos, ieafmodel, ieaflast;
     sleep(2);
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ( (rc = tty_write(PortFD, ":DeviceInfo#", 12, &nbytes_written)) != TTY_OK)
     {
         char errstr[MAXRBUF] = {0};
@@ -150,7 +150,7 @@ bool iEAFFocus::Ack()
         DEBUGF(INDI::Logger::DBG_ERROR, "Init read deviceinfo error: %s.", errstr);
         return false;
     }
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     resp[nbytes_read] = '\0';
     sscanf(resp, "%6d%2d%4d", &ieafpos, &ieafmodel, &ieaflast);
     //add iAFS Focuser
@@ -178,7 +178,7 @@ bool iEAFFocus::updateInfo()
     char joedeviceinfo[16] = {0};
     int ieafpos, ieafmove, ieaftemp, ieafdir;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ( (rc = tty_write(PortFD, ":FI#", 4, &nbytes_written)) != TTY_OK)
     {
         tty_error_msg(rc, errstr, MAXRBUF);
@@ -191,7 +191,7 @@ bool iEAFFocus::updateInfo()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     resp[nbytes_read] = '\0';
 
@@ -271,7 +271,7 @@ bool iEAFFocus::MoveMyFocuser(uint32_t position)
     snprintf(cmd, 12, ":FM%7u#", position);
 
     // Set Position
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ( (rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
         char errstr[MAXRBUF];
@@ -294,7 +294,7 @@ bool iEAFFocus::ReverseFocuser(bool enabled)
         return true;
 
     // Change Direction
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ( (rc = tty_write(PortFD, ":FR#", 4, &nbytes_written)) != TTY_OK)
     {
         char errstr[MAXRBUF];
@@ -312,7 +312,7 @@ void iEAFFocus::setZero()
 {
     int nbytes_written = 0, rc = -1;
     // Set Zero
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ( (rc = tty_write(PortFD, ":FZ#", 4, &nbytes_written)) != TTY_OK)
     {
         char errstr[MAXRBUF];
@@ -407,7 +407,7 @@ void iEAFFocus::TimerHit()
 bool iEAFFocus::AbortFocuser()
 {
     int nbytes_written;
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if (tty_write(PortFD, ":FQ#", 4, &nbytes_written) == TTY_OK)
     {
         FocusAbsPosNP.setState(IPS_IDLE);
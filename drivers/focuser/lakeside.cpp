@@ -1066,7 +1066,7 @@ bool Lakeside::gotoPosition(uint32_t position)
         }
 
     // flush ready to move
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!SendCmd(cmd))
     {
@@ -1100,7 +1100,7 @@ bool Lakeside::setBacklash(int backlash )
     char cmd[LAKESIDE_LEN] = {0};
     char resp[LAKESIDE_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //CRBnnn#
     snprintf(cmd, LAKESIDE_LEN, "CRB%d#", backlash);
@@ -1137,7 +1137,7 @@ bool Lakeside::setStepSize(int stepsize )
     char cmd[LAKESIDE_LEN] = {0};
     char resp[LAKESIDE_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // CRSnnnnn#
     snprintf(cmd, LAKESIDE_LEN,  "CRS%d#", stepsize);
@@ -1186,7 +1186,7 @@ bool Lakeside::ReverseFocuser(bool enabled)
     char cmd[LAKESIDE_LEN] = {0};
     char resp[LAKESIDE_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     strncpy(cmd, enabled ? "CRD1#" : "CRD0#", LAKESIDE_LEN);
 
@@ -1236,7 +1236,7 @@ bool Lakeside::setTemperatureTracking(bool enable)
     char cmd[LAKESIDE_LEN] = {0};
 
     // flush all
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (enable)
         strncpy(cmd, "CTN#", LAKESIDE_LEN);
@@ -1271,7 +1271,7 @@ bool Lakeside::setActiveTemperatureSlope(uint32_t active_slope)
     char resp[LAKESIDE_LEN] = {0};
 
     // flush all
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // slope in is either 1 or 2
     // CRg1# : Slope 1
@@ -1313,7 +1313,7 @@ bool Lakeside::setSlope1Inc(uint32_t slope1_inc)
     char cmd[LAKESIDE_LEN] = {0};
     char resp[LAKESIDE_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //CR1nnn#
     snprintf(cmd, LAKESIDE_LEN,  "CR1%d#", slope1_inc);
@@ -1349,7 +1349,7 @@ bool Lakeside::setSlope2Inc(uint32_t slope2_inc)
     char cmd[LAKESIDE_LEN] = {0};
     char resp[LAKESIDE_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //CR2nnn#
     snprintf(cmd, LAKESIDE_LEN,  "CR2%d#", slope2_inc);
@@ -1385,7 +1385,7 @@ bool Lakeside::setSlope1Dir(uint32_t slope1_direction)
     char cmd[LAKESIDE_LEN] = {0};
     char resp[LAKESIDE_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //CRannn#
     snprintf(cmd, LAKESIDE_LEN,  "CRa%d#", slope1_direction);
@@ -1421,7 +1421,7 @@ bool Lakeside::setSlope2Dir(uint32_t slope2_direction)
     char cmd[LAKESIDE_LEN] = {0};
     char resp[LAKESIDE_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //CRannn#
     snprintf(cmd, LAKESIDE_LEN,  "CRb%d#", slope2_direction);
@@ -1457,7 +1457,7 @@ bool Lakeside::setSlope1Deadband(uint32_t slope1_deadband)
     char cmd[LAKESIDE_LEN] = {0};
     char resp[LAKESIDE_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //CRcnnn#
     snprintf(cmd, LAKESIDE_LEN,  "CRc%d#", slope1_deadband);
@@ -1493,7 +1493,7 @@ bool Lakeside::setSlope2Deadband(uint32_t slope2_deadband)
     char cmd[LAKESIDE_LEN] = {0};
     char resp[LAKESIDE_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //CRdnnn#
     snprintf(cmd, LAKESIDE_LEN,  "CRd%d#", slope2_deadband);
@@ -1529,7 +1529,7 @@ bool Lakeside::setSlope1Period(uint32_t slope1_period)
     char cmd[LAKESIDE_LEN] = {0};
     char resp[LAKESIDE_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //CRennn#
     snprintf(cmd, LAKESIDE_LEN,  "CRe%d#", slope1_period);
@@ -1565,7 +1565,7 @@ bool Lakeside::setSlope2Period(uint32_t slope2_period)
     char cmd[LAKESIDE_LEN] = {0};
     char resp[LAKESIDE_LEN] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //CRfnnn#
     snprintf(cmd, LAKESIDE_LEN,  "CRf%d#", slope2_period);
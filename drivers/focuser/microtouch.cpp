@@ -137,7 +137,7 @@ bool Microtouch::updateProperties()
 
 bool Microtouch::Handshake()
 {
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (Ack())
     {
@@ -208,7 +208,7 @@ bool Microtouch::updateSpeed()
     char resp[3];
     short speed;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ( (rc = tty_write(PortFD, ":GD#", 4, &nbytes_written)) != TTY_OK)
     {
@@ -680,7 +680,7 @@ bool Microtouch::WriteCmd(char cmd)
     int nbytes_written = 0, rc = -1;
     char errstr[MAXRBUF];
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("WriteCmd : %02x ", cmd);
 
@@ -737,7 +737,7 @@ bool Microtouch::WriteCmdSetByte(char cmd, char val)
 
     LOGF_DEBUG("WriteCmdSetByte : CMD %02x %02x ", write_buffer[0], write_buffer[1]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, write_buffer, 2, &nbytes_written)) != TTY_OK)
     {
@@ -761,7 +761,7 @@ bool Microtouch::WriteCmdSetShortInt(char cmd, short int val)
     LOGF_DEBUG("WriteCmdSetShortInt : %02x %02x %02x ", write_buffer[0], write_buffer[1],
                write_buffer[2]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, write_buffer, 3, &nbytes_written)) != TTY_OK)
     {
@@ -798,7 +798,7 @@ bool Microtouch::WriteCmdSetInt(char cmd, int val)
     LOGF_DEBUG("WriteCmdSetInt : %02x %02x %02x %02x %02x ", write_buffer[0], write_buffer[1],
                write_buffer[2], write_buffer[3], write_buffer[4]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, write_buffer, 5, &nbytes_written)) != TTY_OK)
     {
@@ -824,7 +824,7 @@ bool Microtouch::WriteCmdSetIntAsDigits(char cmd, int val)
     LOGF_DEBUG("WriteCmdSetIntAsDigits : CMD (%02x %02x %02x %02x %02x) ", write_buffer[0],
                write_buffer[1], write_buffer[2], write_buffer[3], write_buffer[4]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, write_buffer, 5, &nbytes_written)) != TTY_OK)
     {
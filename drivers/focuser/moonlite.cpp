@@ -584,7 +584,7 @@ bool MoonLite::sendCommand(const char * cmd, char * res, bool silent, int nret)
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
@@ -623,7 +623,7 @@ bool MoonLite::sendCommand(const char * cmd, char * res, bool silent, int nret)
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -229,7 +229,7 @@ bool MoonLiteDRO::Ack()
     char resp[5] = {0};
     short pos = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //Try to request the position of the focuser
     //Test for success on transmission and response
@@ -266,7 +266,7 @@ bool MoonLiteDRO::Ack()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     rc = sscanf(resp, "%hX#", &pos);
 
@@ -288,7 +288,7 @@ bool MoonLiteDRO::updateStepDelay()
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
     {
@@ -304,7 +304,7 @@ bool MoonLiteDRO::updateStepDelay()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("RES <%s>", resp);
 
@@ -342,7 +342,7 @@ bool MoonLiteDRO::updateStepMode()
     else
         strncpy(cmd, ":2GH#", DRO_CMD);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
@@ -360,7 +360,7 @@ bool MoonLiteDRO::updateStepMode()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     resp[3] = '\0';
 
@@ -387,7 +387,7 @@ bool MoonLiteDRO::updateTemperature()
     char errstr[MAXRBUF];
     char resp[16] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     tty_write(PortFD, ":C#", 3, &nbytes_written);
 
@@ -407,7 +407,7 @@ bool MoonLiteDRO::updateTemperature()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     resp[nbytes_read - 1] = '\0';
 
@@ -445,7 +445,7 @@ bool MoonLiteDRO::updatePosition()
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
     {
@@ -461,7 +461,7 @@ bool MoonLiteDRO::updatePosition()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("RES <%s>", resp);
 
@@ -494,7 +494,7 @@ bool MoonLiteDRO::isMoving()
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
     {
@@ -510,7 +510,7 @@ bool MoonLiteDRO::isMoving()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     resp[2] = '\0';
 
@@ -535,7 +535,7 @@ bool MoonLiteDRO::setTemperatureCalibration(double calibration)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
     {
@@ -558,7 +558,7 @@ bool MoonLiteDRO::setTemperatureCoefficient(double coefficient)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write_string(PortFD, cmd, &nbytes_written)) != TTY_OK)
     {
@@ -646,7 +646,7 @@ bool MoonLiteDRO::setStepMode(FocusStepMode mode)
     char errstr[MAXRBUF];
     char cmd[DRO_CMD] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (mode == FOCUS_HALF_STEP)
     {
@@ -708,7 +708,7 @@ bool MoonLiteDRO::setTemperatureCompensation(bool enable)
     char errstr[MAXRBUF];
     char cmd[DRO_CMD] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (enable)
         strncpy(cmd, ":+#", DRO_CMD);
@@ -224,7 +224,7 @@ bool MyFocuserPro2::Ack()
     char resp[5] = {0};
     int firmWareVersion = 0;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //Try to request the firmware version
     //Test for success on transmission and response
@@ -271,7 +271,7 @@ bool MyFocuserPro2::Ack()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     rc = sscanf(resp, "F%d#", &firmWareVersion);
 
@@ -1441,7 +1441,7 @@ bool MyFocuserPro2::sendCommand(const char * cmd, char * res)
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
@@ -1489,7 +1489,7 @@ bool MyFocuserPro2::sendCommand(const char * cmd, char * res)
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     pthread_mutex_unlock(&cmdlock);
     return true;
 }
@@ -117,7 +117,7 @@ bool OnFocus::Ack()
     char errstr[MAXRBUF];
     char resp[16];
     sleep(2);
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ( (rc = tty_write(PortFD, ":IP#", 4, &nbytes_written)) != TTY_OK)
     {
@@ -131,7 +131,7 @@ bool OnFocus::Ack()
         DEBUGF(INDI::Logger::DBG_ERROR, "Init error: %s.", errstr);
         return false;
     }
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     resp[nbytes_read] = '\0';
     if (!strcmp(resp, "On-Focus#"))
     {
@@ -152,7 +152,7 @@ bool OnFocus::updatePosition()
     char resp[16];
     int pos = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ( (rc = tty_write(PortFD, ":GP#", 4, &nbytes_written)) != TTY_OK)
     {
@@ -168,7 +168,7 @@ bool OnFocus::updatePosition()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     resp[nbytes_read] = '\0';
 
@@ -196,7 +196,7 @@ bool OnFocus::updateMaxPos()
     char resp[16];
     long maxposition;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ( (rc = tty_write(PortFD, ":GM#", 4, &nbytes_written)) != TTY_OK)
     {
@@ -212,7 +212,7 @@ bool OnFocus::updateMaxPos()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     resp[nbytes_read] = '\0';
 
     rc = sscanf(resp, "%ld#", &maxposition);
@@ -237,7 +237,7 @@ bool OnFocus::isMoving()
     char errstr[MAXRBUF];
     char resp[16];
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ( (rc = tty_write(PortFD, ":IS#", 4, &nbytes_written)) != TTY_OK)
     {
@@ -253,7 +253,7 @@ bool OnFocus::isMoving()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     resp[nbytes_read] = '\0';
     if (!strcmp(resp, "M#"))
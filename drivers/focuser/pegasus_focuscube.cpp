@@ -164,7 +164,7 @@ bool PegasusFocusCube::ack()
 
     LOGF_DEBUG("CMD <%#02X>", cmd[0]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 2, &nbytes_written)) != TTY_OK)
     {
@@ -188,7 +188,7 @@ bool PegasusFocusCube::ack()
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if(strstr(res, "OK_FC") != nullptr)
         return true;
@@ -310,7 +310,7 @@ bool PegasusFocusCube::updateFocusParams()
 
     LOGF_DEBUG("CMD <%#02X>", cmd[0]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 2, &nbytes_written)) != TTY_OK)
     {
@@ -334,7 +334,7 @@ bool PegasusFocusCube::updateFocusParams()
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     char *token = std::strtok(res, ":");
 
@@ -522,7 +522,7 @@ bool PegasusFocusCube::setMaxSpeed(uint16_t speed)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Set Speed
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -547,7 +547,7 @@ bool PegasusFocusCube::ReverseFocuser(bool enabled)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Reverse
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -573,7 +573,7 @@ bool PegasusFocusCube::setLedEnabled(bool enable)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Led
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -598,7 +598,7 @@ bool PegasusFocusCube::setEncodersEnabled(bool enable)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Encoders
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -623,7 +623,7 @@ bool PegasusFocusCube::SetFocuserBacklash(int32_t steps)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Backlash
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -63,7 +63,7 @@ bool PegasusFocusCube3::Handshake()
 
 
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     strncpy(command, "##\r\n", PEGASUS_LEN);
     if ( (tty_rc = tty_write_string(PortFD, command, &nbytes_written)) != TTY_OK)
     {
@@ -79,7 +79,7 @@ bool PegasusFocusCube3::Handshake()
         // Try 0xA as the stop character
         if (tty_rc == TTY_OVERFLOW || tty_rc == TTY_TIME_OUT)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
             tty_write_string(PortFD, command, &nbytes_written);
             stopChar = 0xA;
             tty_rc = tty_nread_section(PortFD, response, PEGASUS_LEN, stopChar, 1, &nbytes_read);
@@ -94,7 +94,7 @@ bool PegasusFocusCube3::Handshake()
         }
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     response[nbytes_read - 1] = '\0';
     LOGF_DEBUG("RES <%s>", response);
 
@@ -266,14 +266,14 @@ bool PegasusFocusCube3::sendCommand(const char * cmd, char * res)
 
     for (int i = 0; i < 2; i++)
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         snprintf(command, PEGASUS_LEN, "%s\n", cmd);
         if ( (tty_rc = tty_write_string(PortFD, command, &nbytes_written)) != TTY_OK)
             continue;
 
         if (!res)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
             return true;
         }
 
@@ -281,7 +281,7 @@ bool PegasusFocusCube3::sendCommand(const char * cmd, char * res)
                 || nbytes_read == 1)
             continue;
 
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         res[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES <%s>", res);
         return true;
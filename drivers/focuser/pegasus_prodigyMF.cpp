@@ -142,7 +142,7 @@ bool PegasusProdigyMF::ack()
 
     LOGF_DEBUG("CMD <%#02X>", cmd[0]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 2, &nbytes_written)) != TTY_OK)
     {
@@ -166,7 +166,7 @@ bool PegasusProdigyMF::ack()
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if(strstr(res, "OK_PRDG") != nullptr)
         return true;
@@ -260,7 +260,7 @@ bool PegasusProdigyMF::updateFocusParams()
 
     LOGF_DEBUG("CMD <%#02X>", cmd[0]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 2, &nbytes_written)) != TTY_OK)
     {
@@ -284,7 +284,7 @@ bool PegasusProdigyMF::updateFocusParams()
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     char *token = std::strtok(res, ":");
 
@@ -411,7 +411,7 @@ bool PegasusProdigyMF::setMaxSpeed(uint16_t speed)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Set Speed
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
@@ -436,7 +436,7 @@ bool PegasusProdigyMF::ReverseFocuser(bool enabled)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Reverse
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
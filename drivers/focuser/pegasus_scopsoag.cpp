@@ -145,7 +145,7 @@ bool PegasusScopsOAG::ack()
 
     LOGF_DEBUG("CMD <%#02X>", cmd[0]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 2, &nbytes_written)) != TTY_OK)
     {
@@ -169,7 +169,7 @@ bool PegasusScopsOAG::ack()
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
 
 
@@ -263,7 +263,7 @@ bool PegasusScopsOAG::updateFocusParams()
 
     LOGF_DEBUG("CMD <%#02X>", cmd[0]);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 2, &nbytes_written)) != TTY_OK)
     {
@@ -287,7 +287,7 @@ bool PegasusScopsOAG::updateFocusParams()
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     char *token = std::strtok(res, ":");
 
@@ -424,7 +424,7 @@ bool PegasusScopsOAG::setLedEnabled(bool enable)
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Led
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
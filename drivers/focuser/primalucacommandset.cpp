@@ -57,7 +57,7 @@ bool Communication::sendRequest(const json &command, json *response)
 {
     int tty_rc = TTY_OK;
     int nbytes_written = 0, nbytes_read = 0;
-    tcflush(m_PortFD, TCIOFLUSH);
+    tty_flush(m_PortFD, TCIOFLUSH);
 
     std::string output = command.dump();
     LOGF_DEBUG("<REQ> %s", output.c_str());
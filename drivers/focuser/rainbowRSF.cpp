@@ -457,7 +457,7 @@ bool RainbowRSF::sendCommand(const char * cmd, char * res, int res_len)
     if (cmd_len <= 0)
         return false;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
@@ -487,7 +487,7 @@ bool RainbowRSF::sendCommand(const char * cmd, char * res, int res_len)
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
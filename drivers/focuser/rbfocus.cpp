@@ -102,7 +102,7 @@ bool RBFOCUS::Ack()
     char errstr[MAXRBUF];
     char resp[5] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     int numChecks = 0;
     bool success = false;
@@ -135,7 +135,7 @@ bool RBFOCUS::Ack()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return !strcmp(resp, "OK!#");
 }
@@ -437,7 +437,7 @@ bool RBFOCUS::sendCommand(const char * cmd, char * res)
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
@@ -465,7 +465,7 @@ bool RBFOCUS::sendCommand(const char * cmd, char * res)
 
     LOGF_DEBUG("RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
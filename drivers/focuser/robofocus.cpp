@@ -214,7 +214,7 @@ int RoboFocus::SendCommand(char *rf_cmd)
     if (isSimulation())
         return 0;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%#02X %#02X %#02X %#02X %#02X %#02X %#02X %#02X %#02X)", rf_cmd_cks[0],
                rf_cmd_cks[1], rf_cmd_cks[2], rf_cmd_cks[3], rf_cmd_cks[4], rf_cmd_cks[5], rf_cmd_cks[6], rf_cmd_cks[7],
@@ -311,7 +311,7 @@ int RoboFocus::ReadResponse(char *buf)
                     }
                 }
 
-                tcflush(PortFD, TCIOFLUSH);
+                tty_flush(PortFD, TCIOFLUSH);
                 return (bytesRead + 1);
                 break;
 
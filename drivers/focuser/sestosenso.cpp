@@ -633,7 +633,7 @@ bool SestoSenso::sendCommand(const char * cmd, char * res, int cmd_len, int res_
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -686,7 +686,7 @@ bool SestoSenso::sendCommand(const char * cmd, char * res, int cmd_len, int res_
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -185,7 +185,7 @@ IPState SmartFocus::MoveAbsFocuser(uint32_t targetPosition)
             command[1] = ((destination >> 8) & 0xFF);
             command[2] = (destination & 0xFF);
             LOGF_DEBUG("MoveAbsFocuser: destination= %d", destination);
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
             if (send(command, sizeof(command), "MoveAbsFocuser"))
             {
                 char respons;
@@ -282,7 +282,7 @@ bool SmartFocus::SFacknowledge()
         success = true;
     else
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         if (send(&read_id_register, sizeof(read_id_register), "SFacknowledge"))
         {
             char respons[2];
@@ -306,7 +306,7 @@ SmartFocus::Position SmartFocus::SFgetPosition()
         result = position;
     else
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         if (send(&read_position, sizeof(read_position), "SFgetPosition"))
         {
             char respons[3];
@@ -332,7 +332,7 @@ SmartFocus::Flags SmartFocus::SFgetFlags()
     Flags result = 0x00;
     if (!isSimulation())
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         if (send(&read_flags, sizeof(read_flags), "SFgetFlags"))
         {
             char respons[2];
@@ -197,7 +197,7 @@ bool SteelDrive::Ack()
     char resp[STEELDRIVE_MAXBUF] = {0};
     char hwVer[STEELDRIVE_MAXBUF];
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, ":FVERSIO#", STEELDRIVE_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -250,7 +250,7 @@ bool SteelDrive::updateVersion()
     memset(fwdate, 0, sizeof(fwdate));
     memset(fwrev, 0, sizeof(fwrev));
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, ":FVERSIO#", STEELDRIVE_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -297,7 +297,7 @@ bool SteelDrive::updateVersion()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, ":FNFIRMW#", STEELDRIVE_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -357,7 +357,7 @@ bool SteelDrive::updateTemperature()
     char resp[STEELDRIVE_MAXBUF] = {0};
     int temperature;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, ":F5ASKT0#", STEELDRIVE_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -423,7 +423,7 @@ bool SteelDrive::updatePosition()
 
     for (retries = 0; retries < STEELDRIVE_MAX_RETRIES; retries++)
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
 
         if (!sim && (rc = tty_write(PortFD, ":F8ASKS0#", STEELDRIVE_CMD, &nbytes_written)) != TTY_OK)
         {
@@ -486,7 +486,7 @@ bool SteelDrive::updateSpeed()
     char resp[STEELDRIVE_MAXBUF] = {0};
     unsigned short speed;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, ":FGSPMAX#", STEELDRIVE_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -538,7 +538,7 @@ bool SteelDrive::updateAcceleration()
     char resp[STEELDRIVE_MAXBUF] = {0};
     unsigned short accel;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, ":FHSPMIN#", STEELDRIVE_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -590,7 +590,7 @@ bool SteelDrive::updateTemperatureSettings()
 
     char selectedFocuser[1], coeff[3], enabled[1], tResp[STEELDRIVE_MAXBUF];
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sim && (rc = tty_write(PortFD, ":F7ASKC0#", STEELDRIVE_CMD, &nbytes_written)) != TTY_OK)
     {
@@ -655,7 +655,7 @@ bool SteelDrive::updateCustomSettings()
     int gearR;
     double gearRatio;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Get Gear Ratio
     if (!sim && (rc = tty_write(PortFD, ":FEASKGR#", STEELDRIVE_CMD, &nbytes_written)) != TTY_OK)
@@ -695,7 +695,7 @@ bool SteelDrive::updateCustomSettings()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Get Max Trip
     if (!sim && (rc = tty_write(PortFD, ":F8ASKS1#", STEELDRIVE_CMD, &nbytes_written)) != TTY_OK)
@@ -788,7 +788,7 @@ bool SteelDrive::setTemperatureSamples(unsigned int targetSamples, unsigned int
 
     snprintf(cmd, STEELDRIVE_CMD + 1, ":FI%05d#", value);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", cmd);
 
@@ -820,7 +820,7 @@ bool SteelDrive::setTemperatureCompensation()
 
     snprintf(cmd, STEELDRIVE_CMD + 1, ":F%02d%03d%d#", selectedFocus, (int)(coeff * 1000), enable ? 2 : 0);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", cmd);
 
@@ -847,7 +847,7 @@ bool SteelDrive::setCustomSettings(double maxTrip, double gearRatio)
 
     snprintf(cmd, STEELDRIVE_CMD_LONG + 1, ":FC%07d#", mmTrip);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", cmd);
 
@@ -860,7 +860,7 @@ bool SteelDrive::setCustomSettings(double maxTrip, double gearRatio)
 
     snprintf(cmd, STEELDRIVE_CMD + 1, ":FD%05d#", (int)(gearRatio * 100000));
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", cmd);
 
@@ -885,7 +885,7 @@ bool SteelDrive::Sync(unsigned int position)
 
     snprintf(cmd, STEELDRIVE_CMD_LONG + 1, ":FB%07d#", position);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", cmd);
 
@@ -921,7 +921,7 @@ bool SteelDrive::moveFocuser(unsigned int position)
 
     snprintf(cmd, STEELDRIVE_CMD_LONG + 1, ":F9%07d#", position);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", cmd);
 
@@ -951,7 +951,7 @@ bool SteelDrive::startMotion(FocusDirection dir)
     // outward --> increasing value --> UP
     strncpy(cmd, (dir == FOCUS_INWARD) ? ":F2MDOW0#" : ":F1MUP00#", STEELDRIVE_CMD + 1);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", cmd);
 
@@ -976,7 +976,7 @@ bool SteelDrive::setSpeed(unsigned short speed)
 
     snprintf(cmd, STEELDRIVE_CMD + 1, ":Fg%05d#", speed);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", cmd);
 
@@ -1003,7 +1003,7 @@ bool SteelDrive::setAcceleration(unsigned short accel)
 
     snprintf(cmd, STEELDRIVE_CMD + 1, ":Fh%05d#", accel);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", cmd);
 
@@ -1424,7 +1424,7 @@ bool SteelDrive::AbortFocuser()
     int nbytes_written = 0, rc = -1;
     char errstr[MAXRBUF] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOG_DEBUG("CMD :F3STOP0#");
 
@@ -1494,7 +1494,7 @@ bool SteelDrive::saveFocuserConfig()
     int nbytes_written = 0, rc = -1;
     char errstr[MAXRBUF] = {0};
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOG_DEBUG("CMD (:FFPOWER#)");
 
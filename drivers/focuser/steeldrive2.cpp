@@ -647,7 +647,7 @@ bool SteelDriveII::sendCommand(const char * cmd, char * res, int cmd_len, int re
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -711,7 +711,7 @@ bool SteelDriveII::sendCommand(const char * cmd, char * res, int cmd_len, int re
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -263,7 +263,7 @@ bool TCFS::Handshake()
     if (strcmp(response, "WAKE") == 0)
     {
         LOG_INFO("TCF-S Focuser is awake");
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
     }
 
     if(SetManualMode())
@@ -275,7 +275,7 @@ bool TCFS::Handshake()
 
         return true;
     }
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     LOG_ERROR("Failed connection to TCF-S Focuser.");
     return false;
 }
@@ -292,12 +292,12 @@ bool TCFS::SetManualMode()
         read_tcfs(response);
         if (strcmp(response, "!") == 0)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
             currentMode = MANUAL;
             return true;
         }
     }
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     return false;
 }
 
@@ -909,7 +909,7 @@ bool TCFS::dispatch_command(TCFSCommand command_type, int val, TCFSMode m)
     if (isSimulation())
         return true;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ( (err_code = tty_write(PortFD, command, strlen(command), &nbytes_written)) != TTY_OK)
     {
@@ -1186,7 +1186,7 @@ bool TCFS::read_tcfs(char *response, bool silent)
     // Remove LF & CR
     response[nbytes_read - 2] = '\0';
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (strstr(response, "ER="))
     {
@@ -532,7 +532,7 @@ bool TeenAstroFocuser::send(const char *const msg)
 {
     DEBUGF(INDI::Logger::DBG_DEBUG, "send(\"%s\")", msg);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     int nbytes_written = 0, rc = -1;
     if ( (rc = tty_write(PortFD, msg, strlen(msg), &nbytes_written)) != TTY_OK)
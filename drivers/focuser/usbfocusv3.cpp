@@ -214,7 +214,7 @@ bool USBFocusV3::Resync()
     // Send up to 5 space characters and wait for error
     // response ("ER=1") after which the communication
     // is back in sync
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     for (int resync = 0; resync < UFOCMDLEN; resync++)
     {
@@ -247,7 +247,7 @@ bool USBFocusV3::sendCommand(const char *cmd, char *resp)
     char errstr[MAXRBUF];
     LOGF_DEBUG("CMD: %s.", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
         tty_error_msg(rc, errstr, MAXRBUF);
@@ -307,7 +307,7 @@ bool USBFocusV3::sendCommandSpecial(const char *cmd, char *resp)
     char errstr[MAXRBUF];
     LOGF_DEBUG("CMD: %s.", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
         tty_error_msg(rc, errstr, MAXRBUF);
@@ -336,7 +336,7 @@ bool USBFocusV3::sendCommandSpecial(const char *cmd, char *resp)
 bool USBFocusV3::Ack()
 {
     char resp[UFORESLEN] = {};
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (!sendCommand(UFOCDEVID, resp))
         return false;
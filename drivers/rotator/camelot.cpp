@@ -340,7 +340,7 @@ bool Camelot::sendCommand(const char * cmd, char * res, int cmd_len, int res_len
 
     do
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
 
         if (cmd_len > 0)
         {
@@ -787,12 +787,12 @@ bool Gemini::ack()
         // Read 'END'
         tty_read_section(PortFD, response, 0xA, GEMINI_TIMEOUT, &nbytes_read);
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         return true;
     }
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
     return false;
 }
 
@@ -820,7 +820,7 @@ bool Gemini::getFocusConfig()
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1257,7 +1257,7 @@ bool Gemini::getFocusConfig()
     }
     // End of added code by Philippe Besson
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     focuserConfigurationComplete = true;
 
@@ -1288,7 +1288,7 @@ bool Gemini::getRotatorStatus()
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1521,7 +1521,7 @@ bool Gemini::getRotatorStatus()
     }
     // End of added code by Philippe Besson
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return true;
 
@@ -1551,7 +1551,7 @@ bool Gemini::getRotatorConfig()
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1829,7 +1829,7 @@ bool Gemini::getRotatorConfig()
     }
     // End of added code by Philippe Besson
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     rotatorConfigurationComplete = true;
 
@@ -1860,7 +1860,7 @@ bool Gemini::getFocusStatus()
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2164,7 +2164,7 @@ bool Gemini::getFocusStatus()
     }
     // End of added code by Philippe Besson
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return true;
 
@@ -2197,7 +2197,7 @@ bool Gemini::setLedLevel(int level)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2221,7 +2221,7 @@ bool Gemini::setLedLevel(int level)
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
             return true;
@@ -2253,7 +2253,7 @@ bool Gemini::setNickname(DeviceType type, const char *nickname)
 
     if (!isSimulation())
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2269,7 +2269,7 @@ bool Gemini::setNickname(DeviceType type, const char *nickname)
         tty_read_section(PortFD, response, 0xA, GEMINI_TIMEOUT, &nbytes_read);
     }
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
     return true;
 }
 
@@ -2302,7 +2302,7 @@ bool Gemini::halt(DeviceType type)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2320,7 +2320,7 @@ bool Gemini::halt(DeviceType type)
 
     isRotatorHoming = false;
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return true;
 }
@@ -2357,7 +2357,7 @@ bool Gemini::home(DeviceType type)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2373,7 +2373,7 @@ bool Gemini::home(DeviceType type)
         tty_read_section(PortFD, response, 0xA, GEMINI_TIMEOUT, &nbytes_read);
     }
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return true;
 }
@@ -2397,7 +2397,7 @@ bool Gemini::homeOnStart(DeviceType type, bool enable)
 
     if (isSimulation() == false)
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2413,7 +2413,7 @@ bool Gemini::homeOnStart(DeviceType type, bool enable)
         tty_read_section(PortFD, response, 0xA, GEMINI_TIMEOUT, &nbytes_read);
     }
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return true;
 }
@@ -2453,7 +2453,7 @@ bool Gemini::center(DeviceType type)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2469,7 +2469,7 @@ bool Gemini::center(DeviceType type)
         tty_read_section(PortFD, response, 0xA, GEMINI_TIMEOUT, &nbytes_read);
     }
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return true;
 }
@@ -2494,7 +2494,7 @@ bool Gemini::setTemperatureCompensation(bool enable)
 
     if (isSimulation() == false)
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2533,7 +2533,7 @@ bool Gemini::setTemperatureCompensationMode(char mode)
 
     if (isSimulation() == false)
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2572,7 +2572,7 @@ bool Gemini::setTemperatureCompensationCoeff(char mode, int16_t coeff)
 
     if (isSimulation() == false)
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2609,7 +2609,7 @@ bool Gemini::setTemperatureCompensationOnStart(bool enable)
 
     LOGF_DEBUG("CMD (%s)", cmd);
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     if (isSimulation() == false)
     {
@@ -2780,7 +2780,7 @@ bool Gemini::resetFactory()
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2804,7 +2804,7 @@ bool Gemini::resetFactory()
     {
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (!strcmp(response, "SET"))
         {
@@ -2895,7 +2895,7 @@ IPState Gemini::MoveFocuser(FocusDirection dir, int speed, uint16_t duration)
 
     if (!isSimulation())
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2918,7 +2918,7 @@ IPState Gemini::MoveFocuser(FocusDirection dir, int speed, uint16_t duration)
         return IPS_OK;
     }
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return IPS_BUSY;
 }
@@ -2944,7 +2944,7 @@ IPState Gemini::MoveAbsFocuser(uint32_t targetTicks)
 
     if (!isSimulation())
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2959,7 +2959,7 @@ IPState Gemini::MoveAbsFocuser(uint32_t targetTicks)
 
     FocusAbsPosNP.setState(IPS_BUSY);
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return IPS_BUSY;
 }
@@ -3166,7 +3166,7 @@ bool Gemini::AbortFocuser()
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -3193,7 +3193,7 @@ bool Gemini::AbortFocuser()
     FocusAbsPosNP.apply();
     FocuserGotoSP.apply();
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return true;
 }
@@ -3239,7 +3239,7 @@ IPState Gemini::MoveAbsRotatorTicks(uint32_t targetTicks)
 
     if (!isSimulation())
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -3254,7 +3254,7 @@ IPState Gemini::MoveAbsRotatorTicks(uint32_t targetTicks)
 
     RotatorAbsPosNP.setState(IPS_BUSY);
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return IPS_BUSY;
 }
@@ -3280,7 +3280,7 @@ IPState Gemini::MoveAbsRotatorAngle(double angle)
     {
         int errcode = 0;
         char errmsg[MAXRBUF];
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -3295,7 +3295,7 @@ IPState Gemini::MoveAbsRotatorAngle(double angle)
 
     GotoRotatorNP.setState(IPS_BUSY);
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return IPS_BUSY;
 }
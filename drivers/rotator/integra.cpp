@@ -930,7 +930,7 @@ bool Integra::genericIntegraCommand(const char *name, const char *cmd, const cha
     cleanPrint(cmd, cmdnocrlf);
     LOGF_DEBUG("CMD %s (%s)", name, cmdnocrlf);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     if ( (rc = tty_write(PortFD, cmd, (int)strlen(cmd), &nbytes_written)) != TTY_OK)
     {
         tty_error_msg(rc, errstr, MAXRBUF);
@@ -350,7 +350,7 @@ bool PegasusFalcon::sendCommand(const char * cmd, char * res, int cmd_len, int r
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -405,7 +405,7 @@ bool PegasusFalcon::sendCommand(const char * cmd, char * res, int cmd_len, int r
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
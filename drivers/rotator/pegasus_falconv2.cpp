@@ -328,7 +328,7 @@ bool PegasusFalconV2::sendCommand(const char * cmd, char * res, int cmd_len, int
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -383,7 +383,7 @@ bool PegasusFalconV2::sendCommand(const char * cmd, char * res, int cmd_len, int
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -128,7 +128,7 @@ bool WandererRotatorBase::ISNewNumber(const char * dev, const char * name, doubl
 bool WandererRotatorBase::Handshake()
 {
     PortFD = serialConnection->getPortFD();
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     int nbytes_read_name = 0, nbytes_written = 0, rc = -1;
     char name[64] = {0};
 
@@ -143,7 +143,7 @@ bool WandererRotatorBase::Handshake()
     //Device Model//////////////////////////////////////////////////////////////////////////////////////////////////////
     if ((rc = tty_read_section(PortFD, name, 'A', 3, &nbytes_read_name)) != TTY_OK)
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         if ((rc = tty_write_string(PortFD, "1500001", &nbytes_written)) != TTY_OK)
         {
             char errorMessage[MAXRBUF];
@@ -226,7 +226,7 @@ bool WandererRotatorBase::Handshake()
         ReverseRotator(true);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     return true;
 }
 
@@ -253,7 +253,7 @@ bool WandererRotatorBase::AbortRotator()
     {
         haltcommand = true;
         int nbytes_written = 0, rc = -1;
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
         if ((rc = tty_write_string(PortFD, "Stop", &nbytes_written)) != TTY_OK)
         {
             char errorMessage[MAXRBUF];
@@ -646,7 +646,7 @@ bool SpectraCyber::dispatch_command(SpectrometerCommand command_type)
     // Maximum of 3 hex digits in addition to null terminator
     char hex[5];
 
-    tcflush(fd, TCIOFLUSH);
+    tty_flush(fd, TCIOFLUSH);
 
     switch (command_type)
     {
@@ -1396,7 +1396,7 @@ bool AstroTrac::sendCommand(const char *cmd, char *res, int cmd_len, int res_len
     if (isSimulation())
         return handleSimulationCommand(cmd, res, cmd_len, res_len);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -1449,7 +1449,7 @@ bool AstroTrac::sendCommand(const char *cmd, char *res, int cmd_len, int res_len
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -111,7 +111,7 @@ void CelestronDriver::set_device(const char *name)
 // Virtual method for testing
 int CelestronDriver::serial_write(const char *cmd, int nbytes, int *nbytes_written)
 {
-    tcflush(fd, TCIOFLUSH);
+    tty_flush(fd, TCIOFLUSH);
     return tty_write(fd, cmd, nbytes, nbytes_written);
 }
 
@@ -710,7 +710,7 @@ bool TitanTCS::SendCommand(const char *cmd)
     if (isSimulation())
         return false;
 
-    // tcflush(PortFD, TCIOFLUSH);  // Error with Bluetooth!
+    // tty_flush(PortFD, TCIOFLUSH);  // Error with Bluetooth!
     ReadFlush();
 
     int nbytes_written = 0;
@@ -724,7 +724,7 @@ bool TitanTCS::SendCommand(const char *cmd)
         return false;
     }
 
-    // tcflush(PortFD, TCIOFLUSH);  // Error with Bluetooth!
+    // tty_flush(PortFD, TCIOFLUSH);  // Error with Bluetooth!
 
     return true;
 }
@@ -753,7 +753,7 @@ void TitanTCS::ReadFlush()
     char buff[256];
     int bytesRead = 0;
 
-    // tcflush(PortFD, TCIOFLUSH);  // Error with Bluetooth!
+    // tty_flush(PortFD, TCIOFLUSH);  // Error with Bluetooth!
 
     for(int i = 0; i < 3; i++)
     {
@@ -779,7 +779,7 @@ int TitanTCS::ReadResponse(char *buf, int len, char delimeter, int timeout)
     int bytesRead = 0;
     int recv_len = 0;
 
-    // tcflush(PortFD, TCIOFLUSH);  // Error with Bluetooth!
+    // tty_flush(PortFD, TCIOFLUSH);  // Error with Bluetooth!
 
     for(int i = 0; i < len; i++)
     {
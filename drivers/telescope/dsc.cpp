@@ -263,7 +263,7 @@ bool DSC::ReadScopeStatus()
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((rc = tty_write(PortFD, CR, 1, &nbytes_written)) != TTY_OK)
         {
@@ -173,7 +173,7 @@ bool EQ500X::checkConnection()
         tty_set_debug(1);
 
         LOG_DEBUG("Clearing input...");
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
     }
 
     for (int i = 0; i < 2; i++)
@@ -703,7 +703,7 @@ bool EQ500X::Sync(double ra, double dec)
         if (!isSimulation())
         {
             char b[64/*RB_MAX_LEN*/] = {0};
-            tcflush(PortFD, TCIFLUSH);
+            tty_flush(PortFD, TCIFLUSH);
 
             if (getCommandString(PortFD, b, ":CM#") < 0)
                 goto sync_error;
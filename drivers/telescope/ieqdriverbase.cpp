@@ -704,7 +704,7 @@ bool Base::sendCommand(const char * cmd, char * res, int cmd_len, int res_len)
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(m_PortFD, TCIOFLUSH);
+    tty_flush(m_PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -754,7 +754,7 @@ bool Base::sendCommand(const char * cmd, char * res, int cmd_len, int res_len)
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(m_PortFD, TCIOFLUSH);
+    tty_flush(m_PortFD, TCIOFLUSH);
 
     return true;
 }
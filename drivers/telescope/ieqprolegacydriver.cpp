@@ -132,7 +132,7 @@ bool check_ieqpro_connection(int fd)
         }
         else
         {
-            tcflush(fd, TCIFLUSH);
+            tty_flush(fd, TCIFLUSH);
 
             if ((errcode = tty_write(fd, initCMD, 3, &nbytes_written)) != TTY_OK)
             {
@@ -185,7 +185,7 @@ bool get_ieqpro_status(int fd, IEQInfo *info)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -216,7 +216,7 @@ bool get_ieqpro_status(int fd, IEQInfo *info)
             info->timeSource   = (IEQ_TIME_SOURCE)(response[4] - '0');
             info->hemisphere   = (IEQ_HEMISPHERE)(response[5] - '0');
 
-            tcflush(fd, TCIFLUSH);
+            tty_flush(fd, TCIFLUSH);
 
             return true;
         }
@@ -263,7 +263,7 @@ bool get_ieqpro_model(int fd, FirmwareInfo *info)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -314,7 +314,7 @@ bool get_ieqpro_model(int fd, FirmwareInfo *info)
             else
                 info->Model = "Unknown";
 
-            tcflush(fd, TCIFLUSH);
+            tty_flush(fd, TCIFLUSH);
 
             return true;
         }
@@ -342,7 +342,7 @@ bool get_ieqpro_main_firmware(int fd, FirmwareInfo *info)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -374,7 +374,7 @@ bool get_ieqpro_main_firmware(int fd, FirmwareInfo *info)
             info->MainBoardFirmware.assign(board, 6);
             info->ControllerFirmware.assign(controller, 6);
 
-            tcflush(fd, TCIFLUSH);
+            tty_flush(fd, TCIFLUSH);
 
             return true;
         }
@@ -402,7 +402,7 @@ bool get_ieqpro_radec_firmware(int fd, FirmwareInfo *info)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -434,7 +434,7 @@ bool get_ieqpro_radec_firmware(int fd, FirmwareInfo *info)
             info->RAFirmware.assign(ra, 6);
             info->DEFirmware.assign(dec, 6);
 
-            tcflush(fd, TCIFLUSH);
+            tty_flush(fd, TCIFLUSH);
 
             return true;
         }
@@ -479,7 +479,7 @@ bool start_ieqpro_motion(int fd, IEQ_DIRECTION dir)
     if (ieqpro_simulation)
         return true;
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
@@ -488,7 +488,7 @@ bool start_ieqpro_motion(int fd, IEQ_DIRECTION dir)
         return false;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return true;
 }
 
@@ -523,7 +523,7 @@ bool stop_ieqpro_motion(int fd, IEQ_DIRECTION dir)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -545,7 +545,7 @@ bool stop_ieqpro_motion(int fd, IEQ_DIRECTION dir)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -571,7 +571,7 @@ bool find_ieqpro_home(int fd)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -593,7 +593,7 @@ bool find_ieqpro_home(int fd)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -619,7 +619,7 @@ bool goto_ieqpro_home(int fd)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -641,7 +641,7 @@ bool goto_ieqpro_home(int fd)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -667,7 +667,7 @@ bool set_ieqpro_current_home(int fd)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -689,7 +689,7 @@ bool set_ieqpro_current_home(int fd)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -718,7 +718,7 @@ bool set_ieqpro_slew_rate(int fd, IEQ_SLEW_RATE rate)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -740,7 +740,7 @@ bool set_ieqpro_slew_rate(int fd, IEQ_SLEW_RATE rate)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -786,7 +786,7 @@ bool set_ieqpro_track_mode(int fd, IEQ_TRACK_RATE rate)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -808,7 +808,7 @@ bool set_ieqpro_track_mode(int fd, IEQ_TRACK_RATE rate)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -842,7 +842,7 @@ bool set_ieqpro_custom_ra_track_rate(int fd, double rate)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -864,7 +864,7 @@ bool set_ieqpro_custom_ra_track_rate(int fd, double rate)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -898,7 +898,7 @@ bool set_ieqpro_custom_de_track_rate(int fd, double rate)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -920,7 +920,7 @@ bool set_ieqpro_custom_de_track_rate(int fd, double rate)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -950,7 +950,7 @@ bool set_ieqpro_guide_rate(int fd, double raRate, double deRate)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -972,7 +972,7 @@ bool set_ieqpro_guide_rate(int fd, double raRate, double deRate)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -999,7 +999,7 @@ bool get_ieqpro_guide_rate(int fd, double *raRate, double *deRate)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1026,7 +1026,7 @@ bool get_ieqpro_guide_rate(int fd, double *raRate, double *deRate)
         strncpy(response + 2, deRateStr, 2);
         *raRate = atoi(raRateStr) / 100.0;
         *deRate = atoi(deRateStr) / 100.0;
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1070,7 +1070,7 @@ bool start_ieqpro_guide(int fd, IEQ_DIRECTION dir, uint32_t ms)
         return true;
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1080,7 +1080,7 @@ bool start_ieqpro_guide(int fd, IEQ_DIRECTION dir, uint32_t ms)
         }
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return true;
 }
 
@@ -1104,7 +1104,7 @@ bool park_ieqpro(int fd)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1128,7 +1128,7 @@ bool park_ieqpro(int fd)
 
         if (!strcmp(response, "1"))
         {
-            tcflush(fd, TCIFLUSH);
+            tty_flush(fd, TCIFLUSH);
             return true;
         }
         else
@@ -1161,7 +1161,7 @@ bool unpark_ieqpro(int fd)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1183,7 +1183,7 @@ bool unpark_ieqpro(int fd)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1211,7 +1211,7 @@ bool abort_ieqpro(int fd)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1233,7 +1233,7 @@ bool abort_ieqpro(int fd)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1261,7 +1261,7 @@ bool slew_ieqpro(int fd)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1285,13 +1285,13 @@ bool slew_ieqpro(int fd)
 
         if (!strcmp(response, "1"))
         {
-            tcflush(fd, TCIFLUSH);
+            tty_flush(fd, TCIFLUSH);
             return true;
         }
         else
         {
             DEBUGDEVICE(ieqpro_device, INDI::Logger::DBG_ERROR, "Requested object is below horizon.");
-            tcflush(fd, TCIFLUSH);
+            tty_flush(fd, TCIFLUSH);
             return false;
         }
     }
@@ -1318,7 +1318,7 @@ bool sync_ieqpro(int fd)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1340,7 +1340,7 @@ bool sync_ieqpro(int fd)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1369,7 +1369,7 @@ bool set_ieqpro_track_enabled(int fd, bool enabled)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1391,7 +1391,7 @@ bool set_ieqpro_track_enabled(int fd, bool enabled)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1423,7 +1423,7 @@ bool set_ieqpro_ra(int fd, double ra)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1445,7 +1445,7 @@ bool set_ieqpro_ra(int fd, double ra)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1483,7 +1483,7 @@ bool set_ieqpro_dec(int fd, double dec)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1505,7 +1505,7 @@ bool set_ieqpro_dec(int fd, double dec)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1540,7 +1540,7 @@ bool set_ieqpro_longitude(int fd, double longitude)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1562,7 +1562,7 @@ bool set_ieqpro_longitude(int fd, double longitude)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1597,7 +1597,7 @@ bool set_ieqpro_latitude(int fd, double latitude)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1619,7 +1619,7 @@ bool set_ieqpro_latitude(int fd, double latitude)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1647,7 +1647,7 @@ bool get_ieqpro_longitude(int fd, double *longitude)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1668,7 +1668,7 @@ bool get_ieqpro_longitude(int fd, double *longitude)
         response[nbytes_read - 1] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         int longitude_arcsecs = 0;
 
@@ -1706,7 +1706,7 @@ bool get_ieqpro_latitude(int fd, double *latitude)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1727,7 +1727,7 @@ bool get_ieqpro_latitude(int fd, double *latitude)
         response[nbytes_read - 1] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         int latitude_arcsecs = 0;
 
@@ -1765,7 +1765,7 @@ bool set_ieqpro_local_date(int fd, int yy, int mm, int dd)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1787,7 +1787,7 @@ bool set_ieqpro_local_date(int fd, int yy, int mm, int dd)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1815,7 +1815,7 @@ bool set_ieqpro_local_time(int fd, int hh, int mm, int ss)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1837,7 +1837,7 @@ bool set_ieqpro_local_time(int fd, int hh, int mm, int ss)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1868,7 +1868,7 @@ bool set_ieqpro_daylight_saving(int fd, bool enabled)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1890,7 +1890,7 @@ bool set_ieqpro_daylight_saving(int fd, bool enabled)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1926,7 +1926,7 @@ bool set_ieqpro_utc_offset(int fd, double offset)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1948,7 +1948,7 @@ bool set_ieqpro_utc_offset(int fd, double offset)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1989,7 +1989,7 @@ bool get_ieqpro_coords(int fd, double *ra, double *dec)
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2008,7 +2008,7 @@ bool get_ieqpro_coords(int fd, double *ra, double *dec)
 
     if (nbytes_read > 0)
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_EXTRA_1, "RES <%s>", response);
 
@@ -2052,7 +2052,7 @@ bool get_ieqpro_utc_date_time(int fd, double *utc_hours, int *yy, int *mm, int *
     }
     else
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -2071,7 +2071,7 @@ bool get_ieqpro_utc_date_time(int fd, double *utc_hours, int *yy, int *mm, int *
 
     if (nbytes_read > 0)
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(ieqpro_device, INDI::Logger::DBG_DEBUG, "RES <%s>", response);
 
@@ -511,7 +511,7 @@ int ioptronHC8406::ioptronHC8406SyncCMR(char *matchedObject)
     /* Sleep 10ms before flushing. This solves some issues with LX200 compatible devices. */
     nanosleep(&timeout, nullptr);
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return 0;
 }
@@ -538,7 +538,7 @@ int ioptronHC8406::slewioptronHC8406()
     }
 
     /* We don't need to read the string message, just return corresponding error code */
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     DEBUGF(DBG_SCOPE, "RES <%c>", slewNum[0]);
 
@@ -595,7 +595,7 @@ int ioptronHC8406::setCalenderDate(int fd, int dd, int mm, int yy)
 
     DEBUGF(DBG_SCOPE, "CMD <%s>", read_buffer);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     /* Sleep 100ms before flushing. This solves some issues with LX200 compatible devices. */
     //usleep(10);
     if ((error_type = tty_write_string(fd, read_buffer, &nbytes_write)) != TTY_OK)
@@ -603,7 +603,7 @@ int ioptronHC8406::setCalenderDate(int fd, int dd, int mm, int yy)
 
     error_type = tty_read(fd, response, sizeof(response), ioptronHC8406_TIMEOUT, &nbytes_read);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
     {
@@ -621,7 +621,7 @@ int ioptronHC8406::setCalenderDate(int fd, int dd, int mm, int yy)
     }
 
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     LOGF_DEBUG("Set date failed! Response: <%s>", response);
 
@@ -736,7 +736,7 @@ int ioptronHC8406::setioptronHC8406StandardProcedure(int fd, const char *data)
     // JM: Hack from Jon in the INDI forums to fix longitude/latitude settings failure
 
     nanosleep(&timeout, nullptr);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     nanosleep(&timeout, nullptr);
 
 
@@ -821,7 +821,7 @@ bool ioptronHC8406::Park()
 
     if ((error_type = tty_write_string(PortFD, ":KA#", &nbytes_write)) != TTY_OK)
         return error_type;
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
     DEBUG(DBG_SCOPE, "CMD <:KA#>");
 
     TrackState = SCOPE_PARKING;
@@ -1062,7 +1062,7 @@ int ioptronHC8406::setMoveRate(int rate, int move_type)
     LOGF_DEBUG("CMD (%s)", cmd);
 
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
@@ -1084,7 +1084,7 @@ void ioptronHC8406::syncSideOfPier()
 
     LOGF_DEBUG("CMD: <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
@@ -1105,7 +1105,7 @@ void ioptronHC8406::syncSideOfPier()
 
     response[nbytes_read - 1] = '\0';
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("RES: <%s>", response);
 
@@ -1136,7 +1136,7 @@ int ioptronHC8406::getCommandString(int fd, char *data, const char *cmd)
         return error_type;
 
     error_type = tty_read_section(fd, data, '#', ioptronHC8406_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (error_type != TTY_OK)
         return error_type;
@@ -1180,7 +1180,7 @@ bool ioptronHC8406::sendScopeTime()
     }
 
     //getCommandSexa(PortFD, &lx200_utc_offset, ":GG#");
-    //tcflush(PortFD, TCIOFLUSH);
+    //tty_flush(PortFD, TCIOFLUSH);
     getCommandString(PortFD, utc_offset_res, ":GG#");
 
     f_scansexa(utc_offset_res, &lx200_utc_offset);
@@ -1282,7 +1282,7 @@ int ioptronHC8406::SendPulseCmd(int8_t direction, uint32_t duration_msec)
         LOGF_ERROR("Error writing to device %s (%d)", errmsg, rc);
         return 1;
     }
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     if (duration_left != 0)
     {
@@ -128,7 +128,7 @@ bool Driver::sendCommand(const char *command,
     // Try to dispatch command and read twice in case of timeouts.
     for (int i = 0; i < 2; i++)
     {
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
 
         if ((errCode = tty_write(PortFD, command, strlen(command), &nbytes_written)) != TTY_OK)
         {
@@ -162,7 +162,7 @@ bool Driver::sendCommand(const char *command,
 
     DEBUGFDEVICE(m_DeviceName, debugLog, "RES <%s>", res);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Copy response to buffer
     if (response)
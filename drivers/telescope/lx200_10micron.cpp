@@ -430,7 +430,7 @@ bool LX200_10MICRON::ReadScopeStatus()
         return false;
     }
     error_type = tty_read_section(fd, data, '#', LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     if (error_type != TTY_OK)
     {
         return false;
@@ -1387,13 +1387,13 @@ int LX200_10MICRON::setStandardProcedureWithoutRead(int fd, const char *data)
     int nbytes_write = 0;
 
     DEBUGFDEVICE(getDefaultName(), DBG_SCOPE, "CMD <%s>", data);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     if ((error_type = tty_write_string(fd, data, &nbytes_write)) != TTY_OK)
     {
         LOGF_ERROR("CMD <%s> write ERROR %d", data, error_type);
         return error_type;
     }
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -1404,14 +1404,14 @@ int LX200_10MICRON::setStandardProcedureAndExpectChar(int fd, const char *data,
     int nbytes_write = 0, nbytes_read = 0;
 
     DEBUGFDEVICE(getDefaultName(), DBG_SCOPE, "CMD <%s>", data);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     if ((error_type = tty_write_string(fd, data, &nbytes_write)) != TTY_OK)
     {
         LOGF_ERROR("CMD <%s> write ERROR %d", data, error_type);
         return error_type;
     }
     error_type = tty_read(fd, bool_return, 1, LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
     {
@@ -1436,14 +1436,14 @@ int LX200_10MICRON::setStandardProcedureAndReturnResponse(int fd, const char *da
     int nbytes_write = 0, nbytes_read = 0;
 
     DEBUGFDEVICE(getDefaultName(), DBG_SCOPE, "CMD <%s>", data);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     if ((error_type = tty_write_string(fd, data, &nbytes_write)) != TTY_OK)
     {
         LOGF_ERROR("CMD <%s> write ERROR %d", data, error_type);
         return error_type;
     }
     error_type = tty_read(fd, response, max_response_length, LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
     {
@@ -2120,7 +2120,7 @@ bool LX200_OnStep::ReadScopeStatus()
         return true;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     flushIO(PortFD);
 
 
@@ -3407,7 +3407,7 @@ bool LX200_OnStep::sendOnStepCommandBlind(const char *cmd)
     flushIO(PortFD);
     /* Add mutex */
     std::unique_lock<std::mutex> guard(lx200CommsLock);
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
 
     if ((error_type = tty_write_string(PortFD, cmd, &nbytes_write)) != TTY_OK)
@@ -3431,14 +3431,14 @@ bool LX200_OnStep::sendOnStepCommand(const char *cmd)
     flushIO(PortFD);
     /* Add mutex */
     std::unique_lock<std::mutex> guard(lx200CommsLock);
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     if ((error_type = tty_write_string(PortFD, cmd, &nbytes_write)) != TTY_OK)
         return error_type;
 
     error_type = tty_read_expanded(PortFD, response, 1, OSTimeoutSeconds, OSTimeoutMicroSeconds, &nbytes_read);
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
     DEBUGF(DBG_SCOPE, "RES <%c>", response[0]);
 
     if (nbytes_read < 1)
@@ -3466,7 +3466,7 @@ int LX200_OnStep::getCommandSingleCharResponse(int fd, char *data, const char *c
         return error_type;
 
     error_type = tty_read_expanded(fd, data, 1, OSTimeoutSeconds, OSTimeoutMicroSeconds, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (error_type != TTY_OK)
         return error_type;
@@ -3492,11 +3492,11 @@ int LX200_OnStep::getCommandSingleCharResponse(int fd, char *data, const char *c
 
 int LX200_OnStep::flushIO(int fd)
 {
-    tcflush(fd, TCIOFLUSH);
+    tty_flush(fd, TCIOFLUSH);
     int error_type = 0;
     int nbytes_read;
     std::unique_lock<std::mutex> guard(lx200CommsLock);
-    tcflush(fd, TCIOFLUSH);
+    tty_flush(fd, TCIOFLUSH);
     do
     {
         char discard_data[RB_MAX_LEN] = {0};
@@ -3522,13 +3522,13 @@ int LX200_OnStep::getCommandDoubleResponse(int fd, double *value, char *data, co
     flushIO(fd);
     /* Add mutex */
     std::unique_lock<std::mutex> guard(lx200CommsLock);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((error_type = tty_write_string(fd, cmd, &nbytes_write)) != TTY_OK)
         return error_type;
 
     error_type = tty_nread_section_expanded(fd, data, RB_MAX_LEN, '#', OSTimeoutSeconds, OSTimeoutMicroSeconds, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     term = strchr(data, '#');
     if (term)
@@ -3549,7 +3549,7 @@ int LX200_OnStep::getCommandDoubleResponse(int fd, double *value, char *data, co
     {
         LOGF_DEBUG("Error %d", error_type);
         LOG_DEBUG("Flushing connection");
-        tcflush(fd, TCIOFLUSH);
+        tty_flush(fd, TCIOFLUSH);
         return error_type;
     }
 
@@ -3557,7 +3557,7 @@ int LX200_OnStep::getCommandDoubleResponse(int fd, double *value, char *data, co
     {
         LOG_WARN("Invalid response, check connection");
         LOG_DEBUG("Flushing connection");
-        tcflush(fd, TCIOFLUSH);
+        tty_flush(fd, TCIOFLUSH);
         return RES_ERR_FORMAT; //-1001, so as not to conflict with TTY_RESPONSE;
     }
 
@@ -3577,13 +3577,13 @@ int LX200_OnStep::getCommandIntResponse(int fd, int *value, char *data, const ch
     flushIO(fd);
     /* Add mutex */
     std::unique_lock<std::mutex> guard(lx200CommsLock);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((error_type = tty_write_string(fd, cmd, &nbytes_write)) != TTY_OK)
         return error_type;
 
     error_type = tty_nread_section_expanded(fd, data, RB_MAX_LEN, '#', OSTimeoutSeconds, OSTimeoutMicroSeconds, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     term = strchr(data, '#');
     if (term)
@@ -3602,14 +3602,14 @@ int LX200_OnStep::getCommandIntResponse(int fd, int *value, char *data, const ch
     {
         LOGF_DEBUG("Error %d", error_type);
         LOG_DEBUG("Flushing connection");
-        tcflush(fd, TCIOFLUSH);
+        tty_flush(fd, TCIOFLUSH);
         return error_type;
     }
     if (sscanf(data, "%i", value) != 1)
     {
         LOG_WARN("Invalid response, check connection");
         LOG_DEBUG("Flushing connection");
-        tcflush(fd, TCIOFLUSH);
+        tty_flush(fd, TCIOFLUSH);
         return RES_ERR_FORMAT; //-1001, so as not to conflict with TTY_RESPONSE;
     }
     return nbytes_read;
@@ -3626,13 +3626,13 @@ int LX200_OnStep::getCommandSingleCharErrorOrLongResponse(int fd, char *data, co
     flushIO(fd);
     /* Add mutex */
     std::unique_lock<std::mutex> guard(lx200CommsLock);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((error_type = tty_write_string(fd, cmd, &nbytes_write)) != TTY_OK)
         return error_type;
 
     error_type = tty_nread_section_expanded(fd, data, RB_MAX_LEN, '#', OSTimeoutSeconds, OSTimeoutMicroSeconds, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     term = strchr(data, '#');
     if (term)
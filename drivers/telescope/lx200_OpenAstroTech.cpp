@@ -198,7 +198,7 @@ int LX200_OpenAstroTech::OATUpdateProperties()
         return 0;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     flushIO(PortFD);
 
     char value[RB_MAX_LEN] = {0};
@@ -456,7 +456,7 @@ bool LX200_OpenAstroTech::executeMeadeCommandBlind(const char *cmd)
     flushIO(PortFD);
     /* Add mutex */
     std::unique_lock<std::mutex> guard(lx200CommsLock);
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     if ((error_type = tty_write_string(PortFD, cmd, &nbytes_write)) != TTY_OK)
     {
@@ -469,11 +469,11 @@ bool LX200_OpenAstroTech::executeMeadeCommandBlind(const char *cmd)
 
 int LX200_OpenAstroTech::flushIO(int fd)
 {
-    tcflush(fd, TCIOFLUSH);
+    tty_flush(fd, TCIOFLUSH);
     int error_type = 0;
     int nbytes_read;
     std::unique_lock<std::mutex> guard(lx200CommsLock);
-    tcflush(fd, TCIOFLUSH);
+    tty_flush(fd, TCIOFLUSH);
     do
     {
         char discard_data[RB_MAX_LEN] = {0};
@@ -607,7 +607,7 @@ int LX200_OpenAstroTech::OATUpdateFocuser()
         return 0;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
     flushIO(PortFD);
     // get position
     char value[RB_MAX_LEN] = {0};
@@ -953,7 +953,7 @@ bool LX200NYX101::sendCommand(const char * cmd, char * res, int cmd_len, int res
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -1006,7 +1006,7 @@ bool LX200NYX101::sendCommand(const char * cmd, char * res, int cmd_len, int res
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -954,7 +954,7 @@ bool LX200AM5::sendCommand(const char * cmd, char * res, int cmd_len, int res_le
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -1007,7 +1007,7 @@ bool LX200AM5::sendCommand(const char * cmd, char * res, int cmd_len, int res_le
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -857,7 +857,7 @@ void LX200AstroPhysicsGTOCP2::syncSideOfPier()
 
     LOGF_DEBUG("CMD: <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
@@ -878,7 +878,7 @@ void LX200AstroPhysicsGTOCP2::syncSideOfPier()
 
     response[nbytes_read - 1] = '\0';
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("RES: <%s>", response);
 
@@ -2063,7 +2063,7 @@ void LX200AstroPhysicsV2::syncSideOfPier()
 
     LOGF_DEBUG("CMD: <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
@@ -2084,7 +2084,7 @@ void LX200AstroPhysicsV2::syncSideOfPier()
 
     response[nbytes_read - 1] = '\0';
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("RES: <%s>", response);
 
@@ -79,7 +79,7 @@ int check_lx200ap_connection(int fd)
             return error_type;
         }
         tty_read_section(fd, temp_string, '#', LX200_TIMEOUT, &nbytes_read);
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         if (nbytes_read > 1)
         {
             temp_string[nbytes_read - 1] = '\0';
@@ -121,7 +121,7 @@ int getAPUTCOffset(int fd, double *value)
         return error_type;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     DEBUGFDEVICE(lx200ap_name, AP_DBG_SCOPE, "RES <%s>", temp_string);
 
@@ -304,7 +304,7 @@ int APSyncCM(int fd, char *matchedObject)
     /* Sleep 10ms before flushing. This solves some issues with LX200 compatible devices. */
     nanosleep(&timeout, nullptr);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     return 0;
 }
@@ -332,7 +332,7 @@ int APSyncCMR(int fd, char *matchedObject)
     /* Sleep 10ms before flushing. This solves some issues with LX200 compatible devices. */
     nanosleep(&timeout, nullptr);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     return 0;
 }
@@ -392,7 +392,7 @@ int getAPWormPosition(int fd, int *position)
         return res;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     if (nbytes_read > 1)
     {
         response[nbytes_read - 1] = '\0';
@@ -578,7 +578,7 @@ int setAPRATrackRate(int fd, double rate)
 
     DEBUGFDEVICE(lx200ap_name, INDI::Logger::DBG_DEBUG, "CMD (%s)", cmd);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
@@ -599,7 +599,7 @@ int setAPRATrackRate(int fd, double rate)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(lx200ap_name, INDI::Logger::DBG_DEBUG, "RES (%s)", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return 0;
     }
 
@@ -627,7 +627,7 @@ int setAPDETrackRate(int fd, double rate)
     DEBUGFDEVICE(lx200ap_name, INDI::Logger::DBG_DEBUG, "CMD (%s)", cmd);
 
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((errcode = tty_write(fd, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
@@ -648,7 +648,7 @@ int setAPDETrackRate(int fd, double rate)
         response[nbytes_read] = '\0';
         DEBUGFDEVICE(lx200ap_name, INDI::Logger::DBG_DEBUG, "RES (%s)", response);
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return 0;
     }
 
@@ -686,7 +686,7 @@ int APSendPulseCmd(int fd, int direction, int duration_msec)
     }
 
     int res = sendAPCommand(fd, cmd, "APSendPulseCmd: Sending pulse command.");
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return res;
 }
 
@@ -822,7 +822,7 @@ int getApStatusStringInternal(int fd, char *statusString, bool complain)
     }
 
     tty_read_section(fd, statusString, '#', LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     if (nbytes_read > 3)
     {
         statusString[nbytes_read - 1] = '\0';
@@ -996,7 +996,7 @@ int getApMountFeatures(int fd, bool *hasEncoder, bool *clutchAware)
     }
 
     tty_read_section(fd, readBuffer, '#', LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     if (nbytes_read > 1)
     {
         readBuffer[nbytes_read - 1] = '\0';
@@ -1076,6 +1076,6 @@ int isAPInitialized(int fd, bool *isInitialized)
     else
         *isInitialized = true; // Should I test further????
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
@@ -149,7 +149,7 @@ int getCommandSexa(int fd, double *value, const char *cmd)
     /* Add mutex */
     std::unique_lock<std::mutex> guard(lx200CommsLock);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     DEBUGFDEVICE(lx200Name, DBG_SCOPE, "CMD <%s>", cmd);
 
@@ -157,7 +157,7 @@ int getCommandSexa(int fd, double *value, const char *cmd)
         return error_type;
 
     error_type = tty_nread_section(fd, read_buffer, RB_MAX_LEN,  '#', LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     if (error_type != TTY_OK)
         return error_type;
 
@@ -173,7 +173,7 @@ int getCommandSexa(int fd, double *value, const char *cmd)
 
     DEBUGFDEVICE(lx200Name, DBG_SCOPE, "VAL [%g]", *value);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -187,7 +187,7 @@ int getCommandInt(int fd, int *value, const char *cmd)
     /* Add mutex */
     std::unique_lock<std::mutex> guard(lx200CommsLock);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     DEBUGFDEVICE(lx200Name, DBG_SCOPE, "CMD <%s>", cmd);
 
@@ -195,7 +195,7 @@ int getCommandInt(int fd, int *value, const char *cmd)
         return error_type;
 
     error_type = tty_nread_section(fd, read_buffer, RB_MAX_LEN, '#', LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     if (error_type != TTY_OK)
         return error_type;
 
@@ -235,7 +235,7 @@ int getCommandString(int fd, char *data, const char *cmd)
         return error_type;
 
     error_type = tty_nread_section(fd, data, RB_MAX_LEN, '#', LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (error_type != TTY_OK)
         return error_type;
@@ -285,7 +285,7 @@ int isSlewComplete(int fd)
         return error_type;
 
     error_type = tty_nread_section(fd, data, 33, '#', LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIOFLUSH);
+    tty_flush(fd, TCIOFLUSH);
 
     if (error_type != TTY_OK)
         return error_type;
@@ -389,7 +389,7 @@ int getTimeFormat(int fd, int *format)
     if ((error_type = tty_nread_section(fd, read_buffer, RB_MAX_LEN, '#', LX200_TIMEOUT, &nbytes_read)) != TTY_OK)
         return error_type;
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
         return error_type;
@@ -454,7 +454,7 @@ int getSiteName(int fd, char *siteName, int siteNum)
     }
 
     error_type = tty_nread_section(fd, siteName, RB_MAX_LEN, '#', LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
         return error_type;
@@ -536,14 +536,14 @@ int getSiteLatitudeAlt(int fd, int *dd, int *mm, double *ssf, const char *cmd)
     /* Add mutex */
     std::unique_lock<std::mutex> guard(lx200CommsLock);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((error_type = tty_write_string(fd, cmd, &nbytes_write)) != TTY_OK)
         return error_type;
 
     error_type = tty_nread_section(fd, read_buffer, RB_MAX_LEN, '#', LX200_TIMEOUT, &nbytes_read);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
         return error_type;
@@ -603,7 +603,7 @@ int getSiteLongitudeAlt(int fd, int *ddd, int *mm, double *ssf, const char *cmd)
 
     error_type = tty_nread_section(fd, read_buffer, RB_MAX_LEN, '#', LX200_TIMEOUT, &nbytes_read);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
         return error_type;
@@ -669,7 +669,7 @@ int getTrackFreq(int fd, double *value)
         return error_type;
 
     error_type = tty_nread_section(fd, read_buffer, RB_MAX_LEN, '#', LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
         return error_type;
@@ -715,7 +715,7 @@ int getHomeSearchStatus(int fd, int *status)
         return error_type;
 
     error_type = tty_nread_section(fd, read_buffer, RB_MAX_LEN, '#', LX200_TIMEOUT, &nbytes_read);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
         return error_type;
@@ -795,14 +795,14 @@ int setStandardProcedure(int fd, const char *data)
     /* Add mutex */
     std::unique_lock<std::mutex> guard(lx200CommsLock);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((error_type = tty_write_string(fd, data, &nbytes_write)) != TTY_OK)
         return error_type;
 
     error_type = tty_read(fd, bool_return, 1, LX200_TIMEOUT, &nbytes_read);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
         return error_type;
@@ -831,7 +831,7 @@ int setCommandInt(int fd, int data, const char *cmd)
 
     DEBUGFDEVICE(lx200Name, DBG_SCOPE, "CMD <%s>", read_buffer);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((error_type = tty_write_string(fd, read_buffer, &nbytes_write)) != TTY_OK)
     {
@@ -839,7 +839,7 @@ int setCommandInt(int fd, int data, const char *cmd)
         return error_type;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     DEBUGFDEVICE(lx200Name, DBG_SCOPE, "CMD <%s> successful.", read_buffer);
 
@@ -1088,7 +1088,7 @@ int setAlignmentMode(int fd, unsigned int alignMode)
             break;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -1125,7 +1125,7 @@ int setCalenderDate(int fd, int dd, int mm, int yy, bool addSpace)
 
     DEBUGFDEVICE(lx200Name, DBG_SCOPE, "CMD <%s>", read_buffer);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((error_type = tty_write_string(fd, read_buffer, &nbytes_write)) != TTY_OK)
         return error_type;
@@ -1135,7 +1135,7 @@ int setCalenderDate(int fd, int dd, int mm, int yy, bool addSpace)
     // Can't just use the tcflush to clear the stream because it doesn't seem to work correctly on sockets
     tty_nread_section(fd, dummy_buffer, RB_MAX_LEN, '#', LX200_TIMEOUT, &nbytes_read);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
     {
@@ -1152,7 +1152,7 @@ int setCalenderDate(int fd, int dd, int mm, int yy, bool addSpace)
 
     /* Sleep 10ms before flushing. This solves some issues with LX200 compatible devices. */
     nanosleep(&timeout, nullptr);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     return 0;
 }
@@ -1398,7 +1398,7 @@ int setSlewMode(int fd, int slewMode)
             break;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -1428,7 +1428,7 @@ int setFocuserMotion(int fd, int motionType)
             break;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -1464,7 +1464,7 @@ int setFocuserSpeedMode(int fd, int speedMode)
             break;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -1486,7 +1486,7 @@ int setGPSFocuserSpeed(int fd, int speed)
         if ((error_type = tty_write_string(fd, ":FQ#", &nbytes_write)) != TTY_OK)
             return error_type;
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return 0;
     }
 
@@ -1501,7 +1501,7 @@ int setGPSFocuserSpeed(int fd, int speed)
     if ((error_type = tty_write_string(fd, speed_str, &nbytes_write)) != TTY_OK)
         return error_type;
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -1596,7 +1596,7 @@ int Slew(int fd)
     }
 
     /* We don't need to read the string message, just return corresponding error code */
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     DEBUGFDEVICE(lx200Name, DBG_SCOPE, "RES <%c>", slewNum[0]);
 
@@ -1646,7 +1646,7 @@ int MoveTo(int fd, int direction)
             break;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -1690,7 +1690,7 @@ int SendPulseCmd(int fd, int direction, int duration_msec, bool wait_after_comma
 
     tty_write_string(fd, cmd, &nbytes_write);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if(wait_after_command){
         if (duration_msec > max_wait_ms)
@@ -1747,7 +1747,7 @@ int HaltMovement(int fd, int direction)
             return -1;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -1766,7 +1766,7 @@ int abortSlew(int fd)
     if ((error_type = tty_write_string(fd, ":Q#", &nbytes_write)) != TTY_OK)
         return error_type;
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -1813,7 +1813,7 @@ int Sync(int fd, char *matchedObject)
 
     /* Sleep 10ms before flushing. This solves some issues with LX200 compatible devices. */
     nanosleep(&timeout, nullptr);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     return 0;
 }
@@ -1866,7 +1866,7 @@ int selectSite(int fd, int siteNum)
             return -1;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -1916,7 +1916,7 @@ int selectCatalogObject(int fd, int catalog, int NNNN)
     if ((error_type = tty_write_string(fd, read_buffer, &nbytes_write)) != TTY_OK)
         return error_type;
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
@@ -1988,7 +1988,7 @@ int checkLX200EquatorialFormat(int fd)
     /* Add mutex */
     std::unique_lock<std::mutex> guard(lx200CommsLock);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     // Meade Telescope Serial Command Protocol Revision 2010.10
     // :GR#
@@ -2077,7 +2077,7 @@ int checkLX200EquatorialFormat(int fd)
 
     DEBUGFDEVICE(lx200Name, DBG_SCOPE, "CMD <%s>", ":GR#");
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((error_type = tty_write_string(fd, ":GR#", &nbytes_write)) != TTY_OK)
         return error_type;
@@ -2105,7 +2105,7 @@ int checkLX200EquatorialFormat(int fd)
         DEBUGDEVICE(lx200Name, DBG_SCOPE, "Equatorial coordinate format is high precision.");
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     return 0;
 }
@@ -2150,7 +2150,7 @@ int selectTrackingMode(int fd, int trackMode)
             return -1;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     return 0;
 }
 
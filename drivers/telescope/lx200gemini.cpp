@@ -253,7 +253,7 @@ bool LX200Gemini::getRefractionJNOW(int &data)
     int rc = 0, nbytes_read = 0, nbytes_written = 0;
 
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     const char *cmd = ":p?#";
     data = 0;
@@ -273,7 +273,7 @@ bool LX200Gemini::getRefractionJNOW(int &data)
         LOGF_ERROR("Error reading from device %s (%d)", errmsg, rc);
         return false;
     }
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
     response[1] = '\0';
 
     data = atoi(response);
@@ -318,7 +318,7 @@ bool LX200Gemini::setRefraction(int data)
 
     int rc = 0, nbytes_written = 0;
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     char cmd[5] = { 0 };
     snprintf(cmd, 5, ":p%i#", data);
@@ -330,7 +330,7 @@ bool LX200Gemini::setRefraction(int data)
         LOGF_ERROR("Error writing to device %s (%d)", errmsg, rc);
         return false;
     }
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return true;
 }
@@ -1678,7 +1678,7 @@ bool LX200Gemini::checkConnection()
 
     LOGF_DEBUG("CMD: <%#02X>", 0x06);
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     char ack[1] = { 0x06 };
 
@@ -1701,7 +1701,7 @@ bool LX200Gemini::checkConnection()
 
     //response[1] = '\0';
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     LOGF_DEBUG("RES: <%s>", response);
 
@@ -1726,7 +1726,7 @@ bool LX200Gemini::checkConnection()
             return false;
         }
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         // Send ack again and check response
         return checkConnection();
@@ -1840,7 +1840,7 @@ void LX200Gemini::syncSideOfPier()
 
     LOGF_DEBUG("CMD: <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 5, &nbytes_written)) != TTY_OK)
     {
@@ -1860,7 +1860,7 @@ void LX200Gemini::syncSideOfPier()
 
     response[nbytes_read - 1] = '\0';
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     //LOGF_DEBUG("RES: <%s>", response);
 
@@ -1910,7 +1910,7 @@ bool LX200Gemini::Park()
 
     LOGF_DEBUG("CMD: <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 5, &nbytes_written)) != TTY_OK)
     {
@@ -1920,7 +1920,7 @@ bool LX200Gemini::Park()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     ParkSP.setState(IPS_BUSY);
     TrackState = SCOPE_PARKING;
@@ -1950,7 +1950,7 @@ bool LX200Gemini::sleepMount()
 
     LOGF_DEBUG("CMD: <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 5, &nbytes_written)) != TTY_OK)
     {
@@ -1960,7 +1960,7 @@ bool LX200Gemini::sleepMount()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOG_INFO("Mount is sleeping...");
     return true;
@@ -1975,7 +1975,7 @@ bool LX200Gemini::wakeupMount()
 
     LOGF_DEBUG("CMD: <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 5, &nbytes_written)) != TTY_OK)
     {
@@ -1985,7 +1985,7 @@ bool LX200Gemini::wakeupMount()
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOG_INFO("Mount is awake...");
     return true;
@@ -2048,7 +2048,7 @@ LX200Gemini::MovementState LX200Gemini::getMovementState()
 
     LOGF_DEBUG("CMD: <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 5, &nbytes_written)) != TTY_OK)
     {
@@ -2068,7 +2068,7 @@ LX200Gemini::MovementState LX200Gemini::getMovementState()
 
     response[1] = '\0';
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("RES: <%s>", response);
 
@@ -2105,7 +2105,7 @@ LX200Gemini::ParkingState LX200Gemini::getParkingState()
 
     LOGF_DEBUG("CMD: <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, 5, &nbytes_written)) != TTY_OK)
     {
@@ -2125,7 +2125,7 @@ LX200Gemini::ParkingState LX200Gemini::getParkingState()
 
     response[1] = '\0';
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("RES: <%s>", response);
 
@@ -2225,7 +2225,7 @@ bool LX200Gemini::getGeminiProperty(uint32_t propertyNumber, char* value)
 
     value[nbytes - 1] = '\0';
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     LOGF_DEBUG("RES: <%s>", value);
     return true;
@@ -2279,7 +2279,7 @@ int  LX200Gemini::Flip(int fd)
     }
 
     /* We don't need to read the string message, just return corresponding error code */
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     DEBUGFDEVICE(getDeviceName(), DBG_SCOPE, "RES <%c>", FlipNum[0]);
 
@@ -2435,7 +2435,7 @@ bool LX200Gemini::setGeminiProperty(uint32_t propertyNumber, char* value)
         return false;
     }
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return true;
 }
@@ -251,7 +251,7 @@ bool LX200GotoNova::isSlewComplete()
         response[nbytes_read] = '\0';
         LOGF_DEBUG("RES (%s)", response);
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (response[0] == '0')
             return true;
@@ -425,7 +425,7 @@ int LX200GotoNova::GotonovaSyncCMR(char *matchedObject)
     /* Sleep 10ms before flushing. This solves some issues with LX200 compatible devices. */
     nanosleep(&timeout, nullptr);
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     return 0;
 }
@@ -452,7 +452,7 @@ int LX200GotoNova::slewGotoNova()
     }
 
     /* We don't need to read the string message, just return corresponding error code */
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     DEBUGF(DBG_SCOPE, "RES <%c>", slewNum[0]);
 
@@ -532,14 +532,14 @@ int LX200GotoNova::setCalenderDate(int fd, int dd, int mm, int yy)
 
     DEBUGF(DBG_SCOPE, "CMD <%s>", read_buffer);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if ((error_type = tty_write_string(fd, read_buffer, &nbytes_write)) != TTY_OK)
         return error_type;
 
     error_type = tty_read(fd, response, sizeof(response), GOTONOVA_TIMEOUT, &nbytes_read);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     if (nbytes_read < 1)
     {
@@ -558,7 +558,7 @@ int LX200GotoNova::setCalenderDate(int fd, int dd, int mm, int yy)
 
     /* Sleep 10ms before flushing. This solves some issues with LX200 compatible devices. */
     nanosleep(&timeout, nullptr);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     LOGF_DEBUG("Set date failed! Response: <%s>", response);
 
@@ -670,7 +670,7 @@ int LX200GotoNova::setGotoNovaStandardProcedure(int fd, const char *data)
 
     // JM: Hack from Jon in the INDI forums to fix longitude/latitude settings failure on GotoNova
     nanosleep(&timeout, nullptr);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     nanosleep(&timeout, nullptr);
 
     if (nbytes_read < 1)
@@ -713,7 +713,7 @@ bool LX200GotoNova::Park()
     if ((error_type = tty_write_string(PortFD, ":PK#", &nbytes_write)) != TTY_OK)
         return error_type;
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     EqNP.setState( IPS_BUSY);
     TrackState = SCOPE_PARKING;
@@ -859,7 +859,7 @@ int LX200GotoNova::getGotoNovaGuideRate(int *rate)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -906,7 +906,7 @@ int LX200GotoNova::setGotoNovaGuideRate(int rate)
         return 0;
     }
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
@@ -936,7 +936,7 @@ void LX200GotoNova::syncSideOfPier()
 
     LOGF_DEBUG("CMD: <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
     {
@@ -957,7 +957,7 @@ void LX200GotoNova::syncSideOfPier()
 
     response[nbytes_read - 1] = '\0';
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("RES: <%s>", response);
 
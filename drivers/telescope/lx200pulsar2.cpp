@@ -123,7 +123,7 @@ void _resynchronize_(const int fd)
 
     char lead_ACK = LX200Pulsar2::Null;
     char follow_ACK = LX200Pulsar2::Null;
-    tcflush(fd, TCIOFLUSH);
+    tty_flush(fd, TCIOFLUSH);
     while (resynchronize_needed && ack_try_cntr++ < ack_maxtries)
     {
         if (_isValidACKResponse_(lead_ACK) || (_sendReceiveACK_(fd, &lead_ACK) && _isValidACKResponse_(lead_ACK)))
@@ -144,14 +144,14 @@ void _resynchronize_(const int fd)
             {
                 lead_ACK = LX200Pulsar2::Null;
                 follow_ACK = LX200Pulsar2::Null;
-                tcflush(fd, TCIFLUSH);
+                tty_flush(fd, TCIFLUSH);
             }
         }
         else
         {
             lead_ACK = LX200Pulsar2::Null;
             follow_ACK = LX200Pulsar2::Null;
-            tcflush(fd, TCIFLUSH);
+            tty_flush(fd, TCIFLUSH);
         }
     }
 
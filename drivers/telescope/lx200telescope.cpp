@@ -27,6 +27,7 @@
 
 #include "indicom.h"
 #include "lx200driver.h"
+#include "connectionplugins/connectionserial.h"
 
 #include <libnova/sidereal_time.h>
 
@@ -66,6 +67,10 @@ bool LX200Telescope::initProperties()
     /* Make sure to init parent properties first */
     INDI::Telescope::initProperties();
 
+    // LX200 mounts are only read through the tty functions, their replies can be read in bulk
+    if (serialConnection)
+        serialConnection->setBuffered(true);
+
     IUFillSwitch(&AlignmentS[0], "Polar", "", ISS_ON);
     IUFillSwitch(&AlignmentS[1], "AltAz", "", ISS_OFF);
     IUFillSwitch(&AlignmentS[2], "Land", "", ISS_OFF);
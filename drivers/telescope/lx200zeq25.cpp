@@ -194,7 +194,7 @@ bool LX200ZEQ25::isZEQ25Home()
 
     // JM: Hack from Jon in the INDI forums to fix longitude/latitude settings failure on ZEQ25
     nanosleep(&timeout, nullptr);
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
     nanosleep(&timeout, nullptr);
 
     if (nbytes_read < 1)
@@ -223,7 +223,7 @@ bool LX200ZEQ25::isSlewComplete()
 
     LOGF_DEBUG("CMD <%s>", cmd);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((errcode = tty_write(PortFD, cmd, 4, &nbytes_written)) != TTY_OK)
     {
@@ -244,7 +244,7 @@ bool LX200ZEQ25::isSlewComplete()
         response[nbytes_read] = '\0';
         LOGF_DEBUG("RES (%s)", response);
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if (response[0] == '0')
             return true;
@@ -299,7 +299,7 @@ bool LX200ZEQ25::getMountInfo()
             else
                 LOG_INFO("Unknown mount detected.");
 
-            tcflush(PortFD, TCIFLUSH);
+            tty_flush(PortFD, TCIFLUSH);
 
             return true;
         }
@@ -484,7 +484,7 @@ bool LX200ZEQ25::slewZEQ25()
     }
 
     /* We don't need to read the string message, just return corresponding error code */
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     DEBUGF(DBG_SCOPE, "RES <%c>", slewNum[0]);
 
@@ -526,7 +526,7 @@ bool LX200ZEQ25::SetSlewRate(int index)
         response[nbytes_read] = '\0';
         LOGF_DEBUG("RES (%s)", response);
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         return (response[0] == '1');
     }
@@ -570,7 +570,7 @@ int LX200ZEQ25::getZEQ25MoveRate()
         response[nbytes_read - 1] = '\0';
         LOGF_DEBUG("RES (%s)", response);
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         int moveRate = -1;
 
@@ -757,7 +757,7 @@ int LX200ZEQ25::setZEQ25StandardProcedure(int fd, const char *data)
 
     // JM: Hack from Jon in the INDI forums to fix longitude/latitude settings failure on ZEQ25
     nanosleep(&timeout, nullptr);
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
     nanosleep(&timeout, nullptr);
 
     if (nbytes_read < 1)
@@ -866,7 +866,7 @@ int LX200ZEQ25::moveZEQ25To(int direction)
             break;
     }
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
     return 0;
 }
 
@@ -879,7 +879,7 @@ int LX200ZEQ25::haltZEQ25Movement()
     if ((error_type = tty_write_string(PortFD, ":q#", &nbytes_write)) != TTY_OK)
         return error_type;
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
     return 0;
 }
 
@@ -912,7 +912,7 @@ int LX200ZEQ25::setZEQ25Park()
     if ((error_type = tty_write_string(PortFD, ":MP1#", &nbytes_write)) != TTY_OK)
         return error_type;
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
     return 0;
 }
 
@@ -926,7 +926,7 @@ int LX200ZEQ25::setZEQ25UnPark()
     if ((error_type = tty_write_string(PortFD, ":MP0#", &nbytes_write)) != TTY_OK)
         return error_type;
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
     return 0;
 }
 
@@ -965,7 +965,7 @@ bool LX200ZEQ25::isZEQ25Parked()
         response[nbytes_read] = '\0';
         LOGF_DEBUG("RES (%s)", response);
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         return (response[0] == '1');
     }
@@ -1287,7 +1287,7 @@ int LX200ZEQ25::getZEQ25GuideRate(double *rate)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1314,7 +1314,7 @@ int LX200ZEQ25::getZEQ25GuideRate(double *rate)
         if (sscanf(response, "%d#", &rate_num) > 0)
         {
             *rate = rate_num / 100.0;
-            tcflush(PortFD, TCIFLUSH);
+            tty_flush(PortFD, TCIFLUSH);
             return TTY_OK;
         }
         else
@@ -1349,7 +1349,7 @@ int LX200ZEQ25::setZEQ25GuideRate(double rate)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write(PortFD, cmd, strlen(cmd), &nbytes_written)) != TTY_OK)
         {
@@ -1371,7 +1371,7 @@ int LX200ZEQ25::setZEQ25GuideRate(double rate)
         response[nbytes_read] = '\0';
         LOGF_DEBUG("RES (%s)", response);
 
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
         return TTY_OK;
     }
 
@@ -1405,7 +1405,7 @@ int LX200ZEQ25::SendPulseCmd(int8_t direction, uint32_t duration_msec)
 
     tty_write_string(PortFD, cmd, &nbytes_write);
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
     return TTY_OK;
 }
 
@@ -1424,7 +1424,7 @@ bool LX200ZEQ25::getZEQ25PierSide(TelescopePierSide &side)
     }
     else
     {
-        tcflush(PortFD, TCIFLUSH);
+        tty_flush(PortFD, TCIFLUSH);
 
         if ((errcode = tty_write_string(PortFD, ":pS#", &nbytes_written)) != TTY_OK)
         {
@@ -933,7 +933,7 @@ bool Paramount::sendTheSkyOKCommand(const char *command, const char *errorMessag
 
     LOGF_DEBUG("CMD: %s", pCMD);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if ((rc = tty_write_string(PortFD, pCMD, &nbytes_written)) != TTY_OK)
     {
@@ -949,7 +949,7 @@ bool Paramount::sendTheSkyOKCommand(const char *command, const char *errorMessag
 
     LOGF_DEBUG("RES: %s", pRES);
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (strcmp("|No error. Error = 0.OK#", pRES) == 0 )
         return true;
@@ -480,7 +480,7 @@ bool get_pmc8_model(int fd, FirmwareInfo *info)
                 return false;
             }
 
-            tcflush(fd, TCIFLUSH);
+            tty_flush(fd, TCIFLUSH);
         }
     }
     // update mount parameters
@@ -531,7 +531,7 @@ bool get_pmc8_main_firmware(int fd, FirmwareInfo *info)
         // Assuming version strings longer than 24 must be version 2.0 and up
         if (nbytes_read > 24) info->IsRev2Compliant = pmc8_isRev2Compliant = true;
 
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
 
         return true;
     }
@@ -925,7 +925,7 @@ bool set_pmc8_axis_motor_rate(int fd, PMC8_AXIS axis, int mrate, bool fast)
 
     if (nbytes_read == 10)
     {
-        tcflush(fd, TCIFLUSH);
+        tty_flush(fd, TCIFLUSH);
         return true;
     }
 
@@ -1086,7 +1086,7 @@ bool set_pmc8_custom_ra_track_rate(int fd, double rate)
         return false;
     }
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     // set direction to 1
     // return set_pmc8_direction_axis(fd, PMC8_AXIS_RA, 1, false);
@@ -1482,7 +1482,7 @@ bool stop_pmc8_guide(int fd, PMC8_DIRECTION gdir)
     }
 
     // flush any responses to commands we ignored above!
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     // "fake pulse" - it was so short we would have overshot its length AND the motors wouldn't have moved anyways
     if (pstate->fakepulse)
@@ -1533,7 +1533,7 @@ bool stop_pmc8_guide(int fd, PMC8_DIRECTION gdir)
                  pstate->ms, (pulse_end_us - pstate->pulse_start_us) / 1000.0);
 
     // flush any responses to commands we ignored above!
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     // mark pulse done
     pstate->pulseguideactive = false;
@@ -2293,7 +2293,7 @@ bool send_pmc8_command(int fd, const char *buf, int nbytes, int *nbytes_written)
 
     DEBUGFDEVICE(pmc8_device, INDI::Logger::DBG_DEBUG, "CMD (%s)", buf);
 
-    tcflush(fd, TCIFLUSH);
+    tty_flush(fd, TCIFLUSH);
 
     int err_code = 1;
     //try to reconnect if we see broken pipe error
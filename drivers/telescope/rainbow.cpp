@@ -1682,7 +1682,7 @@ bool Rainbow::sendCommand(const char * cmd, char * res, int cmd_len, int res_len
 {
     int nbytes_written = 0, nbytes_read = 0, rc = -1;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     if (cmd_len > 0)
     {
@@ -1737,7 +1737,7 @@ bool Rainbow::sendCommand(const char * cmd, char * res, int cmd_len, int res_len
         LOGF_DEBUG("RES <%s>", res);
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     return true;
 }
@@ -52,7 +52,7 @@ bool SkyCommander::ReadScopeStatus()
 
     LOGF_DEBUG("CMD: %#02X", CR[0]);
 
-    tcflush(PortFD, TCIFLUSH);
+    tty_flush(PortFD, TCIFLUSH);
 
     if ((rc = tty_write(PortFD, CR, 1, &nbytes_written)) != TTY_OK)
     {
@@ -895,7 +895,7 @@ bool SkywatcherAPI::TalkWithAxis(AXISID Axis, SkywatcherCommand Command, std::st
 
     for (int retries = 0; retries < SKYWATCHER_MAX_RETRTY; retries++)
     {
-        tcflush(MyPortFD, TCIOFLUSH);
+        tty_flush(MyPortFD, TCIOFLUSH);
         if ( (errorCode = tty_write_string(MyPortFD, command, &bytesWritten)) != TTY_OK)
         {
             if (retries == SKYWATCHER_MAX_RETRTY - 1)
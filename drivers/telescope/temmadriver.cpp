@@ -285,7 +285,7 @@ bool TemmaMount::sendCommand(const char *cmd, char *response)
         return true;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     // Ask mount for current position
     if ( (rc = tty_write(PortFD, cmd_temma, strlen(cmd_temma), &bytesWritten)) != TTY_OK)
@@ -308,7 +308,7 @@ bool TemmaMount::sendCommand(const char *cmd, char *response)
         return false;
     }
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     response[bytesRead - 2] = 0;
 
@@ -383,7 +383,7 @@ int Lx::openserial(const char *devicename)
     //attr.c_cflag |= CRTSCTS | CLOCAL;
     attr.c_cflag |= CLOCAL;
     attr.c_oflag = 0;
-    if (tcflush(fd, TCIOFLUSH) == -1)
+    if (tty_flush(fd, TCIOFLUSH) == -1)
     {
         IDLog("openserial(): tcflush()");
         return -1;
@@ -99,6 +99,8 @@ V4L2_Driver::V4L2_Driver(std::string label, std::string path)
     v4l_capture_started = false;
 
     m_StackMode = STACK_NONE;
+    // Subframes of a long exposure, and darks, are summed where they fall
+    m_Stacker.setAlignment(INDI::LiveStacker::ALIGN_NONE);
 
     lx       = new Lx();
     lxtimer  = -1;
@@ -133,6 +135,8 @@ V4L2_Driver::V4L2_Driver()
     v4l_capture_started = false;
 
     m_StackMode = STACK_NONE;
+    // Subframes of a long exposure, and darks, are summed where they fall
+    m_Stacker.setAlignment(INDI::LiveStacker::ALIGN_NONE);
 
     lx       = new Lx();
     lxtimer  = -1;
@@ -1394,35 +1398,16 @@ void V4L2_Driver::newFrame(void * p)
     static_cast<V4L2_Driver *>(p)->newFrame();
 }
 
-/** @internal Stack normalized luminance pixels coming from the camera in an accumulator frame.
+/** @internal Stack normalized luminance pixels coming from the camera in the live stacker.
  */
 void V4L2_Driver::stackFrame()
 {
-    /* FIXME: use unsigned floats, or double */
-    size_t const size      = v4l_base->getWidth() * v4l_base->getHeight();
-    float const * src       = v4l_base->getLinearY();
-    float const * const end = v4l_base->getLinearY() + size;
-    float * dest            = V4LFrame->stackedFrame;
+    if (subframeCount == 0)
+        m_Stacker.reset();
 
-    if (!V4LFrame->stackedFrame)
-    {
-        /* FIXME: allocate and reset the accumulator frame prior to this function, because memory owner is unclear, and we need more speed while accumulating */
-        V4LFrame->stackedFrame = (float *)malloc(sizeof(float) * size);
-        memcpy(V4LFrame->stackedFrame, src, sizeof(float) * size);
-        subframeCount = 1;
-    }
-    else
-    {
-        /* Clamp to max float value */
-        float const frameMax = std::numeric_limits<float>::max();
-        while (src < end) if (frameMax - *dest < *src)
-            {
-                *dest++ = frameMax;
-                src++;
-            }
-            else *dest++ += *src++;
-        subframeCount += 1;
-    }
+    m_Stacker.addFrame(v4l_base->getLinearY(), INDI::FrameStatistics::FLOAT32, v4l_base->getWidth(),
+                       v4l_base->getHeight());
+    subframeCount = m_Stacker.getFrameCount();
 }
 
 struct timeval V4L2_Driver::getElapsedExposure() const
@@ -1474,6 +1459,23 @@ void V4L2_Driver::newFrame()
             return;
         }
 
+        // 8 bit frames without binning are decoded straight into a stream buffer
+        if (bpp == dbpp && PrimaryCCD.getBinX() == 1)
+        {
+            guard.unlock();
+
+            bool mono  = CaptureFormatSP[IMAGE_MONO].getState() == ISS_ON;
+            totalBytes = width * height * (mono ? 1 : 3);
+            auto frame = Streamer->acquireFrame(totalBytes);
+            // The streamer counts and skips the frame if the pool is full
+            if (frame && mono)
+                v4l_base->copyY(frame->data());
+            else if (frame)
+                v4l_base->copyRGB(frame->data(), false);
+            Streamer->newFrame(std::move(frame));
+            return;
+        }
+
         if (CaptureFormatSP[IMAGE_MONO].getState() == ISS_ON)
         {
             V4LFrame->Y = v4l_base->getY();
@@ -1607,20 +1609,21 @@ void V4L2_Driver::newFrame()
         {
             if (!m_StackMode)
             {
-                unsigned char * src, *dest;
-                src  = v4l_base->getY();
-                dest = (unsigned char *)PrimaryCCD.getFrameBuffer();
-
                 std::unique_lock<std::mutex> guard(ccdBufferLock);
-                memcpy(dest, src, frameBytes);
+                v4l_base->copyY(PrimaryCCD.getFrameBuffer());
                 guard.unlock();
-                //for (i=0; i< frameBytes; i++)
-                //*(dest++) = *(src++);
 
                 PrimaryCCD.binFrame();
             }
             else
             {
+                /* The stacker holds the mean, the modes below work on the sum of the subframes */
+                size_t const size = v4l_base->getWidth() * v4l_base->getHeight();
+                V4LFrame->stackedFrame = (float *)realloc(V4LFrame->stackedFrame, sizeof(float) * size);
+                m_Stacker.getStack(V4LFrame->stackedFrame, INDI::FrameStatistics::FLOAT32);
+                for (size_t i = 0; i < size; i++)
+                    V4LFrame->stackedFrame[i] *= subframeCount;
+
                 float * src = V4LFrame->stackedFrame;
 
                 /* If we have a dark frame configured, substract it from the stack */
@@ -1732,20 +1735,9 @@ void V4L2_Driver::newFrame()
         else
         {
             // Binning not supported in color images for now
+            // For FITS files each color goes in a separate plane, i.e. RRR GGG BBB ..etc
             std::unique_lock<std::mutex> guard(ccdBufferLock);
-            unsigned char * src  = v4l_base->getRGBBuffer();
-            unsigned char * dest = PrimaryCCD.getFrameBuffer();
-            // We have RGB RGB RGB data but for FITS file we need each color in separate plane. i.e. RRR GGG BBB ..etc
-            unsigned char * red   = dest;
-            unsigned char * green = dest + v4l_base->getWidth() * v4l_base->getHeight() * (v4l_base->getBpp() / 8);
-            unsigned char * blue  = dest + v4l_base->getWidth() * v4l_base->getHeight() * (v4l_base->getBpp() / 8) * 2;
-
-            for (int i = 0; i < (int)frameBytes; i += 3)
-            {
-                *(red++)   = *(src + i);
-                *(green++) = *(src + i + 1);
-                *(blue++)  = *(src + i + 2);
-            }
+            v4l_base->copyRGB(PrimaryCCD.getFrameBuffer(), true);
             guard.unlock();
 
             PrimaryCCD.setImageExtension("fits");
@@ -28,6 +28,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301  USA
 
 #include "indiccd.h"
 #include "webcam/v4l2_base.h"
+#include "indilivestacker.h"
 
 #define IMAGE_CONTROL  "Image Control"
 #define IMAGE_GROUP    "V4L2 Control"
@@ -222,6 +223,7 @@ public:
         float getRemainingExposure() const;
 
         unsigned int m_StackMode;
+        INDI::LiveStacker m_Stacker;
         ulong frameBytes;
         unsigned int non_capture_frames;
         bool v4l_capture_started;
@@ -163,7 +163,7 @@ IPState MBox::updateWeather()
             return IPS_ALERT;
         }
 
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
     }
 
     // Remove \r\n
@@ -339,7 +339,7 @@ bool MBox::getCalibration(bool sendCommand)
 
         if (sendCommand)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
 
             if ((rc = tty_write(PortFD, command, strlen(command), &nbytes_written)) != TTY_OK)
             {
@@ -406,7 +406,7 @@ bool MBox::setCalibration(CalibrationType type)
 
         if (isSimulation() == false)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
 
             if ((rc = tty_write(PortFD, command, strlen(command), &nbytes_written)) != TTY_OK)
             {
@@ -426,7 +426,7 @@ bool MBox::setCalibration(CalibrationType type)
 
         if (isSimulation() == false)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
 
             if ((rc = tty_write(PortFD, command, strlen(command), &nbytes_written)) != TTY_OK)
             {
@@ -445,7 +445,7 @@ bool MBox::setCalibration(CalibrationType type)
 
         if (isSimulation() == false)
         {
-            tcflush(PortFD, TCIOFLUSH);
+            tty_flush(PortFD, TCIOFLUSH);
 
             if ((rc = tty_write(PortFD, command, strlen(command), &nbytes_written)) != TTY_OK)
             {
@@ -468,7 +468,7 @@ bool MBox::resetCalibration()
     if (isSimulation() == false)
     {
         int nbytes_written = 0, rc = -1;
-        tcflush(PortFD, TCIOFLUSH);
+        tty_flush(PortFD, TCIOFLUSH);
 
         if ((rc = tty_write(PortFD, command, strlen(command), &nbytes_written)) != TTY_OK)
         {
@@ -125,7 +125,7 @@ IPState Vantage::updateWeather()
     strncpy(command, "LOOP 1", VANTAGE_CMD);
     command[6] = 0;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", command);
 
@@ -285,7 +285,7 @@ bool Vantage::wakeup()
     char command[VANTAGE_CMD];
     char response[VANTAGE_RES];
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     command[0] = 0xA;
 
@@ -330,7 +330,7 @@ bool Vantage::ack()
     command[2] = 'R';
     command[3] = 0;
 
-    tcflush(PortFD, TCIOFLUSH);
+    tty_flush(PortFD, TCIOFLUSH);
 
     LOGF_DEBUG("CMD (%s)", command);
 
@@ -0,0 +1,185 @@
+/* INDI Server for protocol version 1.7.
+ * Copyright (C) 2026 INDI Library contributors
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include "BlobEncoder.hpp"
+
+#include "base64.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+BlobEncoder &BlobEncoder::instance()
+{
+    // Never destroyed: workers may still wait on it at exit
+    static BlobEncoder * encoder = new BlobEncoder();
+    return *encoder;
+}
+
+BlobEncoder::BlobEncoder()
+{
+    // Leave a core for the main loop
+    unsigned hw = std::thread::hardware_concurrency();
+    workersToStart = std::min(8u, hw > 1 ? hw - 1 : 1u);
+
+    // Bound the chunks in flight, and so the memory used ahead of the writer or left idle in the pool
+    window = 2 * std::max(1u, hw);
+}
+
+char * BlobEncoder::acquireBuffer()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!pool.empty())
+        {
+            char * buffer = pool.back();
+            pool.pop_back();
+            return buffer;
+        }
+    }
+    return (char*)malloc(bufferSize);
+}
+
+void BlobEncoder::releaseBuffer(char * buffer)
+{
+    BlobEncoder &self = instance();
+    {
+        std::lock_guard<std::mutex> guard(self.lock);
+        if (self.pool.size() < self.window)
+        {
+            self.pool.push_back(buffer);
+            return;
+        }
+    }
+    free(buffer);
+}
+
+void BlobEncoder::submit(const std::function<void()> &task)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    // Workers are started on first use and live as long as the process
+    if (workersToStart > 0)
+    {
+        for(unsigned i = 0; i < workersToStart; ++i)
+        {
+            std::thread([this]()
+            {
+                workerLoop();
+            }).detach();
+        }
+        workersToStart = 0;
+    }
+
+    work.push_back(task);
+    workAvailable.notify_one();
+}
+
+void BlobEncoder::workerLoop()
+{
+    while(true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            workAvailable.wait(guard, [this]()
+            {
+                return !work.empty();
+            });
+            task = work.front();
+            work.pop_front();
+        }
+        task();
+    }
+}
+
+void BlobEncoder::encode(const unsigned char * data, size_t size, const Emitter &emit, const std::function<bool()> &canceled)
+{
+    BlobEncoder &self = instance();
+
+    struct Piece
+    {
+        char * buffer;
+        int length;
+    };
+
+    size_t count = (size + chunkSize - 1) / chunkSize;
+    if (count <= 1)
+    {
+        // Not worth a trip through the workers
+        if (count == 1 && !canceled())
+        {
+            char * buffer = self.acquireBuffer();
+            emit(buffer, to64frombits_s((unsigned char*)buffer, data, size, bufferSize));
+        }
+        return;
+    }
+
+    std::vector<Piece> pieces(count, Piece{nullptr, -1});
+    std::mutex piecesLock;
+    std::condition_variable pieceDone;
+
+    size_t submitted = 0;
+    size_t emitted = 0;
+
+    while (emitted < count)
+    {
+        bool stop = canceled();
+
+        while (!stop && submitted < count && submitted - emitted < self.window)
+        {
+            Piece * piece = &pieces[submitted];
+            const unsigned char * src = data + submitted * chunkSize;
+            size_t len = std::min(chunkSize, size - submitted * chunkSize);
+
+            piece->buffer = self.acquireBuffer();
+            submitted++;
+
+            self.submit([piece, src, len, &piecesLock, &pieceDone]()
+            {
+                int length = to64frombits_s((unsigned char*)piece->buffer, src, len, bufferSize);
+                std::lock_guard<std::mutex> guard(piecesLock);
+                piece->length = length;
+                pieceDone.notify_all();
+            });
+        }
+
+        if (emitted == submitted)
+        {
+            // Canceled
+            break;
+        }
+
+        {
+            std::unique_lock<std::mutex> guard(piecesLock);
+            pieceDone.wait(guard, [&pieces, emitted]()
+            {
+                return pieces[emitted].length >= 0;
+            });
+        }
+
+        if (stop)
+        {
+            // Only wait for the chunks in flight, they reference this stack
+            releaseBuffer(pieces[emitted].buffer);
+        }
+        else
+        {
+            emit(pieces[emitted].buffer, pieces[emitted].length);
+        }
+        emitted++;
+    }
+}
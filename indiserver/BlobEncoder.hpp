@@ -0,0 +1,65 @@
+/* INDI Server for protocol version 1.7.
+ * Copyright (C) 2026 INDI Library contributors
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/* Base64 encoding of large BLOBs in chunks, spread on a bounded pool of worker threads.
+ * Chunks are handed out in order, in buffers recycled from one BLOB to the next.
+ */
+class BlobEncoder
+{
+    public:
+        /* BLOB bytes per chunk. A multiple of 3, so that chunks encode independently */
+        static const size_t chunkSize = 3 * 16384;
+
+        /* Bytes of a chunk buffer */
+        static const size_t bufferSize = 4 * chunkSize / 3 + 4;
+
+        /* Called with each encoded chunk, in order. The buffer is then owned by the callee, see releaseBuffer */
+        typedef std::function<void(char * buffer, int length)> Emitter;
+
+        /* Encode size bytes at data. Returns early, without emitting the rest, once canceled returns true */
+        static void encode(const unsigned char * data, size_t size, const Emitter &emit, const std::function<bool()> &canceled);
+
+        /* Give back a buffer received by an Emitter */
+        static void releaseBuffer(char * buffer);
+
+    private:
+        /* Chunks encoded ahead of the emitter, and buffers kept for reuse, at most.
+         * Emitted buffers stay with their message until sent, those beyond the pool are freed. */
+        size_t window = 0;
+
+        std::mutex lock;
+        std::condition_variable workAvailable;
+        std::deque<std::function<void()>> work;
+        std::vector<char *> pool;
+        unsigned workersToStart = 0;
+
+        static BlobEncoder &instance();
+
+        BlobEncoder();
+
+        char * acquireBuffer();
+        void submit(const std::function<void()> &task);
+        void workerLoop();
+};
@@ -25,6 +25,7 @@
 #include "CommandLineArgs.hpp"
 
 ConcurrentSet<ClInfo> ClInfo::clients;
+SubscriptionIndex ClInfo::subscriptions;
 
 // root will be released
 void ClInfo::onMessage(XMLEle * root, std::list<int> &sharedBuffers)
@@ -44,12 +45,18 @@ void ClInfo::onMessage(XMLEle * root, std::list<int> &sharedBuffers)
         // Signature for CHAINED SERVER
         // Not a regular client.
         if (dev[0] == '*' && !this->props.size())
+        {
             this->allprops = 2;
+            subscriptions.insertAll(getId());
+        }
         else
             addDevice(dev, name, isblob);
     }
     else if (!strcmp(roottag, "getProperties") && !this->props.size() && this->allprops != 2)
+    {
         this->allprops = 1;
+        subscriptions.insertAll(getId());
+    }
 
     /* snag enableBLOB -- send to remote drivers too */
     if (!strcmp(roottag, "enableBLOB"))
@@ -108,17 +115,25 @@ void ClInfo::close()
 
 void ClInfo::q2Clients(ClInfo *notme, int isblob, const std::string &dev, const std::string &name, Msg *mp, XMLEle *root)
 {
+    /* every client is interested in messages without device */
+    std::vector<SubscriptionIndex::Match> interested;
+    if (dev.empty())
+    {
+        for (auto cpId : clients.ids())
+            interested.push_back({cpId, subscriptions.findProperty(cpId, dev, name)});
+    }
+    else
+        interested = subscriptions.find(dev, name);
+
     /* queue message to each interested client */
-    for (auto cpId : clients.ids())
+    for (auto &match : interested)
     {
-        auto cp = clients[cpId];
+        auto cp = clients[match.id];
         if (cp == nullptr) continue;
 
-        /* cp in use? notme? want this dev/name? blob? */
+        /* cp in use? notme? blob? */
         if (cp == notme)
             continue;
-        if (cp->findDevice(dev, name) < 0)
-            continue;
 
         //if ((isblob && cp->blob==B_NEVER) || (!isblob && cp->blob==B_ONLY))
         if (!isblob && cp->blob == B_ONLY)
@@ -128,15 +143,7 @@ void ClInfo::q2Clients(ClInfo *notme, int isblob, const std::string &dev, const
         {
             if (cp->props.size() > 0)
             {
-                Property *blobp = nullptr;
-                for (auto pp : cp->props)
-                {
-                    if (pp->dev == dev && pp->name == name)
-                    {
-                        blobp = pp;
-                        break;
-                    }
-                }
+                Property *blobp = (match.prop && match.prop->name == name) ? match.prop : nullptr;
 
                 if ((blobp && blobp->blob == B_NEVER) || (!blobp && cp->blob == B_NEVER))
                     continue;
@@ -253,11 +260,8 @@ int ClInfo::findDevice(const std::string &dev, const std::string &name) const
 {
     if (allprops >= 1 || dev.empty())
         return (0);
-    for (auto pp : props)
-    {
-        if ((pp->dev == dev) && (pp->name.empty() || (pp->name == name)))
-            return (0);
-    }
+    if (subscriptions.findProperty(getId(), dev, name))
+        return (0);
     return (-1);
 }
 
@@ -265,11 +269,9 @@ void ClInfo::addDevice(const std::string &dev, const std::string &name, int isbl
 {
     if (isblob)
     {
-        for (auto pp : props)
-        {
-            if (pp->dev == dev && pp->name == name)
-                return;
-        }
+        Property *pp = subscriptions.findProperty(getId(), dev, name);
+        if (pp && pp->name == name)
+            return;
     }
     /* no dups */
     else if (!findDevice(dev, name))
@@ -278,6 +280,7 @@ void ClInfo::addDevice(const std::string &dev, const std::string &name, int isbl
     /* add */
     Property *pp = new Property(dev, name);
     props.push_back(pp);
+    subscriptions.insert(getId(), dev, name, pp);
 }
 
 void ClInfo::crackBLOBHandling(const std::string &dev, const std::string &name, const char *enableBLOB)
@@ -291,15 +294,16 @@ void ClInfo::crackBLOBHandling(const std::string &dev, const std::string &name,
 
     /* If whole client blob handling policy was updated, we need to pass that also to all children
        and if the request was for a specific property, then we apply the policy to it */
-    for (auto pp : props)
+    if (name.empty())
     {
-        if (name.empty())
+        for (auto pp : props)
             crackBLOB(enableBLOB, &pp->blob);
-        else if (pp->dev == dev && pp->name == name)
-        {
+    }
+    else
+    {
+        Property *pp = subscriptions.findProperty(getId(), dev, name);
+        if (pp && pp->name == name)
             crackBLOB(enableBLOB, &pp->blob);
-            return;
-        }
     }
 }
 ClInfo::ClInfo(bool useSharedBuffer) : MsgQueue(useSharedBuffer)
@@ -309,6 +313,7 @@ ClInfo::ClInfo(bool useSharedBuffer) : MsgQueue(useSharedBuffer)
 
 ClInfo::~ClInfo()
 {
+    subscriptions.erase(getId());
     for(auto prop : props)
     {
         delete prop;
@@ -20,6 +20,7 @@
 
 #include "indicore/indidevapi.h"
 #include "MsgQueue.hpp"
+#include "SubscriptionIndex.hpp"
 #include "lilxml.h"
 
 class DvrInfo;
@@ -40,6 +41,9 @@ class ClInfo: public MsgQueue
         /* close down the given client */
         virtual void close();
 
+        /* dev/name -> clients, to route messages to interested clients only */
+        static SubscriptionIndex subscriptions;
+
     public:
         std::list<Property*> props;     /* props we want */
         int allprops = 0;               /* saw getProperties w/o device */
@@ -44,6 +44,12 @@ class Collectable
         };
 
     protected:
+        /* identifier in the current ConcurrentSet, 0 if not collected */
+        unsigned long getId() const
+        {
+            return id;
+        }
+
         /* heartbeat.alive will return true as long as this item has not changed collection.
          * Also detect deletion of the Collectable */
         HeartBeat heartBeat() const
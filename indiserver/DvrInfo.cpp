@@ -26,6 +26,8 @@
 #include "CommandLineArgs.hpp"
 
 ConcurrentSet<DvrInfo> DvrInfo::drivers;
+SubscriptionIndex DvrInfo::devices;
+SubscriptionIndex DvrInfo::snoops;
 
 void DvrInfo::onMessage(XMLEle * root, std::list<int> &sharedBuffers)
 {
@@ -78,7 +80,7 @@ void DvrInfo::onMessage(XMLEle * root, std::list<int> &sharedBuffers)
             fprintf(stderr, "STARTED \"%s\"\n", dp->name.c_str());
         fflush(stderr);
 #endif
-        this->dev.insert(dev);
+        this->addDevice(dev);
     }
 
     /* log messages if any and wanted */
@@ -186,8 +188,18 @@ void DvrInfo::q2RDrivers(const std::string &dev, Msg *mp, XMLEle *root)
      * N.B. don't send generic getProps to more than one remote driver,
      *   otherwise they all fan out and we get multiple responses back.
      */
+    std::vector<unsigned long> candidates;
+    if ((!dev.empty()) && dev[0] != '*')
+    {
+        /* only drivers known to support this dev */
+        for (auto &match : devices.find(dev, ""))
+            candidates.push_back(match.id);
+    }
+    else
+        candidates = drivers.ids();
+
     std::set<std::string> remoteAdvertised;
-    for (auto dpId : drivers.ids())
+    for (auto dpId : candidates)
     {
         auto dp = drivers[dpId];
         if (dp == nullptr) continue;
@@ -195,10 +207,6 @@ void DvrInfo::q2RDrivers(const std::string &dev, Msg *mp, XMLEle *root)
         std::string remoteUid = dp->remoteServerUid();
         bool isRemote = !remoteUid.empty();
 
-        /* driver known to not support this dev */
-        if ((!dev.empty()) && dev[0] != '*' && !dp->isHandlingDevice(dev))
-            continue;
-
         /* Only send message to each *unique* remote driver at a particular host:port
          * Since it will be propagated to all other devices there */
         if (dev.empty() && isRemote)
@@ -230,12 +238,12 @@ void DvrInfo::q2RDrivers(const std::string &dev, Msg *mp, XMLEle *root)
 void DvrInfo::q2SDrivers(DvrInfo *me, int isblob, const std::string &dev, const std::string &name, Msg *mp, XMLEle *root)
 {
     std::string meRemoteServerUid = me ? me->remoteServerUid() : "";
-    for (auto dpId : drivers.ids())
+    for (auto &match : snoops.find(dev, name))
     {
-        auto dp = drivers[dpId];
+        auto dp = drivers[match.id];
         if (dp == nullptr) continue;
 
-        Property *sp = dp->findSDevice(dev, name);
+        Property *sp = match.prop;
 
         /* nothing for dp if not snooping for dev/name or wrong BLOB mode */
         if (!sp)
@@ -273,6 +281,7 @@ void DvrInfo::addSDevice(const std::string &dev, const std::string &name)
     sp = new Property(dev, name);
     sp->blob = B_NEVER;
     sprops.push_back(sp);
+    snoops.insert(getId(), dev, name, sp);
 
     if (userConfigurableArguments->verbosity)
         log(fmt("snooping on %s.%s\n", dev.c_str(), name.c_str()));
@@ -280,13 +289,8 @@ void DvrInfo::addSDevice(const std::string &dev, const std::string &name)
 
 Property * DvrInfo::findSDevice(const std::string &dev, const std::string &name) const
 {
-    for(auto sp : sprops)
-    {
-        if ((sp->dev == dev) && (sp->name.empty() || sp->name == name))
-            return (sp);
-    }
-
-    return nullptr;
+    /* a property snooped by name was registered before the whole device, else it would not be there */
+    return snoops.findProperty(getId(), dev, name);
 }
 DvrInfo::DvrInfo(bool useSharedBuffer) :
     MsgQueue(useSharedBuffer),
@@ -305,6 +309,8 @@ DvrInfo::DvrInfo(const DvrInfo &model):
 
 DvrInfo::~DvrInfo()
 {
+    devices.erase(getId());
+    snoops.erase(getId());
     drivers.erase(this);
     for(auto prop : sprops)
     {
@@ -312,6 +318,12 @@ DvrInfo::~DvrInfo()
     }
 }
 
+void DvrInfo::addDevice(const std::string &dev)
+{
+    this->dev.insert(dev);
+    devices.insert(getId(), dev, "");
+}
+
 bool DvrInfo::isHandlingDevice(const std::string &dev) const
 {
     return this->dev.find(dev) != this->dev.end();
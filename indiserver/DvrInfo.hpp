@@ -19,6 +19,7 @@
 #pragma once
 
 #include "MsgQueue.hpp"
+#include "SubscriptionIndex.hpp"
 #include "lilxml.h"
 
 #include <list>
@@ -49,6 +50,13 @@ class DvrInfo: public MsgQueue
         /* override to kill driver that are not reachable anymore */
         void closeWritePart() override;
 
+        /* record that this driver serves dev */
+        void addDevice(const std::string &dev);
+
+        /* dev -> drivers serving it, and dev/name -> drivers snooping it */
+        static SubscriptionIndex devices;
+        static SubscriptionIndex snoops;
+
 
         /* Construct an instance that will start the same driver */
         DvrInfo(const DvrInfo &model);
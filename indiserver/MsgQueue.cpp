@@ -24,9 +24,12 @@
 #include "CommandLineArgs.hpp"
 
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 using namespace indiserver::constants;
 
 void MsgQueue::writeToFd()
@@ -65,20 +68,57 @@ void MsgQueue::writeToFd()
     }
     while(nsend == 0);
 
-    /* send next chunk, never more than maxWriteBufferLength to reduce blocking */
-    if (nsend > static_cast<ssize_t>(maxWriteBufferLength))
-        nsend = static_cast<ssize_t>(maxWriteBufferLength);
+    /* gather the next chunks, of this message then the following ones, into a single write.
+     * never more than maxWriteBufferLength to reduce blocking. Stop before chunks with attached
+     * buffers: they must go along with the first byte of their chunk.
+     */
+    struct iovec iov[maxChunksPerWrite];
+    int iovCount = 0;
+    ssize_t total = 0;
+    {
+        auto it = msgq.begin();
+        MsgChunckIterator position = nsent;
+        std::vector<int> nextSharedBuffers;
+
+        while(true)
+        {
+            if (nsend > static_cast<ssize_t>(maxWriteBufferLength) - total)
+                nsend = static_cast<ssize_t>(maxWriteBufferLength) - total;
+
+            iov[iovCount].iov_base = data;
+            iov[iovCount].iov_len = nsend;
+            iovCount++;
+            total += nsend;
+
+            if (iovCount == maxChunksPerWrite || total == static_cast<ssize_t>(maxWriteBufferLength))
+                break;
+
+            (*it)->advance(position, nsend);
+            if (!(*it)->getContent(position, data, nsend, nextSharedBuffers))
+                break;
+
+            if (nsend == 0)
+            {
+                // That message is complete, continue with the next one
+                if (++it == msgq.end())
+                    break;
+                position.reset();
+                if (!(*it)->requestContent(position) || !(*it)->getContent(position, data, nsend, nextSharedBuffers) || nsend == 0)
+                    break;
+            }
+
+            if (!nextSharedBuffers.empty())
+                break;
+        }
+    }
 
     if (!useSharedBuffer)
     {
-        nw = write(wFd, data, nsend);
+        nw = writev(wFd, iov, iovCount);
     }
     else
     {
         struct msghdr msgh;
-        struct iovec iov[1];
-        int cmsghdrlength;
-        struct cmsghdr * cmsgh;
 
         size_t fdCount = sharedBuffers.size();
         if (fdCount > 0)
@@ -90,9 +130,8 @@ void MsgQueue::writeToFd()
                 return;
             }
 
-            cmsghdrlength = CMSG_SPACE((fdCount * sizeof(int)));
-            // FIXME: abort on alloc error here
-            cmsgh = (struct cmsghdr*)malloc(cmsghdrlength);
+            int cmsghdrlength = CMSG_SPACE((fdCount * sizeof(int)));
+            struct cmsghdr * cmsgh = (struct cmsghdr*)cmsgBuffer;
             memset(cmsgh, 0, cmsghdrlength);
 
             /* Write the fd as ancillary data */
@@ -108,24 +147,17 @@ void MsgQueue::writeToFd()
         }
         else
         {
-            cmsgh = NULL;
-            cmsghdrlength = 0;
-            msgh.msg_control = cmsgh;
-            msgh.msg_controllen = cmsghdrlength;
+            msgh.msg_control = NULL;
+            msgh.msg_controllen = 0;
         }
 
-        iov[0].iov_base = data;
-        iov[0].iov_len = nsend;
-
         msgh.msg_flags = 0;
         msgh.msg_name = NULL;
         msgh.msg_namelen = 0;
         msgh.msg_iov = iov;
-        msgh.msg_iovlen = 1;
+        msgh.msg_iovlen = iovCount;
 
         nw = sendmsg(wFd, &msgh,  MSG_NOSIGNAL);
-
-        free(cmsgh);
     }
 
     /* shut down if trouble */
@@ -141,23 +173,29 @@ void MsgQueue::writeToFd()
         return;
     }
 
-    /* trace */
-    if (userConfigurableArguments->verbosity > 2)
-    {
-        log(fmt("sending msg nq %ld:\n%.*s\n",
-                msgq.size(), (int)nw, data));
-    }
-    else if (userConfigurableArguments->verbosity > 1)
+    /* update amount sent, chunk by chunk. when a message is complete: free it if
+     * we are the last to use it and pop from our queue.
+     */
+    for(int i = 0; i < iovCount && nw > 0; ++i)
     {
-        log(fmt("sending %.*s\n", (int)nw, data));
-    }
+        ssize_t sent = std::min(nw, static_cast<ssize_t>(iov[i].iov_len));
 
-    /* update amount sent. when complete: free message if we are the last
-     * to use it and pop from our queue.
-     */
-    mp->advance(nsent, nw);
-    if (nsent.done())
-        consumeHeadMsg();
+        /* trace */
+        if (userConfigurableArguments->verbosity > 2)
+        {
+            log(fmt("sending msg nq %ld:\n%.*s\n",
+                    msgq.size(), (int)sent, iov[i].iov_base));
+        }
+        else if (userConfigurableArguments->verbosity > 1)
+        {
+            log(fmt("sending %.*s\n", (int)sent, iov[i].iov_base));
+        }
+
+        headMsg()->advance(nsent, sent);
+        if (nsent.done())
+            consumeHeadMsg();
+        nw -= sent;
+    }
 }
 
 void MsgQueue::log(const std::string &str) const
@@ -217,7 +255,7 @@ void MsgQueue::traceMsg(const std::string &logMsg, XMLEle *root)
     fprintf(stderr, "\n");
 }
 
-MsgQueue::MsgQueue(bool useSharedBuffer): useSharedBuffer(useSharedBuffer)
+MsgQueue::MsgQueue(bool useSharedBuffer): readBuffer(minReadBufferLength), useSharedBuffer(useSharedBuffer)
 {
     lp = newLilXML();
     rio.set<MsgQueue, &MsgQueue::ioCb>(this);
@@ -240,6 +278,7 @@ MsgQueue::~MsgQueue()
     /* unreference messages queue for this client */
     auto msgqcp = msgq;
     msgq.clear();
+    msgqSize = 0;
     for(auto mp : msgqcp)
     {
         mp->release(this);
@@ -327,6 +366,7 @@ void MsgQueue::consumeHeadMsg()
 {
     auto msg = headMsg();
     msgq.pop_front();
+    msgqSize -= sizeof(Msg) + msg->queueSize();
     msg->release(this);
     nsent.reset();
 
@@ -344,6 +384,7 @@ void MsgQueue::pushMsg(Msg * mp)
     auto serialized = mp->serialize(this);
 
     msgq.push_back(serialized);
+    msgqSize += sizeof(Msg) + serialized->queueSize();
     serialized->addAwaiter(this);
 
     // Register for client write
@@ -387,6 +428,7 @@ void MsgQueue::clearMsgQueue()
         mp->release(this);
     }
     msgq.clear();
+    msgqSize = 0;
 
     // Cancel io write events
     updateIos();
@@ -395,15 +437,7 @@ void MsgQueue::clearMsgQueue()
 
 unsigned long MsgQueue::msgQSize() const
 {
-    unsigned long l = 0;
-
-    for (auto mp : msgq)
-    {
-        l += sizeof(Msg);
-        l += mp->queueSize();
-    }
-
-    return (l);
+    return msgqSize;
 }
 
 void MsgQueue::ioCb(ev::io &, int revents)
@@ -431,12 +465,12 @@ void MsgQueue::ioCb(ev::io &, int revents)
         writeToFd();
 }
 
-size_t MsgQueue::doRead(char * buf, size_t nr)
+ssize_t MsgQueue::doRead(char * buf, size_t nr)
 {
     if (!useSharedBuffer)
     {
         /* read client - works for all kinds of fds incl pipe*/
-        return read(rFd, buf, sizeof(buf));
+        return read(rFd, buf, nr);
     }
     else
     {
@@ -504,11 +538,11 @@ size_t MsgQueue::doRead(char * buf, size_t nr)
 
 void MsgQueue::readFromFd()
 {
-    char buf[maxReadBufferLength];
     ssize_t nr;
 
     /* read client */
-    nr = doRead(buf, sizeof(buf));
+    char * buf = readBuffer.data();
+    nr = doRead(buf, readBuffer.size());
     if (nr <= 0)
     {
         if (errno == EAGAIN || errno == EWOULDBLOCK) return;
@@ -521,6 +555,19 @@ void MsgQueue::readFromFd()
         return;
     }
 
+    /* size the next read after this one: a full buffer means the peer has more pending */
+    if (static_cast<size_t>(nr) == readBuffer.size() && readBuffer.size() < maxReadBufferLength)
+    {
+        readBuffer.resize(readBuffer.size() * 2);
+        buf = readBuffer.data();
+    }
+    else if (static_cast<size_t>(nr) < readBuffer.size() / 4 && readBuffer.size() > minReadBufferLength)
+    {
+        readBuffer.resize(readBuffer.size() / 2);
+        readBuffer.shrink_to_fit();
+        buf = readBuffer.data();
+    }
+
     /* process XML chunk */
     char err[1024];
     XMLEle **nodes = parseXMLChunk(lp, buf, nr, err);
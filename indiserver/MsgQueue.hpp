@@ -24,8 +24,10 @@
 #include "indicore/indidevapi.h"
 
 #include <ev++.h>
+#include <sys/socket.h>
 #include <list>
 #include <set>
+#include <vector>
 
 class SerializedMsg;
 class Msg;
@@ -33,8 +35,10 @@ class Msg;
 class MsgQueue: public Collectable
 {
         static constexpr unsigned maxFDPerMessage {16}; /* No more than 16 buffer attached to a message */
-        static constexpr unsigned maxReadBufferLength {49152};
+        static constexpr unsigned minReadBufferLength {49152};
+        static constexpr unsigned maxReadBufferLength {1048576};
         static constexpr unsigned maxWriteBufferLength {49152};
+        static constexpr unsigned maxChunksPerWrite {64}; /* Chunks gathered in a single write */
 
         int rFd, wFd;
         LilXML * lp;         /* XML parsing context */
@@ -47,18 +51,25 @@ class MsgQueue: public Collectable
         std::set<SerializedMsg*> readBlocker;     /* The message that block this queue */
 
         std::list<SerializedMsg*> msgq;           /* To send msg queue */
+        unsigned long msgqSize {0};               /* Storage size of msgq, see msgQSize */
         std::list<int> incomingSharedBuffers; /* During reception, fds accumulate here */
 
         // Position in the head message
         MsgChunckIterator nsent;
 
+        // Ancillary data of the last write, kept to avoid an allocation per write
+        alignas(struct cmsghdr) char cmsgBuffer[CMSG_SPACE(maxFDPerMessage * sizeof(int))];
+
+        /* Receive buffer. Grows while reads fill it, shrinks back once the peer calms down */
+        std::vector<char> readBuffer;
+
         // Handle fifo or socket case
-        size_t doRead(char * buff, size_t len);
+        ssize_t doRead(char * buff, size_t len);
         void readFromFd();
 
-        /* write the next chunk of the current message in the queue to the given
-         * client. pop message from queue when complete and free the message if we are
-         * the last one to use it. shut down this client if trouble.
+        /* write the next chunks of the messages in the queue to the given client,
+         * gathered in a single write. pop messages from queue when complete and free them
+         * if we are the last one to use them. shut down this client if trouble.
          */
         void writeToFd();
 
@@ -73,7 +73,7 @@ void RemoteDvrInfo::start()
      * dev.
      */
     if (!dev.empty())
-        this->dev.insert(dev);
+        this->addDevice(dev);
 
     /* Sending getProperties with device lets remote server limit its
      * outbound (and our inbound) traffic on this socket to this device.
@@ -18,6 +18,7 @@
 */
 #include "SerializedMsgWithoutSharedBuffer.hpp"
 #include "Utils.hpp"
+#include "BlobEncoder.hpp"
 #include "Msg.hpp"
 #include "MsgChunck.hpp"
 #include "base64.h"
@@ -30,6 +31,10 @@ SerializedMsgWithoutSharedBuffer::SerializedMsgWithoutSharedBuffer(Msg * parent)
 
 SerializedMsgWithoutSharedBuffer::~SerializedMsgWithoutSharedBuffer()
 {
+    for(auto buffer : encodedBuffers)
+    {
+        BlobEncoder::releaseBuffer(buffer);
+    }
 }
 
 bool SerializedMsgWithoutSharedBuffer::generateContentAsync() const
@@ -180,23 +185,16 @@ void SerializedMsgWithoutSharedBuffer::generateContent()
                 unsigned long buffSze = sizes[i];
                 const unsigned char* src = (const unsigned char*)blobs[i];
 
-                // split here in smaller chunks for faster startup
+                // Chunks are encoded in parallel, but still pushed in order.
                 // This allow starting write before the whole blob is converted
-                while(buffSze > 0)
+                BlobEncoder::encode(src, buffSze, [this](char * buffer, int base64Count)
                 {
-                    // We need a block size multiple of 24 bits (3 bytes)
-                    unsigned long sze = buffSze > 3 * 16384 ? 3 * 16384 : buffSze;
-
-                    char* buffer = (char*) malloc(4 * sze / 3 + 4);
-                    ownBuffers.push_back(buffer);
-                    int base64Count = to64frombits_s((unsigned char*)buffer, src, sze, (4 * sze / 3 + 4));
-
+                    encodedBuffers.push_back(buffer);
                     async_pushChunck(MsgChunck(buffer, base64Count));
-
-                    buffSze -= sze;
-                    src += sze;
-                }
-
+                }, [this]()
+                {
+                    return async_canceled();
+                });
 
                 // Dettach blobs ASAP
                 dettachSharedBuffer(fds[i], blobs[i], attachedSizes[i]);
@@ -20,8 +20,12 @@
 
 #include "SerializedMsg.hpp"
 
+#include <list>
+
 class SerializedMsgWithoutSharedBuffer: public SerializedMsg
 {
+        /* base64 chunks, given back to BlobEncoder pool on destruction */
+        std::list<char *> encodedBuffers;
 
     public:
         SerializedMsgWithoutSharedBuffer(Msg * parent);
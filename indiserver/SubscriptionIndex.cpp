@@ -0,0 +1,116 @@
+/* INDI Server for protocol version 1.7.
+ * Copyright (C) 2026 INDI Library contributors
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include "SubscriptionIndex.hpp"
+
+void SubscriptionIndex::insert(unsigned long id, const std::string &dev, const std::string &name, Property *prop)
+{
+    auto &ids = devices[dev][name];
+    if (ids.find(id) != ids.end())
+        return;
+
+    ids[id] = prop;
+    keys[id].push_back(std::make_pair(dev, name));
+}
+
+void SubscriptionIndex::insertAll(unsigned long id)
+{
+    everything.insert(id);
+}
+
+void SubscriptionIndex::erase(unsigned long id)
+{
+    everything.erase(id);
+
+    auto k = keys.find(id);
+    if (k == keys.end())
+        return;
+
+    for (auto &key : k->second)
+    {
+        auto d = devices.find(key.first);
+        if (d == devices.end())
+            continue;
+
+        auto n = d->second.find(key.second);
+        if (n == d->second.end())
+            continue;
+
+        n->second.erase(id);
+        if (n->second.empty())
+            d->second.erase(n);
+        if (d->second.empty())
+            devices.erase(d);
+    }
+    keys.erase(k);
+}
+
+std::vector<SubscriptionIndex::Match> SubscriptionIndex::find(const std::string &dev, const std::string &name) const
+{
+    std::map<unsigned long, Property*> found;
+
+    auto d = devices.find(dev);
+    if (d != devices.end())
+    {
+        /* exact registrations first, they take precedence over the whole device */
+        if (!name.empty())
+        {
+            auto n = d->second.find(name);
+            if (n != d->second.end())
+                found.insert(n->second.begin(), n->second.end());
+        }
+
+        auto w = d->second.find("");
+        if (w != d->second.end())
+            found.insert(w->second.begin(), w->second.end());
+    }
+
+    for (auto id : everything)
+        found.insert(std::make_pair(id, nullptr));
+
+    std::vector<Match> result;
+    result.reserve(found.size());
+    for (auto &f : found)
+        result.push_back({f.first, f.second});
+    return result;
+}
+
+Property * SubscriptionIndex::findProperty(unsigned long id, const std::string &dev, const std::string &name) const
+{
+    auto d = devices.find(dev);
+    if (d == devices.end())
+        return nullptr;
+
+    auto n = d->second.find(name);
+    if (n != d->second.end())
+    {
+        auto p = n->second.find(id);
+        if (p != n->second.end())
+            return p->second;
+    }
+
+    if (name.empty())
+        return nullptr;
+
+    n = d->second.find("");
+    if (n != d->second.end())
+    {
+        auto p = n->second.find(id);
+        if (p != n->second.end())
+            return p->second;
+    }
+    return nullptr;
+}
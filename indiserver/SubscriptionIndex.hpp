@@ -0,0 +1,77 @@
+/* INDI Server for protocol version 1.7.
+ * Copyright (C) 2026 INDI Library contributors
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Property;
+
+/* Index of the (device, property) pairs each queue of a ConcurrentSet is interested in,
+ * so that routing a message only visits the interested queues.
+ * Queues are referenced by their ConcurrentSet id: lookups return ids in increasing order,
+ * the same order as ConcurrentSet::ids(), and callers must resolve them again since queues
+ * may die while a message is being routed.
+ */
+class SubscriptionIndex
+{
+    public:
+        /* An interested queue and the Property it registered for this dev/name:
+         * the one registered for exactly dev/name if any, else the one registered for the whole device.
+         * prop is null for queues that registered without a Property or that want every device.
+         */
+        struct Match
+        {
+            unsigned long id;
+            Property *prop;
+        };
+
+    private:
+        /* name -> (id -> Property). An empty name stands for the whole device */
+        typedef std::unordered_map<std::string, std::map<unsigned long, Property*>> NameMap;
+
+        /* dev -> NameMap */
+        std::unordered_map<std::string, NameMap> devices;
+
+        /* ids that want every device */
+        std::set<unsigned long> everything;
+
+        /* id -> registered (dev, name), to forget a queue without a full scan */
+        std::unordered_map<unsigned long, std::vector<std::pair<std::string, std::string>>> keys;
+
+    public:
+        /* register id for dev/name. An empty name registers the whole device.
+         * No change if id already registered for exactly dev/name.
+         */
+        void insert(unsigned long id, const std::string &dev, const std::string &name, Property *prop = nullptr);
+
+        /* register id for every device */
+        void insertAll(unsigned long id);
+
+        /* forget all registrations of id */
+        void erase(unsigned long id);
+
+        /* return queues interested in dev/name, by increasing id */
+        std::vector<Match> find(const std::string &dev, const std::string &name) const;
+
+        /* return the Property id registered for dev/name (see Match), or null */
+        Property *findProperty(unsigned long id, const std::string &dev, const std::string &name) const;
+};
@@ -0,0 +1,181 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "utils.h"
+
+#include "DriverMock.h"
+#include "IndiServerController.h"
+#include "IndiClientMock.h"
+
+/*
+ * Routing throughput of indiserver.
+ *
+ * Usage: BenchIndiserverRouting [clients] [drivers] [messages per driver]
+ *
+ * Starts indiserver with M fake drivers, each serving its own device, and N clients
+ * each watching one of these devices. Every driver floods small setNumberVector
+ * messages and the bench measures how fast they reach the interested clients.
+ */
+
+static const std::string endTag = "</setNumberVector>";
+
+static std::string deviceName(int id)
+{
+    return "benchDev" + std::to_string(id);
+}
+
+// Read from fd until count setNumberVector were received
+static void consume(int fd, long count)
+{
+    std::vector<char> buffer(65536);
+    std::string pending;
+    long received = 0;
+
+    while (received < count)
+    {
+        ssize_t rd = read(fd, buffer.data(), buffer.size());
+        if (rd == -1)
+            throw std::system_error(errno, std::generic_category(), "read");
+        if (rd == 0)
+            throw std::runtime_error("Client connection closed by indiserver");
+
+        pending.append(buffer.data(), rd);
+
+        size_t pos = 0, found;
+        while ((found = pending.find(endTag, pos)) != std::string::npos)
+        {
+            received++;
+            pos = found + endTag.size();
+        }
+        // Keep what may be the beginning of a split end tag
+        size_t keep = std::min(pending.size() - pos, endTag.size() - 1);
+        pending.erase(0, pending.size() - keep);
+    }
+}
+
+static void flood(DriverMock &driver, int id, long count)
+{
+    std::string msg = "<setNumberVector device='" + deviceName(id) + "' name='bench' state='Ok'>"
+                      "<oneNumber name='value'>1.0</oneNumber></setNumberVector>\n";
+
+    const long batchSize = 64;
+    std::string batch;
+    for (long i = 0; i < batchSize; i++)
+        batch += msg;
+
+    long sent = 0;
+    while (sent + batchSize <= count)
+    {
+        driver.cnx.send(batch);
+        sent += batchSize;
+    }
+    for (; sent < count; sent++)
+        driver.cnx.send(msg);
+}
+
+int main(int argc, char **argv)
+{
+    int clientCount = argc > 1 ? atoi(argv[1]) : 12;
+    int driverCount = argc > 2 ? atoi(argv[2]) : 40;
+    long messageCount = argc > 3 ? atol(argv[3]) : 20000;
+
+    if (clientCount < 1 || driverCount < 1 || messageCount < 1)
+    {
+        fprintf(stderr, "Usage: %s [clients] [drivers] [messages per driver]\n", argv[0]);
+        return 2;
+    }
+
+    setupSigPipe();
+
+    IndiServerController indiServer;
+    std::vector<std::unique_ptr<DriverMock>> drivers;
+
+    // Keep indiserver quiet: logging each message would dominate the measure
+    std::vector<std::string> args = { "-p", std::to_string(indiServer.getTcpPort()), "-r", "0", "-m", "1024" };
+    for (int i = 0; i < driverCount; i++)
+    {
+        drivers.push_back(std::unique_ptr<DriverMock>(new DriverMock()));
+        drivers.back()->setup();
+        args.push_back(getTestExePath("fakedriver"));
+    }
+    indiServer.start(args);
+
+    for (int i = 0; i < driverCount; i++)
+    {
+        DriverMock &driver = *drivers[i];
+        driver.waitEstablish();
+        driver.cnx.expectXml("<getProperties version='1.7'/>");
+        driver.cnx.send("<defNumberVector device='" + deviceName(i) +
+                        "' name='bench' label='bench' group='bench' state='Idle' perm='ro' timeout='100'>\n"
+                        "<defNumber name='value' format='%g' min='0' max='0' step='0'>0</defNumber>\n"
+                        "</defNumberVector>\n");
+        driver.ping();
+    }
+
+    // Each client watches one device
+    std::vector<std::unique_ptr<IndiClientMock>> clients;
+    std::vector<int> clientFds;
+    std::vector<long> expected(clientCount, 0);
+    for (int j = 0; j < clientCount; j++)
+    {
+        int fd = tcpSocketConnect("127.0.0.1", indiServer.getTcpPort());
+        clients.push_back(std::unique_ptr<IndiClientMock>(new IndiClientMock()));
+        clients.back()->associate(fd);
+        clients.back()->cnx.send("<getProperties version='1.7' device='" + deviceName(j % driverCount) + "'/>\n");
+        // Make sure the subscription is registered before flooding
+        clients.back()->ping();
+        clientFds.push_back(fd);
+        expected[j] = messageCount;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int j = 0; j < clientCount; j++)
+        threads.push_back(std::thread(consume, clientFds[j], expected[j]));
+    for (int i = 0; i < driverCount; i++)
+        threads.push_back(std::thread(flood, std::ref(*drivers[i]), i, messageCount));
+    for (auto &thread : threads)
+        thread.join();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    long routed = messageCount * driverCount;
+    long delivered = messageCount * clientCount;
+    printf("clients=%d drivers=%d messages=%ld delivered=%ld elapsed=%.3fs\n",
+           clientCount, driverCount, routed, delivered, elapsed.count());
+    printf("%.0f messages/s routed, %.0f messages/s delivered\n",
+           routed / elapsed.count(), delivered / elapsed.count());
+
+    for (auto &driver : drivers)
+        driver->terminateDriver();
+
+    return 0;
+}
@@ -16,11 +16,14 @@
  Boston, MA 02110-1301, USA.
 *******************************************************************************/
 
+#include <chrono>
 #include <stdexcept>
 #include <stdio.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <system_error>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -295,6 +298,71 @@ TEST(IndiserverSingleDriver, DropMisbehavingDriver)
     indiServer.waitProcessEnd(1);
 }
 
+TEST(IndiserverSingleDriver, FloodSmallPropertiesToClient)
+{
+    // Many small messages queued for a client are sent in batched writes: they must arrive complete and in order
+    DriverMock fakeDriver;
+    IndiServerController indiServer;
+
+    startFakeDev1(indiServer, fakeDriver);
+
+    IndiClientMock indiClient;
+    int fd = tcpSocketConnect("127.0.0.1", indiServer.getTcpPort());
+    indiClient.associate(fd);
+
+    connectFakeDev1Client(indiServer, fakeDriver, indiClient);
+
+    const int count = 20000;
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread flood([&fakeDriver]()
+    {
+        std::string batch;
+        for(int i = 0; i < count; ++i)
+        {
+            batch += "<setNumberVector device='fakedev1' name='flood' state='Ok'><oneNumber name='value'>" + std::to_string(i) + "</oneNumber></setNumberVector>\n";
+            if (batch.size() > 16384 || i == count - 1)
+            {
+                fakeDriver.cnx.send(batch);
+                batch.clear();
+            }
+        }
+    });
+
+    const std::string valueTag = "<oneNumber name=\"value\">";
+    const std::string endTag = "</setNumberVector>";
+    std::vector<char> buffer(65536);
+    std::string pending;
+    int received = 0;
+    bool ordered = true;
+    while(received < count && ordered)
+    {
+        ssize_t rd = read(fd, buffer.data(), buffer.size());
+        if (rd <= 0)
+            break;
+        pending.append(buffer.data(), rd);
+
+        size_t end;
+        while(ordered && (end = pending.find(endTag)) != std::string::npos)
+        {
+            size_t value = pending.find(valueTag);
+            ordered = value < end && atoi(pending.c_str() + value + valueTag.size()) == received;
+            received++;
+            pending.erase(0, end + endTag.size());
+        }
+    }
+    flood.join();
+    ASSERT_TRUE(ordered) << "message " << received - 1 << " lost or out of order";
+    ASSERT_EQ(received, count);
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    fprintf(stderr, "%d messages received in %.3fs: %.0f messages/s\n", count, elapsed.count(), count / elapsed.count());
+
+    fakeDriver.terminateDriver();
+    // Exit code 1 is expected when driver stopped
+    indiServer.waitProcessEnd(1);
+}
+
 TEST(IndiserverSingleDriver, ForwardBase64BlobToIPClient)
 {
     // This tests decoding of base64 by driver
@@ -541,6 +609,60 @@ TEST(IndiserverSingleDriver, ForwardAttachedBlobToIPClient)
 }
 
 
+// Expected base64 of the content sent by driverSendAttachedBlob
+static std::string attachedBlobBase64(ssize_t size)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string result;
+    for(ssize_t i = 0; i < size; i += 3)
+    {
+        unsigned int v = 0;
+        for(int j = 0; j < 3; ++j)
+        {
+            v = (v << 8) | (i + j < size ? (unsigned char)('0' + ((i + j) % 10)) : 0);
+        }
+        result += alphabet[(v >> 18) & 63];
+        result += alphabet[(v >> 12) & 63];
+        result += i + 1 < size ? alphabet[(v >> 6) & 63] : '=';
+        result += i + 2 < size ? alphabet[v & 63] : '=';
+    }
+    return result;
+}
+
+TEST(IndiserverSingleDriver, ForwardLargeAttachedBlobToIPClient)
+{
+    // Large enough to be encoded in many chunks, in parallel
+    DriverMock fakeDriver;
+    IndiServerController indiServer;
+
+    startFakeDev1(indiServer, fakeDriver);
+
+    IndiClientMock indiClient;
+
+    indiClient.connectTcp(indiServer);
+
+    connectFakeDev1Client(indiServer, fakeDriver, indiClient);
+
+    indiClient.cnx.send("<enableBLOB device='fakedev1' name='testblob'>Also</enableBLOB>\n");
+
+    for(ssize_t size : {3 * 16384 + 1, 4 * 1024 * 1024 + 7})
+    {
+        indiClient.ping();
+
+        driverSendAttachedBlob(fakeDriver, size);
+
+        indiClient.cnx.expectXml("<setBLOBVector device='fakedev1' name='testblob' timestamp='2018-01-01T00:01:00'>");
+        indiClient.cnx.expectXml("<oneBLOB name='content' size='" + std::to_string(size) + "' format='.fits'>");
+        indiClient.cnx.expect("\n" + attachedBlobBase64(size));
+        indiClient.cnx.expectXml("</oneBLOB>");
+        indiClient.cnx.expectXml("</setBLOBVector>");
+    }
+    fakeDriver.terminateDriver();
+    // Exit code 1 is expected when driver stopped
+    indiServer.waitProcessEnd(1);
+}
+
+
 TEST(IndiserverSingleDriver, ForwardAttachedBlobToDriver)
 {
     // This tests attached blob pass through
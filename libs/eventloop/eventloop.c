@@ -22,6 +22,8 @@
  *
  * callbacks may be registered that are triggered when a file descriptor
  *   will not block when read;
+ *   on Linux the descriptors are watched with epoll, unless the environment
+ *   variable INDIEVENTLOOP is set to "select"; elsewhere select() is used;
  *
  * timers may be registered that will run no sooner than a specified delay from
  *   the moment they were registered;
@@ -45,6 +47,15 @@
 #include <sys/select.h>
 #endif
 
+#if defined(__linux__)
+#define USE_EPOLL
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#endif
+
 #include "eventloop.h"
 
 /* info about one registered callback.
@@ -57,29 +68,49 @@ typedef struct
     int fd;     /* fd descriptor to watch for read */
     void *ud;   /* user's data handle */
     CBF *fp;    /* callback function */
+#ifdef USE_EPOLL
+    int pollfd;    /* fd added to epoll: fd, a dup of it when fd is watched twice, or -1 */
+    int always;    /* fd can not be polled, eg a regular file, so it is always ready */
+    uint32_t gen;  /* bumped each time the entry is reused, to spot stale events */
+#endif
 } CB;
 static CB *cback;    /* malloced list of callbacks */
 static int ncback;   /* n entries in cback[] */
 static int ncbinuse; /* n entries in cback[] marked in_use */
 static int lastcb;   /* cback index of last cb called */
 
+#ifdef USE_EPOLL
+/* epoll instance watching the callback fds, -1 when select() is used, -2 until chosen */
+static int epfd = -2;
+static int ncbalways; /* n entries in cback[] in use and always ready */
+/* most events taken per epoll_wait(). epoll reports ready fds in turn, so the
+ * others come first next time.
+ */
+#define MAXEVENTS 64
+#endif
+
 /* info about one registered timer function.
- * the entries are kept sorted by increasing time from epoch, ie,
- *   the next entry to fire is at the begin of the list.
+ * the entries are kept in a binary min-heap ordered by trigger time, ie,
+ *   the next entry to fire is timerheap[0], and in a hash table by id.
+ * times are ns on CLOCK_MONOTONIC, so wall clock changes do not move them.
  */
 typedef struct TF
 {
-    double tgo;       /* trigger time, ms from epoch */
+    int64_t tgo;      /* trigger time, ns */
+    int64_t seq;      /* insertion order, timers due at once run in this order */
     int interval;     /* repeat timer if interval > 0, ms */
     void *ud;         /* user's data handle */
     TCF *fp;          /* timer function */
     int tid;          /* unique id for this timer */
-    struct TF *next;  /* pointer to next item */
+    int heapidx;      /* index in timerheap[] */
 } TF;
-static TF  timefunc_null = {0, 0, NULL, NULL, 0, NULL};
-static TF *timefunc = &timefunc_null;  /* list of timer functions */
+static TF **timerheap; /* malloced heap of timer functions */
+static int ntimers;    /* n entries in timerheap[] */
+static int nheap;      /* n slots in timerheap[] */
+static TF **timerids;  /* malloced hash table of timers by id, linear probing */
+static int nids;       /* n slots in timerids[], a power of 2 */
 static int tid = 0;    /* source of unique timer ids */
-#define EPOCHDT(tp) /* ms from epoch to timeval *tp */ (((tp)->tv_usec) / 1000.0 + ((tp)->tv_sec) * 1000.0)
+static int64_t tseq = 0; /* source of insertion order */
 
 /* info about one registered work procedure.
  * the malloced array wproc is never shrunk, entries are reused. new id's are
@@ -98,6 +129,12 @@ static int lastwp;   /* wproc index of last workproc called*/
 
 static void runWorkProc(void);
 static void callCallback(fd_set *rfdp);
+#ifdef USE_EPOLL
+static int useEpoll(void);
+static void watchCallback(CB *cp);
+static void unwatchCallback(CB *cp);
+static void oneLoopEpoll(void);
+#endif
 static void checkTimer();
 static void oneLoop(void);
 static void deferTO(void *p);
@@ -174,6 +211,7 @@ int addCallback(int fd, CBF *fp, void *ud)
     {
         cback = realloc(cback, (ncback + 1) * sizeof(CB));
         cp    = &cback[ncback++];
+        memset(cp, 0, sizeof(CB));
     }
 
     /* init new entry */
@@ -183,6 +221,14 @@ int addCallback(int fd, CBF *fp, void *ud)
     cp->fd     = fd;
     ncbinuse++;
 
+#ifdef USE_EPOLL
+    if (useEpoll())
+    {
+        cp->gen++;
+        watchCallback(cp);
+    }
+#endif
+
     /* id is index into array */
     return (cp - cback);
 }
@@ -204,44 +250,277 @@ void rmCallback(int cid)
     /* mark for reuse */
     cp->in_use = 0;
     ncbinuse--;
+
+#ifdef USE_EPOLL
+    if (epfd >= 0)
+        unwatchCallback(cp);
+#endif
+}
+
+#ifdef USE_EPOLL
+/* choose the backend on first use: epoll, unless INDIEVENTLOOP=select or epoll
+ * is not available. return 1 if epoll is used.
+ */
+static int useEpoll()
+{
+    if (epfd == -2)
+    {
+        const char *backend = getenv("INDIEVENTLOOP");
+        if (backend != NULL && strcmp(backend, "select") == 0)
+            epfd = -1;
+        else
+            epfd = epoll_create1(EPOLL_CLOEXEC);
+    }
+    return (epfd >= 0);
+}
+
+/* add the fd of cp to the epoll set. the event carries the cback index and
+ * the generation of the entry.
+ */
+static void watchCallback(CB *cp)
+{
+    struct epoll_event ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = EPOLLIN;
+    ev.data.u64 = ((uint64_t)cp->gen << 32) | (uint32_t)(cp - cback);
+
+    cp->pollfd = cp->fd;
+    cp->always = 0;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, cp->pollfd, &ev) == 0)
+        return;
+
+    if (errno == EEXIST)
+    {
+        /* fd is watched by another callback already, watch a duplicate */
+        cp->pollfd = fcntl(cp->fd, F_DUPFD_CLOEXEC, 0);
+        if (cp->pollfd >= 0 && epoll_ctl(epfd, EPOLL_CTL_ADD, cp->pollfd, &ev) == 0)
+            return;
+        if (cp->pollfd >= 0)
+            close(cp->pollfd);
+    }
+    else if (errno == EPERM)
+    {
+        /* like select(), regular files are always ready */
+        cp->always = 1;
+        ncbalways++;
+    }
+    else
+        perror("epoll_ctl");
+
+    cp->pollfd = -1;
+}
+
+/* remove the fd of cp from the epoll set. fails quietly when the fd was
+ * closed before, epoll then dropped it already.
+ */
+static void unwatchCallback(CB *cp)
+{
+    CB *other;
+
+    if (cp->always)
+    {
+        cp->always = 0;
+        ncbalways--;
+    }
+
+    if (cp->pollfd < 0)
+        return;
+
+    /* the fd was closed and its number is watched again by a newer callback,
+     * leave that alone
+     */
+    for (other = cback; other < &cback[ncback]; other++)
+        if (other != cp && other->in_use && other->pollfd == cp->pollfd)
+            break;
+
+    if (other == &cback[ncback])
+        epoll_ctl(epfd, EPOLL_CTL_DEL, cp->pollfd, NULL);
+    if (cp->pollfd != cp->fd)
+        close(cp->pollfd);
+    cp->pollfd = -1;
 }
 
-/* insert maintaining sort */
+/* return 1 if ev comes from a callback still in use */
+static int isCurrentEvent(const struct epoll_event *ev)
+{
+    int cid = (int)(uint32_t)ev->data.u64;
+    return (cid < ncback && cback[cid].in_use && cback[cid].gen == (uint32_t)(ev->data.u64 >> 32));
+}
+
+/* n of callbacks from the one after the last called to cid, for round robin */
+static int cbDistance(int cid)
+{
+    return ((cid - lastcb - 1 + ncback) % ncback);
+}
+
+/* start over with a new epoll set. epoll keeps reporting a closed fd while
+ * another process holds a duplicate of it, so events from callbacks removed
+ * after their fd was closed can only be stopped this way.
+ */
+static void rebuildEpoll()
+{
+    CB *cp;
+
+    for (cp = cback; cp < &cback[ncback]; cp++)
+        if (cp->in_use)
+            unwatchCallback(cp);
+
+    close(epfd);
+    epfd = epoll_create1(EPOLL_CLOEXEC);
+
+    /* without epoll, select() takes over */
+    for (cp = cback; cp < &cback[ncback]; cp++)
+        if (cp->in_use && epfd >= 0)
+            watchCallback(cp);
+}
+#endif
+
+/* ns on the monotonic clock */
+static int64_t monotonicNow()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec);
+}
+
+/* timer a is due before timer b */
+static int timerBefore(const TF *a, const TF *b)
+{
+    return (a->tgo < b->tgo || (a->tgo == b->tgo && a->seq < b->seq));
+}
+
+static void placeTimer(TF *node, int idx)
+{
+    timerheap[idx] = node;
+    node->heapidx  = idx;
+}
+
+/* move the timer at idx up or down until the heap is in order again */
+static void siftTimer(int idx)
+{
+    TF *node = timerheap[idx];
+
+    while (idx > 0 && timerBefore(node, timerheap[(idx - 1) / 2]))
+    {
+        placeTimer(timerheap[(idx - 1) / 2], idx);
+        idx = (idx - 1) / 2;
+    }
+
+    for (;;)
+    {
+        int child = 2 * idx + 1;
+        if (child >= ntimers)
+            break;
+        if (child + 1 < ntimers && timerBefore(timerheap[child + 1], timerheap[child]))
+            child++;
+        if (!timerBefore(timerheap[child], node))
+            break;
+        placeTimer(timerheap[child], idx);
+        idx = child;
+    }
+
+    placeTimer(node, idx);
+}
+
+static unsigned hashTimerId(int timer_id)
+{
+    return ((unsigned)timer_id * 2654435761u) & (nids - 1);
+}
+
+static void hashTimer(TF *node)
+{
+    unsigned h = hashTimerId(node->tid);
+    while (timerids[h] != NULL)
+        h = (h + 1) & (nids - 1);
+    timerids[h] = node;
+}
+
+/* find the timer by id */
+static TF *findTimer(int timer_id)
+{
+    unsigned h;
+
+    if (nids == 0)
+        return NULL;
+    for (h = hashTimerId(timer_id); timerids[h] != NULL; h = (h + 1) & (nids - 1))
+        if (timerids[h]->tid == timer_id)
+            return timerids[h];
+    return NULL;
+}
+
+/* add to heap and hash table, growing them to keep the table at most half full */
 static void insertTimer(TF *node)
 {
-    TF *it = timefunc;
+    if (ntimers == nheap)
+    {
+        nheap     = nheap ? 2 * nheap : 16;
+        timerheap = (TF **)realloc(timerheap, nheap * sizeof(TF *));
+    }
+
+    if (2 * (ntimers + 1) > nids)
+    {
+        TF **old = timerids;
+        int i, nold = nids;
+
+        nids     = nids ? 2 * nids : 32;
+        timerids = (TF **)calloc(nids, sizeof(TF *));
+        for (i = 0; i < nold; i++)
+            if (old[i] != NULL)
+                hashTimer(old[i]);
+        free(old);
+    }
+
+    node->seq = ++tseq;
+    hashTimer(node);
+    placeTimer(node, ntimers++);
+    siftTimer(node->heapidx);
+}
+
+/* take out of heap and hash table */
+static void dettachTimer(TF *node)
+{
+    unsigned h, hole, home;
+    int idx = node->heapidx;
 
-    for(; ; it = it->next)
+    /* last entry takes its place in the heap */
+    ntimers--;
+    if (idx != ntimers)
     {
-        if (it->next == NULL || node->tgo < it->next->tgo)
+        placeTimer(timerheap[ntimers], idx);
+        siftTimer(idx);
+    }
+
+    /* shift back the entries probed past the hole, so lookups do not stop at it */
+    for (h = hashTimerId(node->tid); timerids[h] != node; h = (h + 1) & (nids - 1))
+        ;
+    timerids[h] = NULL;
+    hole = h;
+    for (h = (h + 1) & (nids - 1); timerids[h] != NULL; h = (h + 1) & (nids - 1))
+    {
+        home = hashTimerId(timerids[h]->tid);
+        if (((h - home) & (nids - 1)) >= ((h - hole) & (nids - 1)))
         {
-            node->next = it->next;
-            it->next = node;
-            break;
+            timerids[hole] = timerids[h];
+            timerids[h]    = NULL;
+            hole           = h;
         }
     }
 }
 
 /* register a new timer function, fp, to be called with ud as arg after ms
- * milliseconds. add to list in order of increasing time from epoch, ie,
- * first entry runs soonest. return id for use with rmTimer().
+ * milliseconds. return id for use with rmTimer().
  */
 static int addTimerImpl(int delay, int interval, TCF *fp, void *ud)
 {
-    struct timeval t;
-    TF *node;
-
-    /* get time now */
-    gettimeofday(&t, NULL);
-
     /* create entry */
-    node = (TF*)malloc(sizeof(TF));
+    TF *node = (TF*)malloc(sizeof(TF));
 
     /* init new entry */
     node->ud  = ud;
     node->fp  = fp;
     node->tid = ++tid; /* store new unique id */
-    node->tgo = EPOCHDT(&t) + delay;
+    node->tgo = monotonicNow() + (int64_t)delay * 1000000;
     node->interval = interval;
 
     insertTimer(node);
@@ -259,54 +538,23 @@ int addPeriodicTimer(int ms, TCF *fp, void *ud)
     return addTimerImpl(ms, ms, fp, ud);
 }
 
-/* find the timer and remove from list */
-static TF *dettachTimer(TF *node)
-{
-    TF *it = timefunc;
-    for(; it->next != NULL; it = it->next)
-    {
-        if (it->next == node)
-        {
-            it->next = node->next;
-            return node;
-        }
-    }
-    return NULL;
-}
-
-/* find the timer by id */
-static TF *findTimer(int timer_id)
-{
-    TF *it = timefunc->next;
-    for(; it != NULL; it = it->next)
-        if (it->tid == timer_id)
-            return it;
-    return NULL;
-}
-
 /* remove the timer with the given id, as returned from addTimer().
  * silently ignore if id not found.
  */
 void rmTimer(int timer_id)
 {
-    TF *node, *it = timefunc;
-    for(; (node = it->next) != NULL; it = it->next)
-    {
-        if (node->tid == timer_id)
-        {
-            it->next = node->next;
-            free(node);
-            break;
-        }
-    }
+    TF *node = findTimer(timer_id);
+    if (node == NULL)
+        return;
+
+    dettachTimer(node);
+    free(node);
 }
 
-/* Returns the timer's remaining value in milliseconds left until the timeout. */
-static double remainingTimerNode(TF *node)
+/* Returns the timer's remaining value in nanoseconds left until the timeout. */
+static int64_t remainingTimerNode(TF *node)
 {
-    struct timeval now;
-    gettimeofday(&now, NULL);
-    return (node->tgo - EPOCHDT(&now));
+    return (node->tgo - monotonicNow());
 }
 
 /* Returns the timer's remaining value in milliseconds left until the timeout.
@@ -315,7 +563,7 @@ static double remainingTimerNode(TF *node)
 int remainingTimer(int timer_id)
 {
     TF *it = findTimer(timer_id);
-    return it == NULL ? -1 : remainingTimerNode(it);
+    return it == NULL ? -1 : (int)(remainingTimerNode(it) / 1000000);
 }
 
 /* Returns the timer's remaining value in nanoseconds left until the timeout.
@@ -324,7 +572,7 @@ int remainingTimer(int timer_id)
 int64_t nsecsRemainingTimer(int timer_id)
 {
     TF *it = findTimer(timer_id);
-    return it == NULL ? -1 : remainingTimerNode(it) * 1000000;
+    return it == NULL ? -1 : remainingTimerNode(it);
 }
 
 /* add a new work procedure, fp, to be called with ud when nothing else to do.
@@ -414,28 +662,33 @@ static void callCallback(fd_set *rfdp)
 }
 
 /* run the next timer callback whose time has come, if any. all we have to do
- * is is check the first entry in timefunc because it is sorted in increasing
- * order of time from epoch to run, ie, first entry runs soonest.
+ * is check the top of the heap, the entry that runs soonest.
  */
 static void checkTimer()
 {
-    TF *node = timefunc->next;
+    TF *node;
+    int timer_id;
 
-    if (node == NULL || remainingTimerNode(node) > 0)
+    if (ntimers == 0 || remainingTimerNode(timerheap[0]) > 0)
         return;
 
+    /* the timer stays registered while it runs, it may remove itself */
+    node     = timerheap[0];
+    timer_id = node->tid;
     (*node->fp)(node->ud);
 
-    node = dettachTimer(node);
-
+    node = findTimer(timer_id);
     if (node == NULL)
         return;
 
     if (node->interval > 0)
     {
-        node->tgo += node->interval;
+        /* from the previous trigger time, so the period does not drift */
+        node->tgo += (int64_t)node->interval * 1000000;
+        dettachTimer(node);
         insertTimer(node);
     } else {
+        dettachTimer(node);
         free(node);
     }
 }
@@ -450,6 +703,14 @@ static void oneLoop()
     CB *cp;
     int maxfd, ns;
 
+#ifdef USE_EPOLL
+    if (useEpoll())
+    {
+        oneLoopEpoll();
+        return;
+    }
+#endif
+
     /* build list of callback file descriptors to check */
     FD_ZERO(&rfd);
     maxfd = -1;
@@ -476,15 +737,16 @@ static void oneLoop()
         tvp         = &tv;
         tvp->tv_sec = tvp->tv_usec = 0;
     }
-    else if (timefunc->next != NULL)
+    else if (ntimers > 0)
     {
-        double late = remainingTimerNode(timefunc->next); /* ms late */
+        int64_t late = remainingTimerNode(timerheap[0]); /* ns late */
         if (late < 0)
             late = 0;
-        late /= 1000.0; /* secs late */
+        /* rounded up to whole us so timers are not polled early */
+        late         = (late + 999) / 1000;
         tvp          = &tv;
-        tvp->tv_sec  = (long)floor(late);
-        tvp->tv_usec = (long)floor((late - tvp->tv_sec) * 1000000.0);
+        tvp->tv_sec  = (long)(late / 1000000);
+        tvp->tv_usec = (long)(late % 1000000);
     }
     else
         tvp = NULL;
@@ -507,6 +769,76 @@ static void oneLoop()
     runImmediates();
 }
 
+#ifdef USE_EPOLL
+/* oneLoop() with epoll: same order of timers, callbacks and work procedures,
+ * and the same round robin over the ready callbacks, but the cost does not
+ * grow with the number of registered ones.
+ */
+static void oneLoopEpoll()
+{
+    struct epoll_event events[MAXEVENTS];
+    int timeout, ns, i, cid, next = -1;
+
+    /* timeout, as select() above, rounded up to whole ms so timers are not
+     * polled early
+     */
+    if (nwpinuse > 0 || ncbalways > 0)
+        timeout = 0;
+    else if (ntimers > 0)
+    {
+        int64_t late = (remainingTimerNode(timerheap[0]) + 999999) / 1000000; /* ms late */
+        timeout = late < 0 ? 0 : (late > INT_MAX ? INT_MAX : (int)late);
+    }
+    else
+        timeout = -1;
+
+    ns = epoll_wait(epfd, events, MAXEVENTS, timeout);
+    if (ns < 0)
+    {
+        perror("epoll_wait");
+        return;
+    }
+
+    /* events of callbacks already removed come from fds closed too early */
+    for (i = 0; i < ns; i++)
+    {
+        if (!isCurrentEvent(&events[i]))
+        {
+            rebuildEpoll();
+            break;
+        }
+    }
+
+    /* dispatch */
+    checkTimer();
+
+    /* the first ready callback after the last one called, that the timer
+     * did not remove
+     */
+    for (i = 0; i < ns; i++)
+    {
+        cid = (int)(uint32_t)events[i].data.u64;
+        if (isCurrentEvent(&events[i]) && (next < 0 || cbDistance(cid) < cbDistance(next)))
+            next = cid;
+    }
+    for (cid = 0; ncbalways > 0 && cid < ncback; cid++)
+    {
+        if (cback[cid].in_use && cback[cid].always && (next < 0 || cbDistance(cid) < cbDistance(next)))
+            next = cid;
+    }
+
+    if (next >= 0)
+    {
+        lastcb = next;
+        (*cback[next].fp)(cback[next].fd, cback[next].ud);
+    }
+    else if (ns == 0)
+        runWorkProc();
+
+    runImmediates();
+}
+#endif
+
 /* timer callback used to implement deferLoop().
  * arg is pointer to int which we set to 1
  */
@@ -25,8 +25,13 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301  USA
 
 #pragma once
 
+#include <stdint.h>
+
 /** \file eventloop.h
     \brief Public interface to INDI's eventloop mechanism.
+
+    On Linux, callback file descriptors are watched with epoll. Set the environment variable
+    INDIEVENTLOOP to "select" to use select() as on other systems.
     \author Elwood C. Downey
 */
 
@@ -115,7 +120,7 @@ extern int remainingTimer(int tid);
  * \param tid the timer callback ID returned from addTimer() or addPeriodicTimer()
  * \return  If the timer not exists, the returned value will be -1.
  */
-extern int nsecRemainingTimer(int tid);
+extern int64_t nsecsRemainingTimer(int tid);
 
 /** Remove the timer with the given \e id, as returned from addTimer() or addPeriodicTimer().
 *
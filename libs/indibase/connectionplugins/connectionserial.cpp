@@ -318,6 +318,9 @@ bool Serial::Connect(const char *port, uint32_t baud)
 
     LOGF_DEBUG("Port FD %d", PortFD);
 
+    if (m_Buffered)
+        tty_set_buffered(PortFD, 1);
+
     return true;
 }
 
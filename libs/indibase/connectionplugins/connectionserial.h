@@ -149,6 +149,20 @@ class Serial : public Interface
             stopBits = value ;
         }
 
+        bool isBuffered() const
+        {
+            return m_Buffered;
+        }
+        /**
+         * @brief setBuffered Read sections from the port in bulk rather than one byte at a time, see
+         * tty_set_buffered(). Only for drivers that read the port with the tty functions alone and flush it with
+         * tty_flush. Default false. Call this function in initProperties() of your driver.
+         */
+        void setBuffered(bool value)
+        {
+            m_Buffered = value;
+        }
+
     protected:
         /**
          * \brief Connect to serial port device. Default parameters are 8 bits, 1 stop bit, no parity.
@@ -196,6 +210,7 @@ class Serial : public Interface
 
         std::string m_ConfigPort;
         int m_ConfigBaudRate {-1};
+        bool m_Buffered {false};
         std::vector<std::string> m_SystemPorts;
 };
 }
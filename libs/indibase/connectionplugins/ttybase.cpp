@@ -30,6 +30,8 @@
 
 #include "locale_compat.h"
 
+#include <algorithm>
+
 #include <errno.h>
 #include <fcntl.h>
 #include <math.h>
@@ -177,13 +179,23 @@ TTYBase::TTY_RESPONSE TTYBase::read(uint8_t *buffer, uint32_t nbytes, uint8_t ti
 
     while (numBytesToRead > 0)
     {
-        if ((timeoutResponse = checkTimeout(timeout)))
-            return timeoutResponse;
-
-        bytesRead = ::read(m_PortFD, buffer + (*nbytes_read), numBytesToRead);
-
-        if (bytesRead < 0)
-            return TTY_READ_ERROR;
+        // Bytes left over by readSection come first
+        if (m_ReadStart < m_ReadEnd)
+        {
+            bytesRead = std::min(m_ReadEnd - m_ReadStart, numBytesToRead);
+            memcpy(buffer + (*nbytes_read), m_ReadBuffer + m_ReadStart, bytesRead);
+            m_ReadStart += bytesRead;
+        }
+        else
+        {
+            if ((timeoutResponse = checkTimeout(timeout)))
+                return timeoutResponse;
+
+            bytesRead = ::read(m_PortFD, buffer + (*nbytes_read), numBytesToRead);
+
+            if (bytesRead < 0)
+                return TTY_READ_ERROR;
+        }
 
         DEBUGFDEVICE(m_DriverName, m_DebugChannel, "%d bytes read and %d bytes remaining...", bytesRead,
                      numBytesToRead - bytesRead);
@@ -219,6 +231,9 @@ TTYBase::TTY_RESPONSE TTYBase::readSection(uint8_t *buffer, uint32_t nsize, uint
     DEBUGFDEVICE(m_DriverName, m_DebugChannel, "%s: Request to read until stop char '%#02X' with %d timeout for m_PortFD %d",
                  __FUNCTION__, stop_byte, timeout, m_PortFD);
 
+    if (m_Buffered)
+        return readBufferedSection(buffer, nsize, stop_byte, timeout, nbytes_read);
+
     for (;;)
     {
         if ((timeoutResponse = checkTimeout(timeout)))
@@ -243,6 +258,64 @@ TTYBase::TTY_RESPONSE TTYBase::readSection(uint8_t *buffer, uint32_t nsize, uint
 #endif
 }
 
+TTYBase::TTY_RESPONSE TTYBase::readBufferedSection(uint8_t *buffer, uint32_t nsize, uint8_t stop_byte, uint8_t timeout,
+        uint32_t *nbytes_read)
+{
+#ifdef _WIN32
+    return TTY_ERRNO;
+#else
+    TTY_RESPONSE timeoutResponse = TTY_OK;
+
+    if (nsize == 0)
+        return TTY_OVERFLOW;
+
+    // Read in bulk, and keep what arrived after the stop byte for the next read
+    for (;;)
+    {
+        if (m_ReadStart == m_ReadEnd)
+        {
+            if ((timeoutResponse = checkTimeout(timeout)))
+                return timeoutResponse;
+
+            int bytesRead = ::read(m_PortFD, m_ReadBuffer, sizeof(m_ReadBuffer));
+
+            // Nothing to read from a readable port is end of file, eg. the device is gone
+            if (bytesRead <= 0)
+                return TTY_READ_ERROR;
+
+            m_ReadStart = 0;
+            m_ReadEnd   = bytesRead;
+        }
+
+        const uint8_t *data = m_ReadBuffer + m_ReadStart;
+        uint32_t count = std::min(m_ReadEnd - m_ReadStart, nsize - *nbytes_read);
+        const uint8_t *stop = static_cast<const uint8_t *>(memchr(data, stop_byte, count));
+        if (stop)
+            count = stop - data + 1;
+
+        memcpy(buffer + *nbytes_read, data, count);
+        for (uint32_t i = 0; i < count; i++)
+            DEBUGFDEVICE(m_DriverName, m_DebugChannel, "%s: buffer[%d]=%#X (%c)", __FUNCTION__, *nbytes_read + i, data[i], data[i]);
+
+        *nbytes_read += count;
+        m_ReadStart += count;
+
+        if (stop)
+            return TTY_OK;
+        else if (*nbytes_read >= nsize)
+            return TTY_OVERFLOW;
+    }
+
+#endif
+}
+
+void TTYBase::setBuffered(bool enabled)
+{
+    // Bytes kept from earlier reads are not returned once the port is read directly again
+    m_ReadStart = m_ReadEnd = 0;
+    m_Buffered = enabled;
+}
+
 #if defined(BSD) && !defined(__GNU__)
 // BSD - OSX version
 TTYBase::TTY_RESPONSE TTYBase::connect(const char *device, uint32_t bit_rate, uint8_t word_size, uint8_t parity,
@@ -483,6 +556,7 @@ TTYBase::TTY_RESPONSE TTYBase::connect(const char *device, uint32_t bit_rate, ui
 #endif
 
     m_PortFD = t_fd;
+    m_ReadStart = m_ReadEnd = 0;
     /* return success */
     return TTY_OK;
 
@@ -668,6 +742,7 @@ TTYBase::TTY_RESPONSE TTYBase::connect(const char *device, uint32_t bit_rate, ui
     tty_setting.c_cc[VTIME] = 0;
 
     /* now clear input and output buffers and activate the new terminal settings */
+    m_ReadStart = m_ReadEnd = 0;
     tcflush(t_fd, TCIOFLUSH);
     if (tcsetattr(t_fd, TCSANOW, &tty_setting))
     {
@@ -693,7 +768,7 @@ TTYBase::TTY_RESPONSE TTYBase::disconnect()
 #ifdef _WIN32
     return TTY_ERRNO;
 #else
-    tcflush(m_PortFD, TCIOFLUSH);
+    flush();
     int err = close(m_PortFD);
 
     if (err != 0)
@@ -703,6 +778,23 @@ TTYBase::TTY_RESPONSE TTYBase::disconnect()
 #endif
 }
 
+TTYBase::TTY_RESPONSE TTYBase::flush()
+{
+    m_ReadStart = m_ReadEnd = 0;
+
+    if (m_PortFD == -1)
+        return TTY_ERRNO;
+
+#ifdef _WIN32
+    return TTY_ERRNO;
+#else
+    if (tcflush(m_PortFD, TCIOFLUSH) != 0)
+        return TTY_ERRNO;
+
+    return TTY_OK;
+#endif
+}
+
 const std::string TTYBase::error(TTY_RESPONSE code) const
 {
     char error_string[512] = {0};
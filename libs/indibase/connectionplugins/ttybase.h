@@ -112,6 +112,20 @@ class TTYBase
         */
         TTY_RESPONSE disconnect();
 
+        /** \brief Discards data written but not transmitted and data received but not read, like tcflush, including
+            the bytes readSection() took from the port but has not returned yet. Use it instead of tcflush on getPortFD().
+            \return On success, it returns TTY_OK, otherwise, a TTY_ERROR code.
+        */
+        TTY_RESPONSE flush();
+
+        /** \brief Reads sections in bulk instead of one byte at a time. readSection() then reads as much as is available, and
+            keeps what arrived after the stop byte for the next read() or readSection(). Only enable it when the port is read
+            with this class alone: kept bytes are not seen by ::read(), select() or FIONREAD on getPortFD(), and are only
+            discarded by flush(), not tcflush.
+            \param enabled true to read sections in bulk, false to read them one byte at a time again, the default.
+        */
+        void setBuffered(bool enabled);
+
         /**
          * @brief setDebug Enable or Disable debug logging
          * @param enabled If true, TTY traffic will be logged.
@@ -135,8 +149,15 @@ class TTYBase
     private:
 
         TTY_RESPONSE checkTimeout(uint8_t timeout);
+        TTY_RESPONSE readBufferedSection(uint8_t *buffer, uint32_t nsize, uint8_t stop_byte, uint8_t timeout,
+                                         uint32_t *nbytes_read);
 
         int m_PortFD { -1 };
+        // Bytes readSection() read past the stop byte when buffered, returned by the next read
+        bool m_Buffered { false };
+        uint8_t m_ReadBuffer[512];
+        uint32_t m_ReadStart { 0 };
+        uint32_t m_ReadEnd { 0 };
         bool m_Debug { false };
         INDI::Logger::VerbosityLevel m_DebugChannel { INDI::Logger::DBG_IGNORE };
         const char *m_DriverName;
@@ -34,6 +34,8 @@
 #include <cstring>
 #include <assert.h>
 #include <algorithm>
+#include <string>
+#include <vector>
 
 const char *COMMUNICATION_TAB = "Communication";
 const char *MAIN_CONTROL_TAB  = "Main Control";
@@ -280,7 +282,7 @@ bool DefaultDevice::saveConfig(bool silent, const char *property)
 
     if (property == nullptr)
     {
-        fp = IUGetConfigFP(nullptr, getDeviceName(), "w", errmsg);
+        fp = IUGetConfigWriteFP(nullptr, getDeviceName(), errmsg);
 
         if (fp == nullptr)
         {
@@ -295,8 +297,12 @@ bool DefaultDevice::saveConfig(bool silent, const char *property)
 
         IUSaveConfigTag(fp, 1, getDeviceName(), silent ? 1 : 0);
 
-        fflush(fp);
-        fclose(fp);
+        if (IUCommitConfig(fp, nullptr, getDeviceName(), errmsg) != 0)
+        {
+            if (!silent)
+                LOGF_WARN("Failed to save configuration. %s", errmsg);
+            return false;
+        }
 
         if (d->isDefaultConfigLoaded == false)
         {
@@ -307,128 +313,68 @@ bool DefaultDevice::saveConfig(bool silent, const char *property)
     }
     else
     {
-        fp = IUGetConfigFP(nullptr, getDeviceName(), "r", errmsg);
-
-        if (fp == nullptr)
-        {
-            //if (!silent)
-            //   LOGF_ERROR("Error saving configuration. %s", errmsg);
-            //return false;
-            // If we don't have an existing file pointer, save all properties.
-            return saveConfig(silent);
-        }
-
-        LilXML *lp   = newLilXML();
-        XMLEle *root = readXMLFile(fp, lp, errmsg);
+        INDI::Property oneProperty = getProperty(property);
+        std::vector<char *> names;
+        std::vector<std::string> values;
+        const char *tag = nullptr;
 
-        fclose(fp);
-        delLilXML(lp);
-
-        if (root == nullptr)
-            return false;
-
-        XMLEle *ep         = nullptr;
-        bool propertySaved = false;
-
-        for (ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
+        switch (oneProperty.getType())
         {
-            const char *elemName = findXMLAttValu(ep, "name");
-            const char *tagName  = tagXMLEle(ep);
-
-            if (strcmp(elemName, property))
-                continue;
-
-            if (!strcmp(tagName, "newSwitchVector"))
+            case INDI_SWITCH:
             {
-                auto svp = getSwitch(elemName);
-                if (!svp)
+                INDI::PropertySwitch svp = oneProperty;
+                tag = "newSwitchVector";
+                for (auto &oneSwitch : svp)
                 {
-                    delXMLEle(root);
-                    return false;
+                    names.push_back(const_cast<char *>(oneSwitch.getName()));
+                    values.push_back(std::string("      ") + oneSwitch.getStateAsString() + "\n");
                 }
-
-                XMLEle *sw = nullptr;
-                for (sw = nextXMLEle(ep, 1); sw != nullptr; sw = nextXMLEle(ep, 0))
-                {
-                    auto oneSwitch = svp.findWidgetByName(findXMLAttValu(sw, "name"));
-                    if (!oneSwitch)
-                    {
-                        delXMLEle(root);
-                        return false;
-                    }
-                    char formatString[MAXRBUF];
-                    snprintf(formatString, MAXRBUF, "      %s\n", oneSwitch->getStateAsString());
-                    editXMLEle(sw, formatString);
-                }
-
-                propertySaved = true;
                 break;
             }
-            else if (!strcmp(tagName, "newNumberVector"))
+            case INDI_NUMBER:
             {
-                auto nvp = getNumber(elemName);
-                if (!nvp)
-                {
-                    delXMLEle(root);
-                    return false;
-                }
-
-                XMLEle *np = nullptr;
-                for (np = nextXMLEle(ep, 1); np != nullptr; np = nextXMLEle(ep, 0))
+                INDI::PropertyNumber nvp = oneProperty;
+                tag = "newNumberVector";
+                for (auto &oneNumber : nvp)
                 {
-                    auto oneNumber = nvp.findWidgetByName(findXMLAttValu(np, "name"));
-                    if (!oneNumber)
-                        return false;
-
                     char formatString[MAXRBUF];
-                    snprintf(formatString, MAXRBUF, "      %.20g\n", oneNumber->getValue());
-                    editXMLEle(np, formatString);
+                    snprintf(formatString, MAXRBUF, "      %.20g\n", oneNumber.getValue());
+                    names.push_back(const_cast<char *>(oneNumber.getName()));
+                    values.push_back(formatString);
                 }
-
-                propertySaved = true;
                 break;
             }
-            else if (!strcmp(tagName, "newTextVector"))
+            case INDI_TEXT:
             {
-                auto tvp = getText(elemName);
-                if (!tvp)
+                INDI::PropertyText tvp = oneProperty;
+                tag = "newTextVector";
+                for (auto &oneText : tvp)
                 {
-                    delXMLEle(root);
-                    return false;
+                    names.push_back(const_cast<char *>(oneText.getName()));
+                    values.push_back(std::string("      ") + (oneText.getText() ? oneText.getText() : "") + "\n");
                 }
-
-                XMLEle *tp = nullptr;
-                for (tp = nextXMLEle(ep, 1); tp != nullptr; tp = nextXMLEle(ep, 0))
-                {
-                    auto oneText = tvp.findWidgetByName(findXMLAttValu(tp, "name"));
-                    if (!oneText)
-                        return false;
-
-                    char formatString[MAXRBUF];
-                    snprintf(formatString, MAXRBUF, "      %s\n", oneText->getText() ? oneText->getText() : "");
-                    editXMLEle(tp, formatString);
-                }
-
-                propertySaved = true;
                 break;
             }
+            default:
+                // Only switches, numbers and texts are saved on their own
+                return saveConfig(silent);
         }
 
-        if (propertySaved)
-        {
-            fp = IUGetConfigFP(nullptr, getDeviceName(), "w", errmsg);
-            prXMLEle(fp, root, 0);
-            fflush(fp);
-            fclose(fp);
-            delXMLEle(root);
-            LOGF_DEBUG("Configuration successfully saved for %s.", property);
-            return true;
-        }
-        else
+        std::vector<char *> texts;
+        for (auto &value : values)
+            texts.push_back(const_cast<char *>(value.c_str()));
+
+        // The cached configuration is updated and written out, without reading the file again
+        switch (IUUpdateConfig(nullptr, getDeviceName(), tag, property, names.data(), texts.data(), names.size(), errmsg))
         {
-            delXMLEle(root);
-            // If property does not exist, save the whole thing
-            return saveConfig(silent);
+            case 0:
+                LOGF_DEBUG("Configuration successfully saved for %s.", property);
+                return true;
+            case 1:
+                // If the file or the property does not exist yet, save the whole thing
+                return saveConfig(silent);
+            default:
+                return false;
         }
     }
 
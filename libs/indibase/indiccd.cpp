@@ -53,7 +53,6 @@
 #include <iterator>
 #include <variant>
 
-#include <dirent.h>
 #include <cerrno>
 #include <cstdlib>
 #include <zlib.h>
@@ -124,10 +123,34 @@ CCD::CCD() : GI(this)
 
     exposureStartTime[0] = 0;
     exposureDuration = 0.0;
+
+    // Clients learn about a saved file once it is on disk
+    m_FileWriter.setCompletionHandler([this](const std::string & path, int error)
+    {
+        if (error != 0)
+        {
+            LOGF_ERROR("Unable to save image file (%s). %s", path.c_str(), strerror(error));
+            return;
+        }
+
+        FileNameTP[0].setText(path);
+        LOGF_INFO("Image saved to %s", path.c_str());
+        FileNameTP.setState(IPS_OK);
+        FileNameTP.apply();
+    });
+
+    // Encode, save and upload frames off the exposure thread
+    m_Pipeline.reset(new CCDPipeline([this](CCDPipeline::Frame & frame)
+    {
+        processFrame(frame);
+    }));
 }
 
 CCD::~CCD()
 {
+    // Stop processing frames before anything they use goes away
+    m_Pipeline.reset();
+
     // Only update if index is different.
     if (m_ConfigFastExposureIndex != FastExposureToggleSP.findOnSwitchIndex())
         saveConfig(FastExposureToggleSP);
@@ -239,6 +262,15 @@ bool CCD::initProperties()
     PrimaryCCD.FitsBP.fill(getDeviceName(), "CCD1", "Image Data", IMAGE_INFO_TAB,
                            IP_RO, 60, IPS_IDLE);
 
+    // Primary CCD Frame Statistics
+    PrimaryCCD.StatisticsNP[CCDChip::STATISTICS_MIN].fill("MIN", "Minimum", "%.f", 0, 0, 0, 0);
+    PrimaryCCD.StatisticsNP[CCDChip::STATISTICS_MAX].fill("MAX", "Maximum", "%.f", 0, 0, 0, 0);
+    PrimaryCCD.StatisticsNP[CCDChip::STATISTICS_MEAN].fill("MEAN", "Mean", "%.2f", 0, 0, 0, 0);
+    PrimaryCCD.StatisticsNP[CCDChip::STATISTICS_STDDEV].fill("STDDEV", "Std. Deviation", "%.2f", 0, 0, 0, 0);
+    PrimaryCCD.StatisticsNP[CCDChip::STATISTICS_MEDIAN].fill("MEDIAN", "Median", "%.f", 0, 0, 0, 0);
+    PrimaryCCD.StatisticsNP.fill(getDeviceName(), "CCD_STATISTICS", "Statistics", IMAGE_INFO_TAB,
+                                 IP_RO, 60, IPS_IDLE);
+
     // Bayer
     // @INDI_STANDARD_PROPERTY@
     BayerTP[CFA_OFFSET_X].fill("CFA_OFFSET_X", "X Offset", "0");
@@ -319,6 +351,14 @@ bool CCD::initProperties()
     GuideCCD.AbortExposureSP.fill(getDeviceName(), "GUIDER_ABORT_EXPOSURE",
                                   "Abort", MAIN_CONTROL_TAB, IP_RW, ISR_ATMOST1, 60, IPS_IDLE);
 
+    GuideCCD.StatisticsNP[CCDChip::STATISTICS_MIN].fill("MIN", "Minimum", "%.f", 0, 0, 0, 0);
+    GuideCCD.StatisticsNP[CCDChip::STATISTICS_MAX].fill("MAX", "Maximum", "%.f", 0, 0, 0, 0);
+    GuideCCD.StatisticsNP[CCDChip::STATISTICS_MEAN].fill("MEAN", "Mean", "%.2f", 0, 0, 0, 0);
+    GuideCCD.StatisticsNP[CCDChip::STATISTICS_STDDEV].fill("STDDEV", "Std. Deviation", "%.2f", 0, 0, 0, 0);
+    GuideCCD.StatisticsNP[CCDChip::STATISTICS_MEDIAN].fill("MEDIAN", "Median", "%.f", 0, 0, 0, 0);
+    GuideCCD.StatisticsNP.fill(getDeviceName(), "GUIDER_STATISTICS", "Statistics", IMAGE_INFO_TAB,
+                               IP_RO, 60, IPS_IDLE);
+
     GuideCCD.CompressSP[INDI_ENABLED].fill("INDI_ENABLED", "Enabled", ISS_OFF);
     GuideCCD.CompressSP[INDI_DISABLED].fill("INDI_DISABLED", "Disabled", ISS_ON);
     GuideCCD.CompressSP.fill(getDeviceName(), "GUIDER_COMPRESSION", "Compression",
@@ -455,6 +495,12 @@ bool CCD::initProperties()
     FastExposureCountNP.fill(getDeviceName(), "CCD_FAST_COUNT", "Fast Count",
                              OPTIONS_TAB, IP_RW, 0, IPS_IDLE);
 
+    // Image pipeline
+    PipelineNP[PIPELINE_QUEUED].fill("QUEUED", "Queued", "%.f", 0, 100, 1, 0);
+    PipelineNP[PIPELINE_DROPPED].fill("DROPPED", "Dropped", "%.f", 0, 1e9, 1, 0);
+    PipelineNP[PIPELINE_STALLED].fill("STALLED", "Stalled", "%.f", 0, 1e9, 1, 0);
+    PipelineNP.fill(getDeviceName(), "CCD_PIPELINE", "Pipeline", OPTIONS_TAB, IP_RO, 60, IPS_IDLE);
+
     /**********************************************/
     /**************** Snooping ********************/
     /**********************************************/
@@ -584,10 +630,12 @@ bool CCD::updateProperties()
         }
         defineProperty(PrimaryCCD.CompressSP);
         defineProperty(PrimaryCCD.FitsBP);
+        defineProperty(PrimaryCCD.StatisticsNP);
         if (HasGuideHead())
         {
             defineProperty(GuideCCD.CompressSP);
             defineProperty(GuideCCD.FitsBP);
+            defineProperty(GuideCCD.StatisticsNP);
         }
         if (HasST4Port())
         {
@@ -629,6 +677,7 @@ bool CCD::updateProperties()
 
         defineProperty(FastExposureToggleSP);
         defineProperty(FastExposureCountNP);
+        defineProperty(PipelineNP);
     }
     else
     {
@@ -648,6 +697,7 @@ bool CCD::updateProperties()
         if (CanAbort())
             deleteProperty(PrimaryCCD.AbortExposureSP);
         deleteProperty(PrimaryCCD.FitsBP);
+        deleteProperty(PrimaryCCD.StatisticsNP);
         deleteProperty(PrimaryCCD.CompressSP);
 
 #if 0
@@ -670,6 +720,7 @@ bool CCD::updateProperties()
             deleteProperty(GuideCCD.ImagePixelSizeNP);
 
             deleteProperty(GuideCCD.FitsBP);
+            deleteProperty(GuideCCD.StatisticsNP);
             if (CanBin())
                 deleteProperty(GuideCCD.ImageBinNP);
             deleteProperty(GuideCCD.CompressSP);
@@ -708,6 +759,7 @@ bool CCD::updateProperties()
 
         deleteProperty(FastExposureToggleSP);
         deleteProperty(FastExposureCountNP);
+        deleteProperty(PipelineNP);
     }
 
     // Streamer
@@ -1099,6 +1151,8 @@ bool CCD::ISNewText(const char * dev, const char * name, char * texts[], char *
         if (UploadSettingsTP.isNameMatch(name))
         {
             UploadSettingsTP.update(texts, names, n);
+            // Look at the directory again, its files may have changed meanwhile
+            m_FileIndex.reset();
             UploadSettingsTP.setState(IPS_OK);
             UploadSettingsTP.apply();
             return true;
@@ -2108,13 +2162,14 @@ void CCD::addFITSKeywords(CCDChip * targetChip, std::vector<FITSRecord> &fitsKey
     }
 
 #ifdef WITH_MINMAX
-    if (targetChip->getNAxis() == 2)
+    // Computed along with the frame, see CCDChip::computeStatistics
+    if (targetChip->getNAxis() == 2 && targetChip->getStatistics().count > 0)
     {
-        double min_val, max_val;
-        getMinMax(&min_val, &max_val, targetChip);
+        const auto &stats = targetChip->getStatistics();
 
-        fitsKeywords.push_back({"DATAMIN", min_val, 6, "Minimum value"});
-        fitsKeywords.push_back({"DATAMAX", max_val, 6, "Maximum value"});
+        fitsKeywords.push_back({"DATAMIN", stats.min, 6, "Minimum value"});
+        fitsKeywords.push_back({"DATAMAX", stats.max, 6, "Maximum value"});
+        fitsKeywords.push_back({"MEAN", stats.mean, 6, "Mean value"});
     }
 #endif
 
@@ -2326,8 +2381,11 @@ bool CCD::ExposureComplete(CCDChip * targetChip)
     // Reset POLLMS to default value
     setCurrentPollingPeriod(getPollingPeriod());
 
+    // Frames are encoded and uploaded in completion order, whatever order the threads below run in
+    uint64_t ticket = m_Pipeline->reserve();
+
     // Run async
-    std::thread(&CCD::ExposureCompletePrivate, this, targetChip).detach();
+    std::thread(&CCD::ExposureCompletePrivate, this, targetChip, ticket).detach();
 
     return true;
 }
@@ -2335,7 +2393,7 @@ bool CCD::ExposureComplete(CCDChip * targetChip)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
+bool CCD::ExposureCompletePrivate(CCDChip * targetChip, uint64_t ticket)
 {
     LOG_DEBUG("Exposure complete");
 
@@ -2352,9 +2410,6 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
         free(buf);
     }
 
-    if (processFastExposure(targetChip) == false)
-        return false;
-
     bool sendImage = (UploadSP[UPLOAD_CLIENT].getState() == ISS_ON || UploadSP[UPLOAD_BOTH].getState() == ISS_ON);
     bool saveImage = (UploadSP[UPLOAD_LOCAL].getState() == ISS_ON || UploadSP[UPLOAD_BOTH].getState() == ISS_ON);
 
@@ -2362,6 +2417,69 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
     if (targetChip->getFrameBufferSize() == 0)
         sendImage = saveImage = false;
 
+    // Rapid exposures drop frames rather than hold the camera back.
+    bool rapid = FastExposureToggleSP[INDI_ENABLED].getState() == ISS_ON && FastExposureCountNP[0].getValue() > 1;
+    auto frame = m_Pipeline->acquire(ticket, !rapid || !(sendImage || saveImage));
+    if (frame)
+    {
+        frame->chip = targetChip;
+        frame->sendImage = sendImage;
+        frame->saveImage = saveImage;
+        frame->buffer.clear();
+
+        if (sendImage || saveImage)
+        {
+            frame->width  = targetChip->getSubW() / targetChip->getBinX();
+            frame->height = targetChip->getSubH() / targetChip->getBinY();
+            frame->bpp    = targetChip->getBPP();
+            frame->naxis  = targetChip->getNAxis();
+            frame->extension = targetChip->getImageExtension();
+
+            // Copy the frame before the next exposure overwrites it
+            {
+                std::unique_lock<std::mutex> guard(ccdBufferLock);
+                frame->buffer.assign(targetChip->getFrameBuffer(), targetChip->getFrameBuffer() + targetChip->getFrameBufferSize());
+            }
+
+            // Keywords include the statistics
+            targetChip->computeStatistics(frame->buffer.data());
+            addFITSKeywords(targetChip, frame->fitsKeywords);
+        }
+    }
+    else
+    {
+        LOG_WARN("Image pipeline is full, frame dropped.");
+        updatePipelineStatus();
+    }
+
+    if (processFastExposure(targetChip) == false)
+    {
+        m_Pipeline->skip(ticket, std::move(frame));
+        return false;
+    }
+
+    if (!frame)
+    {
+        m_Pipeline->skip(ticket);
+        return false;
+    }
+
+    m_Pipeline->submit(ticket, std::move(frame));
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool CCD::processFrame(CCDPipeline::Frame &frame)
+{
+    CCDChip *targetChip = frame.chip;
+    bool sendImage = frame.sendImage;
+    bool saveImage = frame.saveImage;
+
+    updatePipelineStatus();
+    m_LastSave.reset();
+
     if (sendImage || saveImage)
     {
         if (EncodeFormatSP[FORMAT_FITS].getState() == ISS_ON)
@@ -2371,15 +2489,15 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
             int img_type  = 0;
             int byte_type = 0;
             int status    = 0;
-            long naxis    = targetChip->getNAxis();
+            long naxis    = frame.naxis;
             long naxes[3];
             int nelements = 0;
             char error_status[MAXRBUF];
 
-            naxes[0] = targetChip->getSubW() / targetChip->getBinX();
-            naxes[1] = targetChip->getSubH() / targetChip->getBinY();
+            naxes[0] = frame.width;
+            naxes[1] = frame.height;
 
-            switch (targetChip->getBPP())
+            switch (frame.bpp)
             {
                 case 8:
                     byte_type = TBYTE;
@@ -2397,7 +2515,7 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
                     break;
 
                 default:
-                    LOGF_ERROR("Unsupported bits per pixel value %d", targetChip->getBPP());
+                    LOGF_ERROR("Unsupported bits per pixel value %d", frame.bpp);
                     return false;
             }
 
@@ -2411,10 +2529,8 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
             /*DEBUGF(Logger::DBG_DEBUG, "Exposure complete. Image Depth: %s. Width: %d Height: %d nelements: %d", bit_depth.c_str(), naxes[0],
                     naxes[1], nelements);*/
 
-            std::unique_lock<std::mutex> guard(ccdBufferLock);
-
             // 8640 = 2880 * 3 which is sufficient for most cases.
-            uint32_t size = 8640 + nelements * (targetChip->getBPP() / 8);
+            uint32_t size = 8640 + nelements * (frame.bpp / 8);
             //  Initialize FITS file.
             if (targetChip->openFITSFile(size, status) == false)
             {
@@ -2437,9 +2553,7 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
                 return false;
             }
 
-            std::vector<FITSRecord> fitsKeywords;
-
-            addFITSKeywords(targetChip, fitsKeywords);
+            std::vector<FITSRecord> &fitsKeywords = frame.fitsKeywords;
 
             // Add all custom keywords next
             for (auto &record : m_CustomFITSKeywords)
@@ -2473,7 +2587,7 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
                 }
             }
 
-            fits_write_img(fptr, byte_type, 1, nelements, targetChip->getFrameBuffer(), &status);
+            fits_write_img(fptr, byte_type, 1, nelements, frame.buffer.data(), &status);
             targetChip->finishFITSFile(status);
             if (status)
             {
@@ -2490,8 +2604,6 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
 
             targetChip->closeFITSFile();
 
-            guard.unlock();
-
             if (rc == false)
             {
                 targetChip->setExposureFailed();
@@ -2501,8 +2613,7 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
 #ifdef HAVE_XISF
         else if (EncodeFormatSP[FORMAT_XISF].getState() == ISS_ON)
         {
-            std::vector<FITSRecord> fitsKeywords;
-            addFITSKeywords(targetChip, fitsKeywords);
+            std::vector<FITSRecord> &fitsKeywords = frame.fitsKeywords;
             targetChip->setImageExtension("xisf");
 
             try
@@ -2517,10 +2628,8 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
                     image.addFITSKeywordAsProperty(keyword.key().c_str(), keyword.valueString());
                 }
 
-                image.setGeometry(targetChip->getSubW() / targetChip->getBinX(),
-                                  targetChip->getSubH() / targetChip->getBinY(),
-                                  targetChip->getNAxis() == 2 ? 1 : 3);
-                switch(targetChip->getBPP())
+                image.setGeometry(frame.width, frame.height, frame.naxis == 2 ? 1 : 3);
+                switch(frame.bpp)
                 {
                     case 8:
                         image.setSampleFormat(LibXISF::Image::UInt8);
@@ -2532,7 +2641,7 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
                         image.setSampleFormat(LibXISF::Image::UInt32);
                         break;
                     default:
-                        LOGF_ERROR("Unsupported bits per pixel value %d", targetChip->getBPP());
+                        LOGF_ERROR("Unsupported bits per pixel value %d", frame.bpp);
                         return false;
                 }
 
@@ -2558,19 +2667,18 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
                         image.setCompression(LibXISF::DataBlock::ZSTD);
                     else
                         image.setCompression(LibXISF::DataBlock::LZ4);
-                    image.setByteshuffling(targetChip->getBPP() / 8);
+                    image.setByteshuffling(frame.bpp / 8);
                 }
 
                 if (HasBayer())
                     image.setColorFilterArray({2, 2, BayerTP[2].getText()});
 
-                if (targetChip->getNAxis() == 3)
+                if (frame.naxis == 3)
                 {
                     image.setColorSpace(LibXISF::Image::RGB);
                 }
 
-                std::unique_lock<std::mutex> guard(ccdBufferLock);
-                std::memcpy(image.imageData(), targetChip->getFrameBuffer(), image.imageDataSize());
+                std::memcpy(image.imageData(), frame.buffer.data(), image.imageDataSize());
                 xisfWriter.writeImage(image);
 
                 LibXISF::ByteArray xisfFile;
@@ -2592,12 +2700,8 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
         else
         {
             // If image extension was set to fits (default), change if bin if not already set to another format by the driver.
-            if (!strcmp(targetChip->getImageExtension(), "fits"))
-                targetChip->setImageExtension("bin");
-            std::unique_lock<std::mutex> guard(ccdBufferLock);
-            bool rc = uploadFile(targetChip, targetChip->getFrameBuffer(), targetChip->getFrameBufferSize(), sendImage,
-                                 saveImage);
-            guard.unlock();
+            targetChip->setImageExtension(frame.extension == "fits" ? "bin" : frame.extension.c_str());
+            bool rc = uploadFile(targetChip, frame.buffer.data(), frame.buffer.size(), sendImage, saveImage);
 
             if (rc == false)
             {
@@ -2607,13 +2711,38 @@ bool CCD::ExposureCompletePrivate(CCDChip * targetChip)
         }
     }
 
-    if (FastExposureToggleSP[INDI_ENABLED].getState() != ISS_ON)
-        targetChip->setExposureComplete();
+    // A file that could not be written fails the exposure, now or once the writer thread finds out
+    {
+        std::lock_guard<std::mutex> lock(m_SaveLock);
+        bool saveFailed = m_LastSave && m_LastSave->error != 0;
+        if (m_LastSave)
+            m_LastSave->reported = true;
+
+        if (saveFailed)
+            targetChip->setExposureFailed();
+        else if (FastExposureToggleSP[INDI_ENABLED].getState() != ISS_ON)
+            targetChip->setExposureComplete();
+    }
 
     UploadComplete(targetChip);
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void CCD::updatePipelineStatus()
+{
+    auto queued = m_Pipeline->pending();
+    auto dropped = m_Pipeline->dropped();
+
+    PipelineNP[PIPELINE_QUEUED].setValue(queued);
+    PipelineNP[PIPELINE_DROPPED].setValue(dropped);
+    PipelineNP[PIPELINE_STALLED].setValue(m_Pipeline->stalled());
+    PipelineNP.setState(dropped > 0 ? IPS_ALERT : (queued > 1 ? IPS_BUSY : IPS_OK));
+    PipelineNP.apply();
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2631,69 +2760,55 @@ bool CCD::uploadFile(CCDChip * targetChip, const void * fitsData, size_t totalBy
         targetChip->FitsBP[0].setBlobLen(totalBytes);
         std::string format = "." + std::string(targetChip->getImageExtension());
         targetChip->FitsBP[0].setFormat(format);
-        FILE * fp = nullptr;
 
         std::string prefix = UploadSettingsTP[UPLOAD_PREFIX].getText();
         std::string directory = UploadSettingsTP[UPLOAD_DIR].getText();
 
+        auto now = std::chrono::system_clock::now();
+        std::time_t time = std::chrono::system_clock::to_time_t(now);
+        std::tm* now_tm = std::localtime(&time);
+        long long timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
 
-        int maxIndex       = getFileIndex(directory, prefix,
-                                          targetChip->FitsBP[0].getFormat());
-
-        if (maxIndex < 0)
-        {
-            LOGF_ERROR("Error iterating directory %s. %s", UploadSettingsTP[UPLOAD_DIR].getText(),
-                       strerror(errno));
-            return false;
-        }
+        std::stringstream stream;
+        // JM 2023.08.31 Make timestamps OS friendly (Windows)
+        stream    << std::setfill('0')
+                  << std::put_time(now_tm, "%FT%H-%M-")
+                  << std::setw(2) << (timestamp / 1000) % 60 << '.'
+                  << std::setw(3) << timestamp % 1000;
 
-        if (maxIndex > 0)
+        // Skip names taken behind our back since the directory was scanned
+        std::string imageFileName;
+        struct stat st;
+        do
         {
-            auto now = std::chrono::system_clock::now();
-            std::time_t time = std::chrono::system_clock::to_time_t(now);
-            std::tm* now_tm = std::localtime(&time);
-            long long timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
-
-            std::stringstream stream;
-            // JM 2023.08.31 Make timestamps OS friendly (Windows)
-            stream    << std::setfill('0')
-                      << std::put_time(now_tm, "%FT%H-%M-")
-                      << std::setw(2) << (timestamp / 1000) % 60 << '.'
-                      << std::setw(3) << timestamp % 1000;
-
-            prefix = std::regex_replace(prefix, std::regex("ISO8601"), stream.str());
+            int maxIndex = getFileIndex(directory, prefix, targetChip->FitsBP[0].getFormat());
+            if (maxIndex < 0)
+            {
+                LOGF_ERROR("Error iterating directory %s. %s", UploadSettingsTP[UPLOAD_DIR].getText(),
+                           strerror(errno));
+                return false;
+            }
 
-            char indexString[8];
-            snprintf(indexString, 8, "%03d", maxIndex);
-            std::string prefixIndex = indexString;
-            //prefix.replace(prefix.find("XXX"), std::string::npos, prefixIndex);
-            prefix = std::regex_replace(prefix, std::regex("XXX"), prefixIndex);
+            imageFileName = directory + "/" + FileIndex::expand(prefix, stream.str(), maxIndex) +
+                            std::string(targetChip->FitsBP[0].getFormat());
         }
+        while (stat(imageFileName.c_str(), &st) == 0 && prefix.find("XXX") != std::string::npos);
 
-        std::string imageFileName = std::string(UploadSettingsTP[UPLOAD_DIR].getText()) + "/" + prefix + std::string(
-                                        targetChip->FitsBP[0].getFormat());
-
-        fp = fopen(imageFileName.c_str(), "w");
-        if (fp == nullptr)
+        // The file writer thread saves the file and updates its path
+        auto result = std::make_shared<SaveResult>();
+        result->chip = targetChip;
+        m_LastSave = result;
+        m_FileWriter.write(imageFileName, targetChip->FitsBP[0].getBlob(), targetChip->FitsBP[0].getBlobLen(),
+                           [this, result](int error)
         {
-            LOGF_ERROR("Unable to save image file (%s). %s", imageFileName.c_str(), strerror(errno));
-            return false;
-        }
+            if (error == 0)
+                return;
 
-        int n = 0;
-        auto len = targetChip->FitsBP[0].getBlobLen();
-        auto buffer = static_cast<char *>(targetChip->FitsBP[0].getBlob());
-        for (int nr = 0; nr < len; nr += n)
-            n = fwrite(buffer + nr, 1, len - nr, fp);
-
-        fclose(fp);
-
-        // Save image file path
-        FileNameTP[0].setText(imageFileName);
-
-        LOGF_INFO("Image saved to %s", imageFileName.c_str());
-        FileNameTP.setState(IPS_OK);
-        FileNameTP.apply();
+            std::lock_guard<std::mutex> lock(m_SaveLock);
+            result->error = error;
+            if (result->reported)
+                result->chip->setExposureFailed();
+        });
     }
 
     if (targetChip->SendCompressed && EncodeFormatSP[FORMAT_XISF].getState() != ISS_ON)
@@ -2704,8 +2819,8 @@ bool CCD::uploadFile(CCDChip * targetChip, const void * fitsData, size_t totalBy
             fp_init (&fpvar);
             size_t compressedBytes = 0;
             int islossless = 0;
-            if (fp_pack_data_to_data(reinterpret_cast<const char *>(fitsData), totalBytes, &compressedData, &compressedBytes, fpvar,
-                                     &islossless) < 0)
+            if (fp_pack_data_to_data(reinterpret_cast<const char *>(fitsData), totalBytes, &compressedData, &compressedBytes,
+                                     fpvar, &islossless) < 0)
             {
                 free(compressedData);
                 LOG_ERROR("Error: Ran out of memory compressing image");
@@ -2720,12 +2835,11 @@ bool CCD::uploadFile(CCDChip * targetChip, const void * fitsData, size_t totalBy
         else
         {
             uLong compressedBytes = sizeof(char) * totalBytes + totalBytes / 64 + 16 + 3;
-            compressedData  = new uint8_t[compressedBytes];
+            compressedData  = static_cast<uint8_t *>(malloc(compressedBytes));
 
             if (fitsData == nullptr || compressedData == nullptr)
             {
-                if (compressedData)
-                    delete [] compressedData;
+                free(compressedData);
                 LOG_ERROR("Error: Ran out of memory compressing image");
                 return false;
             }
@@ -2735,7 +2849,7 @@ bool CCD::uploadFile(CCDChip * targetChip, const void * fitsData, size_t totalBy
             {
                 /* this should NEVER happen */
                 LOG_ERROR("Error: Failed to compress image");
-                delete [] compressedData;
+                free(compressedData);
                 return false;
             }
 
@@ -2766,8 +2880,8 @@ bool CCD::uploadFile(CCDChip * targetChip, const void * fitsData, size_t totalBy
         LOGF_DEBUG("BLOB transfer took %g seconds", diff.count());
     }
 
-    if (compressedData)
-        delete [] compressedData;
+    // Both compressors allocate with malloc
+    free(compressedData);
 
     DEBUG(Logger::DBG_DEBUG, "Upload complete");
 
@@ -2966,76 +3080,10 @@ IPState CCD::GuideWest(uint32_t ms)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void CCD::getMinMax(double * min, double * max, CCDChip * targetChip)
 {
-    int ind         = 0, i, j;
-    int imageHeight = targetChip->getSubH() / targetChip->getBinY();
-    int imageWidth  = targetChip->getSubW() / targetChip->getBinX();
-    double lmin = 0, lmax = 0;
-
-    switch (targetChip->getBPP())
-    {
-        case 8:
-        {
-            uint8_t * imageBuffer = targetChip->getFrameBuffer();
-            lmin = lmax = imageBuffer[0];
-
-            for (i = 0; i < imageHeight; i++)
-                for (j = 0; j < imageWidth; j++)
-                {
-                    ind = (i * imageWidth) + j;
-                    if (imageBuffer[ind] < lmin)
-                        lmin = imageBuffer[ind];
-                    else if (imageBuffer[ind] > lmax)
-                        lmax = imageBuffer[ind];
-                }
-        }
-        break;
-
-        case 16:
-        {
-            uint16_t * imageBuffer = reinterpret_cast<uint16_t*>(targetChip->getFrameBuffer());
-            lmin = lmax = imageBuffer[0];
-
-            for (i = 0; i < imageHeight; i++)
-                for (j = 0; j < imageWidth; j++)
-                {
-                    ind = (i * imageWidth) + j;
-                    if (imageBuffer[ind] < lmin)
-                        lmin = imageBuffer[ind];
-                    else if (imageBuffer[ind] > lmax)
-                        lmax = imageBuffer[ind];
-                }
-        }
-        break;
-
-        case 32:
-        {
-            uint32_t * imageBuffer = reinterpret_cast<uint32_t*>(targetChip->getFrameBuffer());
-            lmin = lmax = imageBuffer[0];
-
-            for (i = 0; i < imageHeight; i++)
-                for (j = 0; j < imageWidth; j++)
-                {
-                    ind = (i * imageWidth) + j;
-                    if (imageBuffer[ind] < lmin)
-                        lmin = imageBuffer[ind];
-                    else if (imageBuffer[ind] > lmax)
-                        lmax = imageBuffer[ind];
-                }
-        }
-        break;
-    }
-    *min = lmin;
-    *max = lmax;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-std::string regex_replace_compat(const std::string &input, const std::string &pattern, const std::string &replace)
-{
-    std::stringstream s;
-    std::regex_replace(std::ostreambuf_iterator<char>(s), input.begin(), input.end(), std::regex(pattern), replace);
-    return s.str();
+    auto stats = FrameStatistics::compute(targetChip->getFrameBuffer(), FrameStatistics::typeFromBPP(targetChip->getBPP()),
+                                          (targetChip->getSubW() / targetChip->getBinX()) * (targetChip->getSubH() / targetChip->getBinY()));
+    *min = stats.min;
+    *max = stats.max;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3045,18 +3093,10 @@ int CCD::getFileIndex(const std::string &dir, const std::string &prefix, const s
 {
     INDI_UNUSED(ext);
 
-    DIR * dpdf = nullptr;
-    struct dirent * epdf = nullptr;
-    std::vector<std::string> files = std::vector<std::string>();
-
-    std::string prefixIndex = prefix;
-    prefixIndex             = regex_replace_compat(prefixIndex, "_ISO8601", "");
-    prefixIndex             = regex_replace_compat(prefixIndex, "_XXX", "");
-
-    // Create directory if does not exist
+    // Create directory if does not exist, the first time it is used
     struct stat st;
 
-    if (stat(dir.c_str(), &st) == -1)
+    if (!m_FileIndex.contains(dir, prefix) && stat(dir.c_str(), &st) == -1)
     {
         if (errno == ENOENT)
         {
@@ -3071,39 +3111,7 @@ int CCD::getFileIndex(const std::string &dir, const std::string &prefix, const s
         }
     }
 
-    dpdf = opendir(dir.c_str());
-    if (dpdf != nullptr)
-    {
-        while ((epdf = readdir(dpdf)))
-        {
-            if (strstr(epdf->d_name, prefixIndex.c_str()))
-                files.push_back(epdf->d_name);
-        }
-    }
-    else
-    {
-        closedir(dpdf);
-        return -1;
-    }
-    int maxIndex = 0;
-
-    for (uint32_t i = 0; i < files.size(); i++)
-    {
-        int index = -1;
-
-        std::string file  = files.at(i);
-        std::size_t start = file.find_last_of("_");
-        std::size_t end   = file.find_last_of(".");
-        if (start != std::string::npos)
-        {
-            index = atoi(file.substr(start + 1, end).c_str());
-            if (index > maxIndex)
-                maxIndex = index;
-        }
-    }
-
-    closedir(dpdf);
-    return (maxIndex + 1);
+    return m_FileIndex.next(dir, prefix);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
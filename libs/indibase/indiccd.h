@@ -27,6 +27,9 @@
 #pragma once
 
 #include "indiccdchip.h"
+#include "indiccdpipeline.h"
+#include "indifileindex.h"
+#include "indifilewriter.h"
 #include "defaultdevice.h"
 #include "indiguiderinterface.h"
 #include "indipropertynumber.h"
@@ -734,6 +737,15 @@ class CCD : public DefaultDevice, GuiderInterface
         double m_UploadTime = { 0 };
         std::chrono::system_clock::time_point FastExposureToggleStartup;
 
+        // Frames waiting to be encoded and uploaded, and frames lost or delayed because too many were waiting
+        INDI::PropertyNumber PipelineNP {3};
+        enum
+        {
+            PIPELINE_QUEUED,
+            PIPELINE_DROPPED,
+            PIPELINE_STALLED
+        };
+
         INDI::PropertyText FITSHeaderTP {3};
         enum
         {
@@ -752,13 +764,31 @@ class CCD : public DefaultDevice, GuiderInterface
 
         std::map<std::string, FITSRecord> m_CustomFITSKeywords;
 
+        // Whether the file saved for the frame being processed was written, reported with its exposure
+        struct SaveResult
+        {
+            CCDChip *chip {nullptr};
+            int error {0};
+            bool reported {false};
+        };
+        std::mutex m_SaveLock;
+        std::shared_ptr<SaveResult> m_LastSave;
+
+        // Index of the next file in each upload directory, and the thread saving the files
+        FileIndex m_FileIndex;
+        FileWriter m_FileWriter;
+
+        std::unique_ptr<CCDPipeline> m_Pipeline;
+
         ///////////////////////////////////////////////////////////////////////////////
         /// Utility Functions
         ///////////////////////////////////////////////////////////////////////////////
         bool uploadFile(CCDChip * targetChip, const void * fitsData, size_t totalBytes, bool sendImage, bool saveImage);
         void getMinMax(double * min, double * max, CCDChip * targetChip);
         int getFileIndex(const std::string &dir, const std::string &prefix, const std::string &ext);
-        bool ExposureCompletePrivate(CCDChip * targetChip);
+        bool ExposureCompletePrivate(CCDChip * targetChip, uint64_t ticket);
+        bool processFrame(CCDPipeline::Frame &frame);
+        void updatePipelineStatus();
 
         /////////////////////////////////////////////////////////////////////////////
         /// Misc.
@@ -24,6 +24,8 @@
 #include "indipropertyblob.h"
 
 #include "indipropertynumber.h"
+#include "indiframestatistics.h"
+#include "indiframebinning.h"
 
 #include <sys/time.h>
 #include <stdint.h>
@@ -44,6 +46,7 @@ class CCDChip
         typedef enum { LIGHT_FRAME = 0, BIAS_FRAME, DARK_FRAME, FLAT_FRAME } CCD_FRAME;
         typedef enum { FRAME_X, FRAME_Y, FRAME_W, FRAME_H } CCD_FRAME_INDEX;
         typedef enum { BIN_W, BIN_H } CCD_BIN_INDEX;
+        typedef enum { BINNING_SUM, BINNING_AVERAGE } CCD_BINNING_MODE;
         typedef enum
         {
             CCD_MAX_X,
@@ -293,6 +296,16 @@ class CCDChip
          */
         void setBin(uint8_t hor, uint8_t ver);
 
+        /**
+         * @brief setBinningMode Set how binFrame() and binBayerFrame() combine pixels.
+         * @param mode BINNING_SUM (default) to add the binned pixels, saturated to the pixel depth, BINNING_AVERAGE to
+         * average them, which keeps 8 bit frames from saturating.
+         */
+        void setBinningMode(CCD_BINNING_MODE mode)
+        {
+            BinningMode = mode;
+        }
+
         /**
          * @brief setMinMaxStep for a number property element
          * @param property Property name
@@ -406,17 +419,35 @@ class CCDChip
         }
 
         /**
-         * @brief binFrame Perform software binning on the CCD frame. Only use this function if hardware
+         * @brief binFrame Perform software binning on the CCD frame, BinX by BinY pixels. Only use this function if hardware
          * binning is not supported.
+         * @see setBinningMode
          */
         void binFrame();
 
         /**
-         * @brief binBayerFrame Perform software binning on a 2x2 Bayer matrix CCD frame. Only use this function if hardware
+         * @brief binBayerFrame Perform software binning on a 2x2 Bayer matrix CCD frame. Pixels are binned with pixels of
+         * the same color, so the binned frame keeps the Bayer pattern. Only use this function if hardware
          * binning is not supported.
+         * @see setBinningMode
          */
         void binBayerFrame();
 
+        /**
+         * @brief computeStatistics Compute the statistics of a frame of this chip and publish them.
+         * @param buffer Frame with the current chip geometry and depth. The chip frame buffer if null.
+         * @return The statistics, also available from getStatistics() until the next call.
+         */
+        const FrameStatistics &computeStatistics(const uint8_t *buffer = nullptr);
+
+        /**
+         * @return Statistics of the last frame passed to computeStatistics().
+         */
+        const FrameStatistics &getStatistics() const
+        {
+            return m_Statistics;
+        }
+
         fitsfile **fitsFilePointer()
         {
             return &m_FITSFilePointer;
@@ -433,6 +464,9 @@ class CCDChip
         }
 
     private:
+        // Bin RawFrame into BinFrame and swap them, shared by binFrame() and binBayerFrame()
+        void softwareBin(bool bayer);
+
         /////////////////////////////////////////////////////////////////////////////////////////
         /// Chip Variables
         /////////////////////////////////////////////////////////////////////////////////////////
@@ -468,6 +502,8 @@ class CCDChip
         uint32_t RawFrameSize {0};
         // BINNED Frame when software binning is used.
         uint8_t *BinFrame {nullptr};
+        // Software binning mode
+        CCD_BINNING_MODE BinningMode {BINNING_SUM};
         // Should we compress frame before transmission?
         bool SendCompressed {false};
         // Frame Type
@@ -481,6 +517,7 @@ class CCDChip
         void * m_FITSMemoryBlock {nullptr};
         size_t m_FITSMemorySize {2880};
         fitsfile * m_FITSFilePointer {nullptr};
+        FrameStatistics m_Statistics;
 
         /////////////////////////////////////////////////////////////////////////////////////////
         /// Chip Properties
@@ -534,6 +571,19 @@ class CCDChip
         /////////////////////////////////////////////////////////////////////////////////////////
         INDI::PropertySwitch ResetSP{1};
 
+        /////////////////////////////////////////////////////////////////////////////////////////
+        /// Frame Statistics
+        /////////////////////////////////////////////////////////////////////////////////////////
+        INDI::PropertyNumber StatisticsNP {5};
+        enum
+        {
+            STATISTICS_MIN,
+            STATISTICS_MAX,
+            STATISTICS_MEAN,
+            STATISTICS_STDDEV,
+            STATISTICS_MEDIAN
+        };
+
         friend class CCD;
         friend class StreamRecoder;
 
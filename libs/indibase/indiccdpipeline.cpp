@@ -0,0 +1,168 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#include "indiccdpipeline.h"
+
+namespace INDI
+{
+
+CCDPipeline::CCDPipeline(const std::function<void(Frame &frame)> &process, size_t depth)
+    : m_Process(process), m_Depth(depth)
+{
+    m_Worker = std::thread(&CCDPipeline::run, this);
+}
+
+CCDPipeline::~CCDPipeline()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_Lock);
+        m_Quit = true;
+        m_Queued.notify_all();
+        m_Released.notify_all();
+    }
+    m_Worker.join();
+}
+
+uint64_t CCDPipeline::reserve()
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    return m_NextTicket++;
+}
+
+bool CCDPipeline::available(uint64_t ticket) const
+{
+    // Frames of tickets before this one are queued, or the one being processed
+    return ticket + (m_Processing ? 1 : 0) < m_NextToProcess + m_Depth;
+}
+
+std::unique_ptr<CCDPipeline::Frame> CCDPipeline::acquire(uint64_t ticket, bool wait)
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    if (!available(ticket))
+    {
+        if (!wait)
+        {
+            m_Dropped++;
+            return nullptr;
+        }
+
+        m_Stalled++;
+        m_Released.wait(lock, [this, ticket]()
+        {
+            return available(ticket) || m_Quit;
+        });
+        if (m_Quit)
+            return nullptr;
+    }
+
+    m_InFlight++;
+    if (m_FreeFrames.empty())
+        return std::unique_ptr<Frame>(new Frame());
+
+    auto frame = std::move(m_FreeFrames.back());
+    m_FreeFrames.pop_back();
+    return frame;
+}
+
+void CCDPipeline::submit(uint64_t ticket, std::unique_ptr<Frame> frame)
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    m_Queue[ticket] = std::move(frame);
+    m_Queued.notify_one();
+}
+
+void CCDPipeline::skip(uint64_t ticket, std::unique_ptr<Frame> frame)
+{
+    if (frame)
+        release(std::move(frame));
+    submit(ticket, nullptr);
+}
+
+void CCDPipeline::release(std::unique_ptr<Frame> frame)
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    recycle(std::move(frame));
+}
+
+void CCDPipeline::recycle(std::unique_ptr<Frame> frame)
+{
+    // Keep the buffer allocated for the next frame
+    frame->chip = nullptr;
+    frame->fitsKeywords.clear();
+
+    m_FreeFrames.push_back(std::move(frame));
+    m_InFlight--;
+}
+
+size_t CCDPipeline::pending() const
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    return m_InFlight;
+}
+
+uint64_t CCDPipeline::dropped() const
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    return m_Dropped;
+}
+
+uint64_t CCDPipeline::stalled() const
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    return m_Stalled;
+}
+
+void CCDPipeline::run()
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    for (;;)
+    {
+        m_Queued.wait(lock, [this]()
+        {
+            return m_Quit || m_Queue.count(m_NextToProcess) > 0;
+        });
+        // On quit, frames already queued in order are still processed
+        if (m_Queue.count(m_NextToProcess) == 0)
+        {
+            m_Dropped += m_Queue.size();
+            break;
+        }
+
+        auto frame = std::move(m_Queue[m_NextToProcess]);
+        m_Queue.erase(m_NextToProcess);
+        m_NextToProcess++;
+
+        // Skipped ticket
+        if (!frame)
+        {
+            m_Released.notify_all();
+            continue;
+        }
+
+        m_Processing = true;
+        lock.unlock();
+        m_Process(*frame);
+        lock.lock();
+        recycle(std::move(frame));
+        m_Processing = false;
+        // Waiting tickets each check their own place
+        m_Released.notify_all();
+    }
+}
+
+}
@@ -0,0 +1,121 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#pragma once
+
+#include "fitskeyword.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace INDI
+{
+
+class CCDChip;
+
+/**
+ * @brief The CCDPipeline class hands finished frames over to a worker thread that serializes,
+ * compresses, saves and uploads them, so the camera can start the next exposure right away.
+ *
+ * Frames are processed in the order their tickets were reserved. At most depth frames are in
+ * flight at once, and their buffers are recycled from one frame to the next.
+ */
+class CCDPipeline
+{
+    public:
+        /** @brief A snapshot of a chip frame, with everything needed to encode it. */
+        struct Frame
+        {
+            CCDChip *chip {nullptr};
+            std::vector<uint8_t> buffer;
+            int width {0};
+            int height {0};
+            int bpp {0};
+            int naxis {2};
+            std::string extension;
+            std::vector<FITSRecord> fitsKeywords;
+            bool sendImage {false};
+            bool saveImage {false};
+        };
+
+        CCDPipeline(const std::function<void(Frame &frame)> &process, size_t depth = 3);
+        /**
+         * @brief Process the frames already submitted, then stop the worker. Frames queued after a ticket
+         * that was not given back cannot be processed in order, they are dropped and counted as such.
+         */
+        ~CCDPipeline();
+
+        /** @brief Reserve the place of the next frame. Every ticket must be given back by submit or skip. */
+        uint64_t reserve();
+
+        /**
+         * @brief Get a free frame for a ticket.
+         * Frames go to tickets in order: a ticket gets one once no more than depth frames would be in flight
+         * up to and including it, so a later ticket cannot take the frame an earlier one is waiting for.
+         * @param ticket The ticket the frame is submitted with.
+         * @param wait When no frame is free for the ticket, wait for one if true. Otherwise, the frame is dropped.
+         * @return The frame, or nullptr when dropped.
+         */
+        std::unique_ptr<Frame> acquire(uint64_t ticket, bool wait);
+
+        /** @brief Queue the frame for processing, at the place of ticket. */
+        void submit(uint64_t ticket, std::unique_ptr<Frame> frame);
+
+        /** @brief Give back the ticket without processing anything. A frame, if any, is released. */
+        void skip(uint64_t ticket, std::unique_ptr<Frame> frame = nullptr);
+
+        /** @return Frames acquired and not processed yet. */
+        size_t pending() const;
+        /** @return Frames dropped because the pipeline was full. */
+        uint64_t dropped() const;
+        /** @return Times the camera had to wait for a free frame. */
+        uint64_t stalled() const;
+
+    private:
+        void run();
+        void release(std::unique_ptr<Frame> frame);
+        /** @brief Put the frame back with the free ones. Call with m_Lock held. */
+        void recycle(std::unique_ptr<Frame> frame);
+        bool available(uint64_t ticket) const;
+
+        std::function<void(Frame &frame)> m_Process;
+        size_t m_Depth;
+
+        mutable std::mutex m_Lock;
+        std::condition_variable m_Queued;
+        std::condition_variable m_Released;
+        std::map<uint64_t, std::unique_ptr<Frame>> m_Queue;
+        std::vector<std::unique_ptr<Frame>> m_FreeFrames;
+        uint64_t m_NextTicket {0};
+        uint64_t m_NextToProcess {0};
+        size_t m_InFlight {0};
+        bool m_Processing {false};
+        uint64_t m_Dropped {0};
+        uint64_t m_Stalled {0};
+        bool m_Quit {false};
+        std::thread m_Worker;
+};
+
+}
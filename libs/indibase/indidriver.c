@@ -30,8 +30,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301  USA
 #include "indicom.h"
 #include "indidevapi.h"
 #include "locale_compat.h"
+#include "sharedblob.h"
 
 #include <errno.h>
+#include <limits.h>
 #include <pthread.h>
 #include <stdlib.h>
 #include <stdarg.h>
@@ -451,13 +453,17 @@ int dispatch(XMLEle *root, char msg[])
                         assert_mem(sizes = (int *)realloc(sizes, maxn * sizeof *sizes));
                         assert_mem(blobsizes = (int *)realloc(blobsizes, maxn * sizeof *blobsizes));
                     }
-                    // FIXME : here decode using shared buffer
-                    int bloblen = pcdatalenXMLEle(ep);
-                    // enclen is optional and not required by INDI protocol
-                    if (el)
-                        bloblen = atoi(valuXMLAtt(el));
-                    assert_mem(blobs[n] = (char*)malloc(3 * bloblen / 4));
-                    blobsizes[n] = from64tobits_fast(blobs[n], pcdataXMLEle(ep), bloblen);
+                    // Decoded while being parsed, see clientMsgCB
+                    blobs[n] = (char *)takeBlobXMLEle(ep, &blobsizes[n]);
+                    if (blobs[n] == NULL)
+                    {
+                        int bloblen = pcdatalenXMLEle(ep);
+                        // enclen is optional and not required by INDI protocol
+                        if (el)
+                            bloblen = atoi(valuXMLAtt(el));
+                        assert_mem(blobs[n] = (char*)malloc(3 * bloblen / 4));
+                        blobsizes[n] = from64tobits_fast(blobs[n], pcdataXMLEle(ep), bloblen);
+                    }
                     names[n]     = valuXMLAtt(na);
                     formats[n]   = valuXMLAtt(fa);
                     sizes[n]     = atoi(valuXMLAtt(sa));
@@ -471,7 +477,7 @@ int dispatch(XMLEle *root, char msg[])
         {
             ISNewBLOB(dev, name, sizes, blobsizes, blobs, formats, names, n);
             for (int i = 0; i < n; i++)
-                free(blobs[i]);
+                IDSharedBlobFree(blobs[i]);
         }
         else
             IDMessage(dev, "[ERROR] %s: newBLOBVector with no valid members", name);
@@ -482,59 +488,276 @@ int dispatch(XMLEle *root, char msg[])
     return (1);
 }
 
-int IUReadConfig(const char *filename, const char *dev, const char *property, int silent, char errmsg[])
+/* Parsed configuration files.
+ * The IUGetConfig* functions and IUReadConfig look properties up in the parsed file instead of
+ * reading and parsing it on every call. A file is parsed again when it changed on disk, as told by
+ * its size, inode and modification time. Each file keeps its properties sorted by device and name.
+ */
+typedef struct
+{
+    const char *dev;
+    const char *name;
+    XMLEle *ep;
+    int order;  /* position in the file, the first of duplicate properties is used */
+} ConfigProperty;
+
+typedef struct ConfigFile
+{
+    char fileName[MAXRBUF];
+    struct stat st;         /* the file as it was parsed */
+    XMLEle *root;
+    ConfigProperty *properties;
+    int nproperties;
+    struct ConfigFile *next;
+} ConfigFile;
+
+static ConfigFile *configFiles = NULL;
+static pthread_mutex_t config_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void getConfigFileName(const char *filename, const char *dev, char configFileName[])
+{
+    if (filename)
+        snprintf(configFileName, MAXRBUF, "%s", filename);
+    else if (getenv("INDICONFIG"))
+        snprintf(configFileName, MAXRBUF, "%s", getenv("INDICONFIG"));
+    else
+        snprintf(configFileName, MAXRBUF, "%s/.indi/%s_config.xml", getenv("HOME"), dev);
+}
+
+static int configSameFile(const struct stat *a, const struct stat *b)
+{
+#if defined(__APPLE__)
+    long ansec = a->st_mtimespec.tv_nsec, bnsec = b->st_mtimespec.tv_nsec;
+#else
+    long ansec = a->st_mtim.tv_nsec, bnsec = b->st_mtim.tv_nsec;
+#endif
+    return a->st_dev == b->st_dev && a->st_ino == b->st_ino && a->st_size == b->st_size &&
+           a->st_mtime == b->st_mtime && ansec == bnsec;
+}
+
+static int configCompare(const char *dev, const char *name, int order, const ConfigProperty *property)
+{
+    int diff = strcmp(dev, property->dev);
+    if (diff == 0)
+        diff = strcmp(name, property->name);
+    if (diff == 0)
+        diff = order - property->order;
+    return diff;
+}
+
+static int configSortCompare(const void *a, const void *b)
+{
+    const ConfigProperty *pa = (const ConfigProperty *)a;
+    return configCompare(pa->dev, pa->name, pa->order, (const ConfigProperty *)b);
+}
+
+static void configForget(ConfigFile *cf)
 {
-    char *rname, *rdev;
-    XMLEle *root = NULL, *fproot = NULL;
-    LilXML *lp = newLilXML();
+    ConfigFile **link = &configFiles;
+    while (*link != cf)
+        link = &(*link)->next;
+    *link = cf->next;
+
+    delXMLEle(cf->root);
+    free(cf->properties);
+    free(cf);
+}
+
+static ConfigFile *configFind(const char *fileName)
+{
+    ConfigFile *cf = configFiles;
+    while (cf && strcmp(cf->fileName, fileName))
+        cf = cf->next;
+    return cf;
+}
+
+/* Parsed configuration file, parsed again if the file changed. Call with config_mutex locked. */
+static ConfigFile *configLoad(const char *fileName, char errmsg[])
+{
+    ConfigFile *cf = configFind(fileName);
+    struct stat st;
+
+    if (stat(fileName, &st) != 0)
+    {
+        if (cf)
+            configForget(cf);
+        snprintf(errmsg, MAXRBUF, "Unable to open config file. Error loading file %s: %s", fileName, strerror(errno));
+        return NULL;
+    }
+
+    /* If file is owned by root and current user is NOT root then abort */
+    if ((st.st_uid == 0 && getuid() != 0) || (st.st_gid == 0 && getgid() != 0))
+    {
+        strncpy(errmsg,
+                "Config file is owned by root! This will lead to serious errors. To fix this, run: sudo chown -R $USER:$USER ~/.indi",
+                MAXRBUF);
+        return NULL;
+    }
 
-    FILE *fp = IUGetConfigFP(filename, dev, "r", errmsg);
+    if (cf && configSameFile(&cf->st, &st))
+        return cf;
+    if (cf)
+        configForget(cf);
 
+    FILE *fp = fopen(fileName, "r");
     if (fp == NULL)
-        return -1;
+    {
+        snprintf(errmsg, MAXRBUF, "Unable to open config file. Error loading file %s: %s", fileName, strerror(errno));
+        return NULL;
+    }
 
     char whynot[MAXRBUF];
-    fproot = readXMLFile(fp, lp, whynot);
-
+    LilXML *lp   = newLilXML();
+    XMLEle *root = readXMLFile(fp, lp, whynot);
     delLilXML(lp);
 
-    if (fproot == NULL)
+    /* The file as it was read, should it be replaced meanwhile */
+    fstat(fileno(fp), &st);
+    fclose(fp);
+
+    if (root == NULL)
     {
         snprintf(errmsg, MAXRBUF, "Unable to parse config XML: %s", whynot);
-        fclose(fp);
+        return NULL;
+    }
+
+    assert_mem(cf = (ConfigFile *)calloc(1, sizeof(ConfigFile)));
+    snprintf(cf->fileName, MAXRBUF, "%s", fileName);
+    cf->st   = st;
+    cf->root = root;
+
+    int n = nXMLEle(root);
+    if (n > 0)
+        assert_mem(cf->properties = (ConfigProperty *)malloc(n * sizeof(ConfigProperty)));
+
+    int order = 0;
+    for (XMLEle *ep = nextXMLEle(root, 1); ep != NULL; ep = nextXMLEle(root, 0), order++)
+    {
+        char *dev, *name, msg[MAXRBUF];
+        if (crackDN(ep, &dev, &name, msg) < 0)
+            continue;
+
+        ConfigProperty *property = &cf->properties[cf->nproperties++];
+        property->dev   = dev;
+        property->name  = name;
+        property->ep    = ep;
+        property->order = order;
+    }
+    if (cf->nproperties > 1)
+        qsort(cf->properties, cf->nproperties, sizeof(ConfigProperty), configSortCompare);
+
+    cf->next    = configFiles;
+    configFiles = cf;
+    return cf;
+}
+
+/* First property of dev with the given name */
+static XMLEle *configProperty(ConfigFile *cf, const char *dev, const char *name)
+{
+    /* Lower bound of (dev, name) */
+    int lo = 0, hi = cf->nproperties;
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+        if (configCompare(dev, name, -1, &cf->properties[mid]) > 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo < cf->nproperties && !strcmp(cf->properties[lo].dev, dev) && !strcmp(cf->properties[lo].name, name))
+        return cf->properties[lo].ep;
+
+    return NULL;
+}
+
+/* Property of dev in its default configuration file. Call with config_mutex locked. */
+static XMLEle *configFindProperty(const char *dev, const char *property)
+{
+    char fileName[MAXRBUF], errmsg[MAXRBUF];
+    getConfigFileName(NULL, dev, fileName);
+
+    ConfigFile *cf = configLoad(fileName, errmsg);
+    return cf ? configProperty(cf, dev, property) : NULL;
+}
+
+/* Member of a property in the configuration file */
+static XMLEle *configMember(XMLEle *ep, const char *member)
+{
+    for (XMLEle *oneMember = nextXMLEle(ep, 1); oneMember != NULL; oneMember = nextXMLEle(ep, 0))
+        if (!strcmp(member, findXMLAttValu(oneMember, "name")))
+            return oneMember;
+
+    return NULL;
+}
+
+/* Index of the first ON switch of a property in the configuration file, -1 if none */
+static int configOnSwitch(XMLEle *ep)
+{
+    int index = 0;
+    for (XMLEle *oneSwitch = nextXMLEle(ep, 1); oneSwitch != NULL; oneSwitch = nextXMLEle(ep, 0), index++)
+    {
+        ISState s = ISS_OFF;
+        if (crackISState(pcdataXMLEle(oneSwitch), &s) == 0 && s == ISS_ON)
+            return index;
+    }
+    return -1;
+}
+
+int IUReadConfig(const char *filename, const char *dev, const char *property, int silent, char errmsg[])
+{
+    char fileName[MAXRBUF];
+    XMLEle **roots = NULL;
+    int nroots = 0, nel = 0;
+
+    getConfigFileName(filename, dev, fileName);
+
+    pthread_mutex_lock(&config_mutex);
+    ConfigFile *cf = configLoad(fileName, errmsg);
+    if (cf == NULL)
+    {
+        pthread_mutex_unlock(&config_mutex);
         return -1;
     }
 
-    if (nXMLEle(fproot) > 0 && silent != 1)
-        IDMessage(dev, "[INFO] Loading device configuration...");
+    /* Dispatched from copies, the driver may read or save the configuration meanwhile */
+    nel = nXMLEle(cf->root);
+    if (nel > 0)
+        assert_mem(roots = (XMLEle **)malloc(nel * sizeof(XMLEle *)));
 
-    for (root = nextXMLEle(fproot, 1); root != NULL; root = nextXMLEle(fproot, 0))
+    if (property)
+    {
+        XMLEle *root = configProperty(cf, dev, property);
+        if (root)
+            roots[nroots++] = cloneXMLEle(root, NULL, NULL);
+    }
+    else
     {
-        /* pull out device and name */
-        if (crackDN(root, &rdev, &rname, errmsg) < 0)
+        for (XMLEle *root = nextXMLEle(cf->root, 1); root != NULL; root = nextXMLEle(cf->root, 0))
         {
-            fclose(fp);
-            delXMLEle(fproot);
-            return -1;
-        }
+            const char *rdev = findXMLAttValu(root, "device");
 
-        // It doesn't belong to our device??
-        if (strcmp(dev, rdev))
-            continue;
+            // It doesn't belong to our device??
+            if (strcmp(dev, rdev) || findXMLAtt(root, "name") == NULL)
+                continue;
 
-        if ((property && !strcmp(property, rname)) || property == NULL)
-        {
-            dispatch(root, errmsg);
-            if (property)
-                break;
+            roots[nroots++] = cloneXMLEle(root, NULL, NULL);
         }
     }
+    pthread_mutex_unlock(&config_mutex);
 
-    if (nXMLEle(fproot) > 0 && silent != 1)
-        IDMessage(dev, "[INFO] Device configuration applied.");
+    if (nel > 0 && silent != 1)
+        IDMessage(dev, "[INFO] Loading device configuration...");
 
-    fclose(fp);
-    delXMLEle(fproot);
+    for (int i = 0; i < nroots; i++)
+    {
+        dispatch(roots[i], errmsg);
+        delXMLEle(roots[i]);
+    }
+    free(roots);
+
+    if (nel > 0 && silent != 1)
+        IDMessage(dev, "[INFO] Device configuration applied.");
 
     return (0);
 }
@@ -591,379 +814,95 @@ int IUSaveDefaultConfig(const char *source_config, const char *dest_config, cons
 
 int IUGetConfigOnSwitch(const ISwitchVectorProperty *property, int *index)
 {
-    char *rname, *rdev;
-    XMLEle *root = NULL, *fproot = NULL;
-    char errmsg[MAXRBUF];
-    LilXML *lp = newLilXML();
-    int propertyFound = 0;
-    *index = -1;
+    pthread_mutex_lock(&config_mutex);
+    XMLEle *ep = configFindProperty(property->device, property->name);
+    *index = ep ? configOnSwitch(ep) : -1;
+    pthread_mutex_unlock(&config_mutex);
 
-    FILE *fp = IUGetConfigFP(NULL, property->device, "r", errmsg);
-
-    if (fp == NULL)
-    {
-        delLilXML(lp);
-        return -1;
-    }
-
-    fproot = readXMLFile(fp, lp, errmsg);
-
-    if (fproot == NULL)
-    {
-        delLilXML(lp);
-        fclose(fp);
-        return -1;
-    }
-
-    for (root = nextXMLEle(fproot, 1); root != NULL; root = nextXMLEle(fproot, 0))
-    {
-        /* pull out device and name */
-        if (crackDN(root, &rdev, &rname, errmsg) < 0)
-        {
-            fclose(fp);
-            delXMLEle(fproot);
-            return -1;
-        }
-
-        // It doesn't belong to our device??
-        if (strcmp(property->device, rdev))
-            continue;
-
-        if (!strcmp(property->name, rname))
-        {
-            propertyFound = 1;
-            XMLEle *oneSwitch = NULL;
-            int oneSwitchIndex = 0;
-            ISState oneSwitchState;
-            for (oneSwitch = nextXMLEle(root, 1); oneSwitch != NULL; oneSwitch = nextXMLEle(root, 0), oneSwitchIndex++)
-            {
-                if (crackISState(pcdataXMLEle(oneSwitch), &oneSwitchState) == 0 && oneSwitchState == ISS_ON)
-                {
-                    *index = oneSwitchIndex;
-                    break;
-                }
-            }
-            break;
-        }
-    }
-
-    fclose(fp);
-    delXMLEle(fproot);
-    delLilXML(lp);
-
-    return (propertyFound ? 0 : -1);
+    return (ep ? 0 : -1);
 }
 
 int IUGetConfigSwitch(const char *dev, const char *property, const char *member, ISState *value)
 {
-    char *rname, *rdev;
-    XMLEle *root = NULL, *fproot = NULL;
-    char errmsg[MAXRBUF];
-    LilXML *lp = newLilXML();
     int valueFound = 0;
 
-    FILE *fp = IUGetConfigFP(NULL, dev, "r", errmsg);
-
-    if (fp == NULL)
-    {
-        delLilXML(lp);
-        return -1;
-    }
-
-    fproot = readXMLFile(fp, lp, errmsg);
-
-    if (fproot == NULL)
-    {
-        fclose(fp);
-        delLilXML(lp);
-        return -1;
-    }
-
-    for (root = nextXMLEle(fproot, 1); root != NULL; root = nextXMLEle(fproot, 0))
-    {
-        /* pull out device and name */
-        if (crackDN(root, &rdev, &rname, errmsg) < 0)
-        {
-            fclose(fp);
-            delXMLEle(fproot);
-            return -1;
-        }
-
-        // It doesn't belong to our device??
-        if (strcmp(dev, rdev))
-            continue;
-
-        if ((property && !strcmp(property, rname)) || property == NULL)
-        {
-            XMLEle *oneSwitch = NULL;
-            for (oneSwitch = nextXMLEle(root, 1); oneSwitch != NULL; oneSwitch = nextXMLEle(root, 0))
-            {
-                if (!strcmp(member, findXMLAttValu(oneSwitch, "name")))
-                {
-                    if (crackISState(pcdataXMLEle(oneSwitch), value) == 0)
-                        valueFound = 1;
-                    break;
-                }
-            }
-            break;
-        }
-    }
-
-    fclose(fp);
-    delXMLEle(fproot);
-    delLilXML(lp);
+    pthread_mutex_lock(&config_mutex);
+    XMLEle *ep = configFindProperty(dev, property);
+    XMLEle *oneSwitch = ep ? configMember(ep, member) : NULL;
+    if (oneSwitch && crackISState(pcdataXMLEle(oneSwitch), value) == 0)
+        valueFound = 1;
+    pthread_mutex_unlock(&config_mutex);
 
     return (valueFound == 1 ? 0 : -1);
 }
 
 int IUGetConfigOnSwitchIndex(const char *dev, const char *property, int *index)
 {
-    char *rname, *rdev;
-    XMLEle *root = NULL, *fproot = NULL;
-    char errmsg[MAXRBUF];
-    LilXML *lp = newLilXML();
     int valueFound = 0;
 
-    FILE *fp = IUGetConfigFP(NULL, dev, "r", errmsg);
-
-    if (fp == NULL)
+    pthread_mutex_lock(&config_mutex);
+    XMLEle *ep = configFindProperty(dev, property);
+    int currentIndex = ep ? configOnSwitch(ep) : -1;
+    if (currentIndex >= 0)
     {
-        delLilXML(lp);
-        return -1;
-    }
-
-    fproot = readXMLFile(fp, lp, errmsg);
-
-    if (fproot == NULL)
-    {
-        delLilXML(lp);
-        fclose(fp);
-        return -1;
+        *index = currentIndex;
+        valueFound = 1;
     }
-
-    for (root = nextXMLEle(fproot, 1); root != NULL; root = nextXMLEle(fproot, 0))
-    {
-        /* pull out device and name */
-        if (crackDN(root, &rdev, &rname, errmsg) < 0)
-        {
-            fclose(fp);
-            delXMLEle(fproot);
-            return -1;
-        }
-
-        // It doesn't belong to our device??
-        if (strcmp(dev, rdev))
-            continue;
-
-        if ((property && !strcmp(property, rname)) || property == NULL)
-        {
-            XMLEle *oneSwitch = NULL;
-            int currentIndex = 0;
-            for (oneSwitch = nextXMLEle(root, 1); oneSwitch != NULL; oneSwitch = nextXMLEle(root, 0), currentIndex++)
-            {
-                ISState s = ISS_OFF;
-                if (crackISState(pcdataXMLEle(oneSwitch), &s) == 0 && s == ISS_ON)
-                {
-                    *index = currentIndex;
-                    valueFound = 1;
-                    break;
-                }
-            }
-            break;
-        }
-    }
-
-    fclose(fp);
-    delXMLEle(fproot);
-    delLilXML(lp);
+    pthread_mutex_unlock(&config_mutex);
 
     return (valueFound == 1 ? 0 : -1);
 }
 
 int IUGetConfigOnSwitchName(const char *dev, const char *property, char *name, size_t size)
 {
-    char *rname, *rdev;
-    XMLEle *root = NULL, *fproot = NULL;
-    char errmsg[MAXRBUF];
-    LilXML *lp = newLilXML();
     int found = -1;
 
-    FILE *fp = IUGetConfigFP(NULL, dev, "r", errmsg);
-
-    if (fp == NULL)
-    {
-        delLilXML(lp);
-        return -1;
-    }
-
-    fproot = readXMLFile(fp, lp, errmsg);
-
-    if (fproot == NULL)
-    {
-        delLilXML(lp);
-        fclose(fp);
-        return -1;
-    }
-
-    for (root = nextXMLEle(fproot, 1); root != NULL; root = nextXMLEle(fproot, 0))
+    pthread_mutex_lock(&config_mutex);
+    XMLEle *ep = configFindProperty(dev, property);
+    int index = ep ? configOnSwitch(ep) : -1;
+    if (index >= 0)
     {
-        /* pull out device and name */
-        if (crackDN(root, &rdev, &rname, errmsg) < 0)
-        {
-            fclose(fp);
-            delXMLEle(fproot);
-            return -1;
-        }
-
-        // It doesn't belong to our device??
-        if (strcmp(dev, rdev))
-            continue;
-
-        if ((property && !strcmp(property, rname)) || property == NULL)
-        {
-            XMLEle *oneSwitch = NULL;
-            int currentIndex = 0;
-            for (oneSwitch = nextXMLEle(root, 1); oneSwitch != NULL; oneSwitch = nextXMLEle(root, 0), currentIndex++)
-            {
-                ISState s = ISS_OFF;
-                if (crackISState(pcdataXMLEle(oneSwitch), &s) == 0 && s == ISS_ON)
-                {
-                    found = 0;
-                    strncpy(name, findXMLAttValu(oneSwitch, "name"), size);
-                    break;
-                }
-            }
-            break;
-        }
+        XMLEle *oneSwitch = nextXMLEle(ep, 1);
+        while (index-- > 0)
+            oneSwitch = nextXMLEle(ep, 0);
+        strncpy(name, findXMLAttValu(oneSwitch, "name"), size);
+        found = 0;
     }
-
-    fclose(fp);
-    delXMLEle(fproot);
-    delLilXML(lp);
+    pthread_mutex_unlock(&config_mutex);
 
     return found;
 }
 
 int IUGetConfigNumber(const char *dev, const char *property, const char *member, double *value)
 {
-    char *rname, *rdev;
-    XMLEle *root = NULL, *fproot = NULL;
-    char errmsg[MAXRBUF];
-    LilXML *lp = newLilXML();
     int valueFound = 0;
 
-    FILE *fp = IUGetConfigFP(NULL, dev, "r", errmsg);
-
-    if (fp == NULL)
-    {
-        delLilXML(lp);
-        return -1;
-    }
-
-    fproot = readXMLFile(fp, lp, errmsg);
-
-    if (fproot == NULL)
+    pthread_mutex_lock(&config_mutex);
+    XMLEle *ep = configFindProperty(dev, property);
+    XMLEle *oneNumber = ep ? configMember(ep, member) : NULL;
+    if (oneNumber)
     {
-        fclose(fp);
-        delLilXML(lp);
-        return -1;
-    }
-
-    for (root = nextXMLEle(fproot, 1); root != NULL; root = nextXMLEle(fproot, 0))
-    {
-        /* pull out device and name */
-        if (crackDN(root, &rdev, &rname, errmsg) < 0)
-        {
-            fclose(fp);
-            delXMLEle(fproot);
-            return -1;
-        }
-
-        // It doesn't belong to our device??
-        if (strcmp(dev, rdev))
-            continue;
-
-        if ((property && !strcmp(property, rname)) || property == NULL)
-        {
-            XMLEle *oneNumber = NULL;
-            for (oneNumber = nextXMLEle(root, 1); oneNumber != NULL; oneNumber = nextXMLEle(root, 0))
-            {
-                if (!strcmp(member, findXMLAttValu(oneNumber, "name")))
-                {
-                    *value = atof(pcdataXMLEle(oneNumber));
-                    valueFound = 1;
-                    break;
-                }
-            }
-            break;
-        }
+        *value = atof(pcdataXMLEle(oneNumber));
+        valueFound = 1;
     }
-
-    fclose(fp);
-    delXMLEle(fproot);
-    delLilXML(lp);
+    pthread_mutex_unlock(&config_mutex);
 
     return (valueFound == 1 ? 0 : -1);
 }
 
 int IUGetConfigText(const char *dev, const char *property, const char *member, char *value, int len)
 {
-    char *rname, *rdev;
-    XMLEle *root = NULL, *fproot = NULL;
-    char errmsg[MAXRBUF];
-    LilXML *lp = newLilXML();
     int valueFound = 0;
 
-    FILE *fp = IUGetConfigFP(NULL, dev, "r", errmsg);
-
-    if (fp == NULL)
-    {
-        delLilXML(lp);
-        return -1;
-    }
-
-    fproot = readXMLFile(fp, lp, errmsg);
-
-    if (fproot == NULL)
+    pthread_mutex_lock(&config_mutex);
+    XMLEle *ep = configFindProperty(dev, property);
+    XMLEle *oneText = ep ? configMember(ep, member) : NULL;
+    if (oneText)
     {
-        delLilXML(lp);
-        fclose(fp);
-        return -1;
+        strncpy(value, pcdataXMLEle(oneText), len);
+        valueFound = 1;
     }
-
-    for (root = nextXMLEle(fproot, 1); root != NULL; root = nextXMLEle(fproot, 0))
-    {
-        /* pull out device and name */
-        if (crackDN(root, &rdev, &rname, errmsg) < 0)
-        {
-            fclose(fp);
-            delXMLEle(fproot);
-            return -1;
-        }
-
-        // It doesn't belong to our device??
-        if (strcmp(dev, rdev))
-            continue;
-
-        if ((property && !strcmp(property, rname)) || property == NULL)
-        {
-            XMLEle *oneText = NULL;
-            for (oneText = nextXMLEle(root, 1); oneText != NULL; oneText = nextXMLEle(root, 0))
-            {
-                if (!strcmp(member, findXMLAttValu(oneText, "name")))
-                {
-                    strncpy(value, pcdataXMLEle(oneText), len);
-                    valueFound = 1;
-                    break;
-                }
-            }
-            break;
-        }
-    }
-
-    fclose(fp);
-    delXMLEle(fproot);
-    delLilXML(lp);
+    pthread_mutex_unlock(&config_mutex);
 
     return (valueFound == 1 ? 0 : -1);
 }
@@ -992,19 +931,14 @@ void IDMessage(const char *dev, const char *fmt, ...)
 int IUPurgeConfig(const char *filename, const char *dev, char errmsg[])
 {
     char configFileName[MAXRBUF];
-    char configDir[MAXRBUF];
 
-    snprintf(configDir, MAXRBUF, "%s/.indi/", getenv("HOME"));
+    getConfigFileName(filename, dev, configFileName);
 
-    if (filename)
-        strncpy(configFileName, filename, MAXRBUF);
-    else
-    {
-        if (getenv("INDICONFIG"))
-            strncpy(configFileName, getenv("INDICONFIG"), MAXRBUF);
-        else
-            snprintf(configFileName, MAXRBUF, "%s%s_config.xml", configDir, dev);
-    }
+    pthread_mutex_lock(&config_mutex);
+    ConfigFile *cf = configFind(configFileName);
+    if (cf)
+        configForget(cf);
+    pthread_mutex_unlock(&config_mutex);
 
     if (remove(configFileName) != 0)
     {
@@ -1015,44 +949,46 @@ int IUPurgeConfig(const char *filename, const char *dev, char errmsg[])
     return 0;
 }
 
-FILE *IUGetConfigFP(const char *filename, const char *dev, const char *mode, char errmsg[])
+/* Creates the config directory, and refuses files owned by root */
+static int configCheck(const char *fileName, char errmsg[])
 {
-    char configFileName[MAXRBUF];
     char configDir[MAXRBUF];
     struct stat st;
-    FILE *fp = NULL;
 
     snprintf(configDir, MAXRBUF, "%s/.indi/", getenv("HOME"));
 
-    if (filename)
-        strncpy(configFileName, filename, MAXRBUF);
-    else
-    {
-        if (getenv("INDICONFIG"))
-            strncpy(configFileName, getenv("INDICONFIG"), MAXRBUF);
-        else
-            snprintf(configFileName, MAXRBUF, "%s%s_config.xml", configDir, dev);
-    }
-
     if (stat(configDir, &st) != 0)
     {
         if (mkdir(configDir, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH) < 0)
         {
             snprintf(errmsg, MAXRBUF, "Unable to create config directory. Error %s: %s", configDir, strerror(errno));
-            return NULL;
+            return -1;
         }
     }
 
-    stat(configFileName, &st);
+    stat(fileName, &st);
     /* If file is owned by root and current user is NOT root then abort */
     if ( (st.st_uid == 0 && getuid() != 0) || (st.st_gid == 0 && getgid() != 0) )
     {
         strncpy(errmsg,
                 "Config file is owned by root! This will lead to serious errors. To fix this, run: sudo chown -R $USER:$USER ~/.indi",
                 MAXRBUF);
-        return NULL;
+        return -1;
     }
 
+    return 0;
+}
+
+FILE *IUGetConfigFP(const char *filename, const char *dev, const char *mode, char errmsg[])
+{
+    char configFileName[MAXRBUF];
+    FILE *fp = NULL;
+
+    getConfigFileName(filename, dev, configFileName);
+
+    if (configCheck(configFileName, errmsg) != 0)
+        return NULL;
+
     fp = fopen(configFileName, mode);
     if (fp == NULL)
     {
@@ -1064,6 +1000,160 @@ FILE *IUGetConfigFP(const char *filename, const char *dev, const char *mode, cha
     return fp;
 }
 
+/* Configuration files are written next to the file, and renamed over it once complete */
+/* Names resolved by configTarget are up to PATH_MAX long, the temporary name has the pid added */
+#define CONFIG_TEMP_NAME (PATH_MAX + 32)
+
+static void configTempName(const char *fileName, char tempName[])
+{
+    snprintf(tempName, CONFIG_TEMP_NAME, "%s.%d.tmp", fileName, (int)getpid());
+}
+
+/* The file a symbolic link points to is replaced rather than the link, fileName holds PATH_MAX bytes */
+static void configTarget(const char *filename, const char *dev, char fileName[])
+{
+    char resolved[PATH_MAX];
+    getConfigFileName(filename, dev, fileName);
+    if (realpath(fileName, resolved) != NULL)
+        memcpy(fileName, resolved, strlen(resolved) + 1);
+}
+
+FILE *IUGetConfigWriteFP(const char *filename, const char *dev, char errmsg[])
+{
+    char fileName[PATH_MAX], tempName[CONFIG_TEMP_NAME];
+    struct stat st;
+
+    configTarget(filename, dev, fileName);
+    configTempName(fileName, tempName);
+
+    if (configCheck(fileName, errmsg) != 0)
+        return NULL;
+
+    FILE *fp = fopen(tempName, "w");
+    if (fp == NULL)
+    {
+        snprintf(errmsg, MAXRBUF, "Unable to open config file. Error creating file %s: %s", tempName, strerror(errno));
+        return NULL;
+    }
+
+    /* Keep the permissions of the file it replaces */
+    if (stat(fileName, &st) == 0)
+        fchmod(fileno(fp), st.st_mode & 07777);
+
+    return fp;
+}
+
+int IUCommitConfig(FILE *fp, const char *filename, const char *dev, char errmsg[])
+{
+    char fileName[PATH_MAX], tempName[CONFIG_TEMP_NAME];
+
+    configTarget(filename, dev, fileName);
+    configTempName(fileName, tempName);
+
+    /* On disk before it replaces the previous file, so a crash leaves one or the other */
+    int failed = fflush(fp) != 0 || fsync(fileno(fp)) != 0;
+    failed = fclose(fp) != 0 || failed;
+
+    if (failed || rename(tempName, fileName) != 0)
+    {
+        snprintf(errmsg, MAXRBUF, "Unable to save config file %s: %s", fileName, strerror(errno));
+        remove(tempName);
+        return -1;
+    }
+
+    return 0;
+}
+
+int IUUpdateConfig(const char *filename, const char *dev, const char *tag, const char *property, char *names[],
+                   char *values[], int n, char errmsg[])
+{
+    char fileName[MAXRBUF];
+    getConfigFileName(filename, dev, fileName);
+
+    pthread_mutex_lock(&config_mutex);
+
+    /* Not saved yet */
+    if (access(fileName, F_OK) != 0)
+    {
+        pthread_mutex_unlock(&config_mutex);
+        return 1;
+    }
+
+    ConfigFile *cf = configLoad(fileName, errmsg);
+    if (cf == NULL)
+    {
+        pthread_mutex_unlock(&config_mutex);
+        return -1;
+    }
+
+    /* Not saved yet */
+    XMLEle *ep = configProperty(cf, dev, property);
+    if (ep == NULL)
+    {
+        pthread_mutex_unlock(&config_mutex);
+        return 1;
+    }
+
+    /* Saved as another type of property */
+    if (strcmp(tagXMLEle(ep), tag))
+    {
+        pthread_mutex_unlock(&config_mutex);
+        return 1;
+    }
+
+    /* Every member saved must have a value, or nothing is changed */
+    for (XMLEle *oneMember = nextXMLEle(ep, 1); oneMember != NULL; oneMember = nextXMLEle(ep, 0))
+    {
+        const char *name = findXMLAttValu(oneMember, "name");
+        int i = 0;
+        while (i < n && strcmp(names[i], name))
+            i++;
+        if (i == n)
+        {
+            snprintf(errmsg, MAXRBUF, "%s has no member %s", property, name);
+            pthread_mutex_unlock(&config_mutex);
+            return -1;
+        }
+    }
+
+    /* editXMLEle gives each edited value its own allocation, freed by the next edit of the element,
+     * so the tree kept for the life of the driver does not grow with every save */
+    for (XMLEle *oneMember = nextXMLEle(ep, 1); oneMember != NULL; oneMember = nextXMLEle(ep, 0))
+    {
+        const char *name = findXMLAttValu(oneMember, "name");
+        for (int i = 0; i < n; i++)
+            if (!strcmp(names[i], name))
+            {
+                editXMLEle(oneMember, values[i]);
+                break;
+            }
+    }
+
+    FILE *fp = IUGetConfigWriteFP(filename, dev, errmsg);
+    if (fp == NULL)
+    {
+        configForget(cf);
+        pthread_mutex_unlock(&config_mutex);
+        return -1;
+    }
+
+    prXMLEle(fp, cf->root, 0);
+
+    if (IUCommitConfig(fp, filename, dev, errmsg) != 0)
+    {
+        configForget(cf);
+        pthread_mutex_unlock(&config_mutex);
+        return -1;
+    }
+
+    /* The tree is what was written, it stays valid for the new file */
+    if (stat(fileName, &cf->st) != 0)
+        configForget(cf);
+
+    pthread_mutex_unlock(&config_mutex);
+    return 0;
+}
+
 void IUSaveConfigTag(FILE *fp, int ctag, const char *dev, int silent)
 {
     if (!fp)
@@ -61,6 +61,9 @@ extern int dispatch(XMLEle *root, char msg[]);
  * be used as the configuration filename</li>
  * <li>Generate filename: If the <i>device_name</i> is supplied, the function will attempt to set the configuration filename to ~/.indi/device_name_config.xml</li>
  * </ol>
+ *
+ * <p>Configuration files are parsed once and kept in memory, indexed by device and property name. A file is parsed again
+ * when it changed on disk. Files are saved to a temporary file first, which then replaces the configuration file.</p>
  * @author Jasem Mutlaq
  * @note Drivers subclassing INDI::DefaultDevice do not need to call the configuration functions directly as it is handled internally by the class.
  * @version libindi 1.1+
@@ -78,6 +81,40 @@ extern int dispatch(XMLEle *root, char msg[]);
  */
 extern FILE *IUGetConfigFP(const char *filename, const char *dev, const char *mode, char errmsg[]);
 
+/** @brief Open a temporary file that replaces the configuration file once committed with IUCommitConfig.
+ *  Until then, the previous configuration file is left untouched, and readers never see a partially written file.
+ *  @param filename full path of the configuration file, or NULL as described in the <b>Detailed Description</b> introduction.
+ *  @param dev device name. This is used if the filename parameter is NULL, and INDICONFIG environment variable is not set as described in the <b>Detailed Description</b> introduction.
+ *  @param errmsg In case of errors, store the error message in this buffer. The size of the buffer must be at least MAXRBUF.
+ *  @return pointer to FILE if the temporary file is created, otherwise NULL and errmsg is set.
+ */
+extern FILE *IUGetConfigWriteFP(const char *filename, const char *dev, char errmsg[]);
+
+/** @brief Close a file opened with IUGetConfigWriteFP and rename it over the configuration file.
+ *  @param fp file pointer returned by IUGetConfigWriteFP. It is closed in all cases.
+ *  @param filename the same as given to IUGetConfigWriteFP.
+ *  @param dev the same as given to IUGetConfigWriteFP.
+ *  @param errmsg In case of errors, store the error message in this buffer. The size of the buffer must be at least MAXRBUF.
+ *  @return 0 on success, -1 on failure, in which case the configuration file is left as it was.
+ */
+extern int IUCommitConfig(FILE *fp, const char *filename, const char *dev, char errmsg[]);
+
+/** @brief Update the members of a single property in the configuration file.
+ *  The property is changed in the parsed configuration kept in memory, which is then written out with IUGetConfigWriteFP and IUCommitConfig.
+ *  @param filename full path of the configuration file, or NULL as described in the <b>Detailed Description</b> introduction.
+ *  @param dev device name.
+ *  @param tag the tag the property is saved with, e.g. newNumberVector.
+ *  @param property name of the property.
+ *  @param names names of the members.
+ *  @param values new contents of the members, as saved by the IUSaveConfig functions.
+ *  @param n number of members.
+ *  @param errmsg In case of errors, store the error message in this buffer. The size of the buffer must be at least MAXRBUF.
+ *  @return 0 on success, 1 if the file does not exist or does not have the property saved with the given tag, in which case
+ *  the whole configuration should be saved, and -1 on failure, including a saved member not found in names.
+ */
+extern int IUUpdateConfig(const char *filename, const char *dev, const char *tag, const char *property, char *names[],
+                          char *values[], int n, char errmsg[]);
+
 /**
  *  @param filename full path of the configuration file. If set, it will be deleted from disk.
  *         If set to NULL, it will attempt to generate the filename as described in the <b>Detailed Description</b> introduction and then delete it.
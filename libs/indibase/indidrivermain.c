@@ -35,6 +35,7 @@
 #include "indidevapi.h"
 #include "indidriver.h"
 #include "lilxml.h"
+#include "sharedblob.h"
 
 #include <errno.h>
 #include <stdarg.h>
@@ -71,7 +72,8 @@ static int messageHandling = PROCEED_IMMEDIATE;
  */
 static void clientMsgCB(int fd, void *arg)
 {
-    char buf[MAXRBUF], msg[MAXRBUF], *bp;
+    char buf[MAXRBUF], msg[MAXRBUF];
+    XMLEle **nodes, **node;
     int nr;
 
     (void) arg;
@@ -97,22 +99,22 @@ static void clientMsgCB(int fd, void *arg)
     }
 
     /* crack and dispatch when complete */
-    for (bp = buf; nr-- > 0; bp++)
+    nodes = parseXMLChunk(clixml, buf, nr, msg);
+    if (msg[0])
+        fprintf(stderr, "%s XML error: %s\n", me, msg);
+
+    for (node = nodes; *node; node++)
     {
-        XMLEle *root = readXMLEle(clixml, *bp, msg);
-        if (root)
+        XMLEle *root = *node;
+        if (strcmp(tagXMLEle(root), "pingReply") == 0)
         {
-            if (strcmp(tagXMLEle(root), "pingReply") == 0)
-            {
-                handlePingReply(root);
-                delXMLEle(root);
-                continue;
-            }
-            deferMessage(root);
+            handlePingReply(root);
+            delXMLEle(root);
+            continue;
         }
-        else if (msg[0])
-            fprintf(stderr, "%s XML error: %s\n", me, msg);
+        deferMessage(root);
     }
+    free(nodes);
 }
 
 typedef struct DeferredMessage
@@ -334,6 +336,8 @@ int main(int ac, char *av[])
 
     /* init */
     clixml = newLilXML();
+    /* decode BLOBs as they arrive, straight to buffers that ISNewBLOB can share */
+    decodeXMLBLOBs(clixml, IDSharedBlobAlloc, IDSharedBlobRealloc, IDSharedBlobFree);
     addCallback(0, clientMsgCB, clixml);
 
     /* service client */
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#include "indifileindex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+
+namespace INDI
+{
+
+namespace
+{
+
+void replaceAll(std::string &text, const std::string &pattern, const std::string &value)
+{
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + value.size()))
+        text.replace(pos, pattern.size(), value);
+}
+
+}
+
+int FileIndex::next(const std::string &dir, const std::string &prefix)
+{
+    auto key = std::make_pair(dir, stem(prefix));
+
+    std::unique_lock<std::mutex> lock(m_Lock);
+    auto last = m_Last.find(key);
+    if (last == m_Last.end())
+    {
+        int found = scan(dir, key.second);
+        if (found < 0)
+            return -1;
+        last = m_Last.emplace(key, found).first;
+    }
+
+    return ++last->second;
+}
+
+bool FileIndex::contains(const std::string &dir, const std::string &prefix) const
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    return m_Last.count(std::make_pair(dir, stem(prefix))) > 0;
+}
+
+void FileIndex::reset()
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    m_Last.clear();
+}
+
+std::string FileIndex::expand(const std::string &prefix, const std::string &timestamp, int index)
+{
+    char indexString[16];
+    snprintf(indexString, sizeof(indexString), "%03d", index);
+
+    std::string name = prefix;
+    replaceAll(name, "ISO8601", timestamp);
+    replaceAll(name, "XXX", indexString);
+    return name;
+}
+
+std::string FileIndex::stem(const std::string &prefix)
+{
+    std::string stem = prefix;
+    replaceAll(stem, "_ISO8601", "");
+    replaceAll(stem, "_XXX", "");
+    return stem;
+}
+
+int FileIndex::scan(const std::string &dir, const std::string &stem)
+{
+    DIR *dpdf = opendir(dir.c_str());
+    if (dpdf == nullptr)
+        return -1;
+
+    // The index follows the last underscore of the names holding the stem
+    int maxIndex = 0;
+    struct dirent *epdf = nullptr;
+    while ((epdf = readdir(dpdf)))
+    {
+        if (strstr(epdf->d_name, stem.c_str()) == nullptr)
+            continue;
+
+        const char *start = strrchr(epdf->d_name, '_');
+        if (start != nullptr)
+            maxIndex = std::max(maxIndex, atoi(start + 1));
+    }
+
+    closedir(dpdf);
+    return maxIndex;
+}
+
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace INDI
+{
+
+/**
+ * @brief The FileIndex class numbers the files saved in upload directories.
+ *
+ * File names are made from a prefix where ISO8601 stands for a timestamp and XXX for the index of
+ * the file. The first time a directory is used with a prefix, it is scanned for the largest index
+ * already there. The index then lives in memory, and each new file takes the next one, so saving
+ * a file does not read the directory again.
+ */
+class FileIndex
+{
+    public:
+        /**
+         * @brief next Reserve the index of the next file saved in dir with prefix.
+         * @return The index, from 1, or -1 if the directory cannot be read. errno is then set.
+         */
+        int next(const std::string &dir, const std::string &prefix);
+
+        /** @return True if dir was scanned already for prefix. */
+        bool contains(const std::string &dir, const std::string &prefix) const;
+
+        /** @brief reset Forget all indexes, directories are scanned again when next used. */
+        void reset();
+
+        /**
+         * @brief expand Make a file name from a prefix.
+         * @param prefix File name prefix, with ISO8601 and XXX patterns.
+         * @param timestamp Replaces ISO8601.
+         * @param index Replaces XXX, on three digits or more.
+         */
+        static std::string expand(const std::string &prefix, const std::string &timestamp, int index);
+
+        /** @return The part of the prefix all file names share, the prefix without _ISO8601 and _XXX. */
+        static std::string stem(const std::string &prefix);
+
+    private:
+        static int scan(const std::string &dir, const std::string &stem);
+
+        mutable std::mutex m_Lock;
+        // Last index used, by directory and stem
+        std::map<std::pair<std::string, std::string>, int> m_Last;
+};
+
+}
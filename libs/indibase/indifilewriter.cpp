@@ -0,0 +1,204 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#include "indifilewriter.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace INDI
+{
+
+namespace
+{
+
+// Buffers kept for the next files, enough for a burst of frames
+constexpr size_t maxFreeBuffers = 4;
+// Files open at once while a batch is synced
+constexpr size_t maxBatchFiles = 64;
+
+}
+
+FileWriter::FileWriter(size_t maxQueuedBytes) : m_MaxQueuedBytes(maxQueuedBytes)
+{
+    m_Worker = std::thread(&FileWriter::run, this);
+}
+
+FileWriter::~FileWriter()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_Lock);
+        m_Quit = true;
+        m_Queued.notify_all();
+    }
+    m_Worker.join();
+}
+
+void FileWriter::setCompletionHandler(const std::function<void(const std::string &path, int error)> &handler)
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    m_CompletionHandler = handler;
+}
+
+void FileWriter::write(const std::string &path, const void *data, size_t size, const std::function<void(int error)> &done)
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+
+    // A file larger than the limit still goes through, alone
+    m_Written.wait(lock, [&]()
+    {
+        return m_QueuedBytes == 0 || m_QueuedBytes + size <= m_MaxQueuedBytes;
+    });
+
+    File file;
+    file.path = path;
+    file.done = done;
+    if (!m_FreeBuffers.empty())
+    {
+        file.data = std::move(m_FreeBuffers.back());
+        m_FreeBuffers.pop_back();
+    }
+
+    // Copy outside the lock, the worker only needs it to pick up the queue
+    m_QueuedBytes += size;
+    lock.unlock();
+    file.data.assign(static_cast<const uint8_t *>(data), static_cast<const uint8_t *>(data) + size);
+    lock.lock();
+
+    m_Queue.push_back(std::move(file));
+    m_Queued.notify_one();
+}
+
+void FileWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    m_Written.wait(lock, [this]()
+    {
+        return m_Queue.empty() && m_Writing == 0;
+    });
+}
+
+size_t FileWriter::pending() const
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    return m_Queue.size() + m_Writing;
+}
+
+uint64_t FileWriter::failed() const
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+    return m_Failed;
+}
+
+int FileWriter::save(const File &file, int &error)
+{
+    int fd = open(file.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        error = errno;
+        return -1;
+    }
+
+    for (size_t done = 0; done < file.data.size();)
+    {
+        ssize_t n = ::write(fd, file.data.data() + done, file.data.size() - done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+        {
+            error = n < 0 ? errno : EIO;
+            close(fd);
+            return -1;
+        }
+        done += n;
+    }
+
+    return fd;
+}
+
+void FileWriter::run()
+{
+    std::unique_lock<std::mutex> lock(m_Lock);
+
+    for (;;)
+    {
+        m_Queued.wait(lock, [this]()
+        {
+            return !m_Queue.empty() || m_Quit;
+        });
+        if (m_Queue.empty())
+            break;
+
+        // Everything queued so far makes one batch, synced together
+        std::deque<File> batch;
+        while (!m_Queue.empty() && batch.size() < maxBatchFiles)
+        {
+            batch.push_back(std::move(m_Queue.front()));
+            m_Queue.pop_front();
+        }
+        m_Writing = batch.size();
+        auto completionHandler = m_CompletionHandler;
+        lock.unlock();
+
+        // Files are written in order, a failed one keeps its place
+        std::vector<std::pair<int, int>> results;
+        for (const auto &file : batch)
+        {
+            int error = 0;
+            int fd = save(file, error);
+            results.emplace_back(fd, error);
+        }
+
+        size_t failed = 0;
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            int fd = results[i].first;
+            int error = results[i].second;
+            if (fd >= 0)
+            {
+                // Some file systems cannot sync, their files are written all the same
+                if (fsync(fd) != 0 && errno != EINVAL)
+                    error = errno;
+                if (close(fd) != 0 && error == 0 && errno != EINTR)
+                    error = errno;
+            }
+
+            if (error != 0)
+                failed++;
+            if (completionHandler)
+                completionHandler(batch[i].path, error);
+            if (batch[i].done)
+                batch[i].done(error);
+        }
+
+        lock.lock();
+        m_Failed += failed;
+        for (auto &file : batch)
+        {
+            m_QueuedBytes -= file.data.size();
+            if (m_FreeBuffers.size() < maxFreeBuffers)
+                m_FreeBuffers.push_back(std::move(file.data));
+        }
+        m_Writing = 0;
+        m_Written.notify_all();
+    }
+}
+
+}
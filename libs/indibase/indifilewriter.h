@@ -0,0 +1,97 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace INDI
+{
+
+/**
+ * @brief The FileWriter class saves files on a worker thread, so a slow disk does not hold up
+ * the thread that produced them.
+ *
+ * Files are written in the order they were queued. The worker takes all the files queued at once,
+ * writes them, then syncs them to disk one after the other, so a burst of frames costs one round of
+ * syncs instead of one per file. The data is copied when queued; when more than maxQueuedBytes are
+ * waiting, write blocks until the worker catches up.
+ */
+class FileWriter
+{
+    public:
+        explicit FileWriter(size_t maxQueuedBytes = 512 * 1024 * 1024);
+        /** @brief Writes all the files still queued. */
+        ~FileWriter();
+
+        /**
+         * @brief setCompletionHandler Called on the worker thread once a file is on disk, with error 0, or
+         * when it failed, with errno.
+         */
+        void setCompletionHandler(const std::function<void(const std::string &path, int error)> &handler);
+
+        /**
+         * @brief write Queue a copy of data to be saved to path, replacing any file there.
+         * @param done Called on the worker thread after the completion handler, with the same error.
+         */
+        void write(const std::string &path, const void *data, size_t size,
+                   const std::function<void(int error)> &done = nullptr);
+
+        /** @brief flush Wait until all the files queued are on disk. */
+        void flush();
+
+        /** @return Files queued and not on disk yet. */
+        size_t pending() const;
+
+        /** @return Files that could not be written. */
+        uint64_t failed() const;
+
+    private:
+        struct File
+        {
+            std::string path;
+            std::vector<uint8_t> data;
+            std::function<void(int error)> done;
+        };
+
+        void run();
+        int save(const File &file, int &error);
+
+        size_t m_MaxQueuedBytes;
+        std::function<void(const std::string &path, int error)> m_CompletionHandler;
+
+        mutable std::mutex m_Lock;
+        std::condition_variable m_Queued;
+        std::condition_variable m_Written;
+        std::deque<File> m_Queue;
+        std::vector<std::vector<uint8_t>> m_FreeBuffers;
+        size_t m_QueuedBytes {0};
+        size_t m_Writing {0};
+        uint64_t m_Failed {0};
+        bool m_Quit {false};
+        std::thread m_Worker;
+};
+
+}
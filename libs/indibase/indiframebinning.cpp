@@ -0,0 +1,185 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#include "indiframebinning.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace INDI
+{
+
+namespace
+{
+
+// Below this many input pixels, a thread costs more than it saves
+constexpr size_t minPixelsPerBand = 1 << 20;
+
+// Input pixels binned into output pixel o along one axis: first, first + step, ... clipped to size
+struct Span
+{
+    uint32_t first;
+    uint32_t step;
+    uint32_t count;
+};
+
+Span sourceSpan(uint32_t o, uint32_t bin, bool bayer, uint32_t size)
+{
+    Span span;
+    if (bayer)
+    {
+        // Same color as o in the 2x2 pattern
+        span.first = (o & ~1u) * bin + (o & 1u);
+        span.step  = 2;
+    }
+    else
+    {
+        span.first = o * bin;
+        span.step  = 1;
+    }
+
+    span.count = 0;
+    while (span.count < bin && span.first + span.count * span.step < size)
+        span.count++;
+    return span;
+}
+
+template <typename T, typename Acc>
+T store(Acc sum, uint32_t count, FrameBinning::Mode mode)
+{
+    if (mode == FrameBinning::AVERAGE && count > 0)
+        sum /= count;
+
+    if (std::is_floating_point<T>::value)
+        return static_cast<T>(sum);
+
+    return static_cast<T>(std::min<Acc>(sum, std::numeric_limits<T>::max()));
+}
+
+template <typename T, typename Acc>
+void binRows(const T *source, T *target, uint32_t width, uint32_t height, uint32_t binX, uint32_t binY,
+             FrameBinning::Mode mode, bool bayer, uint32_t beginRow, uint32_t endRow)
+{
+    const uint32_t outWidth = width / binX;
+    std::vector<Acc> columns(width);
+    std::vector<Span> spans(outWidth);
+
+    for (uint32_t x = 0; x < outWidth; x++)
+        spans[x] = sourceSpan(x, binX, bayer, width);
+
+    for (uint32_t y = beginRow; y < endRow; y++)
+    {
+        Span rows = sourceSpan(y, binY, bayer, height);
+
+        // Vertical: sum the input rows of this output row, contiguous so it vectorizes
+        const T *row = source + size_t(rows.first) * width;
+        for (uint32_t x = 0; x < width; x++)
+            columns[x] = row[x];
+        for (uint32_t k = 1; k < rows.count; k++)
+        {
+            row = source + (size_t(rows.first) + size_t(k) * rows.step) * width;
+            for (uint32_t x = 0; x < width; x++)
+                columns[x] += row[x];
+        }
+
+        // Horizontal: sum groups of columns
+        T *out = target + size_t(y) * outWidth;
+        if (!bayer && binX == 2)
+        {
+            for (uint32_t x = 0; x < outWidth; x++)
+                out[x] = store<T, Acc>(columns[2 * x] + columns[2 * x + 1], 2 * rows.count, mode);
+        }
+        else
+        {
+            for (uint32_t x = 0; x < outWidth; x++)
+            {
+                const Span &span = spans[x];
+                Acc sum = 0;
+                for (uint32_t l = 0; l < span.count; l++)
+                    sum += columns[span.first + l * span.step];
+                out[x] = store<T, Acc>(sum, span.count * rows.count, mode);
+            }
+        }
+    }
+}
+
+template <typename T, typename Acc>
+void binBands(const void *source, void *target, uint32_t width, uint32_t height, uint32_t binX, uint32_t binY,
+              FrameBinning::Mode mode, bool bayer, unsigned threads)
+{
+    const uint32_t outHeight = height / binY;
+    const T *in = static_cast<const T *>(source);
+    T *out = static_cast<T *>(target);
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t bands = std::max<size_t>(1, std::min<size_t>({threads, size_t(width) * height / minPixelsPerBand, outHeight}));
+    uint32_t bandRows = (outHeight + bands - 1) / bands;
+
+    // Bands write disjoint output rows, band 0 runs on the calling thread
+    std::vector<std::thread> workers;
+    for (size_t band = 1; band < bands; band++)
+    {
+        uint32_t begin = std::min<uint32_t>(outHeight, band * bandRows);
+        uint32_t end = std::min<uint32_t>(outHeight, begin + bandRows);
+        workers.emplace_back(binRows<T, Acc>, in, out, width, height, binX, binY, mode, bayer, begin, end);
+    }
+
+    binRows<T, Acc>(in, out, width, height, binX, binY, mode, bayer, 0, std::min(outHeight, bandRows));
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+}
+
+bool FrameBinning::bin(const void *source, void *target, int bpp, uint32_t width, uint32_t height,
+                       uint32_t binX, uint32_t binY, Mode mode, bool bayer, unsigned threads)
+{
+    if (binX == 0 || binY == 0 || width / binX == 0 || height / binY == 0)
+        return false;
+
+    // 32 bit accumulators hold up to 65536 binned 16 bit pixels
+    bool wide = uint64_t(binX) * binY > 65536;
+
+    switch (bpp)
+    {
+        case 8:
+            binBands<uint8_t, uint32_t>(source, target, width, height, binX, binY, mode, bayer, threads);
+            return true;
+        case 16:
+            if (wide)
+                binBands<uint16_t, uint64_t>(source, target, width, height, binX, binY, mode, bayer, threads);
+            else
+                binBands<uint16_t, uint32_t>(source, target, width, height, binX, binY, mode, bayer, threads);
+            return true;
+        case 32:
+            binBands<uint32_t, uint64_t>(source, target, width, height, binX, binY, mode, bayer, threads);
+            return true;
+        case -32:
+            binBands<float, float>(source, target, width, height, binX, binY, mode, bayer, threads);
+            return true;
+        default:
+            return false;
+    }
+}
+
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace INDI
+{
+
+/**
+ * @brief The FrameBinning class bins image buffers in software.
+ *
+ * Each output row first sums its BinY input rows into a row accumulator, then sums groups of BinX
+ * columns of that accumulator. Both loops run over contiguous memory and are vectorized by the compiler.
+ * Output rows are split in bands, each on its own thread. Saturation is applied once per output pixel.
+ *
+ * In Bayer mode, pixels are only binned with pixels of the same color, so the output keeps the 2x2
+ * Bayer pattern of the input.
+ */
+class FrameBinning
+{
+    public:
+        typedef enum
+        {
+            /** Sum of the binned pixels, saturated to the pixel type. */
+            SUM,
+            /** Sum divided by BinX * BinY, rounded down. */
+            AVERAGE
+        } Mode;
+
+        /**
+         * @brief bin Bin a frame.
+         * @param source Input frame, width x height pixels.
+         * @param target Output frame, (width / binX) x (height / binY) pixels. Must not overlap the source.
+         * @param bpp Bits per pixel: 8, 16 or 32 for unsigned integers, -32 for float.
+         * @param width Input width in pixels.
+         * @param height Input height in pixels.
+         * @param binX Horizontal binning.
+         * @param binY Vertical binning.
+         * @param mode Sum or average of the binned pixels.
+         * @param bayer True to bin a 2x2 Bayer frame color by color.
+         * @param threads Maximum number of threads, 0 for one per core.
+         * @return False if the pixel depth is not supported, or the binning leaves no output pixel.
+         */
+        static bool bin(const void *source, void *target, int bpp, uint32_t width, uint32_t height,
+                        uint32_t binX, uint32_t binY, Mode mode, bool bayer = false, unsigned threads = 0);
+};
+
+}
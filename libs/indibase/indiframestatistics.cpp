@@ -0,0 +1,282 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#include "indiframestatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace INDI
+{
+
+namespace
+{
+
+// Below this, a thread costs more than it saves
+constexpr size_t minSamplesPerBand = 1 << 20;
+
+size_t bandCount(size_t count, unsigned threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    return std::max<size_t>(1, std::min<size_t>(threads, count / minSamplesPerBand));
+}
+
+// Run task(band, begin, end) on each band, band 0 on the calling thread
+void forEachBand(size_t count, size_t bands, const std::function<void(size_t, size_t, size_t)> &task)
+{
+    std::vector<std::thread> workers;
+    size_t bandSize = (count + bands - 1) / bands;
+
+    for (size_t band = 1; band < bands; band++)
+    {
+        size_t begin = std::min(count, band * bandSize);
+        size_t end = std::min(count, begin + bandSize);
+        workers.emplace_back(task, band, begin, end);
+    }
+
+    task(0, 0, std::min(count, bandSize));
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+// 8 and 16 bit: a count of every possible value gives everything else
+template <typename T>
+void computeExact(const T *samples, size_t count, size_t bins, unsigned threads, FrameStatistics &stats)
+{
+    constexpr size_t values = size_t(1) << (8 * sizeof(T));
+    size_t bands = bandCount(count, threads);
+    std::vector<std::vector<uint32_t>> partial(bands);
+
+    forEachBand(count, bands, [&](size_t band, size_t begin, size_t end)
+    {
+        // Two interleaved tables, so runs of equal values do not wait on the same counter
+        std::vector<uint32_t> &hist = partial[band];
+        hist.assign(2 * values, 0);
+        uint32_t *even = hist.data();
+        uint32_t *odd = hist.data() + values;
+
+        size_t i = begin;
+        for (; i + 1 < end; i += 2)
+        {
+            even[samples[i]]++;
+            odd[samples[i + 1]]++;
+        }
+        if (i < end)
+            even[samples[i]]++;
+    });
+
+    std::vector<uint64_t> hist(values, 0);
+    for (auto &table : partial)
+        for (size_t v = 0; v < values; v++)
+            hist[v] += uint64_t(table[v]) + table[v + values];
+
+    size_t lo = 0, hi = values - 1;
+    while (hist[lo] == 0)
+        lo++;
+    while (hist[hi] == 0)
+        hi--;
+
+    double sum = 0, sumSquares = 0;
+    uint64_t seen = 0;
+    uint64_t lowerRank = (count - 1) / 2, upperRank = count / 2;
+    double lowerMedian = 0, upperMedian = 0;
+    size_t range = hi - lo + 1;
+    stats.histogram.assign(bins, 0);
+
+    for (size_t v = lo; v <= hi; v++)
+    {
+        if (hist[v] == 0)
+            continue;
+
+        sum += double(v) * hist[v];
+        sumSquares += double(v) * v * hist[v];
+
+        if (seen <= lowerRank && lowerRank < seen + hist[v])
+            lowerMedian = v;
+        if (seen <= upperRank && upperRank < seen + hist[v])
+            upperMedian = v;
+        seen += hist[v];
+
+        stats.histogram[(v - lo) * bins / range] += hist[v];
+    }
+
+    stats.min = lo;
+    stats.max = hi;
+    stats.mean = sum / count;
+    stats.stddev = std::sqrt(std::max(0.0, sumSquares / count - stats.mean * stats.mean));
+    stats.median = (lowerMedian + upperMedian) / 2;
+    stats.binWidth = double(range) / bins;
+}
+
+// 32 bit and float: range first, then histogram within it
+template <typename T>
+void computeBinned(const T *samples, size_t count, size_t bins, unsigned threads, FrameStatistics &stats)
+{
+    struct Partial
+    {
+        T min, max;
+        double sum, sumSquares;
+        std::vector<uint32_t> hist;
+    };
+
+    size_t bands = bandCount(count, threads);
+    std::vector<Partial> partial(bands);
+
+    forEachBand(count, bands, [&](size_t band, size_t begin, size_t end)
+    {
+        // Independent lanes the compiler can keep in vector registers
+        constexpr size_t lanes = 8;
+        T mins[lanes], maxs[lanes];
+        double sums[lanes] = {0}, squares[lanes] = {0};
+        std::fill(mins, mins + lanes, samples[begin]);
+        std::fill(maxs, maxs + lanes, samples[begin]);
+
+        size_t i = begin;
+        for (; i + lanes <= end; i += lanes)
+        {
+            for (size_t l = 0; l < lanes; l++)
+            {
+                T v = samples[i + l];
+                mins[l] = std::min(mins[l], v);
+                maxs[l] = std::max(maxs[l], v);
+                sums[l] += double(v);
+                squares[l] += double(v) * double(v);
+            }
+        }
+        for (; i < end; i++)
+        {
+            T v = samples[i];
+            mins[0] = std::min(mins[0], v);
+            maxs[0] = std::max(maxs[0], v);
+            sums[0] += double(v);
+            squares[0] += double(v) * double(v);
+        }
+
+        Partial &p = partial[band];
+        p.min = *std::min_element(mins, mins + lanes);
+        p.max = *std::max_element(maxs, maxs + lanes);
+        p.sum = p.sumSquares = 0;
+        for (size_t l = 0; l < lanes; l++)
+        {
+            p.sum += sums[l];
+            p.sumSquares += squares[l];
+        }
+    });
+
+    T lo = partial[0].min, hi = partial[0].max;
+    double sum = 0, sumSquares = 0;
+    for (auto &p : partial)
+    {
+        lo = std::min(lo, p.min);
+        hi = std::max(hi, p.max);
+        sum += p.sum;
+        sumSquares += p.sumSquares;
+    }
+
+    // Integers: bins of whole values, as for 8 and 16 bit frames
+    bool integral = std::numeric_limits<T>::is_integer;
+    double range = integral ? double(hi) - double(lo) + 1 : double(hi) - double(lo);
+    double scale = range > 0 ? bins / range : 0;
+
+    forEachBand(count, bands, [&](size_t band, size_t begin, size_t end)
+    {
+        std::vector<uint32_t> &hist = partial[band].hist;
+        hist.assign(bins, 0);
+        for (size_t i = begin; i < end; i++)
+        {
+            size_t bin = size_t((double(samples[i]) - double(lo)) * scale);
+            hist[std::min(bin, bins - 1)]++;
+        }
+    });
+
+    stats.histogram.assign(bins, 0);
+    for (auto &p : partial)
+        for (size_t b = 0; b < bins; b++)
+            stats.histogram[b] += p.hist[b];
+
+    stats.min = lo;
+    stats.max = hi;
+    stats.mean = sum / count;
+    stats.stddev = std::sqrt(std::max(0.0, sumSquares / count - stats.mean * stats.mean));
+    stats.binWidth = range / bins;
+
+    // Median, interpolated within its bin
+    double target = count / 2.0, seen = 0;
+    stats.median = lo;
+    for (size_t b = 0; b < bins; b++)
+    {
+        if (seen + stats.histogram[b] >= target && stats.histogram[b] > 0)
+        {
+            stats.median = double(lo) + (b + (target - seen) / stats.histogram[b]) * stats.binWidth;
+            break;
+        }
+        seen += stats.histogram[b];
+    }
+}
+
+}
+
+FrameStatistics FrameStatistics::compute(const void *buffer, SampleType type, size_t count, size_t bins, unsigned threads)
+{
+    FrameStatistics stats;
+    stats.count = count;
+
+    if (buffer == nullptr || count == 0 || bins == 0)
+        return stats;
+
+    switch (type)
+    {
+        case UINT8:
+            computeExact(static_cast<const uint8_t *>(buffer), count, bins, threads, stats);
+            break;
+        case UINT16:
+            computeExact(static_cast<const uint16_t *>(buffer), count, bins, threads, stats);
+            break;
+        case UINT32:
+            computeBinned(static_cast<const uint32_t *>(buffer), count, bins, threads, stats);
+            break;
+        case FLOAT32:
+            computeBinned(static_cast<const float *>(buffer), count, bins, threads, stats);
+            break;
+    }
+
+    return stats;
+}
+
+FrameStatistics::SampleType FrameStatistics::typeFromBPP(int bpp)
+{
+    switch (bpp)
+    {
+        case 8:
+            return UINT8;
+        case 32:
+            return UINT32;
+        case -32:
+            return FLOAT32;
+        default:
+            return UINT16;
+    }
+}
+
+}
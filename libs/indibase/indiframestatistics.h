@@ -0,0 +1,67 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace INDI
+{
+
+/**
+ * @brief The FrameStatistics class holds the statistics of an image buffer: minimum, maximum, mean,
+ * standard deviation, median and a histogram.
+ *
+ * 8 and 16 bit frames are read once, into a histogram of every possible value, so the median is exact.
+ * 32 bit and float frames are read twice, the second time to bin the values between minimum and maximum;
+ * their median is interpolated within its bin. Large frames are split in bands, each on its own thread.
+ */
+class FrameStatistics
+{
+    public:
+        typedef enum { UINT8, UINT16, UINT32, FLOAT32 } SampleType;
+
+        /**
+         * @brief compute Get the statistics of a buffer.
+         * @param buffer Samples, in native byte order.
+         * @param type Type of the samples.
+         * @param count Number of samples.
+         * @param bins Number of histogram bins, spread between minimum and maximum.
+         * @param threads Maximum number of threads, 0 for one per core.
+         */
+        static FrameStatistics compute(const void *buffer, SampleType type, size_t count, size_t bins = 256,
+                                       unsigned threads = 0);
+
+        /** @return Sample type of a CCD chip with the given bits per pixel. */
+        static SampleType typeFromBPP(int bpp);
+
+        double min {0};
+        double max {0};
+        double mean {0};
+        double stddev {0};
+        double median {0};
+        size_t count {0};
+
+        /** @brief Histogram of the samples, bin i holds values from min + i * binWidth. */
+        std::vector<uint32_t> histogram;
+        double binWidth {0};
+};
+
+}
@@ -0,0 +1,644 @@
+/*******************************************************************************
+ Copyright(c) 2026 INDI Library contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#include "indilivestacker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <type_traits>
+
+namespace INDI
+{
+
+namespace
+{
+
+// Below this, a thread costs more than it saves
+constexpr size_t minSamplesPerBand = 1 << 18;
+
+// Kappa-sigma rejection starts once a pixel has this many samples
+constexpr float minSigmaSamples = 4;
+
+// Stars used for registration, and the brightest of them tried as anchors of the offset
+constexpr size_t maxStars = 32;
+constexpr size_t anchorStars = 8;
+// Distance in pixels under which a star of the frame matches a star of the reference
+constexpr float matchTolerance = 2;
+
+// Largest side of the square compared by phase correlation
+constexpr uint32_t maxPhaseSize = 256;
+
+size_t bandCount(size_t rows, size_t samples, unsigned threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    return std::max<size_t>(1, std::min<size_t>({threads, samples / minSamplesPerBand, rows}));
+}
+
+// Run task(begin, end) on each band of rows, band 0 on the calling thread
+void forEachBand(size_t rows, size_t bands, const std::function<void(size_t, size_t)> &task)
+{
+    std::vector<std::thread> workers;
+    size_t bandRows = (rows + bands - 1) / bands;
+
+    for (size_t band = 1; band < bands; band++)
+    {
+        size_t begin = std::min(rows, band * bandRows);
+        size_t end = std::min(rows, begin + bandRows);
+        workers.emplace_back(task, begin, end);
+    }
+
+    task(0, std::min(rows, bandRows));
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+// Call f with the buffer cast to its sample type
+template <typename F>
+void dispatch(const void *buffer, FrameStatistics::SampleType type, F f)
+{
+    switch (type)
+    {
+        case FrameStatistics::UINT8:
+            f(static_cast<const uint8_t *>(buffer));
+            break;
+        case FrameStatistics::UINT16:
+            f(static_cast<const uint16_t *>(buffer));
+            break;
+        case FrameStatistics::UINT32:
+            f(static_cast<const uint32_t *>(buffer));
+            break;
+        case FrameStatistics::FLOAT32:
+            f(static_cast<const float *>(buffer));
+            break;
+    }
+}
+
+template <typename F>
+void dispatch(void *buffer, FrameStatistics::SampleType type, F f)
+{
+    switch (type)
+    {
+        case FrameStatistics::UINT8:
+            f(static_cast<uint8_t *>(buffer));
+            break;
+        case FrameStatistics::UINT16:
+            f(static_cast<uint16_t *>(buffer));
+            break;
+        case FrameStatistics::UINT32:
+            f(static_cast<uint32_t *>(buffer));
+            break;
+        case FrameStatistics::FLOAT32:
+            f(static_cast<float *>(buffer));
+            break;
+    }
+}
+
+/********************************************************************************
+ * Accumulator
+ ********************************************************************************/
+
+template <typename T>
+void accumulateMean(const T *in, float *mean, float *count, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        float c = count[i] + 1;
+        mean[i] += (float(in[i]) - mean[i]) / c;
+        count[i] = c;
+    }
+}
+
+// Welford update of the samples within kappa sigma, written without branches so it vectorizes
+template <typename T>
+void accumulateSigma(const T *in, float *mean, float *m2, float *count, size_t n, float kappa2)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        float x = in[i];
+        float c = count[i];
+        float d = x - mean[i];
+        // d^2 <= kappa^2 * m2 / c, a pixel with no spread yet takes anything
+        bool keep = c < minSigmaSamples || m2[i] == 0 || d * d * c <= kappa2 * m2[i];
+        float w = keep ? 1.0f : 0.0f;
+        float c1 = c + w;
+        float m = mean[i] + w * d / std::max(c1, 1.0f);
+        m2[i] += w * d * (x - m);
+        mean[i] = m;
+        count[i] = c1;
+    }
+}
+
+template <typename T>
+void render(const float *mean, T *out, size_t n)
+{
+    if (std::is_floating_point<T>::value)
+    {
+        for (size_t i = 0; i < n; i++)
+            out[i] = mean[i];
+        return;
+    }
+
+    const float high = float(std::numeric_limits<T>::max());
+    for (size_t i = 0; i < n; i++)
+        out[i] = T(std::min(std::max(mean[i] + 0.5f, 0.0f), high));
+}
+
+/********************************************************************************
+ * Star registration
+ ********************************************************************************/
+
+// Median and standard deviation of the background, from the median absolute deviation of a sample
+void background(const std::vector<float> &image, float &median, float &sigma)
+{
+    size_t step = std::max<size_t>(1, image.size() / 65536);
+    std::vector<float> sample;
+    sample.reserve(image.size() / step + 1);
+    for (size_t i = 0; i < image.size(); i += step)
+        sample.push_back(image[i]);
+
+    auto middle = sample.begin() + sample.size() / 2;
+    std::nth_element(sample.begin(), middle, sample.end());
+    median = *middle;
+
+    for (auto &value : sample)
+        value = std::fabs(value - median);
+    std::nth_element(sample.begin(), middle, sample.end());
+    sigma = 1.4826f * *middle;
+}
+
+std::vector<LiveStacker::Star> findStars(const std::vector<float> &image, uint32_t width, uint32_t height)
+{
+    std::vector<LiveStacker::Star> stars;
+    constexpr int radius = 3;
+    if (width <= 2 * radius + 2 || height <= 2 * radius + 2)
+        return stars;
+
+    float median, sigma;
+    background(image, median, sigma);
+    const float threshold = median + 5 * sigma;
+
+    // Local maxima above the threshold, strictly above the pixels before them so plateaus count once
+    const long stride = width;
+    for (long y = radius; y < long(height) - radius; y++)
+    {
+        const float *row = image.data() + y * stride;
+        for (long x = radius; x < stride - radius; x++)
+        {
+            float v = row[x];
+            if (v <= threshold)
+                continue;
+            if (v <= row[x - 1] || v < row[x + 1] ||
+                    v <= row[x - stride - 1] || v <= row[x - stride] || v <= row[x - stride + 1] ||
+                    v < row[x + stride - 1] || v < row[x + stride] || v < row[x + stride + 1])
+                continue;
+
+            // Centroid of the window above the background
+            float sum = 0, sx = 0, sy = 0;
+            for (long j = -radius; j <= radius; j++)
+                for (long i = -radius; i <= radius; i++)
+                {
+                    float w = std::max(0.0f, row[x + i + j * stride] - median);
+                    sum += w;
+                    sx += w * i;
+                    sy += w * j;
+                }
+            if (sum > 0)
+                stars.push_back({x + sx / sum, y + sy / sum, sum});
+        }
+    }
+
+    std::sort(stars.begin(), stars.end(), [](const LiveStacker::Star & a, const LiveStacker::Star & b)
+    {
+        return a.flux > b.flux;
+    });
+
+    // Keep the brightest, away from each other
+    std::vector<LiveStacker::Star> kept;
+    for (const auto &star : stars)
+    {
+        bool isolated = std::none_of(kept.begin(), kept.end(), [&](const LiveStacker::Star & other)
+        {
+            return std::fabs(star.x - other.x) < 2 * radius && std::fabs(star.y - other.y) < 2 * radius;
+        });
+        if (isolated)
+            kept.push_back(star);
+        if (kept.size() == maxStars)
+            break;
+    }
+    return kept;
+}
+
+// Reference stars matching a star of the frame once shifted by (dx, dy), and their mean offset
+size_t matchStars(const std::vector<LiveStacker::Star> &reference, const std::vector<LiveStacker::Star> &stars,
+                  float dx, float dy, float *meanX = nullptr, float *meanY = nullptr)
+{
+    size_t matches = 0;
+    float sumX = 0, sumY = 0;
+    for (const auto &r : reference)
+    {
+        for (const auto &s : stars)
+        {
+            float ex = s.x - r.x - dx, ey = s.y - r.y - dy;
+            if (ex * ex + ey * ey < matchTolerance * matchTolerance)
+            {
+                matches++;
+                sumX += s.x - r.x;
+                sumY += s.y - r.y;
+                break;
+            }
+        }
+    }
+    if (meanX && matches > 0)
+    {
+        *meanX = sumX / matches;
+        *meanY = sumY / matches;
+    }
+    return matches;
+}
+
+// Offset voted by most star pairs, each bright reference star being tried against every star of the frame
+bool starOffset(const std::vector<LiveStacker::Star> &reference, const std::vector<LiveStacker::Star> &stars,
+                float &dx, float &dy)
+{
+    size_t needed = std::min<size_t>(3, std::min(reference.size(), stars.size()));
+    size_t best = 0;
+
+    if (needed == 0)
+        return false;
+
+    for (size_t a = 0; a < std::min(anchorStars, reference.size()); a++)
+    {
+        for (const auto &s : stars)
+        {
+            float cx = s.x - reference[a].x, cy = s.y - reference[a].y;
+            size_t matches = matchStars(reference, stars, cx, cy);
+            if (matches > best)
+            {
+                best = matches;
+                dx = cx;
+                dy = cy;
+            }
+        }
+    }
+
+    if (best < needed)
+        return false;
+
+    // Refine from all the pairs
+    matchStars(reference, stars, dx, dy, &dx, &dy);
+    return true;
+}
+
+/********************************************************************************
+ * Phase correlation
+ ********************************************************************************/
+
+typedef std::complex<float> Complex;
+
+// In place radix-2 FFT of n values, n a power of two
+void fft(Complex *data, size_t n, bool inverse)
+{
+    for (size_t i = 1, j = 0; i < n; i++)
+    {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(data[i], data[j]);
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        double angle = (inverse ? 2 : -2) * M_PI / len;
+        Complex step(std::cos(angle), std::sin(angle));
+        for (size_t i = 0; i < n; i += len)
+        {
+            Complex w(1);
+            for (size_t k = 0; k < len / 2; k++)
+            {
+                Complex u = data[i + k];
+                Complex v = data[i + k + len / 2] * w;
+                data[i + k] = u + v;
+                data[i + k + len / 2] = u - v;
+                w *= step;
+            }
+        }
+    }
+}
+
+void fft2(std::vector<Complex> &data, size_t n, bool inverse)
+{
+    std::vector<Complex> column(n);
+    for (size_t y = 0; y < n; y++)
+        fft(data.data() + y * n, n, inverse);
+    for (size_t x = 0; x < n; x++)
+    {
+        for (size_t y = 0; y < n; y++)
+            column[y] = data[y * n + x];
+        fft(column.data(), n, inverse);
+        for (size_t y = 0; y < n; y++)
+            data[y * n + x] = column[y];
+    }
+}
+
+uint32_t phaseSize(uint32_t width, uint32_t height)
+{
+    uint32_t n = 1;
+    while (2 * n <= std::min({width, height, maxPhaseSize}))
+        n *= 2;
+    return n;
+}
+
+// Spectrum of the central square of the image, without its mean and through a Hann window against edge effects
+std::vector<Complex> spectrum(const std::vector<float> &image, uint32_t width, uint32_t height)
+{
+    const uint32_t n = phaseSize(width, height);
+    const uint32_t x0 = (width - n) / 2, y0 = (height - n) / 2;
+    std::vector<float> window(n);
+    for (uint32_t i = 0; i < n; i++)
+        window[i] = 0.5f - 0.5f * std::cos(2 * M_PI * i / n);
+
+    double mean = 0;
+    for (uint32_t y = 0; y < n; y++)
+        for (uint32_t x = 0; x < n; x++)
+            mean += image[size_t(y0 + y) * width + x0 + x];
+    mean /= double(n) * n;
+
+    std::vector<Complex> data(size_t(n) * n);
+    for (uint32_t y = 0; y < n; y++)
+        for (uint32_t x = 0; x < n; x++)
+            data[y * n + x] = float(image[size_t(y0 + y) * width + x0 + x] - mean) * window[x] * window[y];
+
+    fft2(data, n, false);
+    return data;
+}
+
+bool phaseOffset(const std::vector<Complex> &reference, const std::vector<Complex> &frame, uint32_t n, int &dx, int &dy)
+{
+    // Normalized cross power spectrum, its inverse peaks at the offset
+    std::vector<Complex> cross(frame.size());
+    for (size_t i = 0; i < cross.size(); i++)
+    {
+        Complex c = frame[i] * std::conj(reference[i]);
+        float magnitude = std::abs(c);
+        cross[i] = magnitude > 0 ? c / magnitude : Complex(0);
+    }
+    fft2(cross, n, true);
+
+    size_t peak = 0;
+    double total = 0;
+    for (size_t i = 0; i < cross.size(); i++)
+    {
+        total += std::fabs(cross[i].real());
+        if (cross[i].real() > cross[peak].real())
+            peak = i;
+    }
+
+    // A flat correlation means nothing in common
+    if (!(cross[peak].real() > 10 * total / cross.size()))
+        return false;
+
+    dx = int(peak % n);
+    dy = int(peak / n);
+    if (dx > int(n / 2))
+        dx -= n;
+    if (dy > int(n / 2))
+        dy -= n;
+    return true;
+}
+
+}
+
+LiveStacker::LiveStacker()
+{
+}
+
+uint32_t LiveStacker::channels(INDI_PIXEL_FORMAT format)
+{
+    switch (format)
+    {
+        case INDI_RGB:
+        case INDI_BGR:
+            // The order of the channels does not matter, registration uses their sum
+            return 3;
+        case INDI_JPG:
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+void LiveStacker::setAlignment(Alignment alignment)
+{
+    if (alignment != m_Alignment)
+        reset();
+    m_Alignment = alignment;
+}
+
+void LiveStacker::setRejection(Rejection rejection, double kappa)
+{
+    if (rejection != m_Rejection)
+        reset();
+    m_Rejection = rejection;
+    m_Kappa = kappa;
+}
+
+void LiveStacker::setBayer(bool bayer)
+{
+    if (bayer != m_Bayer)
+        reset();
+    m_Bayer = bayer;
+}
+
+void LiveStacker::reset()
+{
+    m_Width = m_Height = m_Channels = 0;
+    m_Mean.clear();
+    m_M2.clear();
+    m_Count.clear();
+    m_ReferenceStars.clear();
+    m_ReferenceSpectrum.clear();
+    m_Frames = 0;
+    m_Rejected = 0;
+    m_OffsetX = m_OffsetY = 0;
+}
+
+bool LiveStacker::registerFrame(const std::vector<float> &luminance, int &dx, int &dy)
+{
+    dx = dy = 0;
+
+    switch (m_Alignment)
+    {
+        case ALIGN_NONE:
+            return true;
+
+        case ALIGN_STARS:
+        {
+            auto stars = findStars(luminance, m_Width, m_Height);
+            if (m_Frames == 0)
+            {
+                m_ReferenceStars = std::move(stars);
+                return true;
+            }
+
+            float x = 0, y = 0;
+            if (!starOffset(m_ReferenceStars, stars, x, y))
+                return false;
+            dx = int(std::lround(x));
+            dy = int(std::lround(y));
+            return true;
+        }
+
+        case ALIGN_PHASE:
+        {
+            // Too small to correlate
+            if (phaseSize(m_Width, m_Height) < 16)
+                return true;
+
+            auto frame = spectrum(luminance, m_Width, m_Height);
+            if (m_Frames == 0)
+            {
+                m_ReferenceSpectrum = std::move(frame);
+                return true;
+            }
+            return phaseOffset(m_ReferenceSpectrum, frame, phaseSize(m_Width, m_Height), dx, dy);
+        }
+    }
+    return false;
+}
+
+bool LiveStacker::addFrame(const void *buffer, FrameStatistics::SampleType type, uint32_t width, uint32_t height,
+                           uint32_t channels, bool planar)
+{
+    if (width == 0 || height == 0 || channels == 0)
+        return false;
+    if (channels == 1)
+        planar = false;
+
+    if (width != m_Width || height != m_Height || channels != m_Channels || planar != m_Planar)
+    {
+        reset();
+        m_Width = width;
+        m_Height = height;
+        m_Channels = channels;
+        m_Planar = planar;
+    }
+
+    const size_t pixels = size_t(width) * height;
+    const size_t samples = pixels * channels;
+    const bool sigma = m_Rejection == REJECT_SIGMA;
+
+    if (m_Mean.empty())
+    {
+        m_Mean.assign(samples, 0);
+        m_Count.assign(samples, 0);
+        if (sigma)
+            m_M2.assign(samples, 0);
+    }
+
+    int dx = 0, dy = 0;
+    if (m_Alignment != ALIGN_NONE)
+    {
+        // Registration works on the mean of the channels
+        std::vector<float> luminance(pixels, 0);
+        dispatch(buffer, type, [&](auto in)
+        {
+            const size_t pixelStride = planar ? 1 : channels;
+            const size_t channelStride = planar ? pixels : 1;
+            for (uint32_t c = 0; c < channels; c++)
+                for (size_t i = 0; i < pixels; i++)
+                    luminance[i] += float(in[i * pixelStride + c * channelStride]);
+        });
+
+        if (!registerFrame(luminance, dx, dy))
+        {
+            m_Rejected++;
+            return false;
+        }
+
+        if (m_Bayer)
+        {
+            dx = 2 * int(std::lround(dx / 2.0));
+            dy = 2 * int(std::lround(dy / 2.0));
+        }
+    }
+    m_OffsetX = dx;
+    m_OffsetY = dy;
+
+    // Pixel (x, y) of the stack is pixel (x + dx, y + dy) of the frame, only the overlap is added
+    const long x0 = std::max(0, -dx), x1 = std::min<long>(width, long(width) - dx);
+    const long y0 = std::max(0, -dy), y1 = std::min<long>(height, long(height) - dy);
+    if (x0 >= x1 || y0 >= y1)
+    {
+        m_Rejected++;
+        return false;
+    }
+
+    // Planes are processed as mono frames, interleaved channels as wider rows
+    const size_t planes = planar ? channels : 1;
+    const size_t spp = planar ? 1 : channels;
+    const size_t rowSamples = size_t(width) * spp;
+    const size_t span = size_t(x1 - x0) * spp;
+    const float kappa2 = m_Kappa * m_Kappa;
+
+    dispatch(buffer, type, [&](auto in)
+    {
+        forEachBand(size_t(y1 - y0), bandCount(size_t(y1 - y0), samples, m_Threads), [&](size_t begin, size_t end)
+        {
+            for (size_t p = 0; p < planes; p++)
+            {
+                for (size_t row = begin; row < end; row++)
+                {
+                    const size_t y = y0 + row;
+                    const size_t target = p * pixels + y * rowSamples + x0 * spp;
+                    const size_t source = p * pixels + (y + dy) * rowSamples + (x0 + dx) * spp;
+
+                    if (sigma)
+                        accumulateSigma(in + source, m_Mean.data() + target, m_M2.data() + target,
+                                        m_Count.data() + target, span, kappa2);
+                    else
+                        accumulateMean(in + source, m_Mean.data() + target, m_Count.data() + target, span);
+                }
+            }
+        });
+    });
+
+    m_Frames++;
+    return true;
+}
+
+bool LiveStacker::getStack(void *buffer, FrameStatistics::SampleType type) const
+{
+    if (m_Frames == 0)
+        return false;
+
+    dispatch(buffer, type, [&](auto out)
+    {
+        render(m_Mean.data(), out, m_Mean.size());
+    });
+    return true;
+}
+
+}
@@ -27,6 +27,7 @@
 #include "stream/streammanager.h"
 #include "locale_compat.h"
 #include "indiutility.h"
+#include "indiframestatistics.h"
 
 #include <fitsio.h>
 
@@ -34,6 +35,7 @@
 #include <libnova/ln_types.h>
 #include <libnova/precession.h>
 
+#include <algorithm>
 #include <regex>
 
 #include <dirent.h>
@@ -1053,112 +1055,36 @@ bool SensorInterface::saveConfigItems(FILE *fp)
 
 void SensorInterface::getMinMax(double *min, double *max, uint8_t *buf, int len, int bpp)
 {
-    int ind         = 0, i, j;
-    int integrationHeight = 1;
-    int integrationWidth  = len;
     double lmin = 0, lmax = 0;
 
     switch (bpp)
     {
         case 8:
-        {
-            uint8_t *integrationBuffer = static_cast<uint8_t *>(buf);
-            lmin = lmax = integrationBuffer[0];
-
-            for (i = 0; i < integrationHeight; i++)
-                for (j = 0; j < integrationWidth; j++)
-                {
-                    ind = (i * integrationWidth) + j;
-                    if (integrationBuffer[ind] < lmin)
-                        lmin = integrationBuffer[ind];
-                    else if (integrationBuffer[ind] > lmax)
-                        lmax = integrationBuffer[ind];
-                }
-        }
-        break;
-
         case 16:
-        {
-            uint16_t *integrationBuffer = reinterpret_cast<uint16_t *>(buf);
-            lmin = lmax = integrationBuffer[0];
-
-            for (i = 0; i < integrationHeight; i++)
-                for (j = 0; j < integrationWidth; j++)
-                {
-                    ind = (i * integrationWidth) + j;
-                    if (integrationBuffer[ind] < lmin)
-                        lmin = integrationBuffer[ind];
-                    else if (integrationBuffer[ind] > lmax)
-                        lmax = integrationBuffer[ind];
-                }
-        }
-        break;
-
         case 32:
+        case -32:
         {
-            uint32_t *integrationBuffer = reinterpret_cast<uint32_t *>(buf);
-            lmin = lmax = integrationBuffer[0];
-
-            for (i = 0; i < integrationHeight; i++)
-                for (j = 0; j < integrationWidth; j++)
-                {
-                    ind = (i * integrationWidth) + j;
-                    if (integrationBuffer[ind] < lmin)
-                        lmin = integrationBuffer[ind];
-                    else if (integrationBuffer[ind] > lmax)
-                        lmax = integrationBuffer[ind];
-                }
+            auto stats = FrameStatistics::compute(buf, FrameStatistics::typeFromBPP(bpp), len);
+            lmin = stats.min;
+            lmax = stats.max;
         }
         break;
 
         case 64:
         {
-            unsigned long *integrationBuffer = reinterpret_cast<unsigned long *>(buf);
-            lmin = lmax = integrationBuffer[0];
-
-            for (i = 0; i < integrationHeight; i++)
-                for (j = 0; j < integrationWidth; j++)
-                {
-                    ind = (i * integrationWidth) + j;
-                    if (integrationBuffer[ind] < lmin)
-                        lmin = integrationBuffer[ind];
-                    else if (integrationBuffer[ind] > lmax)
-                        lmax = integrationBuffer[ind];
-                }
-        }
-        break;
-
-        case -32:
-        {
-            double *integrationBuffer = reinterpret_cast<double *>(buf);
-            lmin = lmax = integrationBuffer[0];
-
-            for (i = 0; i < integrationHeight; i++)
-                for (j = 0; j < integrationWidth; j++)
-                {
-                    ind = (i * integrationWidth) + j;
-                    if (integrationBuffer[ind] < lmin)
-                        lmin = integrationBuffer[ind];
-                    else if (integrationBuffer[ind] > lmax)
-                        lmax = integrationBuffer[ind];
-                }
+            uint64_t *integrationBuffer = reinterpret_cast<uint64_t *>(buf);
+            auto range = std::minmax_element(integrationBuffer, integrationBuffer + len);
+            lmin = *range.first;
+            lmax = *range.second;
         }
         break;
 
         case -64:
         {
             double *integrationBuffer = reinterpret_cast<double *>(buf);
-            lmin = lmax = integrationBuffer[0];
-
-            for (i = 0; i < integrationHeight; i++)
-                for (j = 0; j < integrationWidth; j++)
-                {
-                    ind = (i * integrationWidth) + j;
-                    if (integrationBuffer[ind] < lmin)
-                        lmin = integrationBuffer[ind];
-                    else if (integrationBuffer[ind] > lmax)
-                        lmax = integrationBuffer[ind];
-                }
+            auto range = std::minmax_element(integrationBuffer, integrationBuffer + len);
+            lmin = *range.first;
+            lmax = *range.second;
         }
         break;
     }
@@ -105,6 +105,29 @@ void ccvt_yuyv_rgb24(int width, int height, const void *src, void *dst);
 /** 4:2:2 YUYV interlaced to 4:2:0 YUV planar */
 void ccvt_yuyv_420p(int width, int height, const void *src, void *dsty, void *dstu, void *dstv);
 
+/* Vectorized conversions. Planar RGB output is a full red plane, then green, then blue. */
+
+/** Byte order of packed 4:2:2 formats */
+typedef enum
+{
+    CCVT_422_YUYV,
+    CCVT_422_UYVY,
+    CCVT_422_YVYU,
+    CCVT_422_VYUY
+} ccvt_422_order;
+
+/** Packed 4:2:2 of any byte order, rows srcstride bytes apart, to contiguous YUYV. Pass a cropped src to crop. */
+void ccvt_422_yuyv(int width, int height, const void *src, int srcstride, ccvt_422_order order, void *dst);
+/** 4:2:2 YUYV interlaced to its Y plane */
+void ccvt_yuyv_y(int width, int height, const void *src, void *dsty);
+/** 4:2:2 YUYV interlaced to RGB24, or planar RGB if planar is set */
+void ccvt_yuyv_rgb(int width, int height, const void *src, void *dst, int planar);
+/** 4:2:0 YUV planar, from separate planes, to RGB24, or planar RGB if planar is set */
+void ccvt_420p_rgb(int width, int height, const void *srcy, const void *srcu, const void *srcv, void *dst,
+                   int planar);
+/** 16 bit samples, rows srcstride bytes apart, to contiguous rows. Bytes are swapped if swap is set. */
+void ccvt_y16_copy(int width, int height, const void *src, int srcstride, int swap, void *dst);
+
 /* RGB/BGR to 4:2:0 YUV interlaced */
 
 /** RGB/BGR to 4:2:0 YUV planar     */
@@ -178,6 +201,44 @@ int mjpegtoyuv420p(unsigned char *map, unsigned char *cap_map, int width, int he
  * SUCH DAMAGE.
  */
 
+/** Colour filter array layouts, named after the top left 2x2 pixels */
+typedef enum
+{
+    CCVT_CFA_RGGB,
+    CCVT_CFA_BGGR,
+    CCVT_CFA_GRBG,
+    CCVT_CFA_GBRG
+} ccvt_cfa;
+
+/** Demosaicing methods */
+typedef enum
+{
+    /** Average of the nearest pixels of each color */
+    CCVT_DEBAYER_BILINEAR,
+    /** As bilinear, but green is interpolated along the direction of the smallest gradient */
+    CCVT_DEBAYER_VNG_LITE
+} ccvt_debayer_method;
+
+typedef enum
+{
+    /** RGBRGB... */
+    CCVT_DEBAYER_INTERLEAVED,
+    /** Full red plane, then green, then blue */
+    CCVT_DEBAYER_PLANAR
+} ccvt_debayer_layout;
+
+/**
+ * @brief ccvt_debayer Demosaic a Bayer frame to RGB.
+ * @param dst Output, width x height x 3 samples of outbits.
+ * @param src Input, width x height samples, 8 bit if depth is 8, 16 bit otherwise.
+ * @param depth Significant bits per input sample, 8 to 16.
+ * @param outbits Bits per output sample, 8 or 16. Samples are shifted from depth to outbits.
+ * @param threads Maximum number of threads, 0 for one per core. Rows are split in bands, one per thread.
+ * @return 0 on success, -1 on invalid arguments. Width and height must be at least 2.
+ */
+int ccvt_debayer(void *dst, const void *src, long int width, long int height, int depth, int outbits,
+                 ccvt_cfa cfa, ccvt_debayer_method method, ccvt_debayer_layout layout, unsigned int threads);
+
 /** Bayer 8bit to RGB 24 */
 void bayer2rgb24(unsigned char *dst, unsigned char *src, long int WIDTH, long int HEIGHT);
 /** Bayer 16 bit to RGB 24 */
@@ -128,5 +128,7 @@ void ccvt_420p_rgb32(int width, int height, const void *src, void *dst)
 
 void ccvt_420p_rgb24(int width, int height, const void *src, void *dst)
 {
-    WHOLE_FUNC2RGB(rgb24)
+    const unsigned char *y = (const unsigned char *)src;
+    const unsigned char *u = y + width * height;
+    ccvt_420p_rgb(width, height, y, u, u + (width * height) / 4, dst, 0);
 }
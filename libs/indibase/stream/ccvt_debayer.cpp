@@ -0,0 +1,389 @@
+/*
+    Bayer demosaicing for CCVT
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+/*
+   A row of output is computed from the input row and its two neighbours. Rows and columns are
+   mirrored at the frame borders (row -1 is row 1), which keeps the CFA phase, so border pixels use
+   the same formulas as the rest of the frame.
+
+   The row kernel is vectorized as described in ccvt_vector.h. Averages are computed in the pixel
+   type, without widening, and are bit exact with the scalar code: floor((a + b) / 2) and
+   floor((a + b + c + d) / 4).
+*/
+
+#include "ccvt.h"
+#include "ccvt_vector.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+// Below this many pixels, a thread costs more than it saves
+constexpr size_t minPixelsPerBand = 1 << 18;
+
+struct Debayer
+{
+    const void *src;
+    void *dst;
+    long width;
+    long height;
+    int depth;
+    int outbits;
+    int redRow;
+    int redCol;
+    bool vng;
+    bool planar;
+};
+
+/********************************************************************************
+ * Scalar kernel, used for the first and last columns and without vector support
+ ********************************************************************************/
+
+template <typename T>
+inline void demosaicPixel(const T *up, const T *cur, const T *down, long x, long width, int site, bool vng,
+                          T *n, T *g, T *m)
+{
+    long l = x > 0 ? x - 1 : 1;
+    long r = x < width - 1 ? x + 1 : width - 2;
+
+    if ((x & 1) == site)
+    {
+        // Red or blue pixel: green around it, the other color on the diagonals
+        unsigned h = cur[l] + cur[r];
+        unsigned v = up[x] + down[x];
+        n[x] = cur[x];
+        m[x] = (up[l] + up[r] + down[l] + down[r]) >> 2;
+
+        if (vng)
+        {
+            unsigned dh = cur[l] > cur[r] ? cur[l] - cur[r] : cur[r] - cur[l];
+            unsigned dv = up[x] > down[x] ? up[x] - down[x] : down[x] - up[x];
+            g[x] = dh < dv ? h >> 1 : dv < dh ? v >> 1 : (h + v) >> 2;
+        }
+        else
+            g[x] = (h + v) >> 2;
+    }
+    else
+    {
+        // Green pixel: this row's color on the sides, the other one above and below
+        n[x] = (cur[l] + cur[r]) >> 1;
+        g[x] = cur[x];
+        m[x] = (up[x] + down[x]) >> 1;
+    }
+}
+
+/********************************************************************************
+ * Vector kernel
+ ********************************************************************************/
+
+#ifdef CCVT_VECTOR
+
+using namespace ccvt;
+
+// floor((a + b) / 2)
+template <typename V>
+VECTOR_INLINE V floorAverage(const V &a, const V &b)
+{
+    return (a & b) + ((a ^ b) >> 1);
+}
+
+// floor((a + b + c + d) / 4), from the averages of each pair and the bits they dropped
+template <typename V>
+VECTOR_INLINE V floorAverage4(const V &a, const V &b, const V &c, const V &d)
+{
+    V ab = floorAverage(a, b);
+    V cd = floorAverage(c, d);
+    V ceil = (ab | cd) - ((ab ^ cd) >> 1);
+    return ceil - ((ab ^ cd) & ~((a ^ b) & (c ^ d)) & 1);
+}
+
+template <typename V>
+VECTOR_INLINE V absDiff(const V &a, const V &b)
+{
+    return select((V)(a > b), a - b, b - a);
+}
+
+// Process columns [2, end) with vectors of Bytes bytes, return end
+template <typename T, int Bytes>
+VECTOR_INLINE long demosaicVector(const T *up, const T *cur, const T *down, long width, int site, bool vng,
+                                  T *n, T *g, T *m)
+{
+    typedef typename Vector<T, Bytes>::type V;
+    constexpr long lanes = Bytes / sizeof(T);
+
+    // Starting on an even column, the same lanes hold red or blue pixels in every vector
+    V siteMask;
+    for (long i = 0; i < lanes; i++)
+        siteMask[i] = (i & 1) == site ? T(~T(0)) : T(0);
+
+    long x = 2;
+    for (; x + lanes < width; x += lanes)
+    {
+        V c = load<V>(cur + x);
+        V l = load<V>(cur + x - 1);
+        V r = load<V>(cur + x + 1);
+        V u = load<V>(up + x);
+        V d = load<V>(down + x);
+
+        V h2 = floorAverage(l, r);
+        V v2 = floorAverage(u, d);
+        V diagonal = floorAverage4(load<V>(up + x - 1), load<V>(up + x + 1), load<V>(down + x - 1),
+                                   load<V>(down + x + 1));
+        V cross = floorAverage4(l, r, u, d);
+
+        if (vng)
+        {
+            V dh = absDiff(l, r);
+            V dv = absDiff(u, d);
+            cross = select((V)(dh < dv), h2, select((V)(dv < dh), v2, cross));
+        }
+
+        store(n + x, select(siteMask, c, h2));
+        store(g + x, select(siteMask, cross, c));
+        store(m + x, select(siteMask, diagonal, v2));
+    }
+    return x;
+}
+
+#ifdef CCVT_VECTOR_AVX2
+template <typename T>
+CCVT_TARGET_AVX2 long demosaicAVX2(const T *up, const T *cur, const T *down, long width, int site, bool vng,
+                                   T *n, T *g, T *m)
+{
+    return demosaicVector<T, 32>(up, cur, down, width, site, vng, n, g, m);
+}
+#endif
+
+#endif
+
+template <typename T>
+void demosaicRow(const T *up, const T *cur, const T *down, long width, int site, bool vng, T *n, T *g, T *m)
+{
+    long x = 2;
+
+#ifdef CCVT_VECTOR
+#ifdef CCVT_VECTOR_AVX2
+    if (haveAVX2())
+        x = demosaicAVX2(up, cur, down, width, site, vng, n, g, m);
+    else
+#endif
+        x = demosaicVector<T, 16>(up, cur, down, width, site, vng, n, g, m);
+#endif
+
+    for (long i = 0; i < std::min(2L, width); i++)
+        demosaicPixel(up, cur, down, i, width, site, vng, n, g, m);
+    for (; x < width; x++)
+        demosaicPixel(up, cur, down, x, width, site, vng, n, g, m);
+}
+
+/********************************************************************************
+ * Output
+ ********************************************************************************/
+
+// Move 16 bit samples from the input depth to the output bits, in place
+void shiftRow(uint16_t *row, long width, int shift)
+{
+    long x = 0;
+
+    // Vector shifts take one count for all lanes, scalar ones are slow with a variable count
+#ifdef CCVT_VECTOR
+    typedef Vector<uint16_t, 16>::type V;
+    if (shift > 0)
+    {
+        for (; x + 8 <= width; x += 8)
+            store(row + x, V(load<V>(row + x) << shift));
+    }
+    else
+    {
+        for (; x + 8 <= width; x += 8)
+            store(row + x, V(load<V>(row + x) >> -shift));
+    }
+#endif
+
+    for (; x < width; x++)
+        row[x] = shift > 0 ? row[x] << shift : row[x] >> -shift;
+}
+
+void shiftRow(uint8_t *, long, int)
+{
+}
+
+// Copy the red, green and blue rows to the output, 8 bit samples going to 16 bit are shifted up
+template <typename T, typename O>
+void storeRow(const T *r, const T *g, const T *b, long width, bool planar, size_t planeSize, O *out)
+{
+    constexpr int shift = sizeof(O) > sizeof(T) ? 8 : 0;
+
+    if (planar)
+    {
+        for (long x = 0; x < width; x++)
+        {
+            out[x] = O(r[x]) << shift;
+            out[planeSize + x] = O(g[x]) << shift;
+            out[2 * planeSize + x] = O(b[x]) << shift;
+        }
+    }
+    else
+    {
+        for (long x = 0; x < width; x++)
+        {
+            out[3 * x] = O(r[x]) << shift;
+            out[3 * x + 1] = O(g[x]) << shift;
+            out[3 * x + 2] = O(b[x]) << shift;
+        }
+    }
+}
+
+template <typename T, typename O>
+void demosaicRows(const Debayer &job, long begin, long end)
+{
+    const T *in = static_cast<const T *>(job.src);
+    O *out = static_cast<O *>(job.dst);
+    const long width = job.width;
+    const size_t planeSize = size_t(width) * job.height;
+
+    // 16 bit input is shifted before the output, 8 bit input only ever goes up to 16 bit
+    const int shift = sizeof(T) == 1 ? 0 : job.outbits - job.depth;
+
+    // Planar output of the input type is written in place, anything else goes through a row buffer
+    const bool direct = sizeof(T) == sizeof(O) && job.planar;
+    std::vector<T> buffer(direct ? 0 : 3 * width);
+
+    for (long y = begin; y < end; y++)
+    {
+        const T *cur = in + y * width;
+        const T *up = in + (y > 0 ? y - 1 : 1) * width;
+        const T *down = in + (y < job.height - 1 ? y + 1 : job.height - 2) * width;
+
+        T *r, *g, *b;
+        if (direct)
+        {
+            r = reinterpret_cast<T *>(out) + y * width;
+            g = r + planeSize;
+            b = g + planeSize;
+        }
+        else
+        {
+            r = buffer.data();
+            g = r + width;
+            b = g + width;
+        }
+
+        // Rows hold either red or blue with green, site is the column parity of red or blue
+        if ((y & 1) == job.redRow)
+            demosaicRow(up, cur, down, width, job.redCol, job.vng, r, g, b);
+        else
+            demosaicRow(up, cur, down, width, job.redCol ^ 1, job.vng, b, g, r);
+
+        if (shift != 0)
+        {
+            shiftRow(r, width, shift);
+            shiftRow(g, width, shift);
+            shiftRow(b, width, shift);
+        }
+
+        if (!direct)
+            storeRow(r, g, b, width, job.planar, planeSize, out + (job.planar ? y * width : 3 * y * width));
+    }
+}
+
+template <typename T, typename O>
+void demosaicBands(const Debayer &job, unsigned threads)
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t bands = std::max<size_t>(1, std::min<size_t>({threads, size_t(job.width) * job.height / minPixelsPerBand,
+                                    size_t(job.height)}));
+    long bandRows = (job.height + bands - 1) / bands;
+
+    // Bands write disjoint output rows, band 0 runs on the calling thread
+    std::vector<std::thread> workers;
+    for (size_t band = 1; band < bands; band++)
+    {
+        long begin = std::min<long>(job.height, band * bandRows);
+        long end = std::min<long>(job.height, begin + bandRows);
+        workers.emplace_back(demosaicRows<T, O>, std::cref(job), begin, end);
+    }
+
+    demosaicRows<T, O>(job, 0, std::min(job.height, bandRows));
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+}
+
+int ccvt_debayer(void *dst, const void *src, long int width, long int height, int depth, int outbits,
+                 ccvt_cfa cfa, ccvt_debayer_method method, ccvt_debayer_layout layout, unsigned int threads)
+{
+    if (width < 2 || height < 2 || depth < 8 || depth > 16 || (outbits != 8 && outbits != 16))
+        return -1;
+
+    Debayer job;
+    job.src = src;
+    job.dst = dst;
+    job.width = width;
+    job.height = height;
+    job.depth = depth;
+    job.outbits = outbits;
+    job.vng = method == CCVT_DEBAYER_VNG_LITE;
+    job.planar = layout == CCVT_DEBAYER_PLANAR;
+
+    switch (cfa)
+    {
+        case CCVT_CFA_RGGB:
+            job.redRow = 0;
+            job.redCol = 0;
+            break;
+        case CCVT_CFA_BGGR:
+            job.redRow = 1;
+            job.redCol = 1;
+            break;
+        case CCVT_CFA_GRBG:
+            job.redRow = 0;
+            job.redCol = 1;
+            break;
+        case CCVT_CFA_GBRG:
+            job.redRow = 1;
+            job.redCol = 0;
+            break;
+        default:
+            return -1;
+    }
+
+    if (depth == 8)
+    {
+        if (outbits == 8)
+            demosaicBands<uint8_t, uint8_t>(job, threads);
+        else
+            demosaicBands<uint8_t, uint16_t>(job, threads);
+    }
+    else
+    {
+        if (outbits == 8)
+            demosaicBands<uint16_t, uint8_t>(job, threads);
+        else
+            demosaicBands<uint16_t, uint16_t>(job, threads);
+    }
+
+    return 0;
+}
@@ -172,48 +172,7 @@ void ccvt_yuyv_bgr24(int width, int height, const void *src, void *dst)
 
 void ccvt_yuyv_rgb24(int width, int height, const void *src, void *dst)
 {
-    const unsigned char *s;
-    PIXTYPE_rgb24 *d;
-    int l, c;
-    int r, g, b, cr, cg, cb, y1, y2;
-
-    l = height;
-    s = src;
-    d = dst;
-    while (l--)
-    {
-        c = width >> 1;
-        while (c--)
-        {
-            y1 = *s++;
-            cb = ((*s - 128) * 454) >> 8;
-            cg = (*s++ - 128) * 88;
-            y2 = *s++;
-            cr = ((*s - 128) * 359) >> 8;
-            cg = (cg + (*s++ - 128) * 183) >> 8;
-
-            r = y1 + cr;
-            b = y1 + cb;
-            g = y1 - cg;
-            SAT(r);
-            SAT(g);
-            SAT(b);
-            d->r = r;
-            d->g = g;
-            d->b = b;
-            d++;
-            r = y2 + cr;
-            b = y2 + cb;
-            g = y2 - cg;
-            SAT(r);
-            SAT(g);
-            SAT(b);
-            d->r = r;
-            d->g = g;
-            d->b = b;
-            d++;
-        }
-    }
+    ccvt_yuyv_rgb(width, height, src, dst, 0);
 }
 
 void ccvt_yuyv_420p(int width, int height, const void *src, void *dsty, void *dstu, void *dstv)
@@ -262,460 +221,22 @@ void ccvt_yuyv_420p(int width, int height, const void *src, void *dsty, void *ds
 
 void bayer2rgb24(unsigned char *dst, unsigned char *src, long int WIDTH, long int HEIGHT)
 {
-    long int i;
-    unsigned char *rawpt, *scanpt;
-    long int size;
-
-    rawpt  = src;
-    scanpt = dst;
-    size   = WIDTH * HEIGHT;
-
-    for (i = 0; i < size; i++)
-    {
-        if ((i / WIDTH) % 2 == 0)
-        {
-            if ((i % 2) == 0)
-            {
-                /* B */
-                if ((i > WIDTH) && ((i % WIDTH) > 0))
-                {
-                    *scanpt++ =
-                        (*(rawpt - WIDTH - 1) + *(rawpt - WIDTH + 1) + *(rawpt + WIDTH - 1) + *(rawpt + WIDTH + 1)) /
-                        4;                                                                               /* R */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt + WIDTH) + *(rawpt - WIDTH)) / 4; /* G */
-                    *scanpt++ = *rawpt;                                                                  /* B */
-                }
-                else
-                {
-                    /* first line or left column */
-                    *scanpt++ = *(rawpt + WIDTH + 1);                  /* R */
-                    *scanpt++ = (*(rawpt + 1) + *(rawpt + WIDTH)) / 2; /* G */
-                    *scanpt++ = *rawpt;                                /* B */
-                }
-            }
-            else
-            {
-                /* (B)G */
-                if ((i > WIDTH) && ((i % WIDTH) < (WIDTH - 1)))
-                {
-                    *scanpt++ = (*(rawpt + WIDTH) + *(rawpt - WIDTH)) / 2; /* R */
-                    *scanpt++ = *rawpt;                                    /* G */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* B */
-                }
-                else
-                {
-                    /* first line or right column */
-                    *scanpt++ = *(rawpt + WIDTH); /* R */
-                    *scanpt++ = *rawpt;           /* G */
-                    *scanpt++ = *(rawpt - 1);     /* B */
-                }
-            }
-        }
-        else
-        {
-            if ((i % 2) == 0)
-            {
-                /* G(R) */
-                if ((i < (WIDTH * (HEIGHT - 1))) && ((i % WIDTH) > 0))
-                {
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* R */
-                    *scanpt++ = *rawpt;                                    /* G */
-                    *scanpt++ = (*(rawpt + WIDTH) + *(rawpt - WIDTH)) / 2; /* B */
-                }
-                else
-                {
-                    /* bottom line or left column */
-                    *scanpt++ = *(rawpt + 1);     /* R */
-                    *scanpt++ = *rawpt;           /* G */
-                    *scanpt++ = *(rawpt - WIDTH); /* B */
-                }
-            }
-            else
-            {
-                /* R */
-                if (i < (WIDTH * (HEIGHT - 1)) && ((i % WIDTH) < (WIDTH - 1)))
-                {
-                    *scanpt++ = *rawpt;                                                                  /* R */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt - WIDTH) + *(rawpt + WIDTH)) / 4; /* G */
-                    *scanpt++ =
-                        (*(rawpt - WIDTH - 1) + *(rawpt - WIDTH + 1) + *(rawpt + WIDTH - 1) + *(rawpt + WIDTH + 1)) /
-                        4; /* B */
-                }
-                else
-                {
-                    /* bottom line or right column */
-                    *scanpt++ = *rawpt;                                /* R */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt - WIDTH)) / 2; /* G */
-                    *scanpt++ = *(rawpt - WIDTH - 1);                  /* B */
-                }
-            }
-        }
-        rawpt++;
-    }
+    ccvt_debayer(dst, src, WIDTH, HEIGHT, 8, 8, CCVT_CFA_BGGR, CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_INTERLEAVED, 0);
 }
 
 void bayer16_2_rgb24(unsigned short *dst, unsigned short *src, long int WIDTH, long int HEIGHT)
 {
-    long int i;
-    unsigned short *rawpt, *scanpt;
-    long int size;
-
-    rawpt  = src;
-    scanpt = dst;
-    size   = WIDTH * HEIGHT;
-
-    for (i = 0; i < size; i++)
-    {
-        if ((i / WIDTH) % 2 == 0)
-        {
-            if ((i % 2) == 0)
-            {
-                /* B */
-                if ((i > WIDTH) && ((i % WIDTH) > 0))
-                {
-                    *scanpt++ =
-                        (*(rawpt - WIDTH - 1) + *(rawpt - WIDTH + 1) + *(rawpt + WIDTH - 1) + *(rawpt + WIDTH + 1)) /
-                        4;                                                                               /* R */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt + WIDTH) + *(rawpt - WIDTH)) / 4; /* G */
-                    *scanpt++ = *rawpt;                                                                  /* B */
-                }
-                else
-                {
-                    /* first line or left column */
-                    *scanpt++ = *(rawpt + WIDTH + 1);                  /* R */
-                    *scanpt++ = (*(rawpt + 1) + *(rawpt + WIDTH)) / 2; /* G */
-                    *scanpt++ = *rawpt;                                /* B */
-                }
-            }
-            else
-            {
-                /* (B)G */
-                if ((i > WIDTH) && ((i % WIDTH) < (WIDTH - 1)))
-                {
-                    *scanpt++ = (*(rawpt + WIDTH) + *(rawpt - WIDTH)) / 2; /* R */
-                    *scanpt++ = *rawpt;                                    /* G */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* B */
-                }
-                else
-                {
-                    /* first line or right column */
-                    *scanpt++ = *(rawpt + WIDTH); /* R */
-                    *scanpt++ = *rawpt;           /* G */
-                    *scanpt++ = *(rawpt - 1);     /* B */
-                }
-            }
-        }
-        else
-        {
-            if ((i % 2) == 0)
-            {
-                /* G(R) */
-                if ((i < (WIDTH * (HEIGHT - 1))) && ((i % WIDTH) > 0))
-                {
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* R */
-                    *scanpt++ = *rawpt;                                    /* G */
-                    *scanpt++ = (*(rawpt + WIDTH) + *(rawpt - WIDTH)) / 2; /* B */
-                }
-                else
-                {
-                    /* bottom line or left column */
-                    *scanpt++ = *(rawpt + 1);     /* R */
-                    *scanpt++ = *rawpt;           /* G */
-                    *scanpt++ = *(rawpt - WIDTH); /* B */
-                }
-            }
-            else
-            {
-                /* R */
-                if (i < (WIDTH * (HEIGHT - 1)) && ((i % WIDTH) < (WIDTH - 1)))
-                {
-                    *scanpt++ = *rawpt;                                                                  /* R */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt - WIDTH) + *(rawpt + WIDTH)) / 4; /* G */
-                    *scanpt++ =
-                        (*(rawpt - WIDTH - 1) + *(rawpt - WIDTH + 1) + *(rawpt + WIDTH - 1) + *(rawpt + WIDTH + 1)) /
-                        4; /* B */
-                }
-                else
-                {
-                    /* bottom line or right column */
-                    *scanpt++ = *rawpt;                                /* R */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt - WIDTH)) / 2; /* G */
-                    *scanpt++ = *(rawpt - WIDTH - 1);                  /* B */
-                }
-            }
-        }
-        rawpt++;
-    }
+    ccvt_debayer(dst, src, WIDTH, HEIGHT, 16, 16, CCVT_CFA_BGGR, CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_INTERLEAVED, 0);
 }
 
 void bayer_rggb_2rgb24(unsigned char *dst, unsigned char *src, long int WIDTH, long int HEIGHT)
 {
-    long int i;
-    unsigned char *rawpt, *scanpt;
-    long int size;
-
-    rawpt  = src;
-    scanpt = dst;
-    size   = WIDTH * HEIGHT;
-
-    for (i = 0; i < size; i++)
-    {
-        if ((i / WIDTH) % 2 == 0) //wenn zeile grade
-        {
-            if ((i % 2) == 0) //spalte gerade
-            {
-                /* B */
-                if ((i > WIDTH) && ((i % WIDTH) > 0)) // wenn nicht erste zeile oder linke spalte
-                {
-                    *scanpt++ = *rawpt;                                                                  /* R */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt + WIDTH) + *(rawpt - WIDTH)) / 4; /* G */
-                    *scanpt++ =
-                        (*(rawpt - WIDTH - 1) + *(rawpt - WIDTH + 1) + *(rawpt + WIDTH - 1) + *(rawpt + WIDTH + 1)) /
-                        4; /* B */
-                }
-                else
-                {
-                    /* first line or left column */
-                    *scanpt++ = *rawpt;                                /* R */
-                    *scanpt++ = (*(rawpt + 1) + *(rawpt + WIDTH)) / 2; /* G */
-                    *scanpt++ = *(rawpt + WIDTH + 1);                  /* B */
-                }
-            }
-            else
-            {
-                /* (B)G */
-                if ((i > WIDTH) && ((i % WIDTH) < (WIDTH - 1)))
-                {
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* R */
-                    *scanpt++ = *rawpt;                                    /* G */
-                    *scanpt++ = (*(rawpt + WIDTH) + *(rawpt - WIDTH)) / 2; /* B */
-                }
-                else
-                {
-                    /* first line or right column */
-                    *scanpt++ = *(rawpt - 1);     /* R */
-                    *scanpt++ = *rawpt;           /* G */
-                    *scanpt++ = *(rawpt + WIDTH); /* B */
-                }
-            }
-        }
-        else
-        {
-            if ((i % 2) == 0)
-            {
-                /* G(R) */
-                if ((i < (WIDTH * (HEIGHT - 1))) && ((i % WIDTH) > 0))
-                {
-                    *scanpt++ = (*(rawpt + WIDTH) + *(rawpt - WIDTH)) / 2; /* R */
-                    *scanpt++ = *rawpt;                                    /* G */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* B */
-                }
-                else
-                {
-                    /* bottom line or left column */
-                    *scanpt++ = *(rawpt - WIDTH); /* R */
-                    *scanpt++ = *rawpt;           /* G */
-                    *scanpt++ = *(rawpt + 1);     /* B */
-                }
-            }
-            else
-            {
-                /* R */
-                if (i < (WIDTH * (HEIGHT - 1)) && ((i % WIDTH) < (WIDTH - 1)))
-                {
-                    *scanpt++ =
-                        (*(rawpt - WIDTH - 1) + *(rawpt - WIDTH + 1) + *(rawpt + WIDTH - 1) + *(rawpt + WIDTH + 1)) /
-                        4;                                                                               /* R */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt - WIDTH) + *(rawpt + WIDTH)) / 4; /* G */
-                    *scanpt++ = *rawpt;                                                                  /* B */
-                }
-                else
-                {
-                    /* bottom line or right column */
-                    *scanpt++ = *(rawpt - WIDTH - 1);                  /* R */
-                    *scanpt++ = (*(rawpt - 1) + *(rawpt - WIDTH)) / 2; /* G */
-                    *scanpt++ = *rawpt;                                /* B */
-                }
-            }
-        }
-        rawpt++;
-    }
+    ccvt_debayer(dst, src, WIDTH, HEIGHT, 8, 8, CCVT_CFA_RGGB, CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_INTERLEAVED, 0);
 }
 
 void bayer_grbg_to_rgb24(unsigned char *dst, unsigned char *src, long int WIDTH, long int HEIGHT)
 {
-	//Format is
-	// GRGRGRGRGR row width = width,  
-	// BGBGBGBGBG this interpolates it as simply as possible
-	// GRGRGRGRGR 
-	// BGBGBGBGBG
-	
-	// Output is
-	// RGBRGBRGBRGBRGB row width = 3x width
-	// RGBRGBRGBRGBRGB each pixel = 3 bytes
-	
-	long int row;
-	long int col;
-	long int width=WIDTH;
-	int RED = 0;
-	int GREEN = 1;
-	int BLUE = 2;
-	for (row = 0; row < HEIGHT; row++) {
-		for (col = 0; col < WIDTH; col++) {
-			//General case:
-			if(row % 2 == 0) { //GRGRGR Row
-				if(col % 2 == 0) {//Over Green
-					//TODO: Double check 1st/last row
-					if (col != 0 && col != WIDTH -1) { // NORMAL
-					dst[(row*width+col)*3+RED]=(src[row*width+col+1]+src[row*width+col-1])/2; // Reds are to L/R
-					} else { //EDGE
-						if (col == 0) { dst[(row*width+col)*3+RED]=src[row*width+col+1];}
-						if (col == WIDTH -1 ) { dst[(row*width+col)*3+RED]=src[row*width+col-1]; }
-					}
-					dst[(row*width+col)*3+GREEN]=src[row*width+col];
-					if (row !=0 && row !=HEIGHT-1) { // NORMAL
-					dst[(row*width+col)*3+BLUE]=(src[(row+1)*width+col]+src[(row-1)*width+col])/2; //Blues are above and below.
-					} else { // EDGE
-						if (row == 0) {dst[(row*width+col)*3+BLUE]=src[(row+1)*width+col];}
-						if (row == WIDTH -1) {dst[(row*width+col)*3+BLUE]=src[(row-1)*width+col];}
-					}
-				} else { // Over RED
-					dst[(row*width+col)*3+RED]=src[row*width+col]; 
-					if (col != WIDTH -1 && row !=0 ) { // NORMAL (Left side and bottom count as normal
-					dst[(row*width+col)*3+GREEN]=(src[(row+1)*width+col]+src[(row-1)*width+col]+src[(row+0)*width+col+1]+src[(row+0)*width+col-1])/4; //GREENS are in all 4 directions
-					dst[(row*width+col)*3+BLUE]=(src[(row+1)*width+col+1]+src[(row-1)*width+col+1]+src[(row+1)*width+col-1]+src[(row-1)*width+col-1])/4; //Blues are caddy corner and below.
-					} else { // EDGE
-						if (col != WIDTH -1 && row == 0) {
-							//Corner && Side: 
-							//     
-							//,G*G.
-							//,BGB.
-							//,....
-							dst[(row*width+col)*3+GREEN]=(src[(row+1)*width+col]+src[(row)*width+col+1]+src[(row)*width+col+1])/3;
-							dst[(row*width+col)*3+BLUE]=(src[(row+1)*width+col+1]+src[(row+1)*width+col-1])/2;
-						} 
-
-						if (col == WIDTH -1 && row !=0 ) {
-							//Side
-							//...
-							//.BG
-							//.GR
-							//.BG
-							//...
-							dst[(row*width+col)*3+GREEN]=(src[(row+1)*width+col]+src[(row-1)*width+col]+src[(row)*width+col-1])/3;
-							dst[(row*width+col)*3+BLUE]=(src[(row+1)*width+col-1]+src[(row-1)*width+col-1])/2;
-							
-						}
-						if (col == WIDTH -1 && row ==0) {
-							//Corner (col=max, row=0)
-							//
-							//.G*
-							//.BG
-							//...
-							dst[(row*width+col)*3+GREEN]=(src[(row-1)*width+col]+src[(row+0)*width+col-1]+src[(row+1)*width+col])/3;
-							dst[(row*width+col)*3+BLUE]=src[(row+1)*width+col-1];
-						}
-						if (col == 1 && row !=0) { //Unnecessary Left here to explain why 
-							//Side && Corner (col=1, row=max)
-							// .....
-							// BGBG..
-							// G*GR
-							// BGBG..
-							// ,,,,,, 
-							// NORMAL
-							dst[(row*width+col)*3+GREEN]=(src[(row+1)*width+col]+src[(row-1)*width+col]+src[(row+0)*width+col+1]+src[(row+0)*width+col-1])/4; //GREENS are in all 4 directions
-							dst[(row*width+col)*3+BLUE]=(src[(row+1)*width+col+1]+src[(row-1)*width+col+1]+src[(row+1)*width+col-1]+src[(row-1)*width+col-1])/4; //Blues are caddy corner and below.
-						}
-						if (row == HEIGHT -1) {//Unnecessary Left here to explain why 
-							//Bottom row (would actually be HEIGHT -2 it still looks like a normal pixel for us
-							// ,.....
-							// ,.BGBG..
-							// ,.G*RG..
-							// ,.BGBG..
-							//        
-							// NORMAL
-							dst[(row*width+col)*3+GREEN]=(src[(row+1)*width+col]+src[(row-1)*width+col]+src[(row+0)*width+col+1]+src[(row+0)*width+col-1])/4; //GREENS are in all 4 directions
-							dst[(row*width+col)*3+BLUE]=(src[(row+1)*width+col+1]+src[(row-1)*width+col+1]+src[(row+1)*width+col-1]+src[(row-1)*width+col-1])/4; //Blues are caddy corner and below.
-							
-						}
-					}
-				}
-			} else { //BRBRBR Row
-				//if (col != 0 && col != WIDTH -1 && row != 0 && row != HEIGHT-1) {
-				if (col % 2 == 0) {//Over Blue
-					dst[(row*width+col)*3+BLUE]=src[row*width+col];
-					if ( col != 0 && row != HEIGHT -1) { //Normal 
-						// Enough clearance to use this:
-						// RGR
-						// G*G
-						// RGR
-						dst[(row*width+col)*3+RED]=(src[(row+1)*width+col+1]+src[(row-1)*width+col+1]+src[(row+1)*width+col-1]+src[(row-1)*width+col-1])/4;//Reds are caddy corner and below.
-						dst[(row*width+col)*3+GREEN]=(src[(row+1)*width+col]+src[(row-1)*width+col]+src[(row+0)*width+col+1]+src[(row+0)*width+col-1])/4; //GREENS are in all 4 directions
-					} else { // EDGE CASES over blue
-						if (col == 0 && row != HEIGHT -1) {
-							//  ,,,,,,,
-							//  GRGRGR.
-							//  *GBGBG.
-							//  GRGRGR.
-							//  .......
-							dst[(row*width+col)*3+RED]=(src[(row+1)*width+col+1]+src[(row-1)*width+col+1])/2;
-							dst[(row*width+col)*3+GREEN]=(src[(row+1)*width+col]+src[(row+0)*width+col+1]+src[(row+0)*width+col-1])/3;
-						}
-						if (row == HEIGHT -1 && col !=0) {
-							//  ........
-							//  .GRGRGR.
-							//  .BG*GBG.
-							dst[(row*width+col)*3+RED]=(src[(row-1)*width+col+1]+src[(row-1)*width+col-1])/2;
-							dst[(row*width+col)*3+GREEN]=(src[(row+1)*width+col]+src[(row-1)*width+col]+src[(row+0)*width+col+1]+src[(row+0)*width+col-1])/3;
-						}
-						if (row == HEIGHT -1 && col ==0) {
-							//  .....
-							//  GRGR.
-							//  *GBG.
-							dst[(row*width+col)*3+RED]=(src[(row-1)*width+col+1]+src[(row-1)*width+col-1])/2;
-							dst[(row*width+col)*3+GREEN]=(src[(row+1)*width+col]+src[(row-1)*width+col]+src[(row+0)*width+col+1]+src[(row+0)*width+col-1])/3;
-						}
-						
-					}
-				} else { // Over Green
-					dst[(row*width+col)*3+GREEN]=src[row*width+col]; // Over Green Pixel
-					if (col != WIDTH -1 && row != HEIGHT -1) { //NORMAL 
-						// Enough clearance to use this:
-						// GRG
-						// B*B
-						// GRG
-						
-						dst[(row*width+col)*3+RED]=(src[(row+1)*width+col]+src[(row-1)*width+col])/2; // Reds are above/below
-						dst[(row*width+col)*3+BLUE]=(src[row*width+col+1]+src[row*width+col-1])/2; //Blues are left/right
-					} else {
-						if (col == WIDTH -1 && row != HEIGHT -1) {
-							// ,,,,,
-							// .GRGR
-							// .BGB*
-							// .GRGR
-							// .....
-							dst[(row*width+col)*3+RED]=(src[(row+1)*width+col]+src[(row-1)*width+col])/2; // Reds are above/below
-							dst[(row*width+col)*3+BLUE]=src[row*width+col-1]; //Blue is left
-						}
-						if (row == HEIGHT -1 && col != WIDTH -1) {
-							// .....
-							// .GRGR
-							// .B*BG
-							dst[(row*width+col)*3+RED]=src[(row-1)*width+col]; // Red is above
-							dst[(row*width+col)*3+BLUE]=(src[row*width+col+1]+src[row*width+col-1])/2; //Blues are left/right
-						}
-						if (row == HEIGHT -1 && col == WIDTH -1) {
-							// ...
-							// .GR
-							// .B*
-							dst[(row*width+col)*3+RED]=src[(row-1)*width+col]; // Red is above
-							dst[(row*width+col)*3+BLUE]=src[row*width+col-1]; //Blue is left
-						}
-					}
-				}
-			}
-		}
-	}
+    ccvt_debayer(dst, src, WIDTH, HEIGHT, 8, 8, CCVT_CFA_GRBG, CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_INTERLEAVED, 0);
 }
 
 int mjpegtoyuv420p(unsigned char *map, unsigned char *cap_map, int width, int height, unsigned int size)
@@ -0,0 +1,87 @@
+/*
+    Vector helpers for CCVT
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+/*
+   Kernels are written with GCC vector extensions. They are built for 16 byte vectors (SSE2 on any
+   x86_64, NEON on ARM) and, on x86, for AVX2 selected at run time: a kernel template is instantiated
+   with 32 byte vectors inside a function marked target("avx2"), and called when haveAVX2() is true.
+
+   Not installed, only used by the ccvt sources.
+*/
+
+#pragma once
+
+#include <cstring>
+
+#if defined(__GNUC__)
+
+#define CCVT_VECTOR
+
+#if !defined(__clang__)
+// All the helpers below are inlined, 32 byte vectors never cross a call
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#define VECTOR_INLINE inline __attribute__((always_inline))
+
+namespace ccvt
+{
+
+template <typename T, int Bytes>
+struct Vector
+{
+    typedef T type __attribute__((vector_size(Bytes)));
+};
+
+template <typename V, typename T>
+VECTOR_INLINE V load(const T *p)
+{
+    V v;
+    memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+template <typename V, typename T>
+VECTOR_INLINE void store(T *p, const V &v)
+{
+    memcpy(p, &v, sizeof(V));
+}
+
+template <typename V>
+VECTOR_INLINE V select(const V &mask, const V &a, const V &b)
+{
+    return (a & mask) | (b & ~mask);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#define CCVT_VECTOR_AVX2
+#define CCVT_TARGET_AVX2 __attribute__((target("avx2")))
+
+inline bool haveAVX2()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+#endif
+
+}
+
+#endif
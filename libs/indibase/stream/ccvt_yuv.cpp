@@ -0,0 +1,298 @@
+/*
+    YUV conversions for CCVT
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+/*
+   Packed 4:2:2 pixels are handled as 32 bit words, one per pair of pixels, so reordering and
+   colour conversion need no byte shuffles: each vector lane holds one Y0 U Y1 V group. The
+   conversion uses the same fixed point coefficients as the scalar ccvt functions, with 32 bit
+   lanes, and is bit exact with them. Other layouts (4:2:0 planar) are packed to a YUYV row first.
+*/
+
+#include "ccvt.h"
+#include "ccvt_vector.h"
+
+#include <vector>
+
+#if defined(CCVT_VECTOR) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define CCVT_YUV_VECTOR
+#endif
+
+namespace
+{
+
+inline int saturate(int c)
+{
+    return c < 0 ? 0 : c > 255 ? 255 : c;
+}
+
+// Pixel pairs [begin, pairs) of a YUYV row to RGB
+void yuyvPairs(const uint8_t *src, long begin, long pairs, uint8_t *dst, size_t planeSize, bool planar)
+{
+    for (long i = begin; i < pairs; i++)
+    {
+        const uint8_t *s = src + 4 * i;
+        int cb = ((s[1] - 128) * 454) >> 8;
+        int cr = ((s[3] - 128) * 359) >> 8;
+        int cg = ((s[1] - 128) * 88 + (s[3] - 128) * 183) >> 8;
+
+        for (int k = 0; k < 2; k++)
+        {
+            int y = s[2 * k];
+            uint8_t *d = planar ? dst + 2 * i + k : dst + 3 * (2 * i + k);
+            size_t step = planar ? planeSize : 1;
+            d[0] = saturate(y + cr);
+            d[step] = saturate(y - cg);
+            d[2 * step] = saturate(y + cb);
+        }
+    }
+}
+
+#ifdef CCVT_YUV_VECTOR
+
+using namespace ccvt;
+
+template <typename V>
+VECTOR_INLINE V saturate(const V &value)
+{
+    V c = value & ~(value >> 31);
+    return (c | ((255 - c) >> 31)) & 255;
+}
+
+// Convert the pairs of a YUYV row, a vector at a time, return the number of pairs converted
+template <int Bytes>
+VECTOR_INLINE long yuyvVector(const uint8_t *src, long pairs, uint8_t *dst, size_t planeSize, bool planar)
+{
+    typedef typename Vector<uint32_t, Bytes>::type U;
+    typedef typename Vector<int32_t, Bytes>::type I;
+    constexpr long lanes = Bytes / 4;
+
+    long i = 0;
+    for (; i + lanes <= pairs; i += lanes)
+    {
+        U w = load<U>(src + 4 * i);
+        I y0 = (I)(w & 0xFF);
+        I u = (I)((w >> 8) & 0xFF) - 128;
+        I y1 = (I)((w >> 16) & 0xFF);
+        I v = (I)(w >> 24) - 128;
+
+        I cb = (u * 454) >> 8;
+        I cr = (v * 359) >> 8;
+        I cg = (u * 88 + v * 183) >> 8;
+
+        // Both pixels of each pair in one lane, first pixel in the low byte
+        U r = (U)(saturate(y0 + cr) | (saturate(y1 + cr) << 8));
+        U g = (U)(saturate(y0 - cg) | (saturate(y1 - cg) << 8));
+        U b = (U)(saturate(y0 + cb) | (saturate(y1 + cb) << 8));
+
+        if (planar)
+        {
+            for (long k = 0; k < lanes; k++)
+            {
+                uint16_t pr = r[k], pg = g[k], pb = b[k];
+                memcpy(dst + 2 * (i + k), &pr, 2);
+                memcpy(dst + planeSize + 2 * (i + k), &pg, 2);
+                memcpy(dst + 2 * planeSize + 2 * (i + k), &pb, 2);
+            }
+        }
+        else
+        {
+            // R0 G0 B0 R1 then G1 B1
+            U low = (r & 0xFF) | ((g & 0xFF) << 8) | ((b & 0xFF) << 16) | (r << 16 & 0xFF000000);
+            U high = (g >> 8) | (b & 0xFF00);
+            for (long k = 0; k < lanes; k++)
+            {
+                uint32_t pl = low[k];
+                uint16_t ph = high[k];
+                memcpy(dst + 6 * (i + k), &pl, 4);
+                memcpy(dst + 6 * (i + k) + 4, &ph, 2);
+            }
+        }
+    }
+    return i;
+}
+
+#ifdef CCVT_VECTOR_AVX2
+CCVT_TARGET_AVX2 long yuyvAVX2(const uint8_t *src, long pairs, uint8_t *dst, size_t planeSize, bool planar)
+{
+    return yuyvVector<32>(src, pairs, dst, planeSize, planar);
+}
+#endif
+
+// Reorder the pairs of a packed 4:2:2 row to YUYV, return the number of pairs done
+VECTOR_INLINE long reorderVector(const uint8_t *src, long pairs, ccvt_422_order order, uint8_t *dst)
+{
+    typedef Vector<uint32_t, 16>::type U;
+    constexpr long lanes = 4;
+
+    long i = 0;
+    for (; i + lanes <= pairs; i += lanes)
+    {
+        U w = load<U>(src + 4 * i);
+        switch (order)
+        {
+            case CCVT_422_UYVY:
+                w = ((w >> 8) & 0x00FF00FF) | ((w & 0x00FF00FF) << 8);
+                break;
+            case CCVT_422_YVYU:
+                w = (w & 0x00FF00FF) | ((w >> 16) & 0xFF00) | ((w & 0xFF00) << 16);
+                break;
+            case CCVT_422_VYUY:
+                w = (w >> 8) | (w << 24);
+                break;
+            default:
+                break;
+        }
+        store(dst + 4 * i, w);
+    }
+    return i;
+}
+
+VECTOR_INLINE long swapVector(const uint8_t *src, long samples, uint8_t *dst)
+{
+    typedef Vector<uint16_t, 16>::type U;
+    constexpr long lanes = 8;
+
+    long i = 0;
+    for (; i + lanes <= samples; i += lanes)
+    {
+        U w = load<U>(src + 2 * i);
+        store(dst + 2 * i, U((w << 8) | (w >> 8)));
+    }
+    return i;
+}
+
+#endif
+
+void yuyvRow(const uint8_t *src, long pairs, uint8_t *dst, size_t planeSize, bool planar)
+{
+    long i = 0;
+#ifdef CCVT_YUV_VECTOR
+#ifdef CCVT_VECTOR_AVX2
+    if (haveAVX2())
+        i = yuyvAVX2(src, pairs, dst, planeSize, planar);
+    else
+#endif
+        i = yuyvVector<16>(src, pairs, dst, planeSize, planar);
+#endif
+    yuyvPairs(src, i, pairs, dst, planeSize, planar);
+}
+
+}
+
+void ccvt_422_yuyv(int width, int height, const void *src, int srcstride, ccvt_422_order order, void *dst)
+{
+    // Offsets of Y0, U, Y1 and V in each group of four bytes
+    static const int offsets[4][4] = {{0, 1, 2, 3}, {1, 0, 3, 2}, {0, 3, 2, 1}, {1, 2, 3, 0}};
+    const int *o = offsets[order];
+    const long pairs = width / 2;
+
+    for (int y = 0; y < height; y++)
+    {
+        const uint8_t *s = static_cast<const uint8_t *>(src) + long(y) * srcstride;
+        uint8_t *d = static_cast<uint8_t *>(dst) + long(y) * 4 * pairs;
+
+        if (order == CCVT_422_YUYV)
+        {
+            memcpy(d, s, 4 * pairs);
+            continue;
+        }
+
+        long i = 0;
+#ifdef CCVT_YUV_VECTOR
+        i = reorderVector(s, pairs, order, d);
+#endif
+        for (; i < pairs; i++)
+            for (int k = 0; k < 4; k++)
+                d[4 * i + k] = s[4 * i + o[k]];
+    }
+}
+
+void ccvt_yuyv_y(int width, int height, const void *src, void *dsty)
+{
+    const uint8_t *s = static_cast<const uint8_t *>(src);
+    uint8_t *d = static_cast<uint8_t *>(dsty);
+    const long pixels = long(width - width % 2) * height;
+
+    for (long i = 0; i < pixels; i++)
+        d[i] = s[2 * i];
+}
+
+void ccvt_yuyv_rgb(int width, int height, const void *src, void *dst, int planar)
+{
+    const long pairs = width / 2;
+    const size_t planeSize = size_t(width) * height;
+
+    for (int y = 0; y < height; y++)
+    {
+        const uint8_t *s = static_cast<const uint8_t *>(src) + long(y) * 4 * pairs;
+        uint8_t *d = static_cast<uint8_t *>(dst) + long(y) * width * (planar ? 1 : 3);
+        yuyvRow(s, pairs, d, planeSize, planar);
+    }
+}
+
+void ccvt_420p_rgb(int width, int height, const void *srcy, const void *srcu, const void *srcv, void *dst,
+                   int planar)
+{
+    const long pairs = width / 2;
+    const size_t planeSize = size_t(width) * height;
+    std::vector<uint8_t> yuyv(4 * pairs);
+
+    for (int y = 0; y < height - height % 2; y++)
+    {
+        const uint8_t *sy = static_cast<const uint8_t *>(srcy) + long(y) * width;
+        const uint8_t *su = static_cast<const uint8_t *>(srcu) + long(y / 2) * pairs;
+        const uint8_t *sv = static_cast<const uint8_t *>(srcv) + long(y / 2) * pairs;
+
+        for (long i = 0; i < pairs; i++)
+        {
+            yuyv[4 * i] = sy[2 * i];
+            yuyv[4 * i + 1] = su[i];
+            yuyv[4 * i + 2] = sy[2 * i + 1];
+            yuyv[4 * i + 3] = sv[i];
+        }
+
+        uint8_t *d = static_cast<uint8_t *>(dst) + long(y) * width * (planar ? 1 : 3);
+        yuyvRow(yuyv.data(), pairs, d, planeSize, planar);
+    }
+}
+
+void ccvt_y16_copy(int width, int height, const void *src, int srcstride, int swap, void *dst)
+{
+    for (int y = 0; y < height; y++)
+    {
+        const uint8_t *s = static_cast<const uint8_t *>(src) + long(y) * srcstride;
+        uint8_t *d = static_cast<uint8_t *>(dst) + long(y) * 2 * width;
+
+        if (!swap)
+        {
+            memcpy(d, s, 2 * width);
+            continue;
+        }
+
+        long i = 0;
+#ifdef CCVT_YUV_VECTOR
+        i = swapVector(s, width, d);
+#endif
+        for (; i < width; i++)
+        {
+            d[2 * i] = s[2 * i + 1];
+            d[2 * i + 1] = s[2 * i];
+        }
+    }
+}
@@ -50,6 +50,12 @@ bool EncoderInterface::setSize(uint16_t width, uint16_t height)
     return true;
 }
 
+void EncoderInterface::setPreview(uint16_t maxWidth, int quality)
+{
+    previewWidth = maxWidth;
+    previewQuality = quality;
+}
+
 bool EncoderInterface::setPixelFormat(INDI_PIXEL_FORMAT pixelFormat, uint8_t pixelDepth)
 {
     this->pixelFormat = pixelFormat;
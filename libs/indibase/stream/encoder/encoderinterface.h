@@ -53,6 +53,13 @@ class EncoderInterface
 
         virtual bool setSize(uint16_t width, uint16_t height);
 
+        /**
+         * @brief setPreview Set how previews are compressed, for the encoders that compress them.
+         * @param maxWidth Wider frames are downscaled to this width or less, 0 to keep the full width.
+         * @param quality Compression quality, from 1 to 100.
+         */
+        virtual void setPreview(uint16_t maxWidth, int quality);
+
         virtual bool upload(INDI::WidgetViewBlob *bp, const uint8_t *buffer, uint32_t nbytes, bool isCompressed = false) = 0;
 
         const char *getName();
@@ -63,6 +70,8 @@ class EncoderInterface
         INDI_PIXEL_FORMAT pixelFormat;            // INDI Pixel Format
         uint8_t pixelDepth = 8;                   // Bits per Pixels
         uint16_t rawWidth, rawHeight;
+        uint16_t previewWidth = 640;
+        int previewQuality = 85;
 };
 
 }
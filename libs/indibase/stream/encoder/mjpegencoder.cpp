@@ -22,28 +22,74 @@
 #include "mjpegencoder.h"
 #include "stream/streammanager.h"
 #include "indiccd.h"
-#include <cmath>
-#include <zlib.h>
+
+#include <algorithm>
+#include <thread>
 #include <jpeglib.h>
 #include <jerror.h>
 
-static void init_destination(j_compress_ptr cinfo)
+namespace
+{
+
+// Below this many output rows, a slice costs more than it saves
+constexpr uint32_t minRowsPerSlice = 64;
+
+// Compressed data goes to a vector, grown as needed and kept for the next frame
+struct VectorDestination
 {
-    INDI_UNUSED(cinfo);
-    /* No work necessary here */
+    jpeg_destination_mgr manager;
+    std::vector<uint8_t> *buffer;
+    size_t *length;
+};
+
+void initDestination(j_compress_ptr cinfo)
+{
+    auto dest = reinterpret_cast<VectorDestination *>(cinfo->dest);
+    if (dest->buffer->size() < 65536)
+        dest->buffer->resize(65536);
+    dest->manager.next_output_byte = dest->buffer->data();
+    dest->manager.free_in_buffer = dest->buffer->size();
 }
 
-static boolean empty_output_buffer(j_compress_ptr cinfo)
+boolean emptyOutputBuffer(j_compress_ptr cinfo)
 {
-    INDI_UNUSED(cinfo);
-    /* No work necessary here */
+    // Called when the whole buffer is full
+    auto dest = reinterpret_cast<VectorDestination *>(cinfo->dest);
+    size_t used = dest->buffer->size();
+    dest->buffer->resize(2 * used);
+    dest->manager.next_output_byte = dest->buffer->data() + used;
+    dest->manager.free_in_buffer = dest->buffer->size() - used;
     return TRUE;
 }
 
-static void term_destination(j_compress_ptr cinfo)
+void termDestination(j_compress_ptr cinfo)
 {
-    INDI_UNUSED(cinfo);
-    /* no work necessary here */
+    auto dest = reinterpret_cast<VectorDestination *>(cinfo->dest);
+    *dest->length = dest->buffer->size() - dest->manager.free_in_buffer;
+}
+
+// Find the SOF0 and SOS markers, and the entropy coded data that follows the SOS header
+bool findScan(const uint8_t *jpeg, size_t size, size_t &sof, size_t &sos, size_t &data)
+{
+    size_t pos = 2;
+    while (pos + 4 <= size && jpeg[pos] == 0xFF)
+    {
+        uint8_t marker = jpeg[pos + 1];
+        size_t length = (jpeg[pos + 2] << 8) | jpeg[pos + 3];
+        if (marker == 0xC0)
+            sof = pos;
+        if (marker == 0xDA)
+        {
+            sos = pos;
+            data = pos + 2 + length;
+            // The data ends with the EOI marker
+            return data + 2 <= size && jpeg[size - 2] == 0xFF && jpeg[size - 1] == 0xD9;
+        }
+        pos += 2 + length;
+    }
+    return false;
+}
+
 }
 
 namespace INDI
@@ -54,153 +100,202 @@ MJPEGEncoder::MJPEGEncoder()
     name = "MJPEG";
 }
 
-MJPEGEncoder::~MJPEGEncoder()
-{
-    delete [] jpegBuffer;
-}
-
 const char *MJPEGEncoder::getDeviceName()
 {
     return currentDevice->getDeviceName();
 }
 
-bool MJPEGEncoder::upload(INDI::WidgetViewBlob *bp, const uint8_t *buffer, uint32_t nbytes, bool isCompressed)
+void MJPEGEncoder::encodeSlice(Slice &slice, const uint8_t *buffer, uint32_t width, uint32_t factor, int components)
 {
-    // We do not support compression
-    if (isCompressed)
+    const uint32_t outWidth = width / factor;
+    const uint32_t rows = slice.end - slice.begin;
+    const size_t inStride = size_t(width) * components;
+    const size_t outStride = size_t(outWidth) * components;
+
+    const uint8_t *pixels = buffer + slice.begin * inStride;
+    size_t stride = inStride;
+
+    if (factor > 1)
     {
-        LOG_ERROR("Compression is not supported in MJPEG stream.");
-        return false;
+        // Average squares of factor x factor pixels: sum the rows, then groups of columns
+        const uint32_t area = factor * factor;
+        const size_t sumWidth = size_t(outWidth) * factor * components;
+        slice.sums.resize(sumWidth);
+        slice.pixels.resize(rows * outStride);
+
+        for (uint32_t y = 0; y < rows; y++)
+        {
+            const uint8_t *in = buffer + size_t(slice.begin + y) * factor * inStride;
+            uint32_t *sums = slice.sums.data();
+            for (size_t i = 0; i < sumWidth; i++)
+                sums[i] = in[i];
+            for (uint32_t k = 1; k < factor; k++)
+            {
+                in += inStride;
+                for (size_t i = 0; i < sumWidth; i++)
+                    sums[i] += in[i];
+            }
+
+            uint8_t *out = slice.pixels.data() + y * outStride;
+            for (uint32_t x = 0; x < outWidth; x++)
+            {
+                const uint32_t *group = sums + size_t(x) * factor * components;
+                for (int c = 0; c < components; c++)
+                {
+                    uint32_t sum = 0;
+                    for (uint32_t k = 0; k < factor; k++)
+                        sum += group[k * components + c];
+                    out[x * components + c] = (sum + area / 2) / area;
+                }
+            }
+        }
+
+        pixels = slice.pixels.data();
+        stride = outStride;
     }
 
-    INDI_UNUSED(nbytes);
-    int bufsize = rawWidth * rawHeight * ((pixelFormat == INDI_RGB) ? 3 : 1);
-    if (bufsize != jpegBufferSize)
+    struct jpeg_compress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    VectorDestination dest;
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    dest.manager.init_destination = initDestination;
+    dest.manager.empty_output_buffer = emptyOutputBuffer;
+    dest.manager.term_destination = termDestination;
+    dest.buffer = &slice.jpeg;
+    dest.length = &slice.jpegSize;
+    cinfo.dest = &dest.manager;
+
+    cinfo.image_width = outWidth;
+    cinfo.image_height = rows;
+    cinfo.input_components = components;
+    cinfo.in_color_space = components == 3 ? JCS_RGB : JCS_GRAYSCALE;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, previewQuality, TRUE);
+    // Standard Huffman tables, the same for every slice
+    cinfo.optimize_coding = FALSE;
+
+    jpeg_start_compress(&cinfo, TRUE);
+    while (cinfo.next_scanline < rows)
     {
-        delete [] jpegBuffer;
-        jpegBuffer = new uint8_t[bufsize];
-        jpegBufferSize = bufsize;
+        JSAMPROW row = const_cast<JSAMPROW>(pixels + cinfo.next_scanline * stride);
+        jpeg_write_scanlines(&cinfo, &row, 1);
     }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+}
 
-    // Scale image DOWN by this factor
-    // 640 is now selected arbitrary to test mpeg streaming performance
-    int scale = std::max(1, static_cast<int>(std::floor(rawWidth / SCALE_WIDTH)));
-    if (pixelFormat == INDI_RGB)
-        jpeg_compress_8u_rgb(buffer, rawWidth, rawHeight, rawWidth * 3, scale, jpegBuffer, &bufsize, 85);
-    else
-        jpeg_compress_8u_gray(buffer, rawWidth, rawHeight, rawWidth, scale, jpegBuffer, &bufsize, 85);
-
-    bp->setBlob(jpegBuffer);
-    bp->setBlobLen(bufsize);
-    bp->setSize(bufsize);
-    bp->setFormat(".stream_jpg");
+bool MJPEGEncoder::joinSlices(uint32_t height, uint32_t restartInterval)
+{
+    const Slice &first = m_Slices.front();
+    size_t sof = 0, sos = 0, data = 0;
+    if (!findScan(first.jpeg.data(), first.jpegSize, sof, sos, data) || sof == 0)
+        return false;
+
+    // Headers of the first slice, with the height of the frame and a restart interval of one slice
+    m_Output.assign(first.jpeg.begin(), first.jpeg.begin() + sos);
+    m_Output[sof + 5] = height >> 8;
+    m_Output[sof + 6] = height & 0xFF;
+    const uint8_t dri[] = {0xFF, 0xDD, 0x00, 0x04, uint8_t(restartInterval >> 8), uint8_t(restartInterval & 0xFF)};
+    m_Output.insert(m_Output.end(), dri, dri + sizeof(dri));
+    m_Output.insert(m_Output.end(), first.jpeg.begin() + sos, first.jpeg.begin() + data);
 
+    // Entropy coded data of each slice, ending on a byte boundary, between restart markers
+    for (size_t i = 0; i < m_Slices.size(); i++)
+    {
+        const Slice &slice = m_Slices[i];
+        if (!findScan(slice.jpeg.data(), slice.jpegSize, sof, sos, data))
+            return false;
+
+        if (i > 0)
+        {
+            m_Output.push_back(0xFF);
+            m_Output.push_back(0xD0 + ((i - 1) & 7));
+        }
+        m_Output.insert(m_Output.end(), slice.jpeg.begin() + data, slice.jpeg.begin() + slice.jpegSize - 2);
+    }
+
+    m_Output.push_back(0xFF);
+    m_Output.push_back(0xD9);
     return true;
 }
 
-/*
-FROM: https://svn.csail.mit.edu/rrg_pods/jpeg-utils/
+bool MJPEGEncoder::upload(INDI::WidgetViewBlob *bp, const uint8_t *buffer, uint32_t nbytes, bool isCompressed)
+{
+    // We do not support compression
+    if (isCompressed)
+    {
+        LOG_ERROR("Compression is not supported in MJPEG stream.");
+        return false;
+    }
 
-Name:         jpeg-utils
-Maintainers:  Albert Huang <albert@csail.mit.edu>
-Summary:      Wrapper functions around libjpeg to simplify JPEG compression and
-              decompression with in-memory buffers.
-Description:
-  note: This is a simple enough library that you could just copy the .c
-  and .h files in to your own programs.
+    const int components = (pixelFormat == INDI_RGB) ? 3 : 1;
+    if (nbytes < uint32_t(rawWidth) * rawHeight * components)
+    {
+        LOGF_ERROR("MJPEG frame of %u bytes is smaller than %ux%u.", nbytes, rawWidth, rawHeight);
+        return false;
+    }
 
-  To use the library, link against -ljpeg-utils, or use
-  pkg-config --cflags --libs jpeg-utils
+    // Scale image DOWN by the smallest factor that fits the preview width
+    const uint32_t factor = previewWidth > 0 ? std::max(1, (rawWidth + previewWidth - 1) / previewWidth) : 1;
+    const uint32_t width = rawWidth / factor;
+    const uint32_t height = rawHeight / factor;
+    if (width == 0 || height == 0)
+        return false;
 
-Requirements:
-  libjpeg62
+    // Slices are whole MCU rows: 8 rows in gray, 16 in color with the default 4:2:0 subsampling
+    const uint32_t mcuSize = components == 3 ? 16 : 8;
+    const uint32_t mcuColumns = (width + mcuSize - 1) / mcuSize;
+    const uint32_t mcuRows = (height + mcuSize - 1) / mcuSize;
 
-  For faster performance, install libjpeg-turbo, an SSE-accelerated
-  library that is ABI compatible with libjpeg62.
-*/
+    unsigned threads = m_Threads > 0 ? m_Threads : std::max(1u, std::thread::hardware_concurrency());
+    uint32_t slices = std::max(1u, std::min({threads, height / minRowsPerSlice, mcuRows}));
+    // The restart interval, the MCUs of one slice, is 16 bits
+    uint32_t sliceMcuRows = std::min((mcuRows + slices - 1) / slices, std::max(1u, 65535 / mcuColumns));
+    slices = (mcuRows + sliceMcuRows - 1) / sliceMcuRows;
 
-int MJPEGEncoder::jpeg_compress_8u_gray (const uint8_t * src, uint16_t width, uint16_t height, int stride, int scale,
-        uint8_t * dest,
-        int * destsize, int quality)
-{
-    struct jpeg_compress_struct cinfo;
-    struct jpeg_error_mgr jerr;
-    struct jpeg_destination_mgr jdest;
-    int out_size = *destsize;
-
-    cinfo.err = jpeg_std_error (&jerr);
-    jpeg_create_compress (&cinfo);
-    jdest.next_output_byte = dest;
-    jdest.free_in_buffer = out_size;
-    jdest.init_destination = init_destination;
-    jdest.empty_output_buffer = empty_output_buffer;
-    jdest.term_destination = term_destination;
-    cinfo.dest = &jdest;
-
-    cinfo.image_width = width;
-    cinfo.image_height = height;
-#if JPEG_LIB_VERSION >= 70
-    cinfo.scale_denom = scale;
-#else
-    INDI_UNUSED(scale);
-#endif
-    cinfo.input_components = 1;
-    cinfo.in_color_space = JCS_GRAYSCALE;
-    jpeg_set_defaults (&cinfo);
-    jpeg_set_quality (&cinfo, quality, TRUE);
-
-    jpeg_start_compress (&cinfo, TRUE);
-    while (cinfo.next_scanline < height)
+    m_Slices.resize(slices);
+    for (uint32_t i = 0; i < slices; i++)
     {
-        JSAMPROW row = (JSAMPROW)(src + cinfo.next_scanline * stride);
-        jpeg_write_scanlines (&cinfo, &row, 1);
+        m_Slices[i].begin = i * sliceMcuRows * mcuSize;
+        m_Slices[i].end = std::min(height, (i + 1) * sliceMcuRows * mcuSize);
     }
 
-    jpeg_finish_compress (&cinfo);
-    *destsize = out_size - jdest.free_in_buffer;
-    jpeg_destroy_compress (&cinfo);
-    return 0;
-}
-
-int MJPEGEncoder::jpeg_compress_8u_rgb (const uint8_t * src, uint16_t width, uint16_t height, int stride, int scale,
-                                        uint8_t * dest, int * destsize, int quality)
-{
-    struct jpeg_compress_struct cinfo;
-    struct jpeg_error_mgr jerr;
-    struct jpeg_destination_mgr jdest;
-    int out_size = *destsize;
-
-    cinfo.err = jpeg_std_error (&jerr);
-    jpeg_create_compress (&cinfo);
-    jdest.next_output_byte = dest;
-    jdest.free_in_buffer = out_size;
-    jdest.init_destination = init_destination;
-    jdest.empty_output_buffer = empty_output_buffer;
-    jdest.term_destination = term_destination;
-    cinfo.dest = &jdest;
-
-    cinfo.image_width = width;
-    cinfo.image_height = height;
-#if JPEG_LIB_VERSION >= 70
-    cinfo.scale_denom = scale;
-#else
-    INDI_UNUSED(scale);
-#endif
-    cinfo.input_components = 3;
-    cinfo.in_color_space = JCS_RGB;
-    jpeg_set_defaults (&cinfo);
-    jpeg_set_quality (&cinfo, quality, TRUE);
-
-    jpeg_start_compress (&cinfo, TRUE);
-    while (cinfo.next_scanline < height)
+    // Worker t compresses slices t, t + workers..., worker 0 runs on the calling thread
+    const unsigned workers = std::min<unsigned>(threads, slices);
+    auto encodeSlices = [&](unsigned worker)
     {
-        JSAMPROW row = (JSAMPROW)(src + cinfo.next_scanline * stride);
-        jpeg_write_scanlines (&cinfo, &row, 1);
+        for (uint32_t i = worker; i < slices; i += workers)
+            encodeSlice(m_Slices[i], buffer, rawWidth, factor, components);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned worker = 1; worker < workers; worker++)
+        pool.emplace_back(encodeSlices, worker);
+    encodeSlices(0);
+    for (auto &thread : pool)
+        thread.join();
+
+    const uint8_t *jpeg = m_Slices[0].jpeg.data();
+    size_t size = m_Slices[0].jpegSize;
+    if (slices > 1)
+    {
+        if (!joinSlices(height, sliceMcuRows * mcuColumns))
+        {
+            LOG_ERROR("Failed to join MJPEG slices.");
+            return false;
+        }
+        jpeg = m_Output.data();
+        size = m_Output.size();
     }
-    jpeg_finish_compress (&cinfo);
-    *destsize = out_size - jdest.free_in_buffer;
-    jpeg_destroy_compress (&cinfo);
-    return 0;
+
+    bp->setBlob(const_cast<uint8_t *>(jpeg));
+    bp->setBlobLen(size);
+    bp->setSize(size);
+    bp->setFormat(".stream_jpg");
+
+    return true;
 }
 
 }
@@ -23,33 +23,52 @@
 
 #include "encoderinterface.h"
 
+#include <vector>
+
 namespace INDI
 {
 
 /**
  * @brief The MJPEGEncoder class encodes frames in JPEG format before transmitting them to the client.
  *
- * The quality is now hard-coded at 70 when encoding the JPEG image. Further compression is not supported.
+ * Frames wider than the target width are first downscaled by the smallest integer factor that fits,
+ * averaging each square of pixels. The frame is then cut in horizontal slices, a whole number of JPEG
+ * MCU rows each, that are downscaled and compressed on their own threads. The slices are joined into
+ * a single baseline JPEG with a restart marker between them, which any decoder reads. Buffers are kept
+ * from one frame to the next. Further compression is not supported.
  */
 class MJPEGEncoder : public EncoderInterface
 {
     public:
         MJPEGEncoder();
-        ~MJPEGEncoder();
+        ~MJPEGEncoder() = default;
 
         virtual bool upload(INDI::WidgetViewBlob *bp, const uint8_t *buffer, uint32_t nbytes, bool isCompressed = false) override;
 
+        /** @brief setThreads Maximum number of slices compressed at once, 0 for one per core. */
+        void setThreads(unsigned threads)
+        {
+            m_Threads = threads;
+        }
+
     private:
-        const char *getDeviceName();
-        int jpeg_compress_8u_gray (const uint8_t * src, uint16_t width, uint16_t height, int stride, int scale, uint8_t * dest,
-                                   int * destsize, int quality);
-        int jpeg_compress_8u_rgb (const uint8_t * src, uint16_t width, uint16_t height, int stride, int scale, uint8_t * dest,
-                                  int * destsize, int quality);
-        uint8_t *jpegBuffer = nullptr;
-        uint16_t jpegBufferSize = 1;
+        struct Slice
+        {
+            uint32_t begin;
+            uint32_t end;
+            std::vector<uint32_t> sums;
+            std::vector<uint8_t> pixels;
+            std::vector<uint8_t> jpeg;
+            size_t jpegSize;
+        };
 
-        static const int SCALE_WIDTH = 640;
+        const char *getDeviceName();
+        void encodeSlice(Slice &slice, const uint8_t *buffer, uint32_t width, uint32_t factor, int components);
+        bool joinSlices(uint32_t height, uint32_t restartInterval);
 
+        unsigned m_Threads {0};
+        std::vector<Slice> m_Slices;
+        std::vector<uint8_t> m_Output;
 };
 
 }
@@ -0,0 +1,195 @@
+/*
+    Frame Buffer Pool
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+#include "framepool.h"
+#include "sharedblob.h"
+
+#include <mutex>
+#include <vector>
+
+namespace INDI
+{
+
+class FramePoolPrivate
+{
+    public:
+        ~FramePoolPrivate()
+        {
+            for (auto buffer : idle)
+                destroy(buffer);
+        }
+
+        static void destroy(FramePool::Buffer *buffer)
+        {
+            IDSharedBlobFree(buffer->m_Data);
+            delete buffer;
+        }
+
+        FramePool::Buffer *take(size_t nbytes)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            // Smallest idle buffer that fits
+            auto best = idle.end();
+            for (auto it = idle.begin(); it != idle.end(); ++it)
+                if ((*it)->m_Capacity >= nbytes && (best == idle.end() || (*it)->m_Capacity < (*best)->m_Capacity))
+                    best = it;
+
+            if (best != idle.end())
+            {
+                FramePool::Buffer *buffer = *best;
+                idle.erase(best);
+                idleBytes -= buffer->m_Capacity;
+                usedBytes += buffer->m_Capacity;
+                usedBuffers++;
+                buffer->m_Size = nbytes;
+                return buffer;
+            }
+
+            // Make room by freeing idle buffers too small to be reused
+            while (usedBytes + idleBytes + nbytes > maxBytes && !idle.empty())
+            {
+                idleBytes -= idle.back()->m_Capacity;
+                destroy(idle.back());
+                idle.pop_back();
+            }
+
+            if (usedBytes + nbytes > maxBytes)
+            {
+                dropped++;
+                return nullptr;
+            }
+
+            uint8_t *data = static_cast<uint8_t *>(IDSharedBlobAlloc(nbytes));
+            if (data == nullptr)
+            {
+                dropped++;
+                return nullptr;
+            }
+
+            FramePool::Buffer *buffer = new FramePool::Buffer();
+            buffer->m_Data = data;
+            buffer->m_Size = nbytes;
+            buffer->m_Capacity = nbytes;
+            usedBytes += nbytes;
+            usedBuffers++;
+            return buffer;
+        }
+
+        void release(FramePool::Buffer *buffer)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            usedBytes -= buffer->m_Capacity;
+            usedBuffers--;
+
+            if (buffer->m_Shared || usedBytes + idleBytes + buffer->m_Capacity > maxBytes)
+            {
+                destroy(buffer);
+                return;
+            }
+
+            idle.push_back(buffer);
+            idleBytes += buffer->m_Capacity;
+        }
+
+        void trim()
+        {
+            while (usedBytes + idleBytes > maxBytes && !idle.empty())
+            {
+                idleBytes -= idle.back()->m_Capacity;
+                destroy(idle.back());
+                idle.pop_back();
+            }
+        }
+
+    public:
+        mutable std::mutex mutex;
+        std::vector<FramePool::Buffer *> idle;
+        size_t maxBytes {0};
+        size_t usedBytes {0};
+        size_t idleBytes {0};
+        size_t usedBuffers {0};
+        uint64_t dropped {0};
+};
+
+FramePool::FramePool(size_t maxBytes)
+    : d(std::make_shared<FramePoolPrivate>())
+{
+    d->maxBytes = maxBytes;
+}
+
+FramePool::~FramePool()
+{
+    clear();
+}
+
+FramePool::BufferPtr FramePool::acquire(size_t nbytes)
+{
+    Buffer *buffer = d->take(nbytes);
+    if (buffer == nullptr)
+        return nullptr;
+
+    std::shared_ptr<FramePoolPrivate> pool = d;
+    return BufferPtr(buffer, [pool](Buffer * buffer)
+    {
+        pool->release(buffer);
+    });
+}
+
+void FramePool::setMaxBytes(size_t maxBytes)
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    d->maxBytes = maxBytes;
+    d->trim();
+}
+
+void FramePool::clear()
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    for (auto buffer : d->idle)
+        FramePoolPrivate::destroy(buffer);
+    d->idle.clear();
+    d->idleBytes = 0;
+}
+
+size_t FramePool::usedBytes() const
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    return d->usedBytes;
+}
+
+size_t FramePool::usedBuffers() const
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    return d->usedBuffers;
+}
+
+uint64_t FramePool::dropped() const
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    return d->dropped;
+}
+
+void FramePool::resetDropped()
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    d->dropped = 0;
+}
+
+}
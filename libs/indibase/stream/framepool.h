@@ -0,0 +1,116 @@
+/*
+    Frame Buffer Pool
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 2.1 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace INDI
+{
+
+class FramePoolPrivate;
+
+/**
+ * @brief The FramePool class recycles frame buffers between the driver, the recorder and the preview.
+ *
+ * Buffers are allocated with IDSharedBlobAlloc, so a buffer can be sent as a BLOB without a copy.
+ * A buffer is reference counted: it returns to the pool when the last reference is released, from any thread.
+ * The pool holds at most maxBytes, counting buffers in use and idle ones; acquire() fails beyond that,
+ * and the failure is counted as a dropped frame.
+ */
+class FramePool
+{
+    public:
+        class Buffer
+        {
+            public:
+                uint8_t *data()
+                {
+                    return m_Data;
+                }
+
+                const uint8_t *data() const
+                {
+                    return m_Data;
+                }
+
+                /** @return Size requested for this frame, in bytes. */
+                size_t size() const
+                {
+                    return m_Size;
+                }
+
+                /**
+                 * @brief setShared Mark the buffer as sent to a client as a shared BLOB. It may then be sealed
+                 * read-only, so it is freed instead of recycled.
+                 */
+                void setShared()
+                {
+                    m_Shared = true;
+                }
+
+            private:
+                friend class FramePoolPrivate;
+
+                uint8_t *m_Data {nullptr};
+                size_t m_Size {0};
+                size_t m_Capacity {0};
+                bool m_Shared {false};
+        };
+
+        typedef std::shared_ptr<Buffer> BufferPtr;
+
+    public:
+        explicit FramePool(size_t maxBytes = 512 * 1024 * 1024);
+        ~FramePool();
+
+        FramePool(const FramePool &) = delete;
+        FramePool &operator=(const FramePool &) = delete;
+
+        /**
+         * @brief acquire Get a buffer of at least nbytes, recycled if possible.
+         * @return The buffer, or null if the pool is full.
+         */
+        BufferPtr acquire(size_t nbytes);
+
+        /** @brief setMaxBytes Change the maximum memory held by the pool. Idle buffers beyond it are freed. */
+        void setMaxBytes(size_t maxBytes);
+
+        /** @brief clear Free the idle buffers. Buffers in use are freed when released. */
+        void clear();
+
+        /** @return Bytes held by buffers in use. */
+        size_t usedBytes() const;
+
+        /** @return Number of buffers in use. */
+        size_t usedBuffers() const;
+
+        /** @return Number of acquire() calls that failed because the pool was full. */
+        uint64_t dropped() const;
+
+        /** @brief resetDropped Reset the dropped frame counter. */
+        void resetDropped();
+
+    private:
+        // Shared with the buffers, so they can be released after the pool is destroyed
+        std::shared_ptr<FramePoolPrivate> d;
+};
+
+}
@@ -23,6 +23,7 @@
 
 #include "indidevapi.h"
 #include "indibasetypes.h"
+#include "../framepool.h"
 
 #include <stdio.h>
 #include <cstdlib>
@@ -75,6 +76,21 @@ class RecorderInterface
         virtual bool close()                                                           = 0;
         // when frame is in known encoding format
         virtual bool writeFrame(const uint8_t *frame, uint32_t nbytes, uint64_t timestamp) = 0;
+        // Same as above, for a frame the recorder may keep a reference to instead of copying it
+        virtual bool writeFrame(const FramePool::BufferPtr &frame, uint64_t timestamp)
+        {
+            return writeFrame(frame->data(), frame->size(), timestamp);
+        }
+        // Frames dropped because the recorder could not keep up
+        virtual uint64_t getDroppedFrames() const
+        {
+            return 0;
+        }
+        // Write rate to disk in MB/s, 0 if unknown
+        virtual double getWriteRate() const
+        {
+            return 0;
+        }
         // If streaming is enabled, then any subframing is already done by the stream recorder
         // and no need to do any further subframing operations. Otherwise, subframing must be done.
         // This is to reduce process time and save memory for a dedicated subframe buffer
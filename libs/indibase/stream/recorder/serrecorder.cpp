@@ -28,10 +28,14 @@
 #include "serrecorder.h"
 #include "jpegutils.h"
 
+#include <algorithm>
 #include <ctime>
 #include <cerrno>
+#include <cstdlib>
 #include <cstring>
+#include <fcntl.h>
 #include <sys/time.h>
+#include <unistd.h>
 
 
 #define ERRMSGSIZ 1024
@@ -39,6 +43,34 @@
 namespace INDI
 {
 
+namespace
+{
+
+// O_DIRECT needs block aligned buffers, offsets and sizes
+constexpr size_t directAlignment = 4096;
+constexpr size_t stagingSize = 8 * 1024 * 1024;
+constexpr uint64_t preallocateStep = 256 * 1024 * 1024;
+
+bool pwriteAll(int fd, const uint8_t *data, size_t size, uint64_t offset)
+{
+    while (size > 0)
+    {
+        ssize_t written = pwrite(fd, data, size, offset);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += written;
+        size -= written;
+        offset += written;
+    }
+    return true;
+}
+
+}
+
 SER_Recorder::SER_Recorder()
 {
     name = "SER";
@@ -53,13 +85,14 @@ SER_Recorder::SER_Recorder()
     // always default to. LITTLE_ENDIAN appears to be ignored by them leading to garbled data.
     serh.LittleEndian = SER_BIG_ENDIAN;
     isRecordingActive = false;
-    f = nullptr;
 
     jpegBuffer = static_cast<uint8_t*>(malloc(1));
 }
 
 SER_Recorder::~SER_Recorder()
 {
+    if (isRecordingActive)
+        close();
     free(jpegBuffer);
 }
 
@@ -70,49 +103,33 @@ bool SER_Recorder::is_little_endian()
     return black_magic == 0x01;
 }
 
-void SER_Recorder::write_int_le(uint32_t *i)
+void SER_Recorder::write_int_le(std::vector<uint8_t> &out, uint32_t i)
 {
-    if (is_little_endian())
-        fwrite((i), sizeof(uint32_t), 1, f);
-    else
-    {
-        unsigned char *c = (unsigned char *)i;
-        fwrite((c + 3), sizeof(char), 1, f);
-        fwrite((c + 2), sizeof(char), 1, f);
-        fwrite((c + 1), sizeof(char), 1, f);
-        fwrite((c), sizeof(char), 1, f);
-    }
+    for (int byte = 0; byte < 4; byte++)
+        out.push_back((i >> (8 * byte)) & 0xff);
 }
 
-void SER_Recorder::write_long_int_le(uint64_t *i)
+void SER_Recorder::write_long_int_le(std::vector<uint8_t> &out, uint64_t i)
 {
-    if (is_little_endian())
-    {
-        fwrite(((uint32_t *)i), sizeof(int), 1, f);
-        fwrite(((uint32_t *)(i) + 1), sizeof(int), 1, f);
-    }
-    else
-    {
-        write_int_le((uint32_t *)(i) + 1);
-        write_int_le((uint32_t *)(i));
-    }
+    write_int_le(out, i & 0xffffffff);
+    write_int_le(out, i >> 32);
 }
 
-void SER_Recorder::write_header(ser_header *s)
+void SER_Recorder::write_header(std::vector<uint8_t> &out, const ser_header *s)
 {
-    fwrite((s->FileID), sizeof(char), 14, f);
-    write_int_le(&(s->LuID));
-    write_int_le(&(s->ColorID));
-    write_int_le(&(s->LittleEndian));
-    write_int_le(&(s->ImageWidth));
-    write_int_le(&(s->ImageHeight));
-    write_int_le(&(s->PixelDepth));
-    write_int_le(&(s->FrameCount));
-    fwrite((s->Observer), sizeof(char), 40, f);
-    fwrite((s->Instrume), sizeof(char), 40, f);
-    fwrite((s->Telescope), sizeof(char), 40, f);
-    write_long_int_le(&(s->DateTime));
-    write_long_int_le(&(s->DateTime_UTC));
+    out.insert(out.end(), s->FileID, s->FileID + 14);
+    write_int_le(out, s->LuID);
+    write_int_le(out, s->ColorID);
+    write_int_le(out, s->LittleEndian);
+    write_int_le(out, s->ImageWidth);
+    write_int_le(out, s->ImageHeight);
+    write_int_le(out, s->PixelDepth);
+    write_int_le(out, s->FrameCount);
+    out.insert(out.end(), s->Observer, s->Observer + 40);
+    out.insert(out.end(), s->Instrume, s->Instrume + 40);
+    out.insert(out.end(), s->Telescope, s->Telescope + 40);
+    write_long_int_le(out, s->DateTime);
+    write_long_int_le(out, s->DateTime_UTC);
 }
 
 bool SER_Recorder::setPixelFormat(INDI_PIXEL_FORMAT pixelFormat, uint8_t pixelDepth)
@@ -175,108 +192,320 @@ bool SER_Recorder::open(const char *filename, char *errmsg)
     if (isRecordingActive)
         return false;
     serh.FrameCount = 0;
-    if ((f = fopen(filename, "w")) == nullptr)
+    if ((metaFd = ::open(filename, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666)) < 0)
     {
         snprintf(errmsg, ERRMSGSIZ, "recorder open error %d, %s\n", errno, strerror(errno));
         return false;
     }
 
+    // Frame data bypasses the page cache if the file system allows it
+    dataFd = metaFd;
+    directIO = false;
+#ifdef O_DIRECT
+    if (useDirectIO)
+    {
+        int fd = ::open(filename, O_WRONLY | O_DIRECT | O_CLOEXEC);
+        void *buffer = nullptr;
+        if (fd >= 0 && posix_memalign(&buffer, directAlignment, stagingSize) == 0)
+        {
+            dataFd = fd;
+            staging = static_cast<uint8_t *>(buffer);
+            directIO = true;
+        }
+        else if (fd >= 0)
+            ::close(fd);
+    }
+#endif
+
+    dataOffset = 0;
+    allocatedEnd = 0;
+    stagingUsed = 0;
+    stagingOffset = 0;
+    frameStamps.clear();
+    queue.clear();
+    queuedBytes = 0;
+    writerStop = false;
+    writerFailed = false;
+    droppedFrames = 0;
+    writeRate = 0;
+    copyPool.setMaxBytes(maxQueuedBytes);
+
     serh.DateTime     = getLocalTimeStamp();
     serh.DateTime_UTC = getUTCTimeStamp();
-    write_header(&serh);
+    std::vector<uint8_t> header;
+    write_header(header, &serh);
+    if (!writeData(header.data(), header.size()))
+    {
+        snprintf(errmsg, ERRMSGSIZ, "recorder write error %d, %s\n", errno, strerror(errno));
+        if (dataFd != metaFd)
+            ::close(dataFd);
+        ::close(metaFd);
+        dataFd = metaFd = -1;
+        free(staging);
+        staging = nullptr;
+        return false;
+    }
+
     frame_size        = serh.ImageWidth * serh.ImageHeight * (serh.PixelDepth <= 8 ? 1 : 2) * number_of_planes;
     isRecordingActive = true;
 
-    frameStamps.clear();
+    writer = std::thread(&SER_Recorder::writerThread, this);
 
     return true;
 }
 
 bool SER_Recorder::close()
 {
-    if (f)
+    if (writer.joinable())
     {
-        // Write all timestamps
-        for (auto value : frameStamps)
-            write_long_int_le(&value);
-
-        frameStamps.clear();
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            writerStop = true;
+        }
+        queueChanged.notify_all();
+        writer.join();
+    }
 
-        fseek(f, 0L, SEEK_SET);
-        write_header(&serh);
-        fclose(f);
-        f = nullptr;
+    if (metaFd >= 0)
+    {
+        // The last partial block of an O_DIRECT file goes through the page cache
+        if (directIO && stagingUsed > 0)
+            pwriteAll(metaFd, staging, stagingUsed, stagingOffset);
+
+        // Timestamps and final header, and release the preallocated space after them
+        if (!writeTrailer(dataOffset) || !checkpoint(serh.FrameCount))
+            writerFailed = true;
+        if (ftruncate(metaFd, dataOffset + frameStamps.size() * sizeof(uint64_t)) != 0)
+            writerFailed = true;
+
+        if (dataFd != metaFd)
+            ::close(dataFd);
+        ::close(metaFd);
+        dataFd = metaFd = -1;
     }
 
+    free(staging);
+    staging = nullptr;
+    frameStamps.clear();
+    copyPool.clear();
+
     isRecordingActive = false;
     return true;
 }
 
 bool SER_Recorder::writeFrame(const uint8_t *frame, uint32_t nbytes, uint64_t timestamp)
 {
-    if (!isRecordingActive)
+    if (!isRecordingActive || writerFailed)
         return false;
 
-#if 0
-    if (serh.ColorID == SER_MONO)
+    // The caller keeps its buffer, copy the frame to one the writer can hold
+    FramePool::BufferPtr copy = copyPool.acquire(nbytes);
+    if (!copy)
     {
-        if (isStreamingActive == false &&
-                (offsetX > 0 || offsetY > 0 || serh.ImageWidth != rawWidth || serh.ImageHeight != rawHeight))
-        {
-            int offset = ((rawWidth * offsetY) + offsetX);
+        droppedFrames++;
+        return true;
+    }
+    memcpy(copy->data(), frame, nbytes);
 
-            uint8_t *srcBuffer  = frame + offset;
-            uint8_t *destBuffer = frame;
-            int imageWidth      = serh.ImageWidth;
-            int imageHeight     = serh.ImageHeight;
+    return enqueue(std::move(copy), timestamp);
+}
 
-            for (int i = 0; i < imageHeight; i++)
-                memcpy(destBuffer + i * imageWidth, srcBuffer + rawWidth * i, imageWidth);
-        }
+bool SER_Recorder::writeFrame(const FramePool::BufferPtr &frame, uint64_t timestamp)
+{
+    if (!isRecordingActive || writerFailed)
+        return false;
+
+    return enqueue(frame, timestamp);
+}
+
+bool SER_Recorder::enqueue(FramePool::BufferPtr frame, uint64_t timestamp)
+{
+    // Stamp on arrival, not when written
+    uint64_t stamp = timestamp ? timestamp * m_sepaseconds_per_microsecond : getUTCTimeStamp();
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (queuedBytes + frame->size() > maxQueuedBytes)
+    {
+        droppedFrames++;
+        return true;
     }
-    else
+
+    queuedBytes += frame->size();
+    queue.push_back(QueuedFrame{std::move(frame), stamp});
+    queueChanged.notify_all();
+    return true;
+}
+
+void SER_Recorder::writerThread()
+{
+    auto lastCheckpoint = std::chrono::steady_clock::now();
+    uint64_t lastOffset = dataOffset;
+    uint32_t checkpointFrames = 0;
+
+    for (;;)
     {
-        if (isStreamingActive == false &&
-                (offsetX > 0 || offsetY > 0 || serh.ImageWidth != rawWidth || serh.ImageHeight != rawHeight))
+        QueuedFrame item;
         {
-            int offset = ((rawWidth * offsetY) + offsetX);
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueChanged.wait_for(lock, checkpointInterval, [this]()
+            {
+                return writerStop || !queue.empty();
+            });
+
+            if (queue.empty())
+            {
+                if (writerStop)
+                    break;
+            }
+            else
+            {
+                item = std::move(queue.front());
+                queue.pop_front();
+                queuedBytes -= item.frame->size();
+            }
+        }
+
+        if (item.frame && !writerFailed)
+        {
+            const uint8_t *data = item.frame->data();
+            size_t size = item.frame->size();
+
+            // Not technically pixel format, but let's use this for now.
+            if (m_PixelFormat == INDI_JPG)
+            {
+                int w = 0, h = 0, naxis = 1;
+                size_t memsize = 0;
+                if (decode_jpeg_rgb(const_cast<uint8_t *>(data), size, &jpegBuffer, &memsize, &naxis, &w, &h) < 0)
+                    continue;
+
+                serh.ImageWidth = w;
+                serh.ImageHeight = h;
+                serh.ColorID = (naxis == 3) ? SER_RGB : SER_MONO;
+                data = jpegBuffer;
+                size = memsize;
+            }
+
+            if (writeData(data, size))
+            {
+                frameStamps.push_back(item.timestamp);
+                serh.FrameCount += 1;
+            }
+            else
+                writerFailed = true;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastCheckpoint < checkpointInterval)
+            continue;
 
-            uint8_t *srcBuffer  = frame + offset * 3;
-            uint8_t *destBuffer = frame;
-            int imageWidth      = serh.ImageWidth;
-            int imageHeight     = serh.ImageHeight;
+        std::chrono::duration<double> elapsed = now - lastCheckpoint;
+        writeRate = (dataOffset - lastOffset) / elapsed.count() / (1024 * 1024);
+        lastOffset = dataOffset;
+        lastCheckpoint = now;
 
-            // RGB
-            for (int i = 0; i < imageHeight; i++)
-                memcpy(destBuffer + i * imageWidth * 3, srcBuffer + rawWidth * 3 * i, imageWidth * 3);
+        if (serh.FrameCount != checkpointFrames && !writerFailed)
+        {
+            // Frames still in the staging buffer must reach the file before the header counts them
+            if ((directIO && !syncStaging()) || !checkpoint(serh.FrameCount))
+                writerFailed = true;
+            checkpointFrames = serh.FrameCount;
         }
     }
-#endif
 
-    if(timestamp)
-        frameStamps.push_back(timestamp * m_sepaseconds_per_microsecond);
-    else
-        frameStamps.push_back(getUTCTimeStamp());
+    writeRate = 0;
+}
 
-    // Not technically pixel format, but let's use this for now.
-    if (m_PixelFormat == INDI_JPG)
+bool SER_Recorder::writeData(const uint8_t *data, size_t size)
+{
+    // Preallocation only helps, a file system without it still works
+    preallocate(dataOffset + size);
+
+    if (!directIO)
     {
-        int w = 0, h = 0, naxis = 1;
-        size_t memsize = 0;
-        if (decode_jpeg_rgb(const_cast<uint8_t *>(frame), nbytes, &jpegBuffer, &memsize, &naxis, &w, &h) < 0)
+        if (!pwriteAll(dataFd, data, size, dataOffset))
             return false;
+        dataOffset += size;
+        return true;
+    }
+
+    dataOffset += size;
+    while (size > 0)
+    {
+        size_t chunk = std::min(size, stagingSize - stagingUsed);
+        memcpy(staging + stagingUsed, data, chunk);
+        stagingUsed += chunk;
+        data += chunk;
+        size -= chunk;
 
-        serh.ImageWidth = w;
-        serh.ImageHeight = h;
-        serh.ColorID = (naxis == 3) ? SER_RGB : SER_MONO;
-        fwrite(jpegBuffer, 1, memsize, f);
+        if (stagingUsed == stagingSize && !flushStaging())
+            return false;
     }
-    else
-        fwrite(frame, 1, nbytes, f);
-    serh.FrameCount += 1;
     return true;
 }
 
+bool SER_Recorder::flushStaging()
+{
+    if (!pwriteAll(dataFd, staging, stagingSize, stagingOffset))
+        return false;
+
+    stagingOffset += stagingSize;
+    stagingUsed = 0;
+    return true;
+}
+
+bool SER_Recorder::syncStaging()
+{
+    // Whole blocks, the zero padding written after the data is overwritten by the next flush
+    size_t size = (stagingUsed + directAlignment - 1) / directAlignment * directAlignment;
+    memset(staging + stagingUsed, 0, size - stagingUsed);
+    return size == 0 || pwriteAll(dataFd, staging, size, stagingOffset);
+}
+
+bool SER_Recorder::preallocate(uint64_t end)
+{
+    if (end <= allocatedEnd)
+        return true;
+
+#ifdef __linux__
+    // Grow in large steps, without changing the file size so the file stays readable
+    uint64_t newEnd = std::max(end, allocatedEnd + preallocateStep);
+    if (fallocate(metaFd, FALLOC_FL_KEEP_SIZE, allocatedEnd, newEnd - allocatedEnd) == 0)
+    {
+        allocatedEnd = newEnd;
+        return true;
+    }
+#endif
+
+    // Not supported, do not try again
+    allocatedEnd = UINT64_MAX;
+    return false;
+}
+
+bool SER_Recorder::checkpoint(uint32_t frames)
+{
+    // The header with the frame count, the timestamps follow the last frame so close() writes them once
+    ser_header header = serh;
+    header.FrameCount = frames;
+    std::vector<uint8_t> out;
+    write_header(out, &header);
+
+    // While the first block is staged, its flushes would write back the header of open()
+    if (directIO && stagingOffset == 0)
+        memcpy(staging, out.data(), out.size());
+
+    return pwriteAll(metaFd, out.data(), out.size(), 0);
+}
+
+bool SER_Recorder::writeTrailer(uint64_t dataEnd)
+{
+    std::vector<uint8_t> out;
+    out.reserve(frameStamps.size() * sizeof(uint64_t));
+    for (uint64_t stamp : frameStamps)
+        write_long_int_le(out, stamp);
+
+    return pwriteAll(metaFd, out.data(), out.size(), dataEnd);
+}
+
 // Copyright (C) 2015 Chris Garry
 //
 
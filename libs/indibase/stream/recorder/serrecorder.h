@@ -23,8 +23,14 @@
 
 #include "recorderinterface.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <mutex>
 #include <stdio.h>
+#include <thread>
 
 typedef struct ser_header
 {
@@ -66,6 +72,12 @@ namespace INDI
 
 /**
  * @brief The SER_Recorder class implements recording of video streams in SER format.
+ *
+ * Frames are queued to a writer thread, so the stream thread never waits on the disk. The queue is bounded,
+ * frames beyond it are dropped and counted. The file is preallocated as it grows and frame data can bypass
+ * the page cache (O_DIRECT). The header is rewritten periodically with the frame count, so a recording
+ * interrupted by a crash is still a valid SER file up to the last checkpoint, without the timestamp trailer,
+ * which is written once on close.
  */
 class SER_Recorder : public RecorderInterface
 {
@@ -83,10 +95,37 @@ class SER_Recorder : public RecorderInterface
         virtual bool close();
         /** timestamp is microseconds from SER epoch Jan 1, 1 AD. If it is zero then system time is used. */
         virtual bool writeFrame(const uint8_t *frame, uint32_t nbytes, uint64_t timestamp);
+        virtual bool writeFrame(const FramePool::BufferPtr &frame, uint64_t timestamp);
         virtual void setStreamEnabled(bool enable)
         {
             isStreamingActive = enable;
         }
+        virtual uint64_t getDroppedFrames() const
+        {
+            return droppedFrames;
+        }
+        virtual double getWriteRate() const
+        {
+            return writeRate;
+        }
+
+        /** Write frame data with O_DIRECT where supported, bypassing the page cache. Applies from the next open(). */
+        void setDirectIO(bool enable)
+        {
+            useDirectIO = enable;
+        }
+
+        /** Maximum bytes waiting for the writer thread, frames beyond it are dropped. */
+        void setMaxQueuedBytes(size_t bytes)
+        {
+            maxQueuedBytes = bytes;
+        }
+
+        /** Interval between header checkpoints. */
+        void setCheckpointInterval(std::chrono::milliseconds interval)
+        {
+            checkpointInterval = interval;
+        }
 
         // Public constants
         static const uint64_t C_SEPASECONDS_PER_SECOND = 10000000;
@@ -94,17 +133,57 @@ class SER_Recorder : public RecorderInterface
     protected:
         uint64_t utcTo64BitTS();
         bool is_little_endian();
-        void write_int_le(uint32_t *i);
-        void write_long_int_le(uint64_t *i);
-        void write_header(ser_header *s);
+        void write_int_le(std::vector<uint8_t> &out, uint32_t i);
+        void write_long_int_le(std::vector<uint8_t> &out, uint64_t i);
+        void write_header(std::vector<uint8_t> &out, const ser_header *s);
+
+        // Writer thread
+        struct QueuedFrame
+        {
+            FramePool::BufferPtr frame;
+            uint64_t timestamp;
+        };
+        bool enqueue(FramePool::BufferPtr frame, uint64_t timestamp);
+        void writerThread();
+        bool writeData(const uint8_t *data, size_t size);
+        bool flushStaging();
+        bool syncStaging();
+        bool checkpoint(uint32_t frames);
+        bool writeTrailer(uint64_t dataEnd);
+        bool preallocate(uint64_t end);
+
         ser_header serh;
         bool isRecordingActive = false, isStreamingActive = false;
-        FILE *f;
         uint32_t frame_size;
         uint32_t number_of_planes;
         uint16_t rawWidth = 0, rawHeight = 0;
         std::vector<uint64_t> frameStamps;
 
+        // File. Frame data goes through dataFd, which may be O_DIRECT, header and trailer through metaFd.
+        int dataFd = -1, metaFd = -1;
+        bool useDirectIO = false, directIO = false;
+        uint64_t dataOffset = 0;            // end of the data handed to the file
+        uint64_t allocatedEnd = 0;          // end of the preallocated space
+        uint8_t *staging = nullptr;         // aligned buffer for O_DIRECT writes
+        size_t stagingUsed = 0;
+        uint64_t stagingOffset = 0;         // file offset of the staging buffer
+
+        // Queue
+        std::thread writer;
+        std::mutex queueMutex;
+        std::condition_variable queueChanged;
+        std::deque<QueuedFrame> queue;
+        size_t queuedBytes = 0;
+        size_t maxQueuedBytes = 1024 * 1024 * 1024;
+        bool writerStop = false;
+        std::atomic<bool> writerFailed {false};
+        FramePool copyPool;
+
+        // Statistics and checkpoints
+        std::atomic<uint64_t> droppedFrames {0};
+        std::atomic<double> writeRate {0};
+        std::chrono::milliseconds checkpointInterval {1000};
+
     private:
         // From pipp_timestamp.h
         // Copyright (C) 2015 Chris Garry
@@ -29,6 +29,7 @@
 #include "indilogger.h"
 #include "indiutility.h"
 #include "indisinglethreadpool.h"
+#include "recorder/serrecorder.h"
 #include "indielapsedtimer.h"
 
 #include <cerrno>
@@ -136,6 +137,20 @@ bool StreamManagerPrivate::initProperties()
     RecordOptionsNP.fill(getDeviceName(), "RECORD_OPTIONS",
                          "Record Options", STREAM_TAB, IP_RW, 60, IPS_IDLE);
 
+    /* Record writer statistics */
+    RecordStatsNP[RECORD_WRITE_RATE].fill("RECORD_WRITE_RATE", "Write (MB/s)",   "%.1f", 0, 1e6, 0, 0);
+    RecordStatsNP[RECORD_DROPPED   ].fill("RECORD_DROPPED",    "Dropped frames", "%.f",  0, 1e9, 0, 0);
+    RecordStatsNP.fill(getDeviceName(), "RECORD_STATS", "Record Stats", STREAM_TAB, IP_RO, 0, IPS_IDLE);
+
+    /* SER writer settings */
+    RecordWriterNP[RECORD_QUEUE_MAX ].fill("RECORD_QUEUE_MAX",  "Maximum Queue (MB)", "%.0f", 1,   1024 * 64, 64,  1024);
+    RecordWriterNP[RECORD_CHECKPOINT].fill("RECORD_CHECKPOINT", "Checkpoint (sec)",   "%.1f", 0.1, 3600,      1,   1);
+    RecordWriterNP.fill(getDeviceName(), "RECORD_WRITER", "Record Writer", STREAM_TAB, IP_RW, 60, IPS_IDLE);
+
+    RecordDirectIOSP[DefaultDevice::INDI_ENABLED ].fill("INDI_ENABLED",  "Enabled",  ISS_OFF);
+    RecordDirectIOSP[DefaultDevice::INDI_DISABLED].fill("INDI_DISABLED", "Disabled", ISS_ON);
+    RecordDirectIOSP.fill(getDeviceName(), "RECORD_DIRECT_IO", "Direct I/O", STREAM_TAB, IP_RW, ISR_1OFMANY, 60, IPS_IDLE);
+
     /* Record Switch */
     // @INDI_STANDARD_PROPERTY@
     RecordStreamSP[RECORD_ON   ].fill("RECORD_ON",          "Record On",         ISS_OFF);
@@ -184,6 +199,39 @@ bool StreamManagerPrivate::initProperties()
     LimitsNP[LIMITS_BUFFER_MAX ].fill("LIMITS_BUFFER_MAX",  "Maximum Buffer Size (MB)", "%.0f", 1, 1024 * 64, 1, 512);
     LimitsNP[LIMITS_PREVIEW_FPS].fill("LIMITS_PREVIEW_FPS", "Maximum Preview FPS",      "%.0f", 1, 120,     1,  10);
     LimitsNP.fill(getDeviceName(), "LIMITS", "Limits", STREAM_TAB, IP_RW, 0, IPS_IDLE);
+
+    /* Frame buffer pool */
+    BufferNP[BUFFER_USED   ].fill("BUFFER_USED",    "Used (MB)",      "%.1f", 0, 1024 * 64, 0, 0);
+    BufferNP[BUFFER_DROPPED].fill("BUFFER_DROPPED", "Dropped frames", "%.f",  0, 1e9,       0, 0);
+    BufferNP.fill(getDeviceName(), "STREAM_BUFFER", "Buffer", STREAM_TAB, IP_RO, 0, IPS_IDLE);
+    framePool.setMaxBytes(LimitsNP[LIMITS_BUFFER_MAX].getValue() * 1024 * 1024);
+
+    /* Preview */
+    PreviewNP[PREVIEW_WIDTH  ].fill("PREVIEW_WIDTH",   "Maximum Width", "%.f", 0, 65535, 64, 640);
+    PreviewNP[PREVIEW_QUALITY].fill("PREVIEW_QUALITY", "Quality",       "%.f", 1, 100,   5,  85);
+    PreviewNP.fill(getDeviceName(), "STREAM_PREVIEW", "Preview", STREAM_TAB, IP_RW, 0, IPS_IDLE);
+
+    EncodeTimeNP[0].fill("ENCODE_TIME", "Encode (ms)", "%.1f", 0, 1e6, 0, 0);
+    EncodeTimeNP.fill(getDeviceName(), "STREAM_ENCODE_TIME", "Encode Time", STREAM_TAB, IP_RO, 0, IPS_IDLE);
+
+    /* Live Stack */
+    StackSP[STACK_OFF  ].fill("STACK_OFF",   "Off",         ISS_ON);
+    StackSP[STACK_MEAN ].fill("STACK_MEAN",  "Mean",        ISS_OFF);
+    StackSP[STACK_SIGMA].fill("STACK_SIGMA", "Kappa-Sigma", ISS_OFF);
+    StackSP.fill(getDeviceName(), "STREAM_STACK", "Live Stack", STREAM_TAB, IP_RW, ISR_1OFMANY, 0, IPS_IDLE);
+
+    StackAlignSP[STACK_ALIGN_NONE ].fill("STACK_ALIGN_NONE",  "None",  ISS_OFF);
+    StackAlignSP[STACK_ALIGN_STARS].fill("STACK_ALIGN_STARS", "Stars", ISS_ON);
+    StackAlignSP[STACK_ALIGN_PHASE].fill("STACK_ALIGN_PHASE", "Phase", ISS_OFF);
+    StackAlignSP.fill(getDeviceName(), "STREAM_STACK_ALIGN", "Stack Align", STREAM_TAB, IP_RW, ISR_1OFMANY, 0, IPS_IDLE);
+
+    StackSettingsNP[STACK_KAPPA   ].fill("STACK_KAPPA",    "Kappa",        "%.1f", 1, 10,   0.5, 2.5);
+    StackSettingsNP[STACK_INTERVAL].fill("STACK_INTERVAL", "Interval (s)", "%.1f", 0, 3600, 1,   5);
+    StackSettingsNP.fill(getDeviceName(), "STREAM_STACK_SETTINGS", "Stack Settings", STREAM_TAB, IP_RW, 0, IPS_IDLE);
+
+    StackStatsNP[STACK_FRAMES  ].fill("STACK_FRAMES",   "Stacked frames",  "%.f", 0, 1e9, 0, 0);
+    StackStatsNP[STACK_REJECTED].fill("STACK_REJECTED", "Rejected frames", "%.f", 0, 1e9, 0, 0);
+    StackStatsNP.fill(getDeviceName(), "STREAM_STACK_STATS", "Stack Stats", STREAM_TAB, IP_RO, 0, IPS_IDLE);
     return true;
 }
 
@@ -207,10 +255,20 @@ void StreamManagerPrivate::ISGetProperties(const char *dev)
         currentDevice->defineProperty(RecordStreamSP);
         currentDevice->defineProperty(RecordFileTP);
         currentDevice->defineProperty(RecordOptionsNP);
+        currentDevice->defineProperty(RecordStatsNP);
+        currentDevice->defineProperty(RecordWriterNP);
+        currentDevice->defineProperty(RecordDirectIOSP);
         currentDevice->defineProperty(StreamFrameNP);
         currentDevice->defineProperty(EncoderSP);
         currentDevice->defineProperty(RecorderSP);
         currentDevice->defineProperty(LimitsNP);
+        currentDevice->defineProperty(BufferNP);
+        currentDevice->defineProperty(PreviewNP);
+        currentDevice->defineProperty(EncodeTimeNP);
+        currentDevice->defineProperty(StackSP);
+        currentDevice->defineProperty(StackAlignSP);
+        currentDevice->defineProperty(StackSettingsNP);
+        currentDevice->defineProperty(StackStatsNP);
     }
 }
 
@@ -241,10 +299,20 @@ bool StreamManagerPrivate::updateProperties()
         currentDevice->defineProperty(RecordStreamSP);
         currentDevice->defineProperty(RecordFileTP);
         currentDevice->defineProperty(RecordOptionsNP);
+        currentDevice->defineProperty(RecordStatsNP);
+        currentDevice->defineProperty(RecordWriterNP);
+        currentDevice->defineProperty(RecordDirectIOSP);
         currentDevice->defineProperty(StreamFrameNP);
         currentDevice->defineProperty(EncoderSP);
         currentDevice->defineProperty(RecorderSP);
         currentDevice->defineProperty(LimitsNP);
+        currentDevice->defineProperty(BufferNP);
+        currentDevice->defineProperty(PreviewNP);
+        currentDevice->defineProperty(EncodeTimeNP);
+        currentDevice->defineProperty(StackSP);
+        currentDevice->defineProperty(StackAlignSP);
+        currentDevice->defineProperty(StackSettingsNP);
+        currentDevice->defineProperty(StackStatsNP);
     }
     else
     {
@@ -256,10 +324,20 @@ bool StreamManagerPrivate::updateProperties()
         currentDevice->deleteProperty(RecordFileTP.getName());
         currentDevice->deleteProperty(RecordStreamSP.getName());
         currentDevice->deleteProperty(RecordOptionsNP.getName());
+        currentDevice->deleteProperty(RecordStatsNP.getName());
+        currentDevice->deleteProperty(RecordWriterNP.getName());
+        currentDevice->deleteProperty(RecordDirectIOSP.getName());
         currentDevice->deleteProperty(StreamFrameNP.getName());
         currentDevice->deleteProperty(EncoderSP.getName());
         currentDevice->deleteProperty(RecorderSP.getName());
         currentDevice->deleteProperty(LimitsNP.getName());
+        currentDevice->deleteProperty(BufferNP.getName());
+        currentDevice->deleteProperty(PreviewNP.getName());
+        currentDevice->deleteProperty(EncodeTimeNP.getName());
+        currentDevice->deleteProperty(StackSP.getName());
+        currentDevice->deleteProperty(StackAlignSP.getName());
+        currentDevice->deleteProperty(StackSettingsNP.getName());
+        currentDevice->deleteProperty(StackStatsNP.getName());
     }
 
     return true;
@@ -276,7 +354,8 @@ bool StreamManager::updateProperties()
  * Subframing for streaming/recording is done in the stream manager.
  * Therefore nbytes is expected to be SubW/BinX * SubH/BinY * Bytes_Per_Pixels * Number_Color_Components
  * Binned frame must be sent from the camera driver for this to work consistentaly for all drivers.*/
-void StreamManagerPrivate::newFrame(const uint8_t * buffer, uint32_t nbytes, uint64_t timestamp)
+void StreamManagerPrivate::newFrame(FramePool::BufferPtr frame, const uint8_t * buffer, uint32_t nbytes,
+                                    uint64_t timestamp)
 {
     // close the data stream on the same thread as the data stream
     // manually triggered to stop recording.
@@ -306,26 +385,45 @@ void StreamManagerPrivate::newFrame(const uint8_t * buffer, uint32_t nbytes, uin
     if (FPSFast.newFrame())
     {
         FpsNP[0].setValue(FPSFast.framesPerSecond());
+        BufferNP[BUFFER_USED].setValue(framePool.usedBytes() / 1024.0 / 1024.0);
+        BufferNP[BUFFER_DROPPED].setValue(framePool.dropped());
+        if (isRecording)
+        {
+            RecordStatsNP[RECORD_WRITE_RATE].setValue(recorder->getWriteRate());
+            RecordStatsNP[RECORD_DROPPED].setValue(recorder->getDroppedFrames());
+        }
         if (fastFPSUpdate.try_lock()) // don't block stream thread / record thread
             std::thread([&]()
         {
             FpsNP.apply();
+            BufferNP.setState(framePool.dropped() > 0 ? IPS_ALERT : IPS_OK);
+            BufferNP.apply();
+            if (isRecording)
+            {
+                RecordStatsNP.setState(RecordStatsNP[RECORD_DROPPED].getValue() > 0 ? IPS_ALERT : IPS_BUSY);
+                RecordStatsNP.apply();
+            }
             fastFPSUpdate.unlock();
         }).detach();
     }
 
     if (isStreaming || (isRecording && !isRecordingAboutToClose))
     {
-        size_t allocatedSize = nbytes * framesIncoming.size() / 1024 / 1024; // allocated size in MB
-        if (allocatedSize > LimitsNP[LIMITS_BUFFER_MAX].getValue())
+        // Buffers are recycled, only copy if the driver did not fill one from the pool
+        if (!frame && buffer != nullptr)
+        {
+            frame = framePool.acquire(nbytes);
+            if (frame)
+                memcpy(frame->data(), buffer, nbytes);
+        }
+
+        if (!frame)
         {
             LOG_WARN("Frame buffer is full, skipping frame...");
             return;
         }
 
-        std::vector<uint8_t> copyBuffer(buffer, buffer + nbytes); // copy the frame
-
-        framesIncoming.push(TimeFrame{FPSFast.deltaTime(), timestamp, std::move(copyBuffer)}); // push it into the queue
+        framesIncoming.push(TimeFrame{FPSFast.deltaTime(), timestamp, std::move(frame)}); // push it into the queue
     }
 
     if (isRecording && !isRecordingAboutToClose)
@@ -361,7 +459,28 @@ void StreamManagerPrivate::newFrame(const uint8_t * buffer, uint32_t nbytes, uin
 void StreamManager::newFrame(const uint8_t * buffer, uint32_t nbytes, uint64_t timestamp)
 {
     D_PTR(StreamManager);
-    d->newFrame(buffer, nbytes, timestamp);
+    d->newFrame(nullptr, buffer, nbytes, timestamp);
+}
+
+FramePool::BufferPtr StreamManager::acquireFrame(size_t nbytes)
+{
+    D_PTR(StreamManager);
+    return d->framePool.acquire(nbytes);
+}
+
+void StreamManager::newFrame(FramePool::BufferPtr frame, uint64_t timestamp)
+{
+    D_PTR(StreamManager);
+    // A frame acquireFrame() had no room for still counts, then is skipped
+    if (!frame)
+    {
+        d->newFrame(nullptr, nullptr, 0, timestamp);
+        return;
+    }
+
+    const uint8_t *buffer = frame->data();
+    uint32_t nbytes = frame->size();
+    d->newFrame(std::move(frame), buffer, nbytes, timestamp);
 }
 
 
@@ -369,7 +488,7 @@ StreamManagerPrivate::FrameInfo StreamManagerPrivate::updateSourceFrameInfo()
 {
     FrameInfo srcFrameInfo;
 
-    uint8_t components = (PixelFormat == INDI_RGB) ? 3 : 1;
+    uint8_t components = (PixelFormat == INDI_RGB || PixelFormat == INDI_BGR) ? 3 : 1;
     uint8_t bytesPerComponent = (PixelDepth + 7) / 8;
 
     dstFrameInfo.bytesPerColor = components * bytesPerComponent;
@@ -430,11 +549,9 @@ void StreamManagerPrivate::asyncStreamThread()
     TimeFrame sourceTimeFrame;
     sourceTimeFrame.time = 0;
 
-    std::vector<uint8_t> subframeBuffer;  // Subframe buffer for recording/streaming
-    std::vector<uint8_t> downscaleBuffer; // Downscale buffer for streaming
-
     INDI::SingleThreadPool previewThreadPool;
     INDI::ElapsedTimer previewElapsed;
+    INDI::ElapsedTimer stackPublished;
 
     while(!framesThreadTerminate)
     {
@@ -443,7 +560,8 @@ void StreamManagerPrivate::asyncStreamThread()
 
         FrameInfo srcFrameInfo = updateSourceFrameInfo();
 
-        std::vector<uint8_t> *sourceBuffer = &sourceTimeFrame.frame;
+        // Subframe and downscale buffers come from the pool too, so the preview can keep them
+        FramePool::BufferPtr sourceBuffer = std::move(sourceTimeFrame.frame);
 
         // Source buffer size may be equal or larger than frame info size
         // as some driver still retain full unbinned window size even when binning the output
@@ -462,10 +580,15 @@ void StreamManagerPrivate::asyncStreamThread()
             dstFrameInfo != srcFrameInfo
         )
         {
-            subframeBuffer.resize(dstFrameInfo.totalSize());
-            subframe(sourceBuffer->data(), srcFrameInfo, subframeBuffer.data(), dstFrameInfo);
+            FramePool::BufferPtr subframeBuffer = framePool.acquire(dstFrameInfo.totalSize());
+            if (!subframeBuffer)
+            {
+                LOG_WARN("Frame buffer is full, skipping frame...");
+                continue;
+            }
+            subframe(sourceBuffer->data(), srcFrameInfo, subframeBuffer->data(), dstFrameInfo);
 
-            sourceBuffer = &subframeBuffer;
+            sourceBuffer = std::move(subframeBuffer);
         }
 
         // For recording, save immediately.
@@ -473,7 +596,7 @@ void StreamManagerPrivate::asyncStreamThread()
             std::lock_guard<std::mutex> lock(recordMutex);
             if (
                 isRecording && !isRecordingAboutToClose &&
-                recordStream(sourceBuffer->data(), sourceBuffer->size(), sourceTimeFrame.time, sourceTimeFrame.timestamp) == false
+                recordStream(sourceBuffer, sourceTimeFrame.time, sourceTimeFrame.timestamp) == false
             )
             {
                 LOG_ERROR("Recording failed.");
@@ -481,41 +604,117 @@ void StreamManagerPrivate::asyncStreamThread()
             }
         }
 
+        // When live stacking, the preview shows the stack at the publishing interval instead of the frames
+        bool stackDue = false;
+        if (isStreaming && isStacking && PixelFormat != INDI_JPG)
+        {
+            FramePool::BufferPtr stack = stackFrame(sourceBuffer, stackPublished);
+            if (!stack)
+                continue;
+
+            sourceBuffer = std::move(stack);
+            stackDue = true;
+        }
+
         // For streaming, downscale to 8bit if higher than 8bit to reduce bandwidth
         // You can reduce the number of frames by setting a frame limit.
-        if (isStreaming && FPSPreview.newFrame())
+        if (isStreaming && (stackDue || FPSPreview.newFrame()))
         {
             // Downscale to 8bit always for streaming to reduce bandwidth
             if (PixelFormat != INDI_JPG && PixelDepth > 8)
             {
-                // Allocale new buffer if size changes
-                downscaleBuffer.resize(dstFrameInfo.pixels());
+                FramePool::BufferPtr downscaleBuffer = framePool.acquire(dstFrameInfo.pixels());
+                if (!downscaleBuffer)
+                    continue;
 
                 // Apply gamma
                 gammaLut16.apply(
                     reinterpret_cast<const uint16_t*>(sourceBuffer->data()),
-                    downscaleBuffer.size(),
-                    downscaleBuffer.data()
+                    downscaleBuffer->size(),
+                    downscaleBuffer->data()
                 );
 
-                sourceBuffer = &downscaleBuffer;
+                sourceBuffer = std::move(downscaleBuffer);
             }
 
-            //uploadStream(sourceBuffer->data(), sourceBuffer->size());
+            // The preview holds a reference, the buffer returns to the pool when it is sent
             previewThreadPool.start(std::bind([this, &previewElapsed](const std::atomic_bool & isAboutToQuit,
-                                              std::vector<uint8_t> frame)
+                                              FramePool::BufferPtr frame)
             {
                 INDI_UNUSED(isAboutToQuit);
                 previewElapsed.start();
-                uploadStream(frame.data(), frame.size());
+                uploadStream(frame);
                 StreamTimeNP[0].setValue(previewElapsed.nsecsElapsed() / 1000000000.0);
                 StreamTimeNP.apply();
 
-            }, std::placeholders::_1, std::move(*sourceBuffer)));
+            }, std::placeholders::_1, std::move(sourceBuffer)));
         }
     }
 }
 
+FramePool::BufferPtr StreamManagerPrivate::stackFrame(const FramePool::BufferPtr &frame, ElapsedTimer &published)
+{
+    std::lock_guard<std::mutex> lock(stackMutex);
+
+    const FrameStatistics::SampleType type = PixelDepth > 8 ? FrameStatistics::UINT16 : FrameStatistics::UINT8;
+    const uint32_t channels = LiveStacker::channels(PixelFormat);
+    if (channels == 0)
+        return nullptr;
+
+    liveStacker.setBayer(PixelFormat >= INDI_BAYER_RGGB && PixelFormat < INDI_RGB);
+    bool added = liveStacker.addFrame(frame->data(), type, dstFrameInfo.w, dstFrameInfo.h, channels);
+
+    // The first frame of a stack is shown right away
+    if (!added || (liveStacker.getFrameCount() > 1 &&
+                   !published.hasExpired(StackSettingsNP[STACK_INTERVAL].getValue() * 1000)))
+        return nullptr;
+
+    FramePool::BufferPtr stack = framePool.acquire(dstFrameInfo.totalSize());
+    if (!stack)
+        return nullptr;
+
+    liveStacker.getStack(stack->data(), type);
+    published.start();
+
+    StackStatsNP[STACK_FRAMES].setValue(liveStacker.getFrameCount());
+    StackStatsNP[STACK_REJECTED].setValue(liveStacker.getRejectedCount());
+    StackStatsNP.setState(IPS_BUSY);
+    StackStatsNP.apply();
+
+    return stack;
+}
+
+void StreamManagerPrivate::updateStacker(bool newStack)
+{
+    std::lock_guard<std::mutex> lock(stackMutex);
+
+    liveStacker.setRejection(StackSP[STACK_SIGMA].getState() == ISS_ON ? LiveStacker::REJECT_SIGMA :
+                             LiveStacker::REJECT_NONE, StackSettingsNP[STACK_KAPPA].getValue());
+
+    switch (StackAlignSP.findOnSwitchIndex())
+    {
+        case STACK_ALIGN_NONE:
+            liveStacker.setAlignment(LiveStacker::ALIGN_NONE);
+            break;
+        case STACK_ALIGN_PHASE:
+            liveStacker.setAlignment(LiveStacker::ALIGN_PHASE);
+            break;
+        default:
+            liveStacker.setAlignment(LiveStacker::ALIGN_STARS);
+            break;
+    }
+
+    isStacking = StackSP[STACK_OFF].getState() != ISS_ON;
+    if (!newStack)
+        return;
+
+    liveStacker.reset();
+    StackStatsNP[STACK_FRAMES].setValue(0);
+    StackStatsNP[STACK_REJECTED].setValue(0);
+    StackStatsNP.setState(IPS_IDLE);
+    StackStatsNP.apply();
+}
+
 void StreamManagerPrivate::setSize(uint16_t width, uint16_t height)
 {
     if (width != StreamFrameNP[CCDChip::FRAME_W].getValue() || height != StreamFrameNP[CCDChip::FRAME_H].getValue())
@@ -603,13 +802,14 @@ void StreamManager::setSize(uint16_t width, uint16_t height)
     d->setSize(width, height);
 }
 
-bool StreamManagerPrivate::recordStream(const uint8_t * buffer, uint32_t nbytes, double deltams, uint64_t timestamp)
+bool StreamManagerPrivate::recordStream(const FramePool::BufferPtr &frame, double deltams, uint64_t timestamp)
 {
     INDI_UNUSED(deltams);
     if (!isRecording)
         return false;
 
-    return recorder->writeFrame(buffer, nbytes, timestamp);
+    // The recorder may keep a reference to the frame and write it later
+    return recorder->writeFrame(frame, timestamp);
 }
 
 std::string StreamManagerPrivate::expand(const std::string &fname, const std::map<std::string, std::string> &patterns)
@@ -660,6 +860,15 @@ bool StreamManagerPrivate::startRecording()
 
     recorder->setFPS(FpsNP[FPS_AVERAGE].getValue());
 
+    // The SER writer settings apply from the next open()
+    if (auto serRecorder = dynamic_cast<SER_Recorder *>(recorder))
+    {
+        serRecorder->setMaxQueuedBytes(RecordWriterNP[RECORD_QUEUE_MAX].getValue() * 1024 * 1024);
+        serRecorder->setCheckpointInterval(std::chrono::milliseconds(static_cast<int64_t>(
+                                               RecordWriterNP[RECORD_CHECKPOINT].getValue() * 1000)));
+        serRecorder->setDirectIO(RecordDirectIOSP[DefaultDevice::INDI_ENABLED].getState() == ISS_ON);
+    }
+
     /* pattern substitution */
     recordfiledir.assign(RecordFileTP[0].getText());
     expfiledir = expand(recordfiledir, patterns);
@@ -714,6 +923,7 @@ bool StreamManagerPrivate::startRecording()
     {
         FPSAverage.reset();
         FPSFast.reset();
+        framePool.resetDropped();
     }
 
     if(currentDevice->getDriverInterface() & INDI::DefaultDevice::CCD_INTERFACE)
@@ -767,9 +977,18 @@ bool StreamManagerPrivate::stopRecording(bool force)
         recorder->close();
     }
 
+    RecordStatsNP[RECORD_WRITE_RATE].setValue(0);
+    RecordStatsNP[RECORD_DROPPED].setValue(recorder->getDroppedFrames());
+    RecordStatsNP.setState(recorder->getDroppedFrames() > 0 ? IPS_ALERT : IPS_IDLE);
+    RecordStatsNP.apply();
+
     if (force)
         return false;
 
+    if (recorder->getDroppedFrames() > 0)
+        LOGF_WARN("Recorder could not keep up, %llu frames were dropped.",
+                  static_cast<unsigned long long>(recorder->getDroppedFrames()));
+
     LOGF_INFO(
         "Record Duration: %g millisec / %d frames",
         FPSRecorder.totalTime(),
@@ -885,6 +1104,39 @@ bool StreamManagerPrivate::ISNewSwitch(const char * dev, const char * name, ISSt
         return true;
     }
 
+    // Live Stack
+    if (StackSP.isNameMatch(name))
+    {
+        StackSP.update(states, names, n);
+        updateStacker(true);
+
+        if (isStacking)
+            LOGF_INFO("Starting a new live stack (%s).", StackSP.findOnSwitch()->getLabel());
+        StackSP.setState(isStacking ? IPS_BUSY : IPS_IDLE);
+        StackSP.apply();
+        return true;
+    }
+
+    if (StackAlignSP.isNameMatch(name))
+    {
+        StackAlignSP.update(states, names, n);
+        updateStacker(true);
+        StackAlignSP.setState(IPS_OK);
+        StackAlignSP.apply();
+        return true;
+    }
+
+    // SER writer direct I/O
+    if (RecordDirectIOSP.isNameMatch(name))
+    {
+        RecordDirectIOSP.update(states, names, n);
+        RecordDirectIOSP.setState(IPS_OK);
+        RecordDirectIOSP.apply();
+        if (isRecording)
+            LOG_INFO("Record writer settings apply from the next recording.");
+        return true;
+    }
+
     // Recorder Selection
     if (RecorderSP.isNameMatch(name))
     {
@@ -971,12 +1223,45 @@ bool StreamManagerPrivate::ISNewNumber(const char * dev, const char * name, doub
 
         FPSPreview.setTimeWindow(1000.0 / LimitsNP[LIMITS_PREVIEW_FPS].getValue());
         FPSPreview.reset();
+        framePool.setMaxBytes(LimitsNP[LIMITS_BUFFER_MAX].getValue() * 1024 * 1024);
 
         LimitsNP.setState(IPS_OK);
         LimitsNP.apply();
         return true;
     }
 
+    /* Preview */
+    if (PreviewNP.isNameMatch(name))
+    {
+        PreviewNP.update(values, names, n);
+        for (EncoderInterface * oneEncoder : encoderManager.getEncoderList())
+            oneEncoder->setPreview(PreviewNP[PREVIEW_WIDTH].getValue(), PreviewNP[PREVIEW_QUALITY].getValue());
+        PreviewNP.setState(IPS_OK);
+        PreviewNP.apply();
+        return true;
+    }
+
+    /* Live Stack */
+    if (StackSettingsNP.isNameMatch(name))
+    {
+        StackSettingsNP.update(values, names, n);
+        updateStacker(false);
+        StackSettingsNP.setState(IPS_OK);
+        StackSettingsNP.apply();
+        return true;
+    }
+
+    /* SER writer settings */
+    if (RecordWriterNP.isNameMatch(name))
+    {
+        RecordWriterNP.update(values, names, n);
+        RecordWriterNP.setState(IPS_OK);
+        RecordWriterNP.apply();
+        if (isRecording)
+            LOG_INFO("Record writer settings apply from the next recording.");
+        return true;
+    }
+
     /* Record Options */
     if (RecordOptionsNP.isNameMatch(name))
     {
@@ -1060,6 +1345,8 @@ bool StreamManagerPrivate::setStream(bool enable)
             FPSPreview.reset();
             FPSPreview.setTimeWindow(1000.0 / LimitsNP[LIMITS_PREVIEW_FPS].getValue());
             frameCountDivider = 0;
+            framePool.resetDropped();
+            updateStacker(true);
 
             if(currentDevice->getDriverInterface() & INDI::DefaultDevice::CCD_INTERFACE)
             {
@@ -1153,8 +1440,13 @@ bool StreamManager::saveConfigItems(FILE * fp)
     d->EncoderSP.save(fp);
     d->RecordFileTP.save(fp);
     d->RecordOptionsNP.save(fp);
+    d->RecordWriterNP.save(fp);
+    d->RecordDirectIOSP.save(fp);
     d->RecorderSP.save(fp);
     d->LimitsNP.save(fp);
+    d->PreviewNP.save(fp);
+    d->StackAlignSP.save(fp);
+    d->StackSettingsNP.save(fp);
     return true;
 }
 
@@ -1185,6 +1477,17 @@ void StreamManager::getStreamFrame(uint16_t * x, uint16_t * y, uint16_t * w, uin
     d->getStreamFrame(x, y, w, h);
 }
 
+bool StreamManagerPrivate::uploadStream(const FramePool::BufferPtr &frame)
+{
+    bool result = uploadStream(frame->data(), frame->size());
+
+    // Sent as a shared BLOB without a copy, the buffer may now be sealed read-only
+    if (imageBP[0].getBlob() == frame->data())
+        frame->setShared();
+
+    return result;
+}
+
 bool StreamManagerPrivate::uploadStream(const uint8_t * buffer, uint32_t nbytes)
 {
     // Send as is, already encoded.
@@ -1209,10 +1512,15 @@ bool StreamManagerPrivate::uploadStream(const uint8_t * buffer, uint32_t nbytes)
     }
 #endif
 
+    INDI::ElapsedTimer encodeElapsed;
+
     if(currentDevice->getDriverInterface() & INDI::DefaultDevice::CCD_INTERFACE)
     {
         if (encoder->upload(&imageBP[0], buffer, nbytes, dynamic_cast<INDI::CCD*>(currentDevice)->PrimaryCCD.isCompressed()))
         {
+            EncodeTimeNP[0].setValue(encodeElapsed.nsecsElapsed() / 1000000.0);
+            EncodeTimeNP.apply();
+
             // Upload to client now
             imageBP.setState(IPS_OK);
             imageBP.apply();
@@ -1224,6 +1532,9 @@ bool StreamManagerPrivate::uploadStream(const uint8_t * buffer, uint32_t nbytes)
         if (encoder->upload(&imageBP[0], buffer, nbytes,
                             false))//dynamic_cast<INDI::SensorInterface*>(currentDevice)->isCompressed()))
         {
+            EncodeTimeNP[0].setValue(encodeElapsed.nsecsElapsed() / 1000000.0);
+            EncodeTimeNP.apply();
+
             // Upload to client now
             imageBP.setState(IPS_OK);
             imageBP.apply();
@@ -26,6 +26,7 @@
 #include "indidevapi.h"
 #include "indibasetypes.h"
 #include "indimacros.h"
+#include "framepool.h"
 #include <cstdint>
 #include <memory>
 
@@ -118,6 +119,21 @@ class StreamManager
          */
         void newFrame(const uint8_t *buffer, uint32_t nbytes, uint64_t timestamp = 0);
 
+        /**
+         * @brief acquireFrame Get a buffer from the stream frame pool, for drivers that can fill it directly
+         * and pass it to newFrame() without a copy.
+         * @param nbytes Size of the frame in bytes.
+         * @return The buffer, or null if the pool is full and the frame must be dropped.
+         */
+        FramePool::BufferPtr acquireFrame(size_t nbytes);
+
+        /**
+         * @brief newFrame Same as above, for a frame in a buffer from acquireFrame(). The buffer is shared with
+         * the recorder and the preview, and returns to the pool once they are done. Pass a null frame when
+         * acquireFrame() failed, so the dropped frame is still counted in the frame rate and recording limits.
+         */
+        void newFrame(FramePool::BufferPtr frame, uint64_t timestamp = 0);
+
         bool close();
 
     public:
@@ -29,6 +29,9 @@
 #include "fpsmeter.h"
 #include "uniquequeue.h"
 #include "gammalut16.h"
+#include "framepool.h"
+#include "indilivestacker.h"
+#include "indielapsedtimer.h"
 
 #include <atomic>
 #include <string>
@@ -110,7 +113,11 @@ class StreamManagerPrivate
         bool ISNewSwitch(const char * dev, const char * name, ISState * states, char * names[], int n);
         bool ISNewNumber(const char * dev, const char * name, double values[], char * names[], int n);
 
-        void newFrame(const uint8_t * buffer, uint32_t nbytes, uint64_t timestamp);
+        /**
+         * @brief newFrame Count the frame, and queue it for recording and streaming.
+         * @param frame Frame buffer from the pool, or null to copy the frame from buffer into a pool buffer if queued.
+         */
+        void newFrame(FramePool::BufferPtr frame, const uint8_t * buffer, uint32_t nbytes, uint64_t timestamp);
 
         bool updateProperties();
         bool setStream(bool enable);
@@ -142,11 +149,16 @@ class StreamManagerPrivate
          */
         bool uploadStream(const uint8_t *buffer, uint32_t nbytes);
 
+        /**
+         * @brief uploadStream Upload a frame from the pool, marking it as shared if it was sent without a copy.
+         */
+        bool uploadStream(const FramePool::BufferPtr &frame);
+
         /**
          * @brief recordStream Calls the backend recorder to record a single frame.
          * @param deltams time in milliseconds since last frame
          */
-        bool recordStream(const uint8_t *buffer, uint32_t nbytes, double deltams, uint64_t timestamp);
+        bool recordStream(const FramePool::BufferPtr &frame, double deltams, uint64_t timestamp);
 
         void getStreamFrame(uint16_t * x, uint16_t * y, uint16_t * w, uint16_t * h) const;
         void setStreamFrame(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
@@ -198,6 +210,15 @@ class StreamManagerPrivate
         /* Record Options */
         INDI::PropertyNumber RecordOptionsNP {2};
 
+        /* Record writer statistics */
+        INDI::PropertyNumber RecordStatsNP {2};
+        enum { RECORD_WRITE_RATE, RECORD_DROPPED };
+
+        /* SER writer settings, applied when a recording starts */
+        INDI::PropertyNumber RecordWriterNP {2};
+        enum { RECORD_QUEUE_MAX, RECORD_CHECKPOINT };
+        INDI::PropertySwitch RecordDirectIOSP {2};
+
         // Stream Frame
         INDI::PropertyNumber StreamFrameNP {4};
 
@@ -216,9 +237,33 @@ class StreamManagerPrivate
         INDI::PropertyNumber LimitsNP {2};
         enum { LIMITS_BUFFER_MAX, LIMITS_PREVIEW_FPS };
 
+        // Frame buffer pool usage
+        INDI::PropertyNumber BufferNP {2};
+        enum { BUFFER_USED, BUFFER_DROPPED };
+
+        // Preview size and quality for compressing encoders, and the time to encode a preview frame
+        INDI::PropertyNumber PreviewNP {2};
+        enum { PREVIEW_WIDTH, PREVIEW_QUALITY };
+
+        INDI::PropertyNumber EncodeTimeNP {1};
+
+        // Live stacking of the preview. Selecting a method again starts a new stack.
+        INDI::PropertySwitch StackSP {3};
+        enum { STACK_OFF, STACK_MEAN, STACK_SIGMA };
+
+        INDI::PropertySwitch StackAlignSP {3};
+        enum { STACK_ALIGN_NONE, STACK_ALIGN_STARS, STACK_ALIGN_PHASE };
+
+        INDI::PropertyNumber StackSettingsNP {2};
+        enum { STACK_KAPPA, STACK_INTERVAL };
+
+        INDI::PropertyNumber StackStatsNP {2};
+        enum { STACK_FRAMES, STACK_REJECTED };
+
         std::atomic<bool> isStreaming { false };
         std::atomic<bool> isRecording { false };
         std::atomic<bool> isRecordingAboutToClose { false };
+        std::atomic<bool> isStacking { false };
         bool hasStreamingExposure { true };
 
         // Recorder
@@ -249,17 +294,31 @@ class StreamManagerPrivate
         {
             double time;
             uint64_t timestamp;
-            std::vector<uint8_t> frame;
+            FramePool::BufferPtr frame;
         } TimeFrame;
 
         std::thread              framesThread;   // async incoming frames processing
         std::atomic<bool>        framesThreadTerminate {false};
         UniqueQueue<TimeFrame>   framesIncoming;
+        FramePool                framePool;
 
         std::mutex               fastFPSUpdate;
         std::mutex               recordMutex;
 
         GammaLut16               gammaLut16;
+
+        // Live stack, fed by the stream thread and configured by clients
+        LiveStacker              liveStacker;
+        std::mutex               stackMutex;
+
+        /** @brief updateStacker Apply the stack properties, optionally dropping the current stack. */
+        void updateStacker(bool newStack);
+
+        /**
+         * @brief stackFrame Add a frame to the live stack.
+         * @return The stack, when it is due for the preview, or nothing.
+         */
+        FramePool::BufferPtr stackFrame(const FramePool::BufferPtr &frame, ElapsedTimer &published);
 };
 
 }
@@ -1965,6 +1965,16 @@ unsigned char * V4L2_Base::getRGBBuffer()
     return decoder->getRGBBuffer();
 }
 
+void V4L2_Base::copyY(unsigned char *dest)
+{
+    decoder->copyY(dest);
+}
+
+void V4L2_Base::copyRGB(unsigned char *dest, bool planar)
+{
+    decoder->copyRGB(dest, planar);
+}
+
 float * V4L2_Base::getLinearY()
 {
     return decoder->getLinearY();
@@ -105,6 +105,8 @@ class V4L2_Base
         unsigned char *getV();
         unsigned char * getMJPEGBuffer(int &size);
         unsigned char *getRGBBuffer();
+        void copyY(unsigned char *dest);
+        void copyRGB(unsigned char *dest, bool planar);
         float *getLinearY();
 
         void registerCallback(WPF *fp, void *ud);
@@ -11,6 +11,9 @@ unsigned char lutrangecbcr8[256];
 unsigned short lutrangecbcr10[1024];
 unsigned short lutrangecbcr12[4096];
 unsigned short lutrangecbcr16[65536];
+float lutlinear8[256];
+unsigned short lutlinear16[256];
+int lutlinearcolorspace = -1;
 
 void initColorSpace()
 {
@@ -78,6 +81,40 @@ void linearize(float *buf, unsigned int len, struct v4l2_format *fmt)
     }
 }
 
+/* 8 bit samples only take 256 values, so the transfer function is evaluated once per value and colorspace */
+static void makeLinearLUT(struct v4l2_format *fmt)
+{
+    unsigned int i;
+
+    if (lutlinearcolorspace == (int)fmt->fmt.pix.colorspace)
+        return;
+
+    for (i = 0; i < 256; i++)
+        lutlinear8[i] = i / 255.0;
+    linearize(lutlinear8, 256, fmt);
+    for (i = 0; i < 256; i++)
+        lutlinear16[i] = (unsigned short)(lutlinear8[i] * 65535.0);
+    lutlinearcolorspace = fmt->fmt.pix.colorspace;
+}
+
+void linearizeY8(const unsigned char *src, float *dest, unsigned int len, struct v4l2_format *fmt)
+{
+    unsigned int i;
+
+    makeLinearLUT(fmt);
+    for (i = 0; i < len; i++)
+        dest[i] = lutlinear8[src[i]];
+}
+
+void linearizeY8To16(const unsigned char *src, unsigned short *dest, unsigned int len, struct v4l2_format *fmt)
+{
+    unsigned int i;
+
+    makeLinearLUT(fmt);
+    for (i = 0; i < len; i++)
+        dest[i] = lutlinear16[src[i]];
+}
+
 const char *getColorSpaceName(struct v4l2_format *fmt)
 {
     switch (fmt->fmt.pix.colorspace)
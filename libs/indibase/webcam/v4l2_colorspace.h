@@ -31,6 +31,10 @@ const char *getQuantizationName(struct v4l2_format *fmt);
 
 void rangeY8(unsigned char *buf, unsigned int len);
 void linearize(float *buf, unsigned int len, struct v4l2_format *fmt);
+/* Same as linearize() on 8 bit samples scaled to [0, 1], through a table built for the colorspace of fmt */
+void linearizeY8(const unsigned char *src, float *dest, unsigned int len, struct v4l2_format *fmt);
+/* Same as linearizeY8(), scaled to 16 bit */
+void linearizeY8To16(const unsigned char *src, unsigned short *dest, unsigned int len, struct v4l2_format *fmt);
 
 #ifdef __cplusplus
 }
@@ -72,6 +72,7 @@ V4L2_Builtin_Decoder::V4L2_Builtin_Decoder()
     useSoftCrop    = false;
     doCrop         = false;
     doQuantization = false;
+    doLinearization = false;
     YBuf           = nullptr;
     UBuf           = nullptr;
     VBuf           = nullptr;
@@ -80,6 +81,7 @@ V4L2_Builtin_Decoder::V4L2_Builtin_Decoder()
     colorBuffer    = nullptr;
     rgb24_buffer   = nullptr;
     linearBuffer   = nullptr;
+    chromaValid    = false;
     //cropbuf = nullptr;
     for (i = 0; i < 32; i++)
     {
@@ -147,30 +149,19 @@ void V4L2_Builtin_Decoder::decode(unsigned char *frame, struct v4l2_buffer *buf,
             break;
 
         case V4L2_PIX_FMT_Y16:
-            if (useSoftCrop && doCrop)
-            {
-                unsigned char *src  = frame + 2 * (crop.c.left) + (crop.c.top * fmt.fmt.pix.bytesperline);
-                unsigned char *dest = yuyvBuffer;
+#ifdef V4L2_PIX_FMT_Y16_BE
+        case V4L2_PIX_FMT_Y16_BE:
+#endif
+        {
+            unsigned char *src = frame;
 
-                for (unsigned int i = 0; i < (unsigned int)crop.c.height; i++)
-                {
-                    memcpy(dest, src, 2 * crop.c.width);
-                    src += fmt.fmt.pix.bytesperline;
-                    dest += 2 * crop.c.width;
-                }
-            }
-            else // No soft crop
-            {
-                unsigned char *src  = frame;
-                unsigned char *dest = yuyvBuffer;
-                for (unsigned int i = 0; i < bufheight; i++)
-                {
-                    memcpy(dest, src, 2 * bufwidth); // Copy 2 * width bytes for each line
-                    src += fmt.fmt.pix.bytesperline; // Advance source by its stride
-                    dest += 2 * bufwidth;            // Advance destination by its stride (2 * width)
-                }
-            }
-            break;
+            if (useSoftCrop && doCrop)
+                src += 2 * (crop.c.left) + (crop.c.top * fmt.fmt.pix.bytesperline);
+            // Y16 is little endian
+            ccvt_y16_copy(bufwidth, bufheight, src, fmt.fmt.pix.bytesperline,
+                          fmt.fmt.pix.pixelformat != V4L2_PIX_FMT_Y16, yuyvBuffer);
+        }
+        break;
 
         case V4L2_PIX_FMT_YUV420:
         case V4L2_PIX_FMT_YVU420:
@@ -307,79 +298,24 @@ void V4L2_Builtin_Decoder::decode(unsigned char *frame, struct v4l2_buffer *buf,
             break;
 
         case V4L2_PIX_FMT_YUYV:
-            if (useSoftCrop && doCrop)
-            {
-                unsigned char *src  = frame + 2 * (crop.c.left) + (crop.c.top * fmt.fmt.pix.bytesperline);
-                unsigned char *dest = yuyvBuffer;
-
-                for (unsigned int i = 0; i < (unsigned int)crop.c.height; i++)
-                {
-                    memcpy(dest, src, 2 * crop.c.width);
-                    src += fmt.fmt.pix.bytesperline;
-                    dest += 2 * crop.c.width;
-                }
-            }
-            else
-            {
-                memcpy(yuyvBuffer, frame, 2 * bufwidth * bufheight);
-            }
-            break;
-
         case V4L2_PIX_FMT_UYVY:
         case V4L2_PIX_FMT_VYUY:
         case V4L2_PIX_FMT_YVYU:
         {
-            unsigned char *src = nullptr;
-            unsigned char *dest = yuyvBuffer;
-            unsigned char *s = nullptr, *s1 = nullptr, *s2 = nullptr, *s3 = nullptr, *s4 = nullptr;
+            unsigned char *src = frame;
+            ccvt_422_order order = CCVT_422_YUYV;
 
             if (useSoftCrop && doCrop)
-            {
-                src = frame + 2 * (crop.c.left) + (crop.c.top * fmt.fmt.pix.bytesperline);
-                //IDLog("Decoding UYVY with cropping %dx%d frame at %lx\n", width, height, src);
-            }
-            else
-            {
-                src = frame;
-                //IDLog("Decoding UYVY  %dx%d frame at %lx\n", width, height, src);
-            }
-            for (int i = 0; i < (int)bufheight; i++)
-            {
-                s = src;
-                switch (fmt.fmt.pix.pixelformat)
-                {
-                    case V4L2_PIX_FMT_UYVY:
-                        s1 = (s + 1);
-                        s2 = (s);
-                        s3 = (s + 3);
-                        s4 = (s + 2);
-                        break;
-                    case V4L2_PIX_FMT_VYUY:
-                        s1 = (s + 1);
-                        s2 = (s + 2);
-                        s3 = (s + 3);
-                        s4 = (s);
-                        break;
-                    case V4L2_PIX_FMT_YVYU:
-                        s1 = (s);
-                        s2 = (s + 3);
-                        s3 = (s + 2);
-                        s4 = (s + 1);
-                        break;
-                }
-                for (int j = 0; j < (int)(bufwidth / 2); j++)
-                {
-                    *(dest++) = *(s1);
-                    *(dest++) = *(s2);
-                    *(dest++) = *(s3);
-                    *(dest++) = *(s4);
-                    s1 += 4;
-                    s2 += 4;
-                    s3 += 4;
-                    s4 += 4;
-                }
-                src += fmt.fmt.pix.bytesperline;
-            }
+                src += 2 * (crop.c.left) + (crop.c.top * fmt.fmt.pix.bytesperline);
+            if (fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_UYVY)
+                order = CCVT_422_UYVY;
+            else if (fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_YVYU)
+                order = CCVT_422_YVYU;
+            else if (fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_VYUY)
+                order = CCVT_422_VYUY;
+            // Reordered to YUYV, chroma is only separated when asked for
+            ccvt_422_yuyv(bufwidth, bufheight, src, fmt.fmt.pix.bytesperline, order, yuyvBuffer);
+            chromaValid = false;
         }
         break;
 
@@ -584,6 +520,7 @@ void V4L2_Builtin_Decoder::allocBuffers()
     if (linearBuffer)
         delete[](linearBuffer);
     linearBuffer = nullptr;
+    chromaValid  = false;
     //if (cropbuf) free(cropbuf); cropbuf=nullptr;
 
     if (doCrop)
@@ -613,6 +550,9 @@ void V4L2_Builtin_Decoder::allocBuffers()
             // bzero(Ubuf, ((bufwidth * bufheight) / 2));
             break;
         case V4L2_PIX_FMT_Y16:
+#ifdef V4L2_PIX_FMT_Y16_BE
+        case V4L2_PIX_FMT_Y16_BE:
+#endif
         case V4L2_PIX_FMT_YUYV:
         case V4L2_PIX_FMT_UYVY:
         case V4L2_PIX_FMT_VYUY:
@@ -640,17 +580,11 @@ void V4L2_Builtin_Decoder::allocBuffers()
 
 void V4L2_Builtin_Decoder::makeLinearY()
 {
-    unsigned char *src = YBuf;
-    float *dest;
-    unsigned int i;
     if (!linearBuffer)
     {
         linearBuffer = new float[(bufwidth * bufheight)];
     }
-    dest = linearBuffer;
-    for (i = 0; i < bufwidth * bufheight; i++)
-        *dest++ = (*src++) / 255.0;
-    linearize(linearBuffer, bufwidth * bufheight, &fmt);
+    linearizeY8(YBuf, linearBuffer, bufwidth * bufheight, &fmt);
 }
 void V4L2_Builtin_Decoder::makeY()
 {
@@ -675,36 +609,92 @@ void V4L2_Builtin_Decoder::makeY()
         case V4L2_PIX_FMT_UYVY:
         case V4L2_PIX_FMT_VYUY:
         case V4L2_PIX_FMT_YVYU:
-            // todo handcopy only Ybuf using an int, byfwidth should be even
-            ccvt_yuyv_420p(bufwidth, bufheight, yuyvBuffer, YBuf, UBuf, VBuf);
+            ccvt_yuyv_y(bufwidth, bufheight, yuyvBuffer, YBuf);
             break;
     }
 }
 
+bool V4L2_Builtin_Decoder::isPackedYUV()
+{
+    switch (fmt.fmt.pix.pixelformat)
+    {
+        case V4L2_PIX_FMT_YUYV:
+        case V4L2_PIX_FMT_UYVY:
+        case V4L2_PIX_FMT_VYUY:
+        case V4L2_PIX_FMT_YVYU:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool V4L2_Builtin_Decoder::isY16()
+{
+#ifdef V4L2_PIX_FMT_Y16_BE
+    if (fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_Y16_BE)
+        return true;
+#endif
+    return fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_Y16;
+}
+
+void V4L2_Builtin_Decoder::makeChroma()
+{
+    if (!isPackedYUV() || chromaValid)
+        return;
+    makeY();
+    ccvt_yuyv_420p(bufwidth, bufheight, yuyvBuffer, YBuf, UBuf, VBuf);
+    chromaValid = true;
+}
+
 unsigned char *V4L2_Builtin_Decoder::getY()
 {
-    if (fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_Y16)
+    if (isY16())
         return yuyvBuffer;
     makeY();
     if (doQuantization && getQuantization(&fmt) == QUANTIZATION_LIM_RANGE)
         rangeY8(YBuf, (bufwidth * bufheight));
     if (doLinearization)
     {
-        unsigned int i;
-        float *src;
-        unsigned short *dest;
+        // The 16 bit result replaces the packed frame, keep its chroma first
+        makeChroma();
         if (!yuyvBuffer)
             yuyvBuffer = new unsigned char[(bufwidth * bufheight) * 2];
-        makeLinearY();
-        src  = linearBuffer;
-        dest = (unsigned short *)yuyvBuffer;
-        for (i = 0; i < bufwidth * bufheight; i++)
-            *dest++ = (unsigned short)(*src++ * 65535.0);
+        linearizeY8To16(YBuf, (unsigned short *)yuyvBuffer, bufwidth * bufheight, &fmt);
         return yuyvBuffer;
     }
     return YBuf;
 }
 
+void V4L2_Builtin_Decoder::copyY(unsigned char *dest)
+{
+    unsigned int pixels = bufwidth * bufheight;
+
+    if (isY16())
+    {
+        memcpy(dest, yuyvBuffer, 2 * pixels);
+        return;
+    }
+
+    // The last step of getY() writes to dest instead of a decoder buffer
+    if (isPackedYUV() && !doLinearization)
+        ccvt_yuyv_y(bufwidth, bufheight, yuyvBuffer, dest);
+    else
+    {
+        makeY();
+        if (doLinearization)
+        {
+            if (doQuantization && getQuantization(&fmt) == QUANTIZATION_LIM_RANGE)
+                rangeY8(YBuf, pixels);
+            linearizeY8To16(YBuf, (unsigned short *)dest, pixels, &fmt);
+            return;
+        }
+        memcpy(dest, YBuf, pixels);
+    }
+
+    if (doQuantization && getQuantization(&fmt) == QUANTIZATION_LIM_RANGE)
+        rangeY8(dest, pixels);
+}
+
 float *V4L2_Builtin_Decoder::getLinearY()
 {
     makeY();
@@ -716,11 +706,13 @@ float *V4L2_Builtin_Decoder::getLinearY()
 
 unsigned char *V4L2_Builtin_Decoder::getU()
 {
+    makeChroma();
     return UBuf;
 }
 
 unsigned char *V4L2_Builtin_Decoder::getV()
 {
+    makeChroma();
     return VBuf;
 }
 
@@ -826,23 +818,30 @@ unsigned char *V4L2_Builtin_Decoder::getRGBBuffer()
         rgb24_buffer = new unsigned char[(bufwidth * bufheight) * 3];
     switch (fmt.fmt.pix.pixelformat)
     {
-        case V4L2_PIX_FMT_GREY:
-        case V4L2_PIX_FMT_JPEG:
-        case V4L2_PIX_FMT_MJPEG:
-        case V4L2_PIX_FMT_YUV420:
-        case V4L2_PIX_FMT_YVU420:
-        case V4L2_PIX_FMT_NV12:
-        case V4L2_PIX_FMT_NV21:
-            ccvt_420p_rgb24(bufwidth, bufheight, (void *)yuvBuffer, (void *)rgb24_buffer);
+        case V4L2_PIX_FMT_RGB24:
+        case V4L2_PIX_FMT_RGB555:
+        case V4L2_PIX_FMT_RGB565:
+        case V4L2_PIX_FMT_SBGGR8:
+        case V4L2_PIX_FMT_SRGGB8:
+        case V4L2_PIX_FMT_SGRBG8:
+        case V4L2_PIX_FMT_SBGGR16:
+            break;
+        default:
+            copyRGB(rgb24_buffer, false);
             break;
+    }
+    return rgb24_buffer;
+}
+
+void V4L2_Builtin_Decoder::copyRGB(unsigned char *dest, bool planar)
+{
+    switch (fmt.fmt.pix.pixelformat)
+    {
         case V4L2_PIX_FMT_YUYV:
         case V4L2_PIX_FMT_UYVY:
         case V4L2_PIX_FMT_VYUY:
         case V4L2_PIX_FMT_YVYU:
-            //if (!colorBuffer) colorBuffer = new unsigned char[(bufwidth * bufheight) * 4];
-            //ccvt_yuyv_bgr32(bufwidth, bufheight, yuyvBuffer, rgb24_buffer);
-            //ccvt_bgr32_rgb24(bufwidth, bufheight, colorBuffer, (void*)rgb24_buffer);
-            ccvt_yuyv_rgb24(bufwidth, bufheight, yuyvBuffer, (void *)rgb24_buffer);
+            ccvt_yuyv_rgb(bufwidth, bufheight, yuyvBuffer, dest, planar);
             break;
         case V4L2_PIX_FMT_RGB24:
         case V4L2_PIX_FMT_RGB555:
@@ -851,12 +850,33 @@ unsigned char *V4L2_Builtin_Decoder::getRGBBuffer()
         case V4L2_PIX_FMT_SRGGB8:
         case V4L2_PIX_FMT_SGRBG8:
         case V4L2_PIX_FMT_SBGGR16:
-            break;
+        {
+            // Already decoded to RGB by decode()
+            unsigned int sample = bpp / 8;
+            unsigned int pixels = bufwidth * bufheight;
+
+            if (!planar)
+            {
+                memcpy(dest, rgb24_buffer, 3 * sample * pixels);
+                break;
+            }
+            for (unsigned int c = 0; c < 3; c++)
+            {
+                unsigned char *d = dest + c * sample * pixels;
+                const unsigned char *s = rgb24_buffer + c * sample;
+                for (unsigned int i = 0; i < pixels; i++)
+                {
+                    memcpy(d, s, sample);
+                    d += sample;
+                    s += 3 * sample;
+                }
+            }
+        }
+        break;
         default:
-            ccvt_420p_rgb24(bufwidth, bufheight, (void *)yuvBuffer, (void *)rgb24_buffer);
+            ccvt_420p_rgb(bufwidth, bufheight, YBuf, UBuf, VBuf, dest, planar);
             break;
     }
-    return rgb24_buffer;
 }
 
 int V4L2_Builtin_Decoder::getBpp()
@@ -907,6 +927,11 @@ void V4L2_Builtin_Decoder::init_supported_formats()
     // V4L2_PIX_FMT_Y16     , // v4l2_fourcc('Y', '1', '6', ' ') /* 16  Greyscale     */
     supported_formats.insert(
         std::make_pair(V4L2_PIX_FMT_Y16, new V4L2_Builtin_Decoder::format(V4L2_PIX_FMT_Y16, 16, true)));
+#ifdef V4L2_PIX_FMT_Y16_BE
+    // V4L2_PIX_FMT_Y16_BE  , // v4l2_fourcc_be('Y', '1', '6', ' ') /* 16  Greyscale BE  */
+    supported_formats.insert(
+        std::make_pair(V4L2_PIX_FMT_Y16_BE, new V4L2_Builtin_Decoder::format(V4L2_PIX_FMT_Y16_BE, 16, true)));
+#endif
 
     /* Grey bit-packed formats */
     // V4L2_PIX_FMT_Y10BPACK    , // v4l2_fourcc('Y', '1', '0', 'B') /* 10  Greyscale bit-packed */
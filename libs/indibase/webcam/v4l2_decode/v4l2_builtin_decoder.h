@@ -53,6 +53,8 @@ class V4L2_Builtin_Decoder : public V4L2_Decoder
         virtual unsigned char *getU();
         virtual unsigned char *getV();
         virtual unsigned char *getRGBBuffer();
+        virtual void copyY(unsigned char *dest);
+        virtual void copyRGB(unsigned char *dest, bool planar);
         virtual unsigned char *getMJPEGBuffer(int &size);
         virtual float *getLinearY();
         virtual int getBpp();
@@ -65,7 +67,10 @@ class V4L2_Builtin_Decoder : public V4L2_Decoder
         std::vector<unsigned int> vsuppformats;
         void allocBuffers();
         void makeY();
+        void makeChroma();
         void makeLinearY();
+        bool isPackedYUV();
+        bool isY16();
 
         struct v4l2_crop crop;
         struct v4l2_format fmt;
@@ -73,6 +78,7 @@ class V4L2_Builtin_Decoder : public V4L2_Decoder
         bool doCrop;      // do software cropping when decoding frames
         bool doQuantization;
         bool doLinearization;
+        bool chromaValid; // UBuf and VBuf hold the chroma of the last packed 4:2:2 frame
 
         unsigned char *YBuf;
         unsigned char *UBuf;
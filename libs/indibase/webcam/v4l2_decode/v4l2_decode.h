@@ -55,6 +55,9 @@ class V4L2_Decoder
         virtual unsigned char *getV()                                         = 0;
         virtual unsigned char *getMJPEGBuffer(int &size) = 0;
         virtual unsigned char *getRGBBuffer() = 0;
+        /* Same as getY() and getRGBBuffer(), written to dest, planar RGB is RRR..GGG..BBB */
+        virtual void copyY(unsigned char *dest) = 0;
+        virtual void copyRGB(unsigned char *dest, bool planar) = 0;
         virtual float *getLinearY()           = 0;
         virtual int getBpp()                  = 0;
         virtual void setQuantization(bool)    = 0;
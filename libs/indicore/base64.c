@@ -39,6 +39,7 @@
 #include "base64.h"
 #include "base64_luts.h"
 #include <stdio.h>
+#include <string.h>
 
 /* 
  * as byteswap.h is not available on macos, add macro here
@@ -56,6 +57,341 @@
 
 #define  IS_LITTLE_ENDIAN  (!IS_BIG_ENDIAN)
 
+/*
+ * SIMD kernels, picked at runtime from what the CPU supports.
+ * They convert whole blocks and leave the rest, padding and line breaks to the scalar code,
+ * so the output is the same whatever the kernel.
+ *
+ * enc kernels encode blocks of 3 bytes, return the number of bytes consumed.
+ * dec kernels decode blocks of quads made of base64 digits only, stopping at the first block
+ * holding anything else, and return the number of quads decoded.
+ */
+typedef int (*base64_enc_kernel)(unsigned char *out, const unsigned char *in, int inlen);
+typedef int (*base64_dec_kernel)(char *out, const char *in, int nquads);
+
+static int enc_scalar(unsigned char *out, const unsigned char *in, int inlen)
+{
+    (void)out;
+    (void)in;
+    (void)inlen;
+    return 0;
+}
+
+static int dec_scalar(char *out, const char *in, int nquads)
+{
+    (void)out;
+    (void)in;
+    (void)nquads;
+    return 0;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BASE64_X86
+#include <immintrin.h>
+
+/* SSSE3: 12 bytes <-> 16 chars, see W. Mula and D. Lemire, "Faster Base64 Encoding and Decoding using AVX2 Instructions" */
+__attribute__((target("ssse3")))
+static inline __m128i enc_reshuffle_ssse3(__m128i in)
+{
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t0, t1);
+}
+
+/* 6 bit values to digits: add an offset chosen by range */
+__attribute__((target("ssse3")))
+static inline __m128i enc_translate_ssse3(__m128i in)
+{
+    const __m128i lut = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    __m128i indices   = _mm_sub_epi8(_mm_subs_epu8(in, _mm_set1_epi8(51)), _mm_cmpgt_epi8(in, _mm_set1_epi8(25)));
+    return _mm_add_epi8(in, _mm_shuffle_epi8(lut, indices));
+}
+
+__attribute__((target("ssse3")))
+static int enc_ssse3(unsigned char *out, const unsigned char *in, int inlen)
+{
+    int done = 0;
+
+    /* loads 16 bytes for 12 */
+    for (; inlen - done >= 16; done += 12, out += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + done));
+        _mm_storeu_si128((__m128i *)out, enc_translate_ssse3(enc_reshuffle_ssse3(v)));
+    }
+    return done;
+}
+
+/* digits to 6 bit values, returns 0 if str holds a non digit */
+__attribute__((target("ssse3")))
+static inline int dec_translate_ssse3(__m128i *str)
+{
+    const __m128i lut_lo   = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i lut_hi   = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask_2f  = _mm_set1_epi8(0x2f);
+
+    __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(*str, 4), mask_2f);
+    __m128i lo_nibbles = _mm_and_si128(*str, mask_2f);
+    __m128i hi         = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+    __m128i lo         = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())))
+        return 0;
+
+    __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(*str, mask_2f), hi_nibbles));
+    *str         = _mm_add_epi8(*str, roll);
+    return 1;
+}
+
+/* 16 6 bit values to 12 bytes, in the low 12 bytes */
+__attribute__((target("ssse3")))
+static inline __m128i dec_reshuffle_ssse3(__m128i in)
+{
+    __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+__attribute__((target("ssse3")))
+static int dec_ssse3(char *out, const char *in, int nquads)
+{
+    int done = 0;
+
+    for (; nquads - done >= 4; done += 4, in += 16, out += 12)
+    {
+        __m128i str = _mm_loadu_si128((const __m128i *)in);
+        if (!dec_translate_ssse3(&str))
+            break;
+        str = dec_reshuffle_ssse3(str);
+        _mm_storel_epi64((__m128i *)out, str);
+        uint32_t last = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(str, 8));
+        memcpy(out + 8, &last, 4);
+    }
+    return done;
+}
+
+/* AVX2: same as SSSE3 on two lanes, 24 bytes <-> 32 chars */
+__attribute__((target("avx2")))
+static int enc_avx2(unsigned char *out, const unsigned char *in, int inlen)
+{
+    const __m256i shuf = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                          1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i lut  = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+                                          65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    int done = 0;
+
+    /* loads 28 bytes for 24 */
+    for (; inlen - done >= 28; done += 24, out += 32)
+    {
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(in + done))),
+                                            _mm_loadu_si128((const __m128i *)(in + done + 12)), 1);
+        v          = _mm256_shuffle_epi8(v, shuf);
+        __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        v          = _mm256_or_si256(t0, t1);
+
+        __m256i indices = _mm256_sub_epi8(_mm256_subs_epu8(v, _mm256_set1_epi8(51)), _mm256_cmpgt_epi8(v, _mm256_set1_epi8(25)));
+        _mm256_storeu_si256((__m256i *)out, _mm256_add_epi8(v, _mm256_shuffle_epi8(lut, indices)));
+    }
+    /* leave AVX state before going on with SSE code */
+    _mm256_zeroupper();
+    return done + enc_ssse3(out, in + done, inlen - done);
+}
+
+__attribute__((target("avx2")))
+static int dec_avx2(char *out, const char *in, int nquads)
+{
+    const __m256i lut_lo   = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+                                              0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+    const __m256i lut_hi   = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                              0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack     = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                              2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i mask_2f  = _mm256_set1_epi8(0x2f);
+    int done = 0;
+
+    for (; nquads - done >= 8; done += 8, in += 32, out += 24)
+    {
+        __m256i str        = _mm256_loadu_si256((const __m256i *)in);
+        __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask_2f);
+        __m256i lo_nibbles = _mm256_and_si256(str, mask_2f);
+        __m256i hi         = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+        __m256i lo         = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+
+        if (!_mm256_testz_si256(lo, hi))
+            break;
+
+        __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(str, mask_2f), hi_nibbles));
+        str          = _mm256_add_epi8(str, roll);
+
+        __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+        merged         = _mm256_shuffle_epi8(merged, pack);
+        _mm_storeu_si128((__m128i *)out, _mm256_castsi256_si128(merged));
+        _mm_storel_epi64((__m128i *)(out + 12), _mm256_extracti128_si256(merged, 1));
+        uint32_t last = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(_mm256_extracti128_si256(merged, 1), 8));
+        memcpy(out + 20, &last, 4);
+    }
+    /* leave AVX state before going on with SSE code */
+    _mm256_zeroupper();
+    return done + dec_ssse3(out, in, nquads - done);
+}
+
+#if (defined(__GNUC__) && __GNUC__ >= 8) || defined(__clang__)
+#define BASE64_X86_AVX512
+
+/* AVX-512 VBMI: 48 bytes <-> 64 chars with byte permutes, see W. Mula and D. Lemire,
+ * "Base64 encoding and decoding at almost the speed of a memory copy"
+ */
+static const unsigned char enc_shuffle_avx512[64] =
+{
+     1,  0,  2,  1,  4,  3,  5,  4,  7,  6,  8,  7, 10,  9, 11, 10,
+    13, 12, 14, 13, 16, 15, 17, 16, 19, 18, 20, 19, 22, 21, 23, 22,
+    25, 24, 26, 25, 28, 27, 29, 28, 31, 30, 32, 31, 34, 33, 35, 34,
+    37, 36, 38, 37, 40, 39, 41, 40, 43, 42, 44, 43, 46, 45, 47, 46,
+};
+
+static const unsigned char dec_lut_avx512[128] =
+{
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x3e, 0x80, 0x80, 0x80, 0x3f,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+static const unsigned char dec_pack_avx512[64] =
+{
+     2,  1,  0,  6,  5,  4, 10,  9,  8, 14, 13, 12, 18, 17, 16, 22,
+    21, 20, 26, 25, 24, 30, 29, 28, 34, 33, 32, 38, 37, 36, 42, 41,
+    40, 46, 45, 44, 50, 49, 48, 54, 53, 52, 58, 57, 56, 62, 61, 60,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+__attribute__((target("avx512f,avx512bw,avx512vbmi,avx2")))
+static int enc_avx512(unsigned char *out, const unsigned char *in, int inlen)
+{
+    const __m512i shuffle = _mm512_loadu_si512(enc_shuffle_avx512);
+    const __m512i shifts  = _mm512_set1_epi64(0x3036242a1016040aLL);
+    const __m512i lookup  = _mm512_loadu_si512(base64digits);
+    int done = 0;
+
+    /* loads 64 bytes for 48 */
+    for (; inlen - done >= 64; done += 48, out += 64)
+    {
+        __m512i v = _mm512_permutexvar_epi8(shuffle, _mm512_loadu_si512(in + done));
+        v         = _mm512_multishift_epi64_epi8(shifts, v);
+        _mm512_storeu_si512(out, _mm512_permutexvar_epi8(v, lookup));
+    }
+    return done + enc_avx2(out, in + done, inlen - done);
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vbmi,avx2")))
+static int dec_avx512(char *out, const char *in, int nquads)
+{
+    const __m512i lut0 = _mm512_loadu_si512(dec_lut_avx512);
+    const __m512i lut1 = _mm512_loadu_si512(dec_lut_avx512 + 64);
+    const __m512i pack = _mm512_loadu_si512(dec_pack_avx512);
+    int done = 0;
+
+    for (; nquads - done >= 16; done += 16, in += 64, out += 48)
+    {
+        __m512i str = _mm512_loadu_si512(in);
+        __m512i val = _mm512_permutex2var_epi8(lut0, str, lut1);
+
+        /* non ASCII chars or chars out of the alphabet */
+        if (_mm512_movepi8_mask(_mm512_or_si512(val, str)))
+            break;
+
+        __m512i merged = _mm512_madd_epi16(_mm512_maddubs_epi16(val, _mm512_set1_epi32(0x01400140)), _mm512_set1_epi32(0x00011000));
+        _mm512_mask_storeu_epi8(out, 0x0000ffffffffffffULL, _mm512_permutexvar_epi8(pack, merged));
+    }
+    return done + dec_avx2(out, in, nquads - done);
+}
+#endif
+#endif
+
+static int isa_best(void)
+{
+#ifdef BASE64_X86
+    __builtin_cpu_init();
+#ifdef BASE64_X86_AVX512
+    if (__builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("avx512bw"))
+        return BASE64_AVX512;
+#endif
+    if (__builtin_cpu_supports("avx2"))
+        return BASE64_AVX2;
+    if (__builtin_cpu_supports("ssse3"))
+        return BASE64_SSSE3;
+#endif
+    return BASE64_SCALAR;
+}
+
+static int enc_init(unsigned char *out, const unsigned char *in, int inlen);
+static int dec_init(char *out, const char *in, int nquads);
+
+/* Any thread may pick the kernels on first use; they hold no state, so relaxed ordering is enough */
+static base64_enc_kernel enc_kernel = enc_init;
+static base64_dec_kernel dec_kernel = dec_init;
+
+#ifdef __GNUC__
+#define KERNEL_LOAD(kernel)            __atomic_load_n(&(kernel), __ATOMIC_RELAXED)
+#define KERNEL_STORE(kernel, function) __atomic_store_n(&(kernel), (function), __ATOMIC_RELAXED)
+#else
+#define KERNEL_LOAD(kernel)            (kernel)
+#define KERNEL_STORE(kernel, function) ((kernel) = (function))
+#endif
+
+int base64_select_isa(int isa)
+{
+    int best = isa_best();
+    if (isa > best)
+        isa = best;
+
+    switch (isa)
+    {
+#ifdef BASE64_X86
+#ifdef BASE64_X86_AVX512
+        case BASE64_AVX512:
+            KERNEL_STORE(enc_kernel, enc_avx512);
+            KERNEL_STORE(dec_kernel, dec_avx512);
+            break;
+#endif
+        case BASE64_AVX2:
+            KERNEL_STORE(enc_kernel, enc_avx2);
+            KERNEL_STORE(dec_kernel, dec_avx2);
+            break;
+        case BASE64_SSSE3:
+            KERNEL_STORE(enc_kernel, enc_ssse3);
+            KERNEL_STORE(dec_kernel, dec_ssse3);
+            break;
+#endif
+        default:
+            isa        = BASE64_SCALAR;
+            KERNEL_STORE(enc_kernel, enc_scalar);
+            KERNEL_STORE(dec_kernel, dec_scalar);
+            break;
+    }
+    return isa;
+}
+
+/* first call picks the best kernels */
+static int enc_init(unsigned char *out, const unsigned char *in, int inlen)
+{
+    base64_select_isa(BASE64_AVX512);
+    return KERNEL_LOAD(enc_kernel)(out, in, inlen);
+}
+
+static int dec_init(char *out, const char *in, int nquads)
+{
+    base64_select_isa(BASE64_AVX512);
+    return KERNEL_LOAD(dec_kernel)(out, in, nquads);
+}
+
 /* convert inlen raw bytes at in to base64 string (NUL-terminated) at out. 
  * out size should be at least 4*inlen/3 + 4.
  * return length of out (sans trailing NUL).
@@ -78,8 +414,15 @@ int to64frombits(unsigned char *out, const unsigned char *in, int inlen)
 {
     uint16_t *b64lut = (uint16_t *)base64lut;
     int dlen         = ((inlen + 2) / 3) * 4; /* 4/3, rounded up */
-    uint16_t *wbuf   = (uint16_t *)out;
+    uint16_t *wbuf;
 
+    /* whole blocks first */
+    int done = KERNEL_LOAD(enc_kernel)(out, in, inlen);
+    out += done / 3 * 4;
+    in += done;
+    inlen -= done;
+
+    wbuf = (uint16_t *)out;
     for (; inlen > 2; inlen -= 3)
     {
         uint32_t n = in[0] << 16 | in[1] << 8 | in[2];
@@ -129,10 +472,30 @@ int from64tobits_fast(char *out, const char *in, int inlen)
     int n         = (inlen / 4) - 1;
     uint16_t *inp = (uint16_t *)in;
 
+    int runend    = 0;
+
     for (j = 0; j < n; j++)
     {
         if (in[0] == '\n')
             in++;
+
+        /* at the start of a line, decode its whole blocks at once */
+        if (j >= runend)
+        {
+            const char *nl = (const char *)memchr(in, '\n', 4 * (size_t)(n - j));
+            int quads      = nl ? (int)(nl - in) / 4 : n - j;
+            int k          = KERNEL_LOAD(dec_kernel)(out, in, quads);
+
+            runend = j + quads;
+            if (k > 0)
+            {
+                in += 4 * k;
+                out += 3 * k;
+                j += k - 1;
+                continue;
+            }
+        }
+
         inp = (uint16_t *)in;
 
         if IS_BIG_ENDIAN {
@@ -266,6 +629,103 @@ int from64tobits_fast_with_bug(char *out, const char *in, int inlen)
 }
 
 
+/* value of each char in an incremental decode: digit value, -2 for padding,
+ * -3 for blanks and -1 for anything else.
+ */
+static const signed char base64values[256] =
+{
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -3, -3, -3, -3, -3, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -2, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+void from64tobits_begin(base64_stream *st)
+{
+    st->nq   = 0;
+    st->done = 0;
+}
+
+int from64tobits_stream(base64_stream *st, char *out, const char *in, int inlen)
+{
+    const unsigned char *s   = (const unsigned char *)in;
+    const unsigned char *end = s + inlen;
+    char *o                  = out;
+
+    while (s < end && !st->done)
+    {
+        /* whole quads at once, between line breaks */
+        if (st->nq == 0)
+        {
+            int k = KERNEL_LOAD(dec_kernel)(o, (const char *)s, (int)((end - s) / 4));
+            o += 3 * k;
+            s += 4 * k;
+
+            while (end - s >= 4)
+            {
+                int v0 = base64values[s[0]], v1 = base64values[s[1]];
+                int v2 = base64values[s[2]], v3 = base64values[s[3]];
+                if ((v0 | v1 | v2 | v3) < 0)
+                    break;
+                uint32_t n32 = (uint32_t)v0 << 18 | (uint32_t)v1 << 12 | (uint32_t)v2 << 6 | (uint32_t)v3;
+                o[0] = (char)(n32 >> 16);
+                o[1] = (char)(n32 >> 8);
+                o[2] = (char)n32;
+                o += 3;
+                s += 4;
+            }
+            if (s == end)
+                break;
+        }
+
+        int v = base64values[*s++];
+        if (v >= 0)
+        {
+            st->q[st->nq++] = (unsigned char)v;
+            if (st->nq == 4)
+            {
+                o[0]   = (char)(st->q[0] << 2 | st->q[1] >> 4);
+                o[1]   = (char)(st->q[1] << 4 | st->q[2] >> 2);
+                o[2]   = (char)(st->q[2] << 6 | st->q[3]);
+                o += 3;
+                st->nq = 0;
+            }
+        }
+        else if (v == -2)
+        {
+            /* padding: flush what the quad holds and ignore the rest */
+            o += from64tobits_end(st, o);
+            st->done = 1;
+        }
+    }
+
+    return (int)(o - out);
+}
+
+int from64tobits_end(base64_stream *st, char *out)
+{
+    int n = 0;
+
+    if (st->nq >= 2)
+        out[n++] = (char)(st->q[0] << 2 | st->q[1] >> 4);
+    if (st->nq >= 3)
+        out[n++] = (char)(st->q[1] << 4 | st->q[2] >> 2);
+    st->nq = 0;
+    return n;
+}
+
 #ifdef BASE64_PROGRAM
 /* standalone program that converts to/from base64.
  * cc -o base64 -DBASE64_PROGRAM base64.c
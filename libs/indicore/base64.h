@@ -59,6 +59,51 @@ extern int from64tobits(char *out, const char *in);
 extern int from64tobits_fast(char *out, const char *in, int inlen);
 extern int from64tobits_fast_with_bug(char *out, const char *in, int inlen);
 
+/** \brief Instruction sets for base64_select_isa() */
+#define BASE64_SCALAR 0
+#define BASE64_SSSE3  1
+#define BASE64_AVX2   2
+#define BASE64_AVX512 3
+
+/** \brief Select the instruction set used to encode and decode.
+    By default, the best one the CPU supports is used. Output is the same with all of them.
+    This is mostly useful for tests and benchmarks.
+    \param isa highest instruction set to use, one of the BASE64_ values.
+    \return the instruction set now in use, lower than isa when the CPU does not support it.
+ */
+extern int base64_select_isa(int isa);
+
+/** \brief State of an incremental base64 decode, see from64tobits_stream(). */
+typedef struct
+{
+    unsigned char q[4]; /* values of the incomplete quad */
+    int nq;             /* number of values in q */
+    int done;           /* 1 once padding was seen */
+} base64_stream;
+
+/** \brief Start an incremental base64 decode.
+    \param st decoder state to initialize.
+ */
+extern void from64tobits_begin(base64_stream *st);
+
+/** \brief Decode the next piece of a base64 stream.
+    Pieces can be cut anywhere. Blanks are skipped, as well as chars outside of the base64 alphabet.
+    Decoding stops at the first padding char.
+    \param st decoder state, see from64tobits_begin().
+    \param out output buffer. The buffer must hold at least 3 * ((st->nq + inlen + 3) / 4) bytes.
+    \param in next piece of base64.
+    \param inlen length of in.
+    \return number of bytes written to out.
+ */
+extern int from64tobits_stream(base64_stream *st, char *out, const char *in, int inlen);
+
+/** \brief Flush the bytes of an incomplete last quad, for streams without padding.
+    \param st decoder state.
+    \param out output buffer, at least 2 bytes.
+    \return number of bytes written to out.
+ */
+extern int from64tobits_end(base64_stream *st, char *out);
+
 /*@}*/
 
 #ifdef __cplusplus
@@ -86,9 +86,11 @@
 #endif
 
 #ifndef _WIN32
+#include <pthread.h>
 #include <unistd.h>
 #include <termios.h>
 #include <sys/param.h>
+#include <sys/stat.h>
 #define PARITY_NONE 0
 #define PARITY_EVEN 1
 #define PARITY_ODD  2
@@ -114,6 +116,30 @@ static int tty_auto_reset_udp_session = 0;
 static int tty_sequence_number = 1;
 static int tty_clear_trailing_lf = 0;
 
+#ifndef _WIN32
+/* Bytes read from a fd but not returned yet.
+ * On fds set with tty_set_buffered, sections are read in bulk, and whatever arrived after the stop
+ * character is kept here for the next read on the same fd, instead of calling select() and read()
+ * for every character. The bytes are only ever left over at the end of a read, so a buffer is
+ * refilled once it is empty. Other fds are read one byte at a time, and nothing is kept from them.
+ */
+#define TTY_BUFFER_SIZE 512
+
+typedef struct
+{
+    char data[TTY_BUFFER_SIZE];
+    int start;  /* first byte not returned yet */
+    int end;    /* one past the last byte read */
+    int enabled;  /* set by tty_set_buffered */
+    dev_t dev;  /* the file buffering was set for, in case fd is closed and reused */
+    ino_t ino;
+} tty_buffer;
+
+static tty_buffer **tty_buffers;
+static int tty_nbuffers;
+static pthread_mutex_t tty_buffers_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 #if defined(HAVE_LIBNOVA)
 int extractISOTime(const char *timestr, struct ln_date *iso_date)
 {
@@ -563,6 +589,124 @@ error_exit:
 #endif
 }
 
+#ifndef _WIN32
+/* Buffer of fd, created if create is set */
+static tty_buffer *tty_get_buffer(int fd, int create)
+{
+    tty_buffer *buffer = NULL;
+
+    pthread_mutex_lock(&tty_buffers_mutex);
+    if (fd >= tty_nbuffers && create)
+    {
+        int n = fd < 16 ? 32 : 2 * fd;
+        tty_buffer **buffers = (tty_buffer **)realloc(tty_buffers, n * sizeof(tty_buffer *));
+        if (buffers)
+        {
+            memset(buffers + tty_nbuffers, 0, (n - tty_nbuffers) * sizeof(tty_buffer *));
+            tty_buffers  = buffers;
+            tty_nbuffers = n;
+        }
+    }
+    if (fd < tty_nbuffers)
+    {
+        if (tty_buffers[fd] == NULL && create)
+            tty_buffers[fd] = (tty_buffer *)calloc(1, sizeof(tty_buffer));
+        buffer = tty_buffers[fd];
+    }
+    pthread_mutex_unlock(&tty_buffers_mutex);
+
+    return buffer;
+}
+
+static void tty_drop_buffer(int fd)
+{
+    pthread_mutex_lock(&tty_buffers_mutex);
+    if (fd >= 0 && fd < tty_nbuffers && tty_buffers[fd])
+        tty_buffers[fd]->start = tty_buffers[fd]->end = 0;
+    pthread_mutex_unlock(&tty_buffers_mutex);
+}
+
+/* Buffer of fd if section reads on fd are buffered, otherwise NULL.
+ * Buffering set for another file that had the same fd, closed without tty_disconnect, ends here. */
+static tty_buffer *tty_get_enabled_buffer(int fd)
+{
+    struct stat st;
+    tty_buffer *buffer = tty_get_buffer(fd, 0);
+
+    if (buffer == NULL || !buffer->enabled)
+        return NULL;
+
+    if (fstat(fd, &st) != 0 || st.st_dev != buffer->dev || st.st_ino != buffer->ino)
+    {
+        buffer->start = buffer->end = 0;
+        buffer->enabled = 0;
+        return NULL;
+    }
+
+    return buffer;
+}
+
+/* Read up to and including stop_char into buf, at most nsize bytes if nsize > 0. */
+static int tty_read_buffered_section(int fd, tty_buffer *buffer, char *buf, int nsize, char stop_char,
+                                     long timeout_seconds, long timeout_microseconds, int *nbytes_read)
+{
+    int err = TTY_OK;
+
+    for (;;)
+    {
+        if (buffer->start == buffer->end)
+        {
+            if ((err = tty_timeout_microseconds(fd, timeout_seconds, timeout_microseconds)))
+                return err;
+
+            int bytesRead = read(fd, buffer->data, TTY_BUFFER_SIZE);
+
+            /* Nothing to read from a readable fd is end of file, eg. the device is gone */
+            if (bytesRead <= 0)
+                return TTY_READ_ERROR;
+
+            buffer->start = 0;
+            buffer->end   = bytesRead;
+        }
+
+        char *data = buffer->data + buffer->start;
+        int available = buffer->end - buffer->start;
+
+        if (*nbytes_read == 0 && tty_clear_trailing_lf && *data == 0x0A)
+        {
+            if (tty_debug)
+                IDLog("%s: Cleared LF char left in buf\n", __FUNCTION__);
+
+            buffer->start++;
+            if (stop_char == 0x0A)
+                return TTY_OK;
+            continue;
+        }
+
+        if (nsize > 0 && available > nsize - *nbytes_read)
+            available = nsize - *nbytes_read;
+
+        char *stop = (char *)memchr(data, stop_char, available);
+        int count = stop ? (int)(stop - data) + 1 : available;
+
+        memcpy(buf + *nbytes_read, data, count);
+        if (tty_debug)
+        {
+            int i = 0;
+            for (i = 0; i < count; i++)
+                IDLog("%s: buffer[%d]=%#X (%c)\n", __FUNCTION__, *nbytes_read + i, (unsigned char)data[i], data[i]);
+        }
+        *nbytes_read += count;
+        buffer->start += count;
+
+        if (stop)
+            return TTY_OK;
+        if (nsize > 0 && *nbytes_read >= nsize)
+            return TTY_OVERFLOW;
+    }
+}
+#endif
+
 int tty_read(int fd, char *buf, int nbytes, int timeout, int *nbytes_read)
 {
     return tty_read_expanded(fd, buf, nbytes, timeout, 0, nbytes_read);
@@ -597,18 +741,30 @@ int tty_read_expanded(int fd, char *buf, int nbytes, long timeout_seconds, long
         buffer = geminiBuffer;
     }
 
+    /* Bytes left over by a section read come first */
+    tty_buffer *leftover = tty_gemini_udp_format ? NULL : tty_get_enabled_buffer(fd);
+
     while (numBytesToRead > 0)
     {
-        if ((err = tty_timeout_microseconds(fd, timeout_seconds, timeout_microseconds))) {
-            if(tty_generic_udp_format)
-                tty_generic_udp_read_error_occured = 1;
-            return err;
+        if (leftover && leftover->start < leftover->end)
+        {
+            bytesRead = MIN(leftover->end - leftover->start, numBytesToRead);
+            memcpy(buffer + (*nbytes_read), leftover->data + leftover->start, bytesRead);
+            leftover->start += bytesRead;
         }
+        else
+        {
+            if ((err = tty_timeout_microseconds(fd, timeout_seconds, timeout_microseconds))) {
+                if(tty_generic_udp_format)
+                    tty_generic_udp_read_error_occured = 1;
+                return err;
+            }
 
-        bytesRead = read(fd, buffer + (*nbytes_read), ((uint32_t)numBytesToRead));
+            bytesRead = read(fd, buffer + (*nbytes_read), ((uint32_t)numBytesToRead));
 
-        if (bytesRead < 0)
-            return TTY_READ_ERROR;
+            if (bytesRead < 0)
+                return TTY_READ_ERROR;
+        }
 
         if (tty_debug)
         {
@@ -671,6 +827,7 @@ int tty_read_section_expanded(int fd, char *buf, char stop_char, long timeout_se
     *nbytes_read  = 0;
 
     uint8_t *read_char = 0;
+    tty_buffer *buffer = NULL;
 
     if (tty_debug)
         IDLog("%s: Request to read until stop char '%#02X' with %ld s %ld us timeout for fd %d\n", __FUNCTION__, stop_char, timeout_seconds, timeout_microseconds, fd);
@@ -722,6 +879,8 @@ int tty_read_section_expanded(int fd, char *buf, char stop_char, long timeout_se
             }
         }
     }
+    else if ((buffer = tty_get_enabled_buffer(fd)))
+        return tty_read_buffered_section(fd, buffer, buf, 0, stop_char, timeout_seconds, timeout_microseconds, nbytes_read);
     else
     {
         for (;;)
@@ -783,6 +942,15 @@ int tty_nread_section_expanded(int fd, char *buf, int nsize, char stop_char, lon
     if (tty_debug)
         IDLog("%s: Request to read until stop char '%#02X' with %ld s %ld us timeout for fd %d\n", __FUNCTION__, stop_char, timeout_seconds, timeout_microseconds, fd);
 
+    tty_buffer *buffer = tty_get_enabled_buffer(fd);
+    if (buffer)
+    {
+        if (nsize <= 0)
+            return TTY_OVERFLOW;
+
+        return tty_read_buffered_section(fd, buffer, buf, nsize, stop_char, timeout_seconds, timeout_microseconds, nbytes_read);
+    }
+
     for (;;)
     {
         if ((err = tty_timeout_microseconds(fd, timeout_seconds, timeout_microseconds)))
@@ -1227,7 +1395,7 @@ int tty_connect(const char *device, int bit_rate, int word_size, int parity, int
     tty_setting.c_cc[VTIME] = 0;
 
     /* now clear input and output buffers and activate the new terminal settings */
-    tcflush(t_fd, TCIOFLUSH);
+    tty_flush(t_fd, TCIOFLUSH);
     if (tcsetattr(t_fd, TCSANOW, &tty_setting))
     {
         perror("tty_connect: failed setting attributes on serial port.");
@@ -1253,7 +1421,8 @@ int tty_disconnect(int fd)
     return TTY_ERRNO;
 #else
     int err;
-    tcflush(fd, TCIOFLUSH);
+    tty_flush(fd, TCIOFLUSH);
+    tty_set_buffered(fd, 0);
     err = close(fd);
 
     if (err != 0)
@@ -1263,6 +1432,48 @@ int tty_disconnect(int fd)
 #endif
 }
 
+int tty_set_buffered(int fd, int enabled)
+{
+#ifdef _WIN32
+    INDI_UNUSED(fd);
+    INDI_UNUSED(enabled);
+    return -1;
+#else
+    struct stat st;
+
+    if (fd < 0 || (enabled && fstat(fd, &st) != 0))
+        return -1;
+
+    tty_buffer *buffer = tty_get_buffer(fd, enabled);
+    if (buffer == NULL)
+        return enabled ? -1 : 0;
+
+    /* Bytes kept from earlier reads are not returned once the fd is read directly again */
+    buffer->start = buffer->end = 0;
+    buffer->enabled = enabled != 0;
+    if (enabled)
+    {
+        buffer->dev = st.st_dev;
+        buffer->ino = st.st_ino;
+    }
+    return 0;
+#endif
+}
+
+int tty_flush(int fd, int queue_selector)
+{
+#ifdef _WIN32
+    INDI_UNUSED(fd);
+    INDI_UNUSED(queue_selector);
+    return -1;
+#else
+    if (queue_selector == TCIFLUSH || queue_selector == TCIOFLUSH)
+        tty_drop_buffer(fd);
+
+    return tcflush(fd, queue_selector);
+#endif
+}
+
 void tty_error_msg(int err_code, char *err_msg, int err_msg_len)
 {
     switch (err_code)
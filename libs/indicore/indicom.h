@@ -283,6 +283,25 @@ int tty_connect(const char *device, int bit_rate, int word_size, int parity, int
  */
 int tty_disconnect(int fd);
 
+/** \brief Reads sections from fd in bulk instead of one byte at a time.
+ *  tty_read_section and tty_nread_section then read as much as is available, and keep what arrived after the stop
+ *  character for the next tty read on fd. Only enable it on descriptors read with the tty functions alone: kept bytes are
+ *  not seen by read(), select() or FIONREAD on fd, and are only discarded by tty_flush, not tcflush.
+ *  Buffering ends with tty_disconnect.
+ *  \param fd file descriptor
+ *  \param enabled 1 to read sections in bulk, 0 to read them one byte at a time again, the default.
+ *  \return 0 on success, otherwise -1.
+ */
+int tty_set_buffered(int fd, int enabled);
+
+/** \brief Discards data like tcflush, including bytes the section reads have already taken from fd but not returned yet.
+ *  Use it instead of tcflush on descriptors set with tty_set_buffered.
+ *  \param fd file descriptor
+ *  \param queue_selector TCIFLUSH, TCOFLUSH or TCIOFLUSH
+ *  \return As tcflush, 0 on success, otherwise -1.
+ */
+int tty_flush(int fd, int queue_selector);
+
 /** \brief Retrieve the tty error message
  *  \param err_code the error code return by any TTY function.
  *  \param err_msg an initialized buffer to hold the error message.
@@ -94,6 +94,7 @@
  */
 
 #include <stdarg.h>
+#include <stdint.h>
 #include "indiapi.h"
 #include "lilxml.h"
 
@@ -350,7 +351,7 @@ extern int IERemainingTimer(int timerid);
  *  @param tid the timer callback ID returned from addTimer() or addPeriodicTimer()
  *  @return  If the timer not exists, the returned value will be -1.
  */
-extern int IENSecRemainingTimer(int tid);
+extern int64_t IENSecsRemainingTimer(int tid);
 
 /** @brief Remove the timer with the given \e timerid, as returned from IEAddTimer() or IEAddPeriodicTimer().
  *  @param timerid the timer callback ID returned from IEAddTimer() or IEAddPeriodicTimer().
@@ -36,6 +36,10 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301  USA
 #include <string.h>
 #include <assert.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #if defined(_MSC_VER)
 #define snprintf _snprintf
 #pragma warning(push)
@@ -44,29 +48,86 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110 - 1301  USA
 #endif
 
 #include "lilxml.h"
+#include "base64.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+typedef struct XMLArena_ XMLArena;
 
 /* used to efficiently manage growing malloced string space */
 typedef struct
 {
-    char *s; /* malloced memory for string */
-    int sl;  /* string length, sans trailing \0 */
-    int sm;  /* total malloced bytes */
+    char *s;         /* malloced memory for string */
+    int sl;          /* string length, sans trailing \0 */
+    int sm;          /* total malloced bytes */
+    XMLArena *arena; /* arena holding s, NULL if s is malloced */
 } String;
 #define MINMEM 64 /* starting string length */
 
+/* Elements built by the parser are carved out of an arena shared by the whole tree:
+ * elements, attributes, their lists and strings are bump allocated from a few blocks
+ * and deleting the tree releases the blocks at once instead of walking each piece.
+ * Large strings (BLOBs) move to malloced memory, that is the only piece walked then.
+ */
+#define ARENAALIGN    16    /* alignment of each arena allocation */
+#define ARENABLOCK    4096  /* size of the first block */
+#define ARENAMAXBLOCK 65536 /* later blocks double up to this size */
+#define ARENAMAXSTR   16384 /* strings growing larger move to malloced memory */
+#define ARENAMINMEM   16    /* starting string length in an arena */
+
+typedef struct ArenaBlock_
+{
+    struct ArenaBlock_ *next; /* previous block */
+    size_t size;              /* usable bytes */
+    size_t used;              /* bytes handed out */
+} ArenaBlock;
+#define ARENAHDR ((sizeof(ArenaBlock) + ARENAALIGN - 1) & ~(size_t)(ARENAALIGN - 1))
+
+struct XMLArena_
+{
+    ArenaBlock *blocks;     /* block being filled, followed by the older ones */
+    void *last;             /* last allocation, can grow in place */
+    std::atomic<int> refs;  /* trees using this arena */
+    int foreign;            /* 1 if trees in this arena hold memory from elsewhere */
+};
+
 static int oneXMLchar(LilXML *lp, int c, char ynot[]);
 static void initParser(LilXML *lp);
 static void pushXMLEle(LilXML *lp);
 static void popXMLEle(LilXML *lp);
 static void resetEndTag(LilXML *lp);
 static XMLAtt *growAtt(XMLEle *e);
-static XMLEle *growEle(XMLEle *pe);
+static XMLEle *growEle(XMLEle *pe, XMLArena *arena);
+static void **growList(XMLArena *arena, void **list, int n);
 static void freeAtt(XMLAtt *a);
+static XMLEle *cloneXMLEleInto(XMLEle *parent, XMLEle *ep, int (*replace)(void *self, XMLEle *source, XMLEle **replace),
+                               void *self);
 static int isTokenChar(int start, int c);
+static void beginContent(LilXML *lp);
+static void growContent(LilXML *lp, int c);
+static void decodeBLOB(LilXML *lp, const char *s, int n);
+static void appendBLOB(LilXML *lp, const char *s, int n);
+static void resizeBLOB(LilXML *lp, int n);
+static void endBLOB(LilXML *lp);
 static void growString(String *sp, int c);
 static void appendString(String *sp, const char *str);
+static void appendChars(String *sp, const char *str, int n);
+static const char *scanContent(const char *s, const char *end);
+static const char *scanAttValue(const char *s, const char *end, char delim);
+static const char *scanToken(const char *s, const char *end);
+static const char *scanSpace(const char *s, const char *end);
+static int countLines(const char *s, const char *end);
 static void freeString(String *sp);
 static void newString(String *sp);
+static void editString(String *sp, const char *str);
+static void resizeString(String *sp, int n);
+static XMLArena *newArena();
+static void *arenaAlloc(XMLArena *arena, size_t n);
+static void *arenaRealloc(XMLArena *arena, void *old, size_t used, size_t n);
+static void arenaRelease(XMLArena *arena);
+static void arenaFree(XMLArena *arena, void *p);
 static void *moremem(void *old, size_t n);
 static void appXMLEle(XMLEle *ep, XMLEle *newep);
 
@@ -101,6 +162,13 @@ struct LilXML_
     int lastc;     /* last char (just used with skipping)*/
     int skipping;  /* in comment or declaration */
     int inblob;    /* in oneBLOB element */
+
+    /* decoding of oneBLOB content, see decodeXMLBLOBs() */
+    void *(*blobmalloc)(size_t size);
+    void *(*blobrealloc)(void *ptr, size_t size);
+    void (*blobfree)(void *ptr);
+    base64_stream b64; /* state of the decode into ce */
+    int blobfixed;     /* 1 if the blob buffer of ce was sized from enclen */
 };
 
 /* internal representation of a (possibly nested) XML element */
@@ -116,6 +184,12 @@ struct xml_ele_
     int eit;           /* used to iterate over el[] */
     String pcdata;     /* character data in this element */
     int pcdata_hasent; /* 1 if pcdata contains an entity char*/
+    XMLArena *arena;   /* arena holding this element, NULL if malloced */
+    int ownsArena;     /* 1 if deleting this element releases a reference on arena */
+    char *blob;        /* content decoded from base64, see decodeXMLBLOBs() */
+    int bloblen;       /* bytes decoded in blob */
+    int blobmax;       /* bytes allocated for blob */
+    void (*blobfree)(void *ptr); /* releases blob */
 };
 
 /* internal representation of an attribute */
@@ -155,10 +229,19 @@ LilXML *newLilXML()
     return (lp);
 }
 
+/* decode the content of oneBLOB elements to buffers managed by the given functions */
+void decodeXMLBLOBs(LilXML *lp, void *(*newmalloc)(size_t size), void *(*newrealloc)(void *ptr, size_t size),
+                    void (*newfree)(void *ptr))
+{
+    lp->blobmalloc  = newmalloc;
+    lp->blobrealloc = newrealloc;
+    lp->blobfree    = newfree;
+}
+
 /* discard */
 void delLilXML(LilXML *lp)
 {
-    delXMLEle(lp->ce);
+    initParser(lp);
     freeString(&lp->endtag);
     (*myfree)(lp);
 }
@@ -172,14 +255,40 @@ void delXMLEle(XMLEle *ep)
     if (!ep)
         return;
 
+    /* remove from parent's list if known */
+    if (ep->pe)
+    {
+        XMLEle *pe = ep->pe;
+        for (i = 0; i < pe->nel; i++)
+        {
+            if (pe->el[i] == ep)
+            {
+                memmove(&pe->el[i], &pe->el[i + 1], (--pe->nel - i) * sizeof(XMLEle *));
+                break;
+            }
+        }
+    }
+
+    XMLArena *arena = ep->arena;
+
+    /* everything below ep lives in its arena: nothing to free piece by piece */
+    if (arena && !arena->foreign)
+    {
+        if (ep->ownsArena)
+            arenaRelease(arena);
+        return;
+    }
+
     /* delete all parts of ep */
     freeString(&ep->tag);
     freeString(&ep->pcdata);
+    if (ep->blob)
+        (*ep->blobfree)(ep->blob);
     if (ep->at)
     {
         for (i = 0; i < ep->nat; i++)
             freeAtt(ep->at[i]);
-        (*myfree)(ep->at);
+        arenaFree(arena, ep->at);
     }
     if (ep->el)
     {
@@ -190,25 +299,14 @@ void delXMLEle(XMLEle *ep)
 
             delXMLEle(ep->el[i]);
         }
-        (*myfree)(ep->el);
+        arenaFree(arena, ep->el);
     }
 
-    /* remove from parent's list if known */
-    if (ep->pe)
-    {
-        XMLEle *pe = ep->pe;
-        for (i = 0; i < pe->nel; i++)
-        {
-            if (pe->el[i] == ep)
-            {
-                memmove(&pe->el[i], &pe->el[i + 1], (--pe->nel - i) * sizeof(XMLEle *));
-                break;
-            }
-        }
-    }
-
-    /* delete ep itself */
-    (*myfree)(ep);
+    /* delete ep itself, its arena last as ep may live in it */
+    if (ep->ownsArena)
+        arenaRelease(arena);
+    else
+        arenaFree(arena, ep);
 }
 
 //#define WITH_MEMCHR
@@ -237,8 +335,7 @@ XMLEle **parseXMLChunk(LilXML *lp, char *buf, int size, char ynot[])
         char *ltpos = memchr(buf, '<', size);
         if (!ltpos)
         {
-            lp->ce->pcdata.s = (char *)moremem(lp->ce->pcdata.s, lp->ce->pcdata.sm + size);
-            lp->ce->pcdata.sm += size;
+            resizeString(&lp->ce->pcdata, lp->ce->pcdata.sm + size);
             memcpy((void *)(lp->ce->pcdata.s + lp->ce->pcdata.sl), (const void *)buf, size);
             lp->ce->pcdata.sl += size;
             return nodes;
@@ -252,7 +349,7 @@ XMLEle **parseXMLChunk(LilXML *lp, char *buf, int size, char ynot[])
         if (lp->ce)
         {
             char *ctag = tagXMLEle(lp->ce);
-            if (ctag && !(strcmp(ctag, "oneBLOB")) && (lp->cs == INCON))
+            if (ctag && !(strcmp(ctag, "oneBLOB")) && (lp->cs == INCON) && !lp->ce->blob)
             {
 #ifdef WITH_ENCLEN
                 XMLAtt *blenatt = findXMLAtt(lp->ce, "enclen");
@@ -264,8 +361,7 @@ XMLEle **parseXMLChunk(LilXML *lp, char *buf, int size, char ynot[])
                     // Add room for those '\n' on every 72 character line + extra half-full line.
                     blen += (blen / 72) + 1;
 
-                    lp->ce->pcdata.s  = (char *)moremem(lp->ce->pcdata.s, blen);
-                    lp->ce->pcdata.sm = blen; // always set sm
+                    resizeString(&lp->ce->pcdata, blen); // always set sm
 
                     if (size <= blen - lp->ce->pcdata.sl)
                     {
@@ -280,8 +376,7 @@ XMLEle **parseXMLChunk(LilXML *lp, char *buf, int size, char ynot[])
                 char *ltpos = memchr(buf, '<', size);
                 if (!ltpos)
                 {
-                    lp->ce->pcdata.s = (char *)moremem(lp->ce->pcdata.s, lp->ce->pcdata.sm + size);
-                    lp->ce->pcdata.sm += size;
+                    resizeString(&lp->ce->pcdata, lp->ce->pcdata.sm + size);
                     memcpy((void *)(lp->ce->pcdata.s + lp->ce->pcdata.sl), (const void *)buf, size);
                     lp->ce->pcdata.sl += size;
                     lp->inblob = 1;
@@ -295,6 +390,59 @@ XMLEle **parseXMLChunk(LilXML *lp, char *buf, int size, char ynot[])
     }
     while (curr - buf < size)
     {
+        /* copy runs of plain pcdata, attribute values and names at once and skip runs
+         * of blanks, the state machine only needs to see the chars that end them.
+         */
+        if (!lp->skipping && lp->lastc != '<')
+        {
+            const char *end  = buf + size;
+            const char *stop = curr;
+            String *sp       = NULL;
+
+            switch (lp->cs)
+            {
+                case INCON:
+                    stop = scanContent(curr, end);
+                    sp   = &lp->ce->pcdata;
+                    break;
+                case INATTRV:
+                    stop = scanAttValue(curr, end, (char)lp->delim);
+                    sp   = &lp->ce->at[lp->ce->nat - 1]->valu;
+                    break;
+                case INTAG:
+                    stop = scanToken(curr, end);
+                    sp   = &lp->ce->tag;
+                    break;
+                case INATTRN:
+                    stop = scanToken(curr, end);
+                    sp   = &lp->ce->at[lp->ce->nat - 1]->name;
+                    break;
+                case INCLOSETAG:
+                    stop = scanToken(curr, end);
+                    sp   = &lp->endtag;
+                    break;
+                case LOOK4CON:
+                case LOOK4ATTRN:
+                case LOOK4CLOSETAG:
+                    stop = scanSpace(curr, end);
+                    break;
+                default:
+                    break;
+            }
+
+            if (stop > curr)
+            {
+                if (sp == &lp->ce->pcdata && lp->ce->blob)
+                    decodeBLOB(lp, curr, int(stop - curr));
+                else if (sp)
+                    appendChars(sp, curr, int(stop - curr));
+                lp->ln += countLines(curr, stop);
+                lp->lastc = stop[-1];
+                curr = const_cast<char *>(stop);
+                continue;
+            }
+        }
+
         char newc = *curr;
         /* EOF? */
         if (newc == 0)
@@ -491,24 +639,34 @@ XMLEle *cloneXMLEle(XMLEle *ep)
 }
 
 XMLEle * cloneXMLEle(XMLEle * ep, int (*replace)(void * self, XMLEle * source, XMLEle * * replace), void * self)
+{
+    return cloneXMLEleInto(nullptr, ep, replace, self);
+}
+
+/* clone ep as a new child of parent, in parent's arena.
+ * parent can be NULL to clone into a new arena.
+ */
+static XMLEle *cloneXMLEleInto(XMLEle *parent, XMLEle *ep, int (*replace)(void *self, XMLEle *source, XMLEle **replace),
+                               void *self)
 {
     XMLEle * result = nullptr;
     if (replace && (*replace)(self, ep, &result))
     {
+        if (result != nullptr && parent != nullptr)
+        {
+            result->pe = parent;
+            appXMLEle(parent, result);
+        }
         return result;
     }
-    result = shallowCloneXMLEle(ep);
+    result = growEle(parent, parent ? nullptr : newArena());
+    appendString(&result->tag, tagXMLEle(ep));
+
+    for(int i = 0; i < ep->nat; ++i)
+        addXMLAtt(result, nameXMLAtt(ep->at[i]), valuXMLAtt(ep->at[i]));
 
     for(int i = 0; i < ep->nel; ++i)
-    {
-        XMLEle * child = ep->el[i];
-        XMLEle * repl = cloneXMLEle(child, replace, self);
-        if (repl != nullptr)
-        {
-            repl->pe = result;
-            appXMLEle(result, repl);
-        }
-    }
+        cloneXMLEleInto(result, ep->el[i], replace, self);
 
     if (pcdatalenXMLEle(ep))
     {
@@ -614,6 +772,20 @@ int pcdatalenXMLEle(XMLEle *ep)
     return (ep->pcdata.sl);
 }
 
+/* return the content decoded from base64 while parsing the given element, or NULL.
+ * the caller then owns it, to release with the free function given to decodeXMLBLOBs().
+ */
+void *takeBlobXMLEle(XMLEle *ep, int *len)
+{
+    void *blob = ep->blob;
+
+    *len        = ep->bloblen;
+    ep->blob    = NULL;
+    ep->bloblen = 0;
+    ep->blobmax = 0;
+    return blob;
+}
+
 /* return the name of the given attribute */
 char *nameXMLAtt(XMLAtt *ap)
 {
@@ -669,7 +841,7 @@ XMLEle *readXMLFile(FILE *fp, LilXML *lp, char ynot[])
  */
 XMLEle *addXMLEle(XMLEle *parent, const char *tag)
 {
-    XMLEle *ep = growEle(parent);
+    XMLEle *ep = growEle(parent, NULL);
     appendString(&ep->tag, tag);
     return (ep);
 }
@@ -679,17 +851,28 @@ XMLEle *addXMLEle(XMLEle *parent, const char *tag)
  */
 static void appXMLEle(XMLEle *ep, XMLEle *newep)
 {
-    ep->el            = (XMLEle **)moremem(ep->el, (ep->nel + 1) * sizeof(XMLEle *));
+    ep->el            = (XMLEle **)growList(ep->arena, (void **)ep->el, ep->nel);
     ep->el[ep->nel++] = newep;
+
+    if (newep->arena != ep->arena)
+    {
+        /* ep's tree can no longer be released with its arena alone */
+        if (ep->arena)
+            ep->arena->foreign = 1;
+        /* keep newep's arena alive as long as newep */
+        if (newep->arena && !newep->ownsArena)
+        {
+            newep->arena->refs++;
+            newep->ownsArena = 1;
+        }
+    }
 }
 
 /* Update the tag of an element
  */
 XMLEle *setXMLEleTag(XMLEle *ep, const char * tag)
 {
-    freeString(&ep->tag);
-    newString(&ep->tag);
-    appendString(&ep->tag, tag);
+    editString(&ep->tag, tag);
     return ep;
 }
 
@@ -697,8 +880,7 @@ XMLEle *setXMLEleTag(XMLEle *ep, const char * tag)
 /* set the pcdata of the given element */
 void editXMLEle(XMLEle *ep, const char *pcdata)
 {
-    freeString(&ep->pcdata);
-    appendString(&ep->pcdata, pcdata);
+    editString(&ep->pcdata, pcdata);
     ep->pcdata_hasent = (strpbrk(pcdata, entities) != NULL);
 }
 
@@ -744,8 +926,7 @@ XMLEle * shallowCloneXMLEle(XMLEle * ele)
 /* change the value of an attribute to str */
 void editXMLAtt(XMLAtt *ap, const char *str)
 {
-    freeString(&ap->valu);
-    appendString(&ap->valu, str);
+    editString(&ap->valu, str);
 }
 
 #define PRINDENT 4 /* sample print indent each level */
@@ -1092,7 +1273,7 @@ static int oneXMLchar(LilXML *lp, int c, char ynot[])
             if (isTokenChar(0, c))
                 growString(&lp->ce->tag, c);
             else if (c == '>')
-                lp->cs = LOOK4CON;
+                beginContent(lp);
             else if (c == '/')
                 lp->cs = SAWSLASH;
             else
@@ -1101,7 +1282,7 @@ static int oneXMLchar(LilXML *lp, int c, char ynot[])
 
         case LOOK4ATTRN: /* looking for attr name, > or / */
             if (c == '>')
-                lp->cs = LOOK4CON;
+                beginContent(lp);
             else if (c == '/')
                 lp->cs = SAWSLASH;
             else if (isTokenChar(1, c))
@@ -1188,10 +1369,13 @@ static int oneXMLchar(LilXML *lp, int c, char ynot[])
 
         case LOOK4CON: /* skipping leading content whitespace*/
             if (c == '<')
+            {
+                endBLOB(lp);
                 lp->cs = SAWLTINCON;
+            }
             else if (!isspace(c))
             {
-                growString(&lp->ce->pcdata, c);
+                growContent(lp, c);
                 lp->cs = INCON;
             }
             break;
@@ -1208,11 +1392,12 @@ static int oneXMLchar(LilXML *lp, int c, char ynot[])
                 /* chomp trailing whitespace */
                 while (lp->ce->pcdata.sl > 0 && isspace(lp->ce->pcdata.s[lp->ce->pcdata.sl - 1]))
                     lp->ce->pcdata.s[--(lp->ce->pcdata.sl)] = '\0';
+                endBLOB(lp);
                 lp->cs = SAWLTINCON;
             }
             else
             {
-                growString(&lp->ce->pcdata, c);
+                growContent(lp, c);
             }
             break;
 
@@ -1303,9 +1488,22 @@ static int oneXMLchar(LilXML *lp, int c, char ynot[])
 /* set up for a fresh start again */
 static void initParser(LilXML *lp)
 {
-    delXMLEle(lp->ce);
+    /* drop any partial element, from its root */
+    XMLEle *root = lp->ce;
+    while (root && root->pe)
+        root = root->pe;
+    delXMLEle(root);
     freeString(&lp->endtag);
+
+    /* keep settings */
+    void *(*blobmalloc)(size_t size)              = lp->blobmalloc;
+    void *(*blobrealloc)(void *ptr, size_t size) = lp->blobrealloc;
+    void (*blobfree)(void *ptr)                   = lp->blobfree;
+
     memset(lp, 0, sizeof(*lp));
+    lp->blobmalloc  = blobmalloc;
+    lp->blobrealloc = blobrealloc;
+    lp->blobfree    = blobfree;
     newString(&lp->endtag);
     lp->cs = LOOK4START;
     lp->ln = 1;
@@ -1318,7 +1516,8 @@ static void initParser(LilXML *lp)
  */
 static void pushXMLEle(LilXML *lp)
 {
-    lp->ce = growEle(lp->ce);
+    /* a new root gets its own arena */
+    lp->ce = growEle(lp->ce, lp->ce ? NULL : newArena());
     resetEndTag(lp);
 }
 
@@ -1331,19 +1530,29 @@ static void popXMLEle(LilXML *lp)
     resetEndTag(lp);
 }
 
-/* return one new XMLEle, added to the given element if given */
-static XMLEle *growEle(XMLEle *pe)
+/* return one new XMLEle, added to the given element if given.
+ * a child lives in the arena of its parent. A new root lives in arena, that it then owns,
+ * or is malloced if arena is NULL.
+ */
+static XMLEle *growEle(XMLEle *pe, XMLArena *arena)
 {
-    XMLEle *newe = (XMLEle *)moremem(NULL, sizeof(XMLEle));
+    if (pe)
+        arena = pe->arena;
+
+    XMLEle *newe = (XMLEle *)(arena ? arenaAlloc(arena, sizeof(XMLEle)) : moremem(NULL, sizeof(XMLEle)));
 
     memset(newe, 0, sizeof(XMLEle));
+    newe->arena        = arena;
+    newe->ownsArena    = (!pe && arena);
+    newe->tag.arena    = arena;
+    newe->pcdata.arena = arena;
     newString(&newe->tag);
     newString(&newe->pcdata);
     newe->pe = pe;
 
     if (pe)
     {
-        pe->el            = (XMLEle **)moremem(pe->el, (pe->nel + 1) * sizeof(XMLEle *));
+        pe->el            = (XMLEle **)growList(arena, (void **)pe->el, pe->nel);
         pe->el[pe->nel++] = newe;
     }
 
@@ -1353,19 +1562,36 @@ static XMLEle *growEle(XMLEle *pe)
 /* add room for and return one new XMLAtt to the given element */
 static XMLAtt *growAtt(XMLEle *ep)
 {
-    XMLAtt *newa = (XMLAtt *)moremem(NULL, sizeof * newa);
+    XMLArena *arena = ep->arena;
+    XMLAtt *newa    = (XMLAtt *)(arena ? arenaAlloc(arena, sizeof * newa) : moremem(NULL, sizeof * newa));
 
     memset(newa, 0, sizeof(*newa));
+    newa->name.arena = arena;
+    newa->valu.arena = arena;
     newString(&newa->name);
     newString(&newa->valu);
     newa->ce = ep;
 
-    ep->at            = (XMLAtt **)moremem(ep->at, (ep->nat + 1) * sizeof(XMLAtt *));
+    ep->at            = (XMLAtt **)growList(arena, (void **)ep->at, ep->nat);
     ep->at[ep->nat++] = newa;
 
     return (newa);
 }
 
+/* return list, holding n pointers, with room for one more.
+ * lists are sized by powers of 2 from 4, so only grow when n is one of them.
+ */
+static void **growList(XMLArena *arena, void **list, int n)
+{
+    if (list && (n < 4 || (n & (n - 1))))
+        return list;
+
+    size_t sz = (n < 4 ? 4 : 2 * n) * sizeof(void *);
+    if (arena)
+        return (void **)arenaRealloc(arena, list, n * sizeof(void *), sz);
+    return (void **)moremem(list, sz);
+}
+
 /* free a and all it holds */
 static void freeAtt(XMLAtt *a)
 {
@@ -1373,14 +1599,128 @@ static void freeAtt(XMLAtt *a)
         return;
     freeString(&a->name);
     freeString(&a->valu);
-    (*myfree)(a);
+    arenaFree(a->ce->arena, a);
 }
 
 /* reset endtag */
 static void resetEndTag(LilXML *lp)
 {
-    freeString(&lp->endtag);
-    newString(&lp->endtag);
+    if (!lp->endtag.s)
+        newString(&lp->endtag);
+    lp->endtag.sl   = 0;
+    lp->endtag.s[0] = '\0';
+}
+
+/* the opening tag of ce is complete, look for its content.
+ * the content of a oneBLOB is decoded as it comes when asked to, into a buffer sized from enclen
+ * if known.
+ */
+static void beginContent(LilXML *lp)
+{
+    XMLEle *ep = lp->ce;
+
+    lp->cs = LOOK4CON;
+    if (!lp->blobmalloc || strcmp(ep->tag.s, "oneBLOB"))
+        return;
+
+    /* attached blobs have no content */
+    const char *attached = findXMLAttValu(ep, "attached");
+    if (!strcmp(attached, "true"))
+        return;
+
+    const char *enclen = findXMLAttValu(ep, "enclen");
+    int len            = atoi(enclen);
+    lp->blobfixed      = (len > 0);
+
+    ep->blobmax  = lp->blobfixed ? 3 * ((len + 3) / 4) : 65536;
+    ep->blob     = (char *)(*lp->blobmalloc)(ep->blobmax);
+    ep->bloblen  = 0;
+    ep->blobfree = lp->blobfree;
+    if (!ep->blob)
+    {
+        fprintf(stderr, "%s(%s): Failed to allocate memory.\n", __FILE__, __func__);
+        exit(1);
+    }
+
+    /* blob is not in the arena, delXMLEle must look for it */
+    if (ep->arena)
+        ep->arena->foreign = 1;
+
+    from64tobits_begin(&lp->b64);
+}
+
+/* add c to the content of ce */
+static void growContent(LilXML *lp, int c)
+{
+    if (lp->ce->blob)
+    {
+        char ch = (char)c;
+        decodeBLOB(lp, &ch, 1);
+    }
+    else
+        growString(&lp->ce->pcdata, c);
+}
+
+/* decode the n chars of base64 at s into the blob of ce */
+static void decodeBLOB(LilXML *lp, const char *s, int n)
+{
+    XMLEle *ep = lp->ce;
+    int bound  = 3 * ((lp->b64.nq + n + 3) / 4);
+
+    if (ep->bloblen + bound <= ep->blobmax)
+    {
+        ep->bloblen += from64tobits_stream(&lp->b64, ep->blob + ep->bloblen, s, n);
+    }
+    else if (lp->blobfixed)
+    {
+        /* the bound counts blanks too: the buffer sized from enclen is likely large enough, decode aside */
+        char *tmp = (char *)moremem(NULL, bound);
+        int len   = from64tobits_stream(&lp->b64, tmp, s, n);
+        appendBLOB(lp, tmp, len);
+        (*myfree)(tmp);
+    }
+    else
+    {
+        resizeBLOB(lp, std::max(2 * ep->blobmax, ep->bloblen + bound));
+        ep->bloblen += from64tobits_stream(&lp->b64, ep->blob + ep->bloblen, s, n);
+    }
+}
+
+/* append the n bytes at s to the blob of ce */
+static void appendBLOB(LilXML *lp, const char *s, int n)
+{
+    XMLEle *ep = lp->ce;
+
+    if (ep->bloblen + n > ep->blobmax)
+        resizeBLOB(lp, ep->bloblen + n);
+    memcpy(ep->blob + ep->bloblen, s, n);
+    ep->bloblen += n;
+}
+
+/* change the size of the blob of ce to n bytes */
+static void resizeBLOB(LilXML *lp, int n)
+{
+    XMLEle *ep = lp->ce;
+
+    ep->blob    = (char *)(*lp->blobrealloc)(ep->blob, n);
+    ep->blobmax = n;
+    if (!ep->blob)
+    {
+        fprintf(stderr, "%s(%s): Failed to allocate memory.\n", __FILE__, __func__);
+        exit(1);
+    }
+}
+
+/* the content of ce is complete, flush its blob if decoding one */
+static void endBLOB(LilXML *lp)
+{
+    char tail[2];
+
+    if (!lp->ce->blob)
+        return;
+
+    int len = from64tobits_end(&lp->b64, tail);
+    appendBLOB(lp, tail, len);
 }
 
 /* 1 if c is a valid token character, else 0.
@@ -1402,7 +1742,7 @@ static void growString(String *sp, int c)
             newString(sp);
         else
         {
-            sp->s = (char *)moremem(sp->s, sp->sm *= 2);
+            resizeString(sp, sp->sm * 2);
         }
     }
     sp->s[--l] = '\0';
@@ -1425,7 +1765,7 @@ static void appendString(String *sp, const char *str)
             newString(sp);
         if (l > sp->sm)
         {
-            sp->s = (char *)moremem(sp->s, (sp->sm = l));
+            resizeString(sp, l);
         }
     }
     if (sp->s)
@@ -1435,28 +1775,288 @@ static void appendString(String *sp, const char *str)
     }
 }
 
-/* init a String with a malloced string containing just \0 */
+/* append the n chars at str to the String storage at *sp, growing it geometrically */
+static void appendChars(String *sp, const char *str, int n)
+{
+    int l = sp->sl + n + 1; /* need room for '\0' */
+
+    if (l > sp->sm)
+    {
+        if (!sp->s)
+            newString(sp);
+        if (l > sp->sm)
+        {
+            int sm = sp->sm;
+            while (sm < l)
+                sm *= 2;
+            resizeString(sp, sm);
+        }
+    }
+    memcpy(&sp->s[sp->sl], str, n);
+    sp->sl += n;
+    sp->s[sp->sl] = '\0';
+}
+
+/* return the first char in [s, end) that the state machine must see in INCON: '<', '&' or '\0'.
+ * return end if none.
+ */
+static const char *scanContent(const char *s, const char *end)
+{
+#if defined(__SSE2__)
+    const __m128i lt  = _mm_set1_epi8('<');
+    const __m128i amp = _mm_set1_epi8('&');
+    const __m128i nul = _mm_setzero_si128();
+
+    for (; end - s >= 16; s += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)s);
+        __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, lt), _mm_cmpeq_epi8(v, amp)), _mm_cmpeq_epi8(v, nul));
+        int mask  = _mm_movemask_epi8(m);
+        if (mask)
+            return s + __builtin_ctz(mask);
+    }
+#endif
+    for (; s < end; s++)
+    {
+        if (*s == '<' || *s == '&' || *s == '\0')
+            return s;
+    }
+    return end;
+}
+
+/* return the first char in [s, end) that the state machine must see in INATTRV:
+ * '&', the delimiter or a control char (those are dropped from values).
+ * return end if none.
+ */
+static const char *scanAttValue(const char *s, const char *end, char delim)
+{
+#if defined(__SSE2__)
+    const __m128i amp = _mm_set1_epi8('&');
+    const __m128i del = _mm_set1_epi8(delim);
+    const __m128i sp  = _mm_set1_epi8(' ');
+    const __m128i neg = _mm_set1_epi8(-1);
+    const __m128i dl  = _mm_set1_epi8(0x7f);
+
+    for (; end - s >= 16; s += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *)s);
+        /* 0 <= c < ' ' as signed bytes, chars >= 0x80 are not control chars */
+        __m128i ctl = _mm_and_si128(_mm_cmplt_epi8(v, sp), _mm_cmpgt_epi8(v, neg));
+        __m128i m   = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, amp), _mm_cmpeq_epi8(v, del)),
+                                   _mm_or_si128(ctl, _mm_cmpeq_epi8(v, dl)));
+        int mask    = _mm_movemask_epi8(m);
+        if (mask)
+            return s + __builtin_ctz(mask);
+    }
+#endif
+    for (; s < end; s++)
+    {
+        unsigned char c = (unsigned char)*s;
+        if (c == '&' || *s == delim || c < ' ' || c == 0x7f)
+            return s;
+    }
+    return end;
+}
+
+/* return the first char in [s, end) that can not continue a tag or attribute name, or end */
+static const char *scanToken(const char *s, const char *end)
+{
+    for (; s < end; s++)
+    {
+        unsigned char c = (unsigned char)*s;
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'))
+            return s;
+    }
+    return end;
+}
+
+/* return the first char in [s, end) that is not a blank, or end */
+static const char *scanSpace(const char *s, const char *end)
+{
+    for (; s < end; s++)
+    {
+        if (*s != ' ' && *s != '\n' && *s != '\t' && *s != '\r' && *s != '\v' && *s != '\f')
+            return s;
+    }
+    return end;
+}
+
+/* return the number of '\n' in [s, end) */
+static int countLines(const char *s, const char *end)
+{
+    int n = 0;
+    while ((s = (const char *)memchr(s, '\n', end - s)) != NULL)
+    {
+        n++;
+        s++;
+    }
+    return n;
+}
+
+/* init a String with a string containing just \0, in sp->arena if set else malloced */
 static void newString(String *sp)
 {
     if (!sp)
         return;
 
-    sp->s  = (char *)moremem(NULL, MINMEM);
-    sp->sm = MINMEM;
+    if (sp->arena)
+    {
+        sp->s  = (char *)arenaAlloc(sp->arena, ARENAMINMEM);
+        sp->sm = ARENAMINMEM;
+    }
+    else
+    {
+        sp->s  = (char *)moremem(NULL, MINMEM);
+        sp->sm = MINMEM;
+    }
     *sp->s = '\0';
     sp->sl = 0;
 }
 
-/* free memory used by the given String */
+/* free memory used by the given String.
+ * arena strings are only forgotten, the arena goes away as a whole.
+ */
 static void freeString(String *sp)
 {
-    if (sp->s)
+    if (sp->s && !sp->arena)
         (*myfree)(sp->s);
     sp->s  = NULL;
     sp->sl = 0;
     sp->sm = 0;
 }
 
+/* replace the content of sp with str.
+ * an edited arena string moves to malloced memory: the arena keeps the first value until the
+ * tree goes, later edits free the value they replace, so a long lived tree does not grow.
+ */
+static void editString(String *sp, const char *str)
+{
+    if (sp->arena)
+    {
+        sp->arena->foreign = 1;
+        sp->arena          = NULL;
+        sp->s              = NULL;
+        sp->sl             = 0;
+        sp->sm             = 0;
+    }
+    else
+        freeString(sp);
+
+    if (str)
+        appendString(sp, str);
+    else
+        newString(sp);
+}
+
+/* change the storage of sp to n bytes, keeping its content.
+ * a string too large for its arena moves to malloced memory.
+ */
+static void resizeString(String *sp, int n)
+{
+    if (sp->arena && n > ARENAMAXSTR)
+    {
+        char *s = (char *)moremem(NULL, n);
+        if (sp->s)
+            memcpy(s, sp->s, std::min(std::min(sp->sl + 1, sp->sm), n));
+        sp->arena->foreign = 1;
+        sp->arena          = NULL;
+        sp->s              = s;
+    }
+    else if (sp->arena)
+        sp->s = (char *)arenaRealloc(sp->arena, sp->s, sp->s ? std::min(sp->sl + 1, sp->sm) : 0, n);
+    else
+        sp->s = (char *)moremem(sp->s, n);
+    sp->sm = n;
+}
+
+/* return a new arena, with one reference */
+static XMLArena *newArena()
+{
+    size_t used     = (sizeof(XMLArena) + ARENAALIGN - 1) & ~(size_t)(ARENAALIGN - 1);
+    ArenaBlock *blk = (ArenaBlock *)moremem(NULL, ARENAHDR + ARENABLOCK);
+
+    blk->next = NULL;
+    blk->size = ARENABLOCK;
+    blk->used = used;
+
+    /* the arena describes itself from the start of its first block */
+    XMLArena *arena = new ((char *)blk + ARENAHDR) XMLArena();
+    arena->blocks   = blk;
+    arena->last     = NULL;
+    arena->refs     = 1;
+    arena->foreign  = 0;
+    return arena;
+}
+
+/* return n bytes from arena, adding a block if needed */
+static void *arenaAlloc(XMLArena *arena, size_t n)
+{
+    ArenaBlock *blk = arena->blocks;
+
+    n = (n + ARENAALIGN - 1) & ~(size_t)(ARENAALIGN - 1);
+    if (blk->used + n > blk->size)
+    {
+        size_t size = std::max(std::min(blk->size * 2, (size_t)ARENAMAXBLOCK), n);
+        ArenaBlock *nb = (ArenaBlock *)moremem(NULL, ARENAHDR + size);
+        nb->next      = blk;
+        nb->size      = size;
+        nb->used      = 0;
+        arena->blocks = blk = nb;
+    }
+
+    void *p = (char *)blk + ARENAHDR + blk->used;
+    blk->used += n;
+    arena->last = p;
+    return p;
+}
+
+/* like arenaAlloc, keeping the first used bytes of old.
+ * the last allocation grows in place when its block has room.
+ */
+static void *arenaRealloc(XMLArena *arena, void *old, size_t used, size_t n)
+{
+    if (old && old == arena->last)
+    {
+        ArenaBlock *blk = arena->blocks;
+        size_t offset   = (char *)old - ((char *)blk + ARENAHDR);
+        size_t end      = offset + ((n + ARENAALIGN - 1) & ~(size_t)(ARENAALIGN - 1));
+        if (end <= blk->size)
+        {
+            blk->used = end;
+            return old;
+        }
+    }
+
+    void *p = arenaAlloc(arena, n);
+    if (old)
+        memcpy(p, old, std::min(used, n));
+    return p;
+}
+
+/* drop one reference to arena, freeing all its blocks with the last one */
+static void arenaRelease(XMLArena *arena)
+{
+    if (--arena->refs > 0)
+        return;
+
+    /* the arena itself lives in its first block, freed last */
+    ArenaBlock *blk = arena->blocks;
+    arena->~XMLArena();
+    while (blk)
+    {
+        ArenaBlock *next = blk->next;
+        (*myfree)(blk);
+        blk = next;
+    }
+}
+
+/* free p, unless it lives in arena */
+static void arenaFree(XMLArena *arena, void *p)
+{
+    if (!arena)
+        (*myfree)(p);
+}
+
 /* like malloc but knows to use realloc if already started */
 static void *moremem(void *old, size_t n)
 {
@@ -92,6 +92,18 @@ extern LilXML *newLilXML();
 */
 extern void delLilXML(LilXML *lp);
 
+/** \brief Decode the base64 content of oneBLOB elements while parsing.
+    The content of each oneBLOB, unless attached, is decoded as it arrives in a buffer obtained from the given
+    functions instead of being collected as pcdata. Use takeBlobXMLEle() to get it.
+    The buffer has the final size from the start when the element has an enclen attribute.
+    \param lp a pointer to a lilxml parser.
+    \param newmalloc allocates a buffer, NULL to collect oneBLOB content as pcdata again.
+    \param newrealloc resizes a buffer.
+    \param newfree releases a buffer.
+*/
+extern void decodeXMLBLOBs(LilXML *lp, void *(*newmalloc)(size_t size), void *(*newrealloc)(void *ptr, size_t size),
+                           void (*newfree)(void *ptr));
+
 /**
  * @brief delXMLEle Delete XML element.
  * @param e Pointer to XML element to delete. If nullptr, no action is taken.
@@ -187,6 +199,14 @@ extern char *valuXMLAtt(XMLAtt *ap);
 */
 extern int pcdatalenXMLEle(XMLEle *ep);
 
+/** \brief Take the content of a oneBLOB element decoded by a parser set up with decodeXMLBLOBs().
+    The caller becomes the owner of the buffer and releases it with the function given to decodeXMLBLOBs().
+    \param ep a pointer to an XML element.
+    \param len receives the number of decoded bytes.
+    \return the decoded buffer, or NULL if none.
+*/
+extern void *takeBlobXMLEle(XMLEle *ep, int *len);
+
 /** \brief Return the number of nested XML elements in a parent XML element.
     \param ep a pointer to an XML element.
     \return the number of nested XML elements.
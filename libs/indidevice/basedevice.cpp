@@ -69,7 +69,7 @@ BaseDevicePrivate::BaseDevicePrivate()
 
 BaseDevicePrivate::~BaseDevicePrivate()
 {
-    pAll.clear();
+    clearProperties();
 }
 
 BaseDevice::BaseDevice()
@@ -139,21 +139,9 @@ void *BaseDevice::getRawProperty(const char *name, INDI_PROPERTY_TYPE type) cons
 INDI::Property BaseDevice::getProperty(const char *name, INDI_PROPERTY_TYPE type) const
 {
     D_PTR(const BaseDevice);
-    std::lock_guard<std::mutex> lock(d->m_Lock);
+    std::shared_lock<std::shared_mutex> lock(d->m_Lock);
 
-    for (const auto &oneProp : getProperties())
-    {
-        if (type != oneProp.getType() && type != INDI_UNKNOWN)
-            continue;
-
-        if (!oneProp.getRegistered())
-            continue;
-
-        if (oneProp.isNameMatch(name))
-            return oneProp;
-    }
-
-    return INDI::Property();
+    return d->findProperty(name, type);
 }
 
 BaseDevice::Properties BaseDevice::getProperties()
@@ -173,7 +161,7 @@ int BaseDevice::removeProperty(const char *name, char *errmsg)
     D_PTR(BaseDevice);
     int result = INDI_PROPERTY_INVALID;
 
-    std::lock_guard<std::mutex> lock(d->m_Lock);
+    std::lock_guard<std::shared_mutex> lock(d->m_Lock);
 
     d->pAll.erase_if([&name, &result](INDI::Property & prop) -> bool
     {
@@ -205,6 +193,18 @@ int BaseDevice::removeProperty(const char *name, char *errmsg)
             return false;
     });
 
+    auto it = d->propertyIndex.find(d->propertyHash(name));
+    if (it != d->propertyIndex.end())
+    {
+        auto &bucket = it->second;
+        bucket.erase(std::remove_if(bucket.begin(), bucket.end(), [&name](INDI::Property & prop)
+        {
+            return prop.isNameMatch(name);
+        }), bucket.end());
+        if (bucket.empty())
+            d->propertyIndex.erase(it);
+    }
+
     if (result != 0)
         snprintf(errmsg, MAXRBUF, "Error: Property %s not found in device %s.", name, getDeviceName());
 
@@ -888,7 +888,7 @@ void BaseDevice::doMessage(XMLEle *msg)
 void BaseDevice::addMessage(const std::string &msg)
 {
     D_PTR(BaseDevice);
-    std::unique_lock<std::mutex> guard(d->m_Lock);
+    std::unique_lock<std::shared_mutex> guard(d->m_Lock);
     d->messageLog.push_back(msg);
     guard.unlock();
 
@@ -898,7 +898,7 @@ void BaseDevice::addMessage(const std::string &msg)
 const std::string &BaseDevice::messageQueue(size_t index) const
 {
     D_PTR(const BaseDevice);
-    std::lock_guard<std::mutex> lock(d->m_Lock);
+    std::shared_lock<std::shared_mutex> lock(d->m_Lock);
     assert(index < d->messageLog.size());
     return d->messageLog.at(index);
 }
@@ -906,7 +906,7 @@ const std::string &BaseDevice::messageQueue(size_t index) const
 const std::string &BaseDevice::lastMessage() const
 {
     D_PTR(const BaseDevice);
-    std::lock_guard<std::mutex> lock(d->m_Lock);
+    std::shared_lock<std::shared_mutex> lock(d->m_Lock);
     assert(d->messageLog.size() != 0);
     return d->messageLog.back();
 }
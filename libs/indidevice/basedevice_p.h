@@ -25,8 +25,12 @@
 
 #include <deque>
 #include <string>
+#include <string_view>
 #include <mutex>
+#include <shared_mutex>
 #include <map>
+#include <unordered_map>
+#include <vector>
 #include <functional>
 
 #include "indipropertyblob.h"
@@ -62,13 +66,48 @@ class BaseDevicePrivate
         void addProperty(const INDI::Property &property)
         {
             {
-                std::unique_lock<std::mutex> lock(m_Lock);
+                std::unique_lock<std::shared_mutex> lock(m_Lock);
                 pAll.push_back(property);
+                propertyIndex[propertyHash(property.getName())].push_back(property);
             }
 
             emitWatchProperty(property, true);
         }
 
+        /** @brief Registered property with the given name and type, or any type if INDI_UNKNOWN. Call with m_Lock held. */
+        INDI::Property findProperty(const char *name, INDI_PROPERTY_TYPE type) const
+        {
+            auto it = propertyIndex.find(propertyHash(name));
+            if (it == propertyIndex.end())
+                return INDI::Property();
+
+            for (const auto &oneProp : it->second)
+            {
+                if (type != oneProp.getType() && type != INDI_UNKNOWN)
+                    continue;
+
+                if (!oneProp.getRegistered())
+                    continue;
+
+                if (oneProp.isNameMatch(name))
+                    return oneProp;
+            }
+
+            return INDI::Property();
+        }
+
+        void clearProperties()
+        {
+            std::unique_lock<std::shared_mutex> lock(m_Lock);
+            pAll.clear();
+            propertyIndex.clear();
+        }
+
+        static size_t propertyHash(const char *name)
+        {
+            return std::hash<std::string_view>()(name ? name : "");
+        }
+
     public: // mediator
         void mediateNewDevice(BaseDevice baseDevice)
         {
@@ -179,12 +218,14 @@ class BaseDevicePrivate
         BaseDevice self {make_shared_weak(this)}; // backward compatible (for operators as pointer)
         std::string deviceName;
         BaseDevice::Properties pAll;
+        // pAll by the hash of the property names, in the order they were defined
+        std::unordered_map<size_t, std::vector<INDI::Property>> propertyIndex;
         std::map<std::string, WatchDetails> watchPropertyMap;
         LilXmlParser xmlParser;
 
         INDI::BaseMediator *mediator {nullptr};
         std::deque<std::string> messageLog;
-        mutable std::mutex m_Lock;
+        mutable std::shared_mutex m_Lock;
 
         bool valid {true};
 };
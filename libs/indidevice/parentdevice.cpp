@@ -53,7 +53,7 @@ ParentDevice::~ParentDevice()
     if (--d->ref == 0)
     {
         // prevent circular reference
-        d->pAll.clear();
+        d->clearProperties();
     }
 }
 
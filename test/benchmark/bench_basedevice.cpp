@@ -0,0 +1,121 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+/*
+ * Property lookups by name.
+ *
+ * Usage: bench_basedevice [lookups per thread]
+ *
+ * Looks properties up by name in devices of increasing size, from one and
+ * from four threads, with BaseDevice::getProperty and with a reference that
+ * scans all properties under a mutex, as getProperty did before it kept an
+ * index. Names are those of standard properties, with a suffix for the
+ * larger devices.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "basedevice.h"
+#include "parentdevice.h"
+#include "indipropertynumber.h"
+
+static std::mutex scanLock;
+
+// The linear scan getProperty did
+static INDI::Property scan(const INDI::BaseDevice &device, const char *name, INDI_PROPERTY_TYPE type)
+{
+    std::lock_guard<std::mutex> lock(scanLock);
+
+    for (const auto &oneProp : device.getProperties())
+    {
+        if (type != oneProp.getType() && type != INDI_UNKNOWN)
+            continue;
+
+        if (!oneProp.getRegistered())
+            continue;
+
+        if (oneProp.isNameMatch(name))
+            return oneProp;
+    }
+
+    return INDI::Property();
+}
+
+static INDI::Property indexed(const INDI::BaseDevice &device, const char *name, INDI_PROPERTY_TYPE type)
+{
+    return device.getProperty(name, type);
+}
+
+typedef INDI::Property (*Lookup)(const INDI::BaseDevice &device, const char *name, INDI_PROPERTY_TYPE type);
+
+// Million lookups per second, over all threads
+static double rate(Lookup lookup, const INDI::BaseDevice &device, const std::vector<std::string> &names, int threads,
+                   int count)
+{
+    std::vector<std::thread> workers;
+    std::vector<int> found(threads, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++)
+        workers.emplace_back([&, t]
+    {
+        for (int i = 0; i < count; i++)
+            found[t] += lookup(device, names[(i * 7 + t) % names.size()].c_str(), INDI_NUMBER).isValid();
+    });
+    for (auto &worker : workers)
+        worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (int t = 0; t < threads; t++)
+        if (found[t] != count)
+            fprintf(stderr, "%d of %d found\n", found[t], count);
+
+    return threads * count / seconds / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+    int count = argc > 1 ? atoi(argv[1]) : 200000;
+    const char *standard[] = {"EQUATORIAL_EOD_COORD", "CCD_EXPOSURE", "ABS_FOCUS_POSITION", "CCD_TEMPERATURE",
+                              "TELESCOPE_TIMED_GUIDE_NS", "FILTER_SLOT", "GEOGRAPHIC_COORD", "CCD_FRAME"
+                             };
+
+    printf("%-11s %8s %16s %16s\n", "properties", "threads", "scan (M/s)", "indexed (M/s)");
+    for (int size : {20, 100, 500})
+    {
+        INDI::ParentDevice device(INDI::ParentDevice::Valid);
+        device.setDeviceName("Bench");
+        std::vector<std::string> names;
+        for (int i = 0; i < size; i++)
+        {
+            names.push_back(std::string(standard[i % 8]) + (i < 8 ? "" : "_" + std::to_string(i / 8)));
+            INDI::PropertyNumber property {1};
+            property.setName(names.back());
+            device.registerProperty(property);
+        }
+
+        for (int threads : {1, 4})
+            printf("%-11d %8d %16.2f %16.2f\n", size, threads, rate(scan, device, names, threads, count),
+                   rate(indexed, device, names, threads, count));
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+/*
+ * Software binning throughput.
+ *
+ * Usage: bench_binning [width height]
+ *
+ * Compares the pixel at a time loops previously in CCDChip::binFrame and
+ * binBayerFrame (including their full frame memset) with FrameBinning, on
+ * one thread and on all cores, for a 16 bit frame (default 4656x3520).
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "indiframebinning.h"
+
+using INDI::FrameBinning;
+
+static void legacyBin16(const uint16_t *RawFrame16, uint16_t *bin_buf, uint32_t SubW, uint32_t SubH, int BinX)
+{
+    memset(bin_buf, 0, size_t(SubW) * SubH * 2);
+    for (uint32_t i = 0; i < SubH; i += BinX)
+        for (uint32_t j = 0; j < SubW; j += BinX)
+        {
+            for (int k = 0; k < BinX; k++)
+                for (int l = 0; l < BinX; l++)
+                {
+                    uint16_t val = *(RawFrame16 + j + (i + k) * SubW + l);
+                    if (val + *bin_buf > UINT16_MAX)
+                        *bin_buf = UINT16_MAX;
+                    else
+                        *bin_buf += val;
+                }
+            bin_buf++;
+        }
+}
+
+static void legacyBinBayer16(const uint16_t *RawFrame16, uint16_t *BinFrame16, uint32_t SubW, uint32_t SubH,
+                             uint32_t BinX, uint32_t BinY)
+{
+    memset(BinFrame16, 0, size_t(SubW) * SubH * 2);
+    uint32_t BinW = SubW / BinX;
+    uint32_t RawOffset = 0;
+
+    for (uint32_t i = 0; i < SubH; i++)
+    {
+        uint32_t BinOffsetH = (((i / BinY) & 0xFFFFFFFE) + (i & 0x00000001)) * BinW;
+        for (uint32_t j = 0; j < SubW; j++)
+        {
+            uint32_t BinFrameOffset = BinOffsetH + ((j / BinX) & 0xFFFFFFFE) + (j & 0x00000001);
+            uint32_t val = BinFrame16[BinFrameOffset];
+            val += RawFrame16[RawOffset];
+            if (val > UINT16_MAX)
+                val = UINT16_MAX;
+            BinFrame16[BinFrameOffset] = (uint16_t)val;
+            RawOffset++;
+        }
+    }
+}
+
+static double timeIt(const std::function<void()> &run)
+{
+    const int rounds = 10;
+    run();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+        run();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / rounds;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t width = 4656, height = 3520;
+    if (argc == 3)
+    {
+        width = atoi(argv[1]);
+        height = atoi(argv[2]);
+    }
+
+    std::vector<uint16_t> frame(size_t(width) * height), binned(frame.size());
+    uint32_t seed = 1;
+    for (auto &value : frame)
+    {
+        seed = seed * 1103515245 + 12345;
+        value = (seed >> 16) & 0x3fff;
+    }
+
+    printf("%ux%u 16 bit frame, ms per frame\n", width, height);
+    printf("%-10s %12s %12s %12s\n", "binning", "previous", "1 thread", "all cores");
+
+    for (uint32_t bin : {2u, 3u, 4u})
+    {
+        double legacy = timeIt([&]() { legacyBin16(frame.data(), binned.data(), width, height, bin); });
+        double single = timeIt([&]() { FrameBinning::bin(frame.data(), binned.data(), 16, width, height, bin, bin, FrameBinning::SUM, false, 1); });
+        double multi = timeIt([&]() { FrameBinning::bin(frame.data(), binned.data(), 16, width, height, bin, bin, FrameBinning::SUM, false, 0); });
+        printf("%ux%-8u %12.2f %12.2f %12.2f\n", bin, bin, legacy, single, multi);
+    }
+
+    for (uint32_t bin : {2u, 4u})
+    {
+        double legacy = timeIt([&]() { legacyBinBayer16(frame.data(), binned.data(), width, height, bin, bin); });
+        double single = timeIt([&]() { FrameBinning::bin(frame.data(), binned.data(), 16, width, height, bin, bin, FrameBinning::SUM, true, 1); });
+        double multi = timeIt([&]() { FrameBinning::bin(frame.data(), binned.data(), 16, width, height, bin, bin, FrameBinning::SUM, true, 0); });
+        printf("bayer %ux%-2u %12.2f %12.2f %12.2f\n", bin, bin, legacy, single, multi);
+    }
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+/*
+ * Configuration lookups at driver startup.
+ *
+ * Usage: bench_config [properties] [lookups]
+ *
+ * Writes a configuration file with the given number of number properties of
+ * eight members each to a temporary HOME, then looks up members spread over
+ * the file the way drivers do while they start, with IUGetConfigNumber and
+ * with a reference that opens and parses the file on every call, as
+ * IUGetConfigNumber did before it kept the parsed file. Saving a single
+ * property is compared the same way.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "indibase.h"
+#include "indidriver.h"
+
+static const char *device = "Bench";
+
+static void writeConfig(const std::string &fileName, int properties)
+{
+    FILE *fp = fopen(fileName.c_str(), "w");
+    fprintf(fp, "<INDIDriver>\n");
+    for (int i = 0; i < properties; i++)
+    {
+        fprintf(fp, "<newNumberVector device='%s' name='PROPERTY_%d'>\n", device, i);
+        for (int j = 0; j < 8; j++)
+            fprintf(fp, "  <oneNumber name='MEMBER_%d'>\n      %.20g\n  </oneNumber>\n", j, i + j / 8.0);
+        fprintf(fp, "</newNumberVector>\n");
+    }
+    fprintf(fp, "</INDIDriver>\n");
+    fclose(fp);
+}
+
+// Parses the file on every call
+static int parsedNumber(const char *dev, const char *property, const char *member, double *value)
+{
+    char errmsg[MAXRBUF];
+    FILE *fp = IUGetConfigFP(nullptr, dev, "r", errmsg);
+    if (fp == nullptr)
+        return -1;
+
+    LilXML *lp = newLilXML();
+    XMLEle *root = readXMLFile(fp, lp, errmsg);
+    delLilXML(lp);
+    fclose(fp);
+    if (root == nullptr)
+        return -1;
+
+    int found = -1;
+    for (XMLEle *ep = nextXMLEle(root, 1); ep != nullptr && found; ep = nextXMLEle(root, 0))
+    {
+        if (strcmp(dev, findXMLAttValu(ep, "device")) || strcmp(property, findXMLAttValu(ep, "name")))
+            continue;
+        for (XMLEle *np = nextXMLEle(ep, 1); np != nullptr; np = nextXMLEle(ep, 0))
+            if (!strcmp(member, findXMLAttValu(np, "name")))
+            {
+                *value = atof(pcdataXMLEle(np));
+                found = 0;
+                break;
+            }
+    }
+    delXMLEle(root);
+    return found;
+}
+
+// Parses the file, edits the property and writes the file back
+static int parsedSave(const char *dev, const char *property, char *names[], char *values[], int n)
+{
+    char errmsg[MAXRBUF];
+    FILE *fp = IUGetConfigFP(nullptr, dev, "r", errmsg);
+    LilXML *lp = newLilXML();
+    XMLEle *root = readXMLFile(fp, lp, errmsg);
+    delLilXML(lp);
+    fclose(fp);
+
+    for (XMLEle *ep = nextXMLEle(root, 1); ep != nullptr; ep = nextXMLEle(root, 0))
+    {
+        if (strcmp(property, findXMLAttValu(ep, "name")))
+            continue;
+        for (XMLEle *np = nextXMLEle(ep, 1); np != nullptr; np = nextXMLEle(ep, 0))
+            for (int i = 0; i < n; i++)
+                if (!strcmp(names[i], findXMLAttValu(np, "name")))
+                    editXMLEle(np, values[i]);
+        break;
+    }
+
+    fp = IUGetConfigFP(nullptr, dev, "w", errmsg);
+    prXMLEle(fp, root, 0);
+    fclose(fp);
+    delXMLEle(root);
+    return 0;
+}
+
+typedef int (*GetNumber)(const char *dev, const char *property, const char *member, double *value);
+
+static double lookups(GetNumber getNumber, int properties, int count)
+{
+    char property[MAXINDINAME], member[MAXINDINAME];
+    double value = 0, sum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+    {
+        snprintf(property, sizeof(property), "PROPERTY_%d", int((i * 2654435761u) % properties));
+        snprintf(member, sizeof(member), "MEMBER_%d", i % 8);
+        if (getNumber(device, property, member, &value) != 0)
+            fprintf(stderr, "%s.%s not found\n", property, member);
+        sum += value;
+    }
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (sum < 0)
+        printf("%g\n", sum);
+    return elapsed;
+}
+
+typedef int (*SaveNumber)(const char *dev, const char *property, char *names[], char *values[], int n);
+
+static int cachedSave(const char *dev, const char *property, char *names[], char *values[], int n)
+{
+    char errmsg[MAXRBUF];
+    return IUUpdateConfig(nullptr, dev, "newNumberVector", property, names, values, n, errmsg);
+}
+
+static double saves(SaveNumber save, int properties, int count)
+{
+    char memberNames[8][MAXINDINAME], memberValues[8][MAXINDINAME], property[MAXINDINAME];
+    char *names[8], *values[8];
+    for (int j = 0; j < 8; j++)
+    {
+        snprintf(memberNames[j], MAXINDINAME, "MEMBER_%d", j);
+        names[j] = memberNames[j];
+        values[j] = memberValues[j];
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++)
+    {
+        snprintf(property, sizeof(property), "PROPERTY_%d", int((i * 2654435761u) % properties));
+        for (int j = 0; j < 8; j++)
+            snprintf(memberValues[j], MAXINDINAME, "      %.20g\n", i + j / 8.0);
+        if (save(device, property, names, values, 8) != 0)
+            fprintf(stderr, "%s not saved\n", property);
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    int properties = argc > 1 ? atoi(argv[1]) : 500;
+    int count = argc > 2 ? atoi(argv[2]) : 200;
+
+    char home[] = "/tmp/indi_bench_config_XXXXXX";
+    if (mkdtemp(home) == nullptr)
+    {
+        perror("mkdtemp");
+        return 1;
+    }
+    setenv("HOME", home, 1);
+    unsetenv("INDICONFIG");
+    std::string dir = std::string(home) + "/.indi";
+    mkdir(dir.c_str(), 0755);
+    std::string fileName = dir + "/" + device + "_config.xml";
+    writeConfig(fileName, properties);
+
+    struct stat st;
+    stat(fileName.c_str(), &st);
+    printf("%d properties, %ld kB, %d lookups and %d saves\n\n", properties, long(st.st_size / 1024), count, count / 10);
+
+    printf("%-10s %14s %14s\n", "config", "lookups (ms)", "saves (ms)");
+    double parsed = lookups(parsedNumber, properties, count);
+    double parsedSaves = saves(parsedSave, properties, count / 10);
+    printf("%-10s %14.2f %14.2f\n", "parsed", parsed, parsedSaves);
+    double cached = lookups(IUGetConfigNumber, properties, count);
+    double cachedSaves = saves(cachedSave, properties, count / 10);
+    printf("%-10s %14.2f %14.2f\n", "cached", cached, cachedSaves);
+
+    char errmsg[MAXRBUF];
+    IUPurgeConfig(nullptr, device, errmsg);
+    rmdir(dir.c_str());
+    rmdir(home);
+    return 0;
+}
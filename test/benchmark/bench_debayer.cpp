@@ -0,0 +1,201 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+/*
+ * Debayer throughput, in megapixels per second.
+ *
+ * Usage: bench_debayer [width height]
+ *
+ * Compares the pixel at a time loop previously behind bayer2rgb24 with ccvt_debayer, on one
+ * thread and on all cores, for 8 and 16 bit frames (default 1920x1080).
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include "stream/ccvt.h"
+
+static void legacyBayer2rgb24(unsigned char *dst, const unsigned char *src, long int WIDTH, long int HEIGHT)
+{
+    long int i;
+    const unsigned char *rawpt;
+    unsigned char *scanpt;
+    long int size;
+
+    rawpt  = src;
+    scanpt = dst;
+    size   = WIDTH * HEIGHT;
+
+    for (i = 0; i < size; i++)
+    {
+        if ((i / WIDTH) % 2 == 0)
+        {
+            if ((i % 2) == 0)
+            {
+                /* B */
+                if ((i > WIDTH) && ((i % WIDTH) > 0))
+                {
+                    *scanpt++ =
+                        (*(rawpt - WIDTH - 1) + *(rawpt - WIDTH + 1) + *(rawpt + WIDTH - 1) + *(rawpt + WIDTH + 1)) /
+                        4;                                                                               /* R */
+                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt + WIDTH) + *(rawpt - WIDTH)) / 4; /* G */
+                    *scanpt++ = *rawpt;                                                                  /* B */
+                }
+                else
+                {
+                    /* first line or left column */
+                    *scanpt++ = *(rawpt + WIDTH + 1);                  /* R */
+                    *scanpt++ = (*(rawpt + 1) + *(rawpt + WIDTH)) / 2; /* G */
+                    *scanpt++ = *rawpt;                                /* B */
+                }
+            }
+            else
+            {
+                /* (B)G */
+                if ((i > WIDTH) && ((i % WIDTH) < (WIDTH - 1)))
+                {
+                    *scanpt++ = (*(rawpt + WIDTH) + *(rawpt - WIDTH)) / 2; /* R */
+                    *scanpt++ = *rawpt;                                    /* G */
+                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* B */
+                }
+                else
+                {
+                    /* first line or right column */
+                    *scanpt++ = *(rawpt + WIDTH); /* R */
+                    *scanpt++ = *rawpt;           /* G */
+                    *scanpt++ = *(rawpt - 1);     /* B */
+                }
+            }
+        }
+        else
+        {
+            if ((i % 2) == 0)
+            {
+                /* G(R) */
+                if ((i < (WIDTH * (HEIGHT - 1))) && ((i % WIDTH) > 0))
+                {
+                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1)) / 2;         /* R */
+                    *scanpt++ = *rawpt;                                    /* G */
+                    *scanpt++ = (*(rawpt + WIDTH) + *(rawpt - WIDTH)) / 2; /* B */
+                }
+                else
+                {
+                    /* bottom line or left column */
+                    *scanpt++ = *(rawpt + 1);     /* R */
+                    *scanpt++ = *rawpt;           /* G */
+                    *scanpt++ = *(rawpt - WIDTH); /* B */
+                }
+            }
+            else
+            {
+                /* R */
+                if (i < (WIDTH * (HEIGHT - 1)) && ((i % WIDTH) < (WIDTH - 1)))
+                {
+                    *scanpt++ = *rawpt;                                                                  /* R */
+                    *scanpt++ = (*(rawpt - 1) + *(rawpt + 1) + *(rawpt - WIDTH) + *(rawpt + WIDTH)) / 4; /* G */
+                    *scanpt++ =
+                        (*(rawpt - WIDTH - 1) + *(rawpt - WIDTH + 1) + *(rawpt + WIDTH - 1) + *(rawpt + WIDTH + 1)) /
+                        4; /* B */
+                }
+                else
+                {
+                    /* bottom line or right column */
+                    *scanpt++ = *rawpt;                                /* R */
+                    *scanpt++ = (*(rawpt - 1) + *(rawpt - WIDTH)) / 2; /* G */
+                    *scanpt++ = *(rawpt - WIDTH - 1);                  /* B */
+                }
+            }
+        }
+        rawpt++;
+    }
+}
+
+static double megapixelsPerSecond(long pixels, const std::function<void()> &run)
+{
+    const int rounds = 20;
+    run();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+        run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return pixels * rounds / elapsed.count() / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+    long width = 1920, height = 1080;
+    if (argc == 3)
+    {
+        width = atol(argv[1]);
+        height = atol(argv[2]);
+    }
+    const long pixels = width * height;
+
+    std::vector<uint16_t> raw16(pixels), rgb16(pixels * 3);
+    std::vector<uint8_t> raw8(pixels), rgb8(pixels * 3);
+    uint32_t seed = 1;
+    for (long i = 0; i < pixels; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        raw16[i] = (seed >> 16) & 0xfff;
+        raw8[i] = raw16[i] >> 4;
+    }
+
+    printf("%ldx%ld frame, megapixels per second\n", width, height);
+    printf("%-32s %12s %12s\n", "", "1 thread", "all cores");
+
+    double legacy = megapixelsPerSecond(pixels, [&]() { legacyBayer2rgb24(rgb8.data(), raw8.data(), width, height); });
+    printf("%-32s %12.1f %12s\n", "previous bayer2rgb24", legacy, "-");
+
+    struct Case
+    {
+        const char *name;
+        const void *src;
+        void *dst;
+        int depth;
+        int outbits;
+        ccvt_debayer_method method;
+        ccvt_debayer_layout layout;
+    } cases[] =
+    {
+        {"8 bit bilinear to RGB24", raw8.data(), rgb8.data(), 8, 8, CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_INTERLEAVED},
+        {"8 bit bilinear to planar", raw8.data(), rgb8.data(), 8, 8, CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_PLANAR},
+        {"8 bit VNG lite to RGB24", raw8.data(), rgb8.data(), 8, 8, CCVT_DEBAYER_VNG_LITE, CCVT_DEBAYER_INTERLEAVED},
+        {"12 bit bilinear to RGB48", raw16.data(), rgb16.data(), 12, 16, CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_INTERLEAVED},
+        {"12 bit bilinear to RGB24", raw16.data(), rgb8.data(), 12, 8, CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_INTERLEAVED},
+        {"12 bit VNG lite to planar", raw16.data(), rgb16.data(), 12, 16, CCVT_DEBAYER_VNG_LITE, CCVT_DEBAYER_PLANAR},
+    };
+
+    for (const Case &c : cases)
+    {
+        double single = megapixelsPerSecond(pixels, [&]()
+        {
+            ccvt_debayer(c.dst, c.src, width, height, c.depth, c.outbits, CCVT_CFA_BGGR, c.method, c.layout, 1);
+        });
+        double multi = megapixelsPerSecond(pixels, [&]()
+        {
+            ccvt_debayer(c.dst, c.src, width, height, c.depth, c.outbits, CCVT_CFA_BGGR, c.method, c.layout, 0);
+        });
+        printf("%-32s %12.1f %12.1f\n", c.name, single, multi);
+    }
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+/*
+ * Callback dispatch in the eventloop, select() against epoll.
+ *
+ * Usage: bench_eventloop [max descriptors]
+ *
+ * For a growing number of watched pipes (default up to 4096), measures the
+ * latency from one pipe becoming readable to its callback running, with all
+ * the other pipes idle, and the throughput of callbacks when every pipe is
+ * readable. Each backend runs in its own process, as the backend is chosen
+ * once per process. select() stops at FD_SETSIZE.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "eventloop.h"
+
+struct Pipe
+{
+    int fds[2];
+    int cid;
+};
+
+static int ready;
+
+static void readOne(int fd, void *)
+{
+    char c;
+    if (read(fd, &c, 1) == 1)
+        ready++;
+}
+
+static void run(const char *backend, int maxFds)
+{
+    setenv("INDIEVENTLOOP", backend, 1);
+    printf("%s\n%8s %14s %16s\n", backend, "fds", "latency (us)", "callbacks/s");
+
+    std::vector<Pipe> pipes;
+    for (int count = 8; count <= maxFds; count *= 2)
+    {
+        while (int(pipes.size()) < count)
+        {
+            Pipe p;
+            if (pipe(p.fds) != 0)
+            {
+                perror("pipe");
+                return;
+            }
+            if (p.fds[0] >= FD_SETSIZE && strcmp(backend, "select") == 0)
+            {
+                close(p.fds[0]);
+                close(p.fds[1]);
+                return;
+            }
+            p.cid = addCallback(p.fds[0], readOne, nullptr);
+            pipes.push_back(p);
+        }
+
+        // One pipe at a time, the others idle
+        const int rounds = 20000;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; i++)
+        {
+            Pipe &p = pipes[(i * 7919) % count];
+            if (write(p.fds[1], "x", 1) != 1)
+                perror("write");
+            ready = 0;
+            deferLoop(0, &ready);
+        }
+        double latency = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / rounds;
+
+        // All pipes ready at once
+        const int bursts = std::max(1, 200000 / count);
+        int calls = 0;
+        start = std::chrono::steady_clock::now();
+        for (int b = 0; b < bursts; b++)
+        {
+            for (auto &p : pipes)
+                if (write(p.fds[1], "x", 1) != 1)
+                    perror("write");
+            for (int i = 0; i < count; i++)
+            {
+                ready = 0;
+                deferLoop(0, &ready);
+                calls++;
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        printf("%8d %14.2f %16.0f\n", count, latency, calls / seconds);
+        fflush(stdout);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int maxFds = argc > 1 ? atoi(argv[1]) : 4096;
+
+    // Two descriptors per pipe
+    struct rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = std::min<rlim_t>(limit.rlim_max, 2 * maxFds + 64);
+    setrlimit(RLIMIT_NOFILE, &limit);
+    if (int(limit.rlim_cur) < 2 * maxFds + 64)
+        maxFds = (int(limit.rlim_cur) - 64) / 2;
+
+    for (const char *backend : {"select", "epoll"})
+    {
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            run(backend, maxFds);
+            exit(0);
+        }
+        waitpid(pid, nullptr, 0);
+        printf("\n");
+    }
+    return 0;
+}
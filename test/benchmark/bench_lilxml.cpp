@@ -0,0 +1,158 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+/*
+ * Parse throughput of lilxml.
+ *
+ * Usage: bench_lilxml [recorded traffic file]
+ *
+ * Compares the one char at a time parser (readXMLEle) with the chunk parser
+ * (parseXMLChunk) used by indiserver and clients. Without a file, a synthetic
+ * mix of number, text, switch and BLOB vectors is used.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "lilxml.h"
+
+static std::string syntheticTraffic()
+{
+    std::string result;
+    char line[512];
+
+    for (int i = 0; i < 2000; i++)
+    {
+        snprintf(line, sizeof(line),
+                 "<setNumberVector device='Telescope Simulator' name='EQUATORIAL_EOD_COORD' state='Busy' timeout='60' timestamp='2024-01-01T00:00:%02d'>\n"
+                 "    <oneNumber name='RA'>\n      %.6f\n    </oneNumber>\n"
+                 "    <oneNumber name='DEC'>\n      %.6f\n    </oneNumber>\n"
+                 "</setNumberVector>\n", i % 60, 12.0 + i * 1e-4, -45.0 + i * 1e-4);
+        result += line;
+
+        if (i % 10 == 0)
+        {
+            result += "<setSwitchVector device='CCD Simulator' name='CCD_FRAME_TYPE' state='Ok' timeout='60'>\n"
+                      "    <oneSwitch name='FRAME_LIGHT'>\n      On\n    </oneSwitch>\n"
+                      "    <oneSwitch name='FRAME_BIAS'>\n      Off\n    </oneSwitch>\n"
+                      "</setSwitchVector>\n"
+                      "<message device='CCD Simulator' timestamp='2024-01-01T00:00:00' message='Exposure &amp; download done'/>\n";
+        }
+
+        if (i % 200 == 0)
+        {
+            // 48 KiB of base64
+            result += "<setBLOBVector device='CCD Simulator' name='CCD1' state='Ok' timeout='60'>\n"
+                      "  <oneBLOB name='CCD1' size='36864' format='.fits' len='49152'>\n";
+            for (int l = 0; l < 49152 / 72; l++)
+            {
+                for (int c = 0; c < 72; c++)
+                    result += "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[(l * 7 + c) % 64];
+                result += '\n';
+            }
+            result += "  </oneBLOB>\n</setBLOBVector>\n";
+        }
+    }
+    return result;
+}
+
+static std::string readFile(const char *path)
+{
+    std::string result;
+    FILE *fp = fopen(path, "rb");
+    if (!fp)
+    {
+        perror(path);
+        exit(1);
+    }
+    char buf[65536];
+    size_t rd;
+    while ((rd = fread(buf, 1, sizeof(buf), fp)) > 0)
+        result.append(buf, rd);
+    fclose(fp);
+    return result;
+}
+
+static long parseByChar(const std::string &data)
+{
+    LilXML *lp = newLilXML();
+    char ynot[1024];
+    long count = 0;
+
+    for (char c : data)
+    {
+        XMLEle *root = readXMLEle(lp, c, ynot);
+        if (root)
+        {
+            count++;
+            delXMLEle(root);
+        }
+    }
+    delLilXML(lp);
+    return count;
+}
+
+static long parseByChunk(std::string &data)
+{
+    // Same read size as indiserver
+    const size_t chunkSize = 49152;
+    LilXML *lp = newLilXML();
+    char ynot[1024];
+    long count = 0;
+
+    for (size_t offset = 0; offset < data.size(); offset += chunkSize)
+    {
+        size_t len = std::min(chunkSize, data.size() - offset);
+        XMLEle **nodes = parseXMLChunk(lp, &data[offset], int(len), ynot);
+        for (XMLEle **it = nodes; *it; ++it)
+        {
+            count++;
+            delXMLEle(*it);
+        }
+        free(nodes);
+    }
+    delLilXML(lp);
+    return count;
+}
+
+template <class F>
+static void run(const char *name, std::string &data, F parse)
+{
+    const int rounds = 5;
+    long count = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++)
+        count = parse(data);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double mb = double(data.size()) * rounds / (1024 * 1024);
+    printf("%-16s %8.1f MB/s %12.0f messages/s (%ld messages)\n",
+           name, mb / elapsed.count(), count * rounds / elapsed.count(), count);
+}
+
+int main(int argc, char **argv)
+{
+    std::string data = argc > 1 ? readFile(argv[1]) : syntheticTraffic();
+
+    printf("%zu bytes of traffic\n", data.size());
+    run("readXMLEle", data, parseByChar);
+    run("parseXMLChunk", data, parseByChunk);
+    return 0;
+}
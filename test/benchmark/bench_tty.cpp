@@ -0,0 +1,133 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+/*
+ * Command and response round trips over a pseudo terminal.
+ *
+ * Usage: bench_tty [round trips]
+ *
+ * A child process plays an LX200 style mount: for every command it receives,
+ * it answers with one or two '#' terminated sections. The driver side reads
+ * the answers with tty_nread_section, one select() and read() per character
+ * by default, then with the port set with tty_set_buffered. Read system calls
+ * are counted from /proc/thread-self/io; each read follows one select(), and
+ * a buffered section read also checks the port with one fstat(). A
+ * pseudo terminal delivers a response at once, a real serial port at a slow
+ * bit rate spreads it over several reads.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "indicom.h"
+
+static const char *responses[] = { "12:34:56#", "+45*12'34#", "12:34:56#+45*12'34#" };
+
+static void device(int fd)
+{
+    char command;
+    while (read(fd, &command, 1) == 1)
+    {
+        const char *response = responses[command - '0'];
+        if (write(fd, response, strlen(response)) < 0)
+            break;
+    }
+    exit(0);
+}
+
+static long readCalls()
+{
+    FILE *io = fopen("/proc/thread-self/io", "r");
+    char line[64];
+    long calls = -1;
+    while (io && fgets(line, sizeof(line), io))
+        if (sscanf(line, "syscr: %ld", &calls) == 1)
+            break;
+    if (io)
+        fclose(io);
+    return calls;
+}
+
+static void run(const char *name, int port, int rounds)
+{
+    char response[64];
+    int nbytes = 0;
+
+    for (int sections = 1; sections <= 2; sections++)
+    {
+        const char command = sections == 1 ? '0' : '2';
+        long calls = readCalls();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; i++)
+        {
+            if (write(port, &command, 1) != 1)
+                perror("write");
+            for (int s = 0; s < sections; s++)
+                if (tty_nread_section(port, response, sizeof(response), '#', 1, &nbytes) != TTY_OK)
+                {
+                    fprintf(stderr, "%s: read failed\n", name);
+                    return;
+                }
+        }
+        double latency = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / rounds;
+        double reads = double(readCalls() - calls) / rounds;
+
+        printf("%-14s %9d %16.2f %14.1f\n", name, sections, latency, reads);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 20000;
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+    {
+        perror("posix_openpt");
+        return 1;
+    }
+    int port = open(ptsname(master), O_RDWR | O_NOCTTY);
+    struct termios raw;
+    tcgetattr(port, &raw);
+    cfmakeraw(&raw);
+    tcsetattr(port, TCSANOW, &raw);
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        close(port);
+        device(master);
+    }
+    close(master);
+
+    printf("%-14s %9s %16s %14s\n", "reader", "sections", "round trip (us)", "read()/trip");
+    run("per character", port, rounds);
+    tty_set_buffered(port, 1);
+    run("buffered", port, rounds);
+
+    kill(pid, SIGTERM);
+    waitpid(pid, nullptr, 0);
+    close(port);
+    return 0;
+}
@@ -21,8 +21,14 @@
 #include "config.h"
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include "base64.h"
 
@@ -115,3 +121,169 @@ TEST(CORE_BASE64, Test_from64tobits_fast_with_bug_time)
     }
 }
 
+
+TEST(CORE_BASE64, Test_from64tobits_stream)
+{
+    // Every length modulo 3, with line breaks every 72 chars like INDI BLOBs
+    for (int len : {1, 2, 3, 53, 54, 55, 1000})
+    {
+        std::vector<unsigned char> raw(len);
+        for (int i = 0; i < len; i++)
+            raw[i] = (unsigned char)(i * 37 + len);
+
+        std::vector<char> b64(4 * len / 3 + 4);
+        int b64len = to64frombits_s(reinterpret_cast<unsigned char *>(b64.data()), raw.data(), len, b64.size());
+        std::string text;
+        for (int i = 0; i < b64len; i += 72)
+            text += std::string(b64.data() + i, std::min(72, b64len - i)) + "\n";
+
+        for (size_t piece : {1, 3, 4, 7, 73, 4096})
+        {
+            base64_stream st;
+            std::vector<char> out(len + 3);
+            int outlen = 0;
+
+            from64tobits_begin(&st);
+            for (size_t i = 0; i < text.size(); i += piece)
+            {
+                int n = int(std::min(piece, text.size() - i));
+                outlen += from64tobits_stream(&st, out.data() + outlen, text.data() + i, n);
+            }
+            outlen += from64tobits_end(&st, out.data() + outlen);
+
+            ASSERT_EQ(outlen, len) << "piece " << piece;
+            ASSERT_EQ(memcmp(out.data(), raw.data(), len), 0) << "piece " << piece;
+        }
+    }
+}
+
+// Plain reference implementation, for the equivalence tests below
+static std::string referenceEncode(const std::vector<unsigned char> &raw)
+{
+    static const char digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string result;
+    size_t i = 0;
+    for (; i + 2 < raw.size(); i += 3)
+    {
+        uint32_t n = raw[i] << 16 | raw[i + 1] << 8 | raw[i + 2];
+        result += digits[n >> 18];
+        result += digits[(n >> 12) & 63];
+        result += digits[(n >> 6) & 63];
+        result += digits[n & 63];
+    }
+    if (i < raw.size())
+    {
+        uint32_t n = raw[i] << 16 | (i + 1 < raw.size() ? raw[i + 1] << 8 : 0);
+        result += digits[n >> 18];
+        result += digits[(n >> 12) & 63];
+        result += i + 1 < raw.size() ? digits[(n >> 6) & 63] : '=';
+        result += '=';
+    }
+    return result;
+}
+
+static std::vector<int> availableIsas()
+{
+    std::vector<int> result;
+    for (int isa : {BASE64_SCALAR, BASE64_SSSE3, BASE64_AVX2, BASE64_AVX512})
+        if (base64_select_isa(isa) == isa)
+            result.push_back(isa);
+    base64_select_isa(BASE64_AVX512);
+    return result;
+}
+
+TEST(CORE_BASE64, Test_simd_equivalence)
+{
+    srand(42);
+    for (int isa : availableIsas())
+    {
+        base64_select_isa(isa);
+        for (int round = 0; round < 2000; round++)
+        {
+            int len = round < 300 ? round + 1 : rand() % 20000 + 1;
+            std::vector<unsigned char> raw(len);
+            for (auto &c : raw)
+                c = (unsigned char)rand();
+
+            // encode
+            std::string expected = referenceEncode(raw);
+            std::vector<char> b64(4 * len / 3 + 4);
+            int b64len = to64frombits_s(reinterpret_cast<unsigned char *>(b64.data()), raw.data(), len, b64.size());
+            ASSERT_EQ(b64len, int(expected.size())) << "isa " << isa << " len " << len;
+            ASSERT_EQ(std::string(b64.data()), expected) << "isa " << isa << " len " << len;
+
+            // decode, with line breaks every 72 chars like INDI BLOBs
+            std::string text;
+            for (int i = 0; i < b64len; i += 72)
+                text += expected.substr(i, 72) + "\n";
+            std::vector<char> out(3 * b64len / 4);
+            int outlen = from64tobits_fast(out.data(), text.c_str(), b64len);
+            ASSERT_EQ(outlen, len) << "isa " << isa << " len " << len;
+            ASSERT_EQ(memcmp(out.data(), raw.data(), len), 0) << "isa " << isa << " len " << len;
+        }
+    }
+    base64_select_isa(BASE64_AVX512);
+}
+
+// Garbage is not validated: all instruction sets must still give the same bytes
+TEST(CORE_BASE64, Test_simd_garbage)
+{
+    srand(7);
+    for (int round = 0; round < 500; round++)
+    {
+        int len = (rand() % 500 + 2) * 4;
+        std::string text(len, 'A');
+        for (auto &c : text)
+            c = (rand() % 8) ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[rand() % 64] : (char)(rand() % 256);
+        // line breaks make the decoder read past inlen
+        std::replace(text.begin(), text.end(), '\n', '#');
+
+        std::vector<char> expected(3 * len / 4);
+        base64_select_isa(BASE64_SCALAR);
+        int expectedLen = from64tobits_fast(expected.data(), text.c_str(), len);
+
+        for (int isa : availableIsas())
+        {
+            base64_select_isa(isa);
+            std::vector<char> out(3 * len / 4);
+            ASSERT_EQ(from64tobits_fast(out.data(), text.c_str(), len), expectedLen);
+            ASSERT_EQ(out, expected) << "isa " << isa;
+        }
+    }
+    base64_select_isa(BASE64_AVX512);
+}
+
+TEST(CORE_BASE64, Test_simd_throughput)
+{
+    const int len = 16 * 1024 * 1024, rounds = 4;
+    std::vector<unsigned char> raw(len);
+    for (int i = 0; i < len; i++)
+        raw[i] = (unsigned char)(i * 2654435761u >> 13);
+
+    std::vector<unsigned char> b64(4 * len / 3 + 4);
+    int b64len = to64frombits_s(b64.data(), raw.data(), len, b64.size());
+    std::string text;
+    for (int i = 0; i < b64len; i += 72)
+        text += std::string(reinterpret_cast<char *>(b64.data()) + i, std::min(72, b64len - i)) + "\n";
+    std::vector<char> out(len + 3);
+
+    for (int isa : availableIsas())
+    {
+        base64_select_isa(isa);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; i++)
+            to64frombits_s(b64.data(), raw.data(), len, b64.size());
+        std::chrono::duration<double> encode = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < rounds; i++)
+            from64tobits_fast(out.data(), text.c_str(), b64len);
+        std::chrono::duration<double> decode = std::chrono::steady_clock::now() - start;
+
+        printf("isa %d: encode %.0f MB/s, decode %.0f MB/s\n", isa,
+               rounds * len / encode.count() / 1e6, rounds * len / decode.count() / 1e6);
+        ASSERT_EQ(memcmp(out.data(), raw.data(), len), 0);
+    }
+    base64_select_isa(BASE64_AVX512);
+}
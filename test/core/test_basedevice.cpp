@@ -0,0 +1,142 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+// Property lookups by name as properties are defined and deleted
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "basedevice.h"
+#include "indibase.h"
+#include "parentdevice.h"
+#include "indipropertynumber.h"
+#include "indipropertyswitch.h"
+#include "indipropertytext.h"
+
+static INDI::PropertyNumber number(const std::string &name)
+{
+    INDI::PropertyNumber property {1};
+    property.setName(name);
+    property[0].setName("VALUE");
+    return property;
+}
+
+TEST(BaseDevice, FindsPropertiesByName)
+{
+    INDI::ParentDevice device(INDI::ParentDevice::Valid);
+    device.setDeviceName("Device");
+
+    for (int i = 0; i < 200; i++)
+        device.registerProperty(number("NUMBER_" + std::to_string(i)));
+
+    INDI::PropertyText text {1};
+    text.setName("NAME");
+    device.registerProperty(text);
+
+    for (int i = 0; i < 200; i++)
+    {
+        std::string name = "NUMBER_" + std::to_string(i);
+        auto property = device.getNumber(name.c_str());
+        ASSERT_TRUE(property.isValid()) << name;
+        EXPECT_STREQ(property.getName(), name.c_str());
+    }
+
+    EXPECT_TRUE(device.getText("NAME").isValid());
+    EXPECT_TRUE(device.getProperty("NAME").isValid());
+    // Of another type, or not defined
+    EXPECT_FALSE(device.getSwitch("NAME").isValid());
+    EXPECT_FALSE(device.getNumber("NUMBER_200").isValid());
+    EXPECT_FALSE(device.getNumber("").isValid());
+    EXPECT_EQ(device.getProperties().size(), 201u);
+}
+
+TEST(BaseDevice, SameNameOfAnotherType)
+{
+    INDI::ParentDevice device(INDI::ParentDevice::Valid);
+
+    INDI::PropertySwitch onOff {2};
+    onOff.setName("POWER");
+    device.registerProperty(number("POWER"));
+    device.registerProperty(onOff);
+
+    EXPECT_EQ(device.getProperty("POWER").getType(), INDI_NUMBER);
+    EXPECT_TRUE(device.getNumber("POWER").isValid());
+    EXPECT_TRUE(device.getSwitch("POWER").isValid());
+
+    // Both go
+    char errmsg[MAXRBUF];
+    EXPECT_EQ(device.removeProperty("POWER", errmsg), 0);
+    EXPECT_FALSE(device.getProperty("POWER").isValid());
+    EXPECT_EQ(device.getProperties().size(), 0u);
+}
+
+TEST(BaseDevice, DeletedAndDefinedAgain)
+{
+    INDI::ParentDevice device(INDI::ParentDevice::Valid);
+    char errmsg[MAXRBUF];
+
+    auto first = number("POSITION");
+    device.registerProperty(first);
+    device.registerProperty(number("SPEED"));
+    EXPECT_EQ(device.removeProperty("POSITION", errmsg), 0);
+    EXPECT_FALSE(device.getNumber("POSITION").isValid());
+    EXPECT_TRUE(device.getNumber("SPEED").isValid());
+    EXPECT_NE(device.removeProperty("POSITION", errmsg), 0);
+
+    auto second = number("POSITION");
+    device.registerProperty(second);
+    EXPECT_EQ(device.getNumber("POSITION").getProperty(), second.getProperty());
+
+    // Defining a registered property again finds the one already there
+    device.registerProperty(number("POSITION"));
+    EXPECT_EQ(device.getProperties().size(), 2u);
+
+    // Unregistered properties are skipped
+    second.setRegistered(false);
+    EXPECT_FALSE(device.getNumber("POSITION").isValid());
+}
+
+TEST(BaseDevice, ConcurrentLookups)
+{
+    INDI::ParentDevice device(INDI::ParentDevice::Valid);
+    for (int i = 0; i < 50; i++)
+        device.registerProperty(number("NUMBER_" + std::to_string(i)));
+
+    std::vector<std::thread> readers;
+    std::vector<int> found(4, 0);
+    for (int t = 0; t < 4; t++)
+        readers.emplace_back([&device, &found, t]
+    {
+        for (int i = 0; i < 10000; i++)
+            found[t] += device.getNumber(("NUMBER_" + std::to_string(i % 50)).c_str()).isValid();
+    });
+
+    // While another thread defines and deletes
+    char errmsg[MAXRBUF];
+    for (int i = 0; i < 1000; i++)
+    {
+        device.registerProperty(number("EXTRA"));
+        device.removeProperty("EXTRA", errmsg);
+    }
+
+    for (auto &reader : readers)
+        reader.join();
+    for (int t = 0; t < 4; t++)
+        EXPECT_EQ(found[t], 10000);
+}
@@ -0,0 +1,265 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+// The configuration functions, against a configuration file in a temporary HOME
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <dirent.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "indibase.h"
+#include "indidriver.h"
+
+static const char *config =
+    "<INDIDriver>\n"
+    "<newSwitchVector device='Dev' name='MODE'>\n"
+    "  <oneSwitch name='SLOW'>\n      Off\n  </oneSwitch>\n"
+    "  <oneSwitch name='FAST'>\n      On\n  </oneSwitch>\n"
+    "</newSwitchVector>\n"
+    "<newNumberVector device='Other' name='POSITION'>\n"
+    "  <oneNumber name='X'>\n      -1\n  </oneNumber>\n"
+    "</newNumberVector>\n"
+    "<newNumberVector device='Dev' name='POSITION'>\n"
+    "  <oneNumber name='X'>\n      1.5\n  </oneNumber>\n"
+    "  <oneNumber name='Y'>\n      -2\n  </oneNumber>\n"
+    "</newNumberVector>\n"
+    "<newTextVector device='Dev' name='PORT'>\n"
+    "  <oneText name='PATH'>\n      /dev/ttyUSB0\n  </oneText>\n"
+    "</newTextVector>\n"
+    "<newNumberVector device='Dev' name='POSITION'>\n"
+    "  <oneNumber name='X'>\n      99\n  </oneNumber>\n"
+    "</newNumberVector>\n"
+    "</INDIDriver>\n";
+
+class Config : public ::testing::Test
+{
+    protected:
+        void SetUp() override
+        {
+            char dir[] = "/tmp/indi_config_XXXXXX";
+            ASSERT_NE(mkdtemp(dir), nullptr);
+            home = dir;
+            setenv("HOME", dir, 1);
+            unsetenv("INDICONFIG");
+            mkdir((home + "/.indi").c_str(), 0755);
+            fileName = home + "/.indi/Dev_config.xml";
+            write(config);
+        }
+
+        void TearDown() override
+        {
+            DIR *dir = opendir((home + "/.indi").c_str());
+            while (struct dirent *entry = dir ? readdir(dir) : nullptr)
+                if (entry->d_name[0] != '.')
+                    remove((home + "/.indi/" + entry->d_name).c_str());
+            if (dir)
+                closedir(dir);
+            rmdir((home + "/.indi").c_str());
+            rmdir(home.c_str());
+        }
+
+        // A new file replacing the configuration, as another program would
+        void write(const std::string &contents)
+        {
+            std::string temp = fileName + ".new";
+            std::ofstream(temp) << contents;
+            ASSERT_EQ(rename(temp.c_str(), fileName.c_str()), 0);
+        }
+
+        std::string read()
+        {
+            std::ostringstream contents;
+            contents << std::ifstream(fileName).rdbuf();
+            return contents.str();
+        }
+
+        int files()
+        {
+            int count = 0;
+            DIR *dir = opendir((home + "/.indi").c_str());
+            while (struct dirent *entry = dir ? readdir(dir) : nullptr)
+                count += entry->d_name[0] != '.';
+            if (dir)
+                closedir(dir);
+            return count;
+        }
+
+        std::string home;
+        std::string fileName;
+};
+
+TEST_F(Config, Lookups)
+{
+    double value = 0;
+    EXPECT_EQ(IUGetConfigNumber("Dev", "POSITION", "X", &value), 0);
+    // The first of duplicate properties, of the right device
+    EXPECT_EQ(value, 1.5);
+    EXPECT_EQ(IUGetConfigNumber("Dev", "POSITION", "Y", &value), 0);
+    EXPECT_EQ(value, -2);
+    EXPECT_EQ(IUGetConfigNumber("Dev", "POSITION", "Z", &value), -1);
+    EXPECT_EQ(IUGetConfigNumber("Dev", "SPEED", "X", &value), -1);
+
+    ISState state = ISS_ON;
+    EXPECT_EQ(IUGetConfigSwitch("Dev", "MODE", "SLOW", &state), 0);
+    EXPECT_EQ(state, ISS_OFF);
+    EXPECT_EQ(IUGetConfigSwitch("Dev", "MODE", "FAST", &state), 0);
+    EXPECT_EQ(state, ISS_ON);
+
+    int index = -1;
+    EXPECT_EQ(IUGetConfigOnSwitchIndex("Dev", "MODE", &index), 0);
+    EXPECT_EQ(index, 1);
+
+    char name[MAXINDINAME] = {0};
+    EXPECT_EQ(IUGetConfigOnSwitchName("Dev", "MODE", name, sizeof(name)), 0);
+    EXPECT_STREQ(name, "FAST");
+
+    char text[MAXINDINAME] = {0};
+    EXPECT_EQ(IUGetConfigText("Dev", "PORT", "PATH", text, sizeof(text)), 0);
+    EXPECT_STREQ(text, "/dev/ttyUSB0");
+
+    // Another device has its own file
+    EXPECT_EQ(IUGetConfigNumber("Other", "POSITION", "X", &value), -1);
+}
+
+TEST_F(Config, ChangedFilesAreParsedAgain)
+{
+    double value = 0;
+    EXPECT_EQ(IUGetConfigNumber("Dev", "POSITION", "X", &value), 0);
+    EXPECT_EQ(value, 1.5);
+
+    std::string changed = config;
+    changed.replace(changed.find("1.5"), 3, "2.5");
+    write(changed);
+    EXPECT_EQ(IUGetConfigNumber("Dev", "POSITION", "X", &value), 0);
+    EXPECT_EQ(value, 2.5);
+
+    remove(fileName.c_str());
+    EXPECT_EQ(IUGetConfigNumber("Dev", "POSITION", "X", &value), -1);
+
+    write(config);
+    EXPECT_EQ(IUGetConfigNumber("Dev", "POSITION", "X", &value), 0);
+    EXPECT_EQ(value, 1.5);
+
+    char errmsg[MAXRBUF];
+    EXPECT_EQ(IUPurgeConfig(nullptr, "Dev", errmsg), 0);
+    EXPECT_EQ(IUGetConfigNumber("Dev", "POSITION", "X", &value), -1);
+}
+
+TEST_F(Config, UpdatesOneProperty)
+{
+    char errmsg[MAXRBUF] = {0};
+    char x[] = "X", y[] = "Y";
+    char newX[] = "      3.25\n", newY[] = "      4\n";
+    char *names[] = {x, y};
+    char *values[] = {newX, newY};
+
+    struct stat before, after;
+    ASSERT_EQ(stat(fileName.c_str(), &before), 0);
+    ASSERT_EQ(IUUpdateConfig(nullptr, "Dev", "newNumberVector", "POSITION", names, values, 2, errmsg), 0) << errmsg;
+    ASSERT_EQ(stat(fileName.c_str(), &after), 0);
+
+    // Replaced by a complete file, nothing left behind
+    EXPECT_NE(before.st_ino, after.st_ino);
+    EXPECT_EQ(files(), 1);
+
+    double value = 0;
+    EXPECT_EQ(IUGetConfigNumber("Dev", "POSITION", "X", &value), 0);
+    EXPECT_EQ(value, 3.25);
+
+    // And in the file, with the rest of it
+    std::string contents = read();
+    EXPECT_NE(contents.find("3.25"), std::string::npos);
+    EXPECT_NE(contents.find("/dev/ttyUSB0"), std::string::npos);
+    EXPECT_NE(contents.find("99"), std::string::npos);
+    EXPECT_EQ(contents.find("1.5"), std::string::npos);
+
+    // Members saved but not given change nothing
+    EXPECT_EQ(IUUpdateConfig(nullptr, "Dev", "newNumberVector", "POSITION", names, values, 1, errmsg), -1);
+    EXPECT_EQ(read(), contents);
+
+    // Properties not saved yet, or saved as another type, need the whole configuration saved
+    EXPECT_EQ(IUUpdateConfig(nullptr, "Dev", "newNumberVector", "SPEED", names, values, 2, errmsg), 1);
+    EXPECT_EQ(IUUpdateConfig(nullptr, "Dev", "newSwitchVector", "POSITION", names, values, 2, errmsg), 1);
+    EXPECT_EQ(read(), contents);
+
+    remove(fileName.c_str());
+    EXPECT_EQ(IUUpdateConfig(nullptr, "Dev", "newNumberVector", "POSITION", names, values, 2, errmsg), 1);
+}
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+// The configuration kept in memory stays the same size however often a property is saved
+TEST_F(Config, RepeatedUpdatesDoNotGrow)
+{
+    char errmsg[MAXRBUF] = {0};
+    char x[] = "X", y[] = "Y";
+    char newX[64], newY[64];
+    char *names[] = {x, y};
+    char *values[] = {newX, newY};
+
+    auto update = [&](int i)
+    {
+        snprintf(newX, sizeof(newX), "      %.20g\n", i * 0.1);
+        snprintf(newY, sizeof(newY), "      %.20g\n", -i * 0.1);
+        return IUUpdateConfig(nullptr, "Dev", "newNumberVector", "POSITION", names, values, 2, errmsg);
+    };
+
+    for (int i = 0; i < 100; i++)
+        ASSERT_EQ(update(i), 0) << errmsg;
+    size_t used = mallinfo2().uordblks;
+    for (int i = 0; i < 2000; i++)
+        ASSERT_EQ(update(i), 0) << errmsg;
+    EXPECT_LT(mallinfo2().uordblks, used + 4096);
+
+    double value = 0;
+    EXPECT_EQ(IUGetConfigNumber("Dev", "POSITION", "X", &value), 0);
+    EXPECT_EQ(value, 1999 * 0.1);
+}
+#endif
+
+TEST_F(Config, WritesAreCommittedAtOnce)
+{
+    char errmsg[MAXRBUF] = {0};
+    FILE *fp = IUGetConfigWriteFP(nullptr, "Dev", errmsg);
+    ASSERT_NE(fp, nullptr) << errmsg;
+
+    fputs("<INDIDriver>\n<newTextVector device='Dev' name='PORT'>\n", fp);
+    fflush(fp);
+    // Still the previous file until committed
+    EXPECT_EQ(read(), config);
+    char text[MAXINDINAME] = {0};
+    EXPECT_EQ(IUGetConfigText("Dev", "PORT", "PATH", text, sizeof(text)), 0);
+    EXPECT_STREQ(text, "/dev/ttyUSB0");
+
+    fputs("  <oneText name='PATH'>\n      /dev/ttyACM0\n  </oneText>\n</newTextVector>\n</INDIDriver>\n", fp);
+    ASSERT_EQ(IUCommitConfig(fp, nullptr, "Dev", errmsg), 0) << errmsg;
+    EXPECT_EQ(files(), 1);
+
+    EXPECT_EQ(IUGetConfigText("Dev", "PORT", "PATH", text, sizeof(text)), 0);
+    EXPECT_STREQ(text, "/dev/ttyACM0");
+    double value = 0;
+    EXPECT_EQ(IUGetConfigNumber("Dev", "POSITION", "X", &value), -1);
+}
@@ -0,0 +1,375 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+// Runs with the default backend, and again with INDIEVENTLOOP=select
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <unistd.h>
+
+#include "eventloop.h"
+
+struct Pipe
+{
+    int fds[2];
+
+    Pipe()
+    {
+        if (pipe(fds) != 0)
+            perror("pipe");
+    }
+    ~Pipe()
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+    void send(int n = 1)
+    {
+        for (int i = 0; i < n; i++)
+            if (write(fds[1], "x", 1) != 1)
+                perror("write");
+    }
+};
+
+struct Reader
+{
+    int id {-1};
+    int calls {0};
+    int *done {nullptr};
+    std::vector<int> *order {nullptr};
+};
+
+static void readOne(int fd, void *ud)
+{
+    Reader *reader = static_cast<Reader *>(ud);
+    char c;
+    if (read(fd, &c, 1) != 1)
+        perror("read");
+    reader->calls++;
+    if (reader->order)
+        reader->order->push_back(reader->id);
+    if (reader->done)
+        *reader->done = 1;
+}
+
+static void countCall(int, void *ud)
+{
+    (*static_cast<int *>(ud))++;
+}
+
+// Runs the loop until one callback ran, or ms passed. Returns false on time out.
+static bool runOnce(int &done, int ms = 1000)
+{
+    done = 0;
+    return deferLoop(ms, &done) == 0;
+}
+
+TEST(EventLoop, ReadyCallbacksTakeTurns)
+{
+    Pipe pipes[3];
+    Reader readers[3];
+    std::vector<int> order;
+    int done = 0;
+
+    for (int i = 0; i < 3; i++)
+    {
+        readers[i].order = &order;
+        readers[i].done = &done;
+        readers[i].id = addCallback(pipes[i].fds[0], readOne, &readers[i]);
+        pipes[i].send(2);
+    }
+
+    for (int i = 0; i < 6; i++)
+        ASSERT_TRUE(runOnce(done));
+
+    ASSERT_EQ(order.size(), 6u);
+    EXPECT_NE(order[0], order[1]);
+    EXPECT_NE(order[1], order[2]);
+    EXPECT_NE(order[0], order[2]);
+    for (int i = 0; i < 3; i++)
+        EXPECT_EQ(order[i], order[i + 3]);
+
+    for (auto &reader : readers)
+        rmCallback(reader.id);
+}
+
+TEST(EventLoop, RemovedCallbacksAreNotCalled)
+{
+    Pipe p;
+    Reader reader;
+    int done = 0;
+    reader.done = &done;
+
+    int cid = addCallback(p.fds[0], readOne, &reader);
+    p.send();
+    rmCallback(cid);
+
+    EXPECT_FALSE(runOnce(done, 50));
+    EXPECT_EQ(reader.calls, 0);
+
+    // The id is reused, for the new callback only
+    Reader other;
+    other.done = &done;
+    EXPECT_EQ(addCallback(p.fds[0], readOne, &other), cid);
+    EXPECT_TRUE(runOnce(done));
+    EXPECT_EQ(other.calls, 1);
+    EXPECT_EQ(reader.calls, 0);
+    rmCallback(cid);
+}
+
+TEST(EventLoop, SameDescriptorTwice)
+{
+    Pipe p;
+    Reader a, b;
+    int done = 0;
+    a.done = b.done = &done;
+
+    int first = addCallback(p.fds[0], readOne, &a);
+    int second = addCallback(p.fds[0], readOne, &b);
+    p.send(4);
+    for (int i = 0; i < 4; i++)
+        ASSERT_TRUE(runOnce(done));
+    EXPECT_EQ(a.calls, 2);
+    EXPECT_EQ(b.calls, 2);
+
+    // Removing one leaves the other watching
+    rmCallback(first);
+    p.send();
+    ASSERT_TRUE(runOnce(done));
+    EXPECT_EQ(b.calls, 3);
+    rmCallback(second);
+}
+
+TEST(EventLoop, DescriptorClosedBeforeRemoval)
+{
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    // Held elsewhere, as by a child process
+    int held = dup(fds[0]);
+
+    int calls = 0;
+    int cid = addCallback(fds[0], countCall, &calls);
+    close(fds[0]);
+    rmCallback(cid);
+    ASSERT_EQ(write(fds[1], "x", 1), 1);
+
+    Pipe p;
+    Reader reader;
+    int done = 0;
+    reader.done = &done;
+    int other = addCallback(p.fds[0], readOne, &reader);
+    p.send();
+    EXPECT_TRUE(runOnce(done));
+    EXPECT_EQ(reader.calls, 1);
+    EXPECT_FALSE(runOnce(done, 50));
+    EXPECT_EQ(calls, 0);
+
+    rmCallback(other);
+    close(held);
+    close(fds[1]);
+}
+
+TEST(EventLoop, RegularFilesAreAlwaysReady)
+{
+    char name[] = "/tmp/indi_eventloop_XXXXXX";
+    int fd = mkstemp(name);
+    ASSERT_GE(fd, 0);
+    unlink(name);
+
+    int calls = 0;
+    int cid = addCallback(fd, countCall, &calls);
+    int done = 0;
+    // countCall does not set done, the loop runs until the time out
+    runOnce(done, 20);
+    EXPECT_GT(calls, 0);
+    rmCallback(cid);
+    close(fd);
+}
+
+TEST(EventLoop, DescriptorsAboveSelectLimit)
+{
+    const char *backend = getenv("INDIEVENTLOOP");
+    if (backend && strcmp(backend, "select") == 0)
+        GTEST_SKIP() << "select() is limited to FD_SETSIZE";
+
+    struct rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+    if (limit.rlim_cur < FD_SETSIZE + 16)
+    {
+        limit.rlim_cur = std::min<rlim_t>(limit.rlim_max, FD_SETSIZE + 16);
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+    int fd = fcntl(0, F_DUPFD, FD_SETSIZE + 4);
+    if (fd < 0)
+        GTEST_SKIP() << "no descriptors above FD_SETSIZE";
+    close(fd);
+
+    Pipe p;
+    int high = fcntl(p.fds[0], F_DUPFD, FD_SETSIZE + 4);
+    Reader reader;
+    int done = 0;
+    reader.done = &done;
+    int cid = addCallback(high, readOne, &reader);
+    p.send();
+    EXPECT_TRUE(runOnce(done));
+    EXPECT_EQ(reader.calls, 1);
+    rmCallback(cid);
+    close(high);
+}
+
+struct Timed
+{
+    int id {-1};
+    int calls {0};
+    int *done {nullptr};
+    std::vector<int> *order {nullptr};
+    int removes {-1};
+};
+
+static void timedOut(void *ud)
+{
+    Timed *timed = static_cast<Timed *>(ud);
+    timed->calls++;
+    if (timed->order)
+        timed->order->push_back(timed->id);
+    if (timed->removes != -1)
+        rmTimer(timed->removes);
+    if (timed->done)
+        *timed->done = 1;
+}
+
+TEST(EventLoop, TimersRunInTimeOrder)
+{
+    const int delays[] = {30, 10, 20, 10, 0, 10};
+    Timed timers[6];
+    std::vector<int> order;
+    int done = 0;
+
+    for (int i = 0; i < 6; i++)
+    {
+        timers[i].order = &order;
+        timers[i].done = &done;
+        timers[i].id = addTimer(delays[i], timedOut, &timers[i]);
+    }
+    for (int i = 0; i < 6; i++)
+        ASSERT_TRUE(runOnce(done));
+
+    // Timers due at once run in the order they were added
+    std::vector<int> expected = {timers[4].id, timers[1].id, timers[3].id, timers[5].id, timers[2].id, timers[0].id};
+    EXPECT_EQ(order, expected);
+
+    // Gone once they ran
+    for (auto &timer : timers)
+        EXPECT_EQ(remainingTimer(timer.id), -1);
+}
+
+TEST(EventLoop, RemovedTimersAreNotCalled)
+{
+    Timed first, second, third;
+    int done = 0;
+    first.done = second.done = third.done = &done;
+
+    first.id = addTimer(10, timedOut, &first);
+    second.id = addTimer(20, timedOut, &second);
+    third.id = addTimer(30, timedOut, &third);
+    rmTimer(second.id);
+    // From within a callback too
+    first.removes = third.id;
+
+    ASSERT_TRUE(runOnce(done));
+    EXPECT_EQ(first.calls, 1);
+    EXPECT_FALSE(runOnce(done, 60));
+    EXPECT_EQ(second.calls, 0);
+    EXPECT_EQ(third.calls, 0);
+
+    // Unknown ids are ignored
+    rmTimer(second.id);
+    rmTimer(-1);
+}
+
+TEST(EventLoop, PeriodicTimers)
+{
+    Timed periodic;
+    int done = 0;
+    periodic.done = &done;
+    periodic.id = addPeriodicTimer(5, timedOut, &periodic);
+
+    for (int i = 0; i < 4; i++)
+        ASSERT_TRUE(runOnce(done));
+    EXPECT_EQ(periodic.calls, 4);
+    EXPECT_GE(remainingTimer(periodic.id), 0);
+
+    // A periodic timer removing itself stops
+    periodic.removes = periodic.id;
+    ASSERT_TRUE(runOnce(done));
+    EXPECT_EQ(remainingTimer(periodic.id), -1);
+    EXPECT_FALSE(runOnce(done, 30));
+    EXPECT_EQ(periodic.calls, 5);
+}
+
+TEST(EventLoop, RemainingTime)
+{
+    Timed timed;
+    timed.id = addTimer(1000, timedOut, &timed);
+
+    int ms = remainingTimer(timed.id);
+    int64_t ns = nsecsRemainingTimer(timed.id);
+    EXPECT_GT(ms, 900);
+    EXPECT_LE(ms, 1000);
+    EXPECT_GT(ns, 900000000);
+    EXPECT_LE(ns, 1000000000);
+    // Not rounded to whole milliseconds
+    EXPECT_LT(nsecsRemainingTimer(timed.id), ns);
+
+    rmTimer(timed.id);
+    EXPECT_EQ(remainingTimer(timed.id), -1);
+    EXPECT_EQ(nsecsRemainingTimer(timed.id), -1);
+}
+
+TEST(EventLoop, ManyTimers)
+{
+    // Enough for the queue and the id index to grow, and to be removed out of order
+    const int count = 1000;
+    std::vector<Timed> timers(count);
+    std::vector<int> order;
+    int done = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        timers[i].order = &order;
+        timers[i].id = addTimer(1 + (i * 7) % 40, timedOut, &timers[i]);
+    }
+    for (int i = 0; i < count; i += 3)
+        rmTimer(timers[i].id);
+
+    Timed last;
+    last.done = &done;
+    last.id = addTimer(100, timedOut, &last);
+    ASSERT_TRUE(runOnce(done));
+
+    EXPECT_EQ(order.size(), size_t(count - (count + 2) / 3));
+    for (int i = 0; i < count; i++)
+        EXPECT_EQ(timers[i].calls, i % 3 == 0 ? 0 : 1) << i;
+}
@@ -0,0 +1,308 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "base64.h"
+#include "lilxml.h"
+
+static const char sampleTraffic[] =
+    "<?xml version='1.0'?>\n"
+    "<defNumberVector device='Telescope Simulator' name='EQUATORIAL_EOD_COORD' label='Eq. Coordinates' group='Main Control' state='Idle' perm='rw' timeout='60' timestamp='2024-01-01T00:00:00'>\n"
+    "    <defNumber name='RA' label='RA (hh:mm:ss)' format='%010.6m' min='0' max='24' step='0'>\n"
+    "      12.5\n"
+    "    </defNumber>\n"
+    "    <defNumber name='DEC' label='DEC (dd:mm:ss)' format='%010.6m' min='-90' max='90' step='0'>\n"
+    "      -45.25\n"
+    "    </defNumber>\n"
+    "</defNumberVector>\n"
+    "<!-- a comment <with> markup -->\n"
+    "<setTextVector device=\"CCD &amp; Co\" name=\"INFO\" state=\"Ok\" message=\"a &lt;b&gt; &quot;c&quot; &apos;d&apos; &unknown; e\">\n"
+    "  <oneText name='T1'>Text &amp; more &lt;text&gt; with &bogus; entity</oneText>\n"
+    "  <oneText name='T2'>multi\nline\n   text   \n</oneText>\n"
+    "  <oneText name='T3' attr='multi\nline\tvalue'/>\n"
+    "</setTextVector>\n"
+    "<pingRequest uid='1'/>\n"
+    "<setBLOBVector device='CCD Simulator' name='CCD1' state='Ok' timeout='60'>\n"
+    "  <oneBLOB name='CCD1' size='96' format='.fits' len='128'>\n"
+    "QUJDREVGR0hJSktMTU5PUFFSU1RVVldYWVphYmNkZWZnaGlqa2xtbm9wcXJzdHV2d3h5ejAxMjM0\n"
+    "NTY3ODlBQkNERUZHSElKS0xNTk9QUVJTVFVWV1hZWmFiY2RlZmdoaWprbG1ub3BxcnN0dXZ3eHl6\n"
+    "  </oneBLOB>\n"
+    "</setBLOBVector>\n"
+    "<message device='Mount' timestamp='2024-01-01T00:00:00' message='\xc3\xa9t\xc3\xa9 ok'/>\n";
+
+static std::string print(XMLEle *root)
+{
+    std::string result(sprlXMLEle(root, 0) + 1, '\0');
+    result.resize(sprXMLEle(&result[0], root, 0));
+    return result;
+}
+
+// Reference: feed one char at a time
+static std::vector<std::string> parseByChar(const std::string &data)
+{
+    std::vector<std::string> result;
+    LilXML *lp = newLilXML();
+    char ynot[1024];
+
+    for (char c : data)
+    {
+        XMLEle *root = readXMLEle(lp, c, ynot);
+        if (root)
+        {
+            result.push_back(print(root));
+            delXMLEle(root);
+        }
+        EXPECT_EQ(ynot[0], '\0') << ynot;
+    }
+    delLilXML(lp);
+    return result;
+}
+
+static std::vector<std::string> parseByChunk(const std::string &data, size_t chunkSize)
+{
+    std::vector<std::string> result;
+    LilXML *lp = newLilXML();
+    char ynot[1024];
+
+    for (size_t offset = 0; offset < data.size(); offset += chunkSize)
+    {
+        std::string chunk = data.substr(offset, chunkSize);
+        XMLEle **nodes = parseXMLChunk(lp, &chunk[0], int(chunk.size()), ynot);
+        EXPECT_EQ(ynot[0], '\0') << ynot;
+        for (XMLEle **it = nodes; *it; ++it)
+        {
+            result.push_back(print(*it));
+            delXMLEle(*it);
+        }
+        free(nodes);
+    }
+    delLilXML(lp);
+    return result;
+}
+
+TEST(CORE_LILXML, ChunkParserMatchesCharParser)
+{
+    std::string traffic;
+    for (int i = 0; i < 8; i++)
+        traffic += sampleTraffic;
+
+    auto expected = parseByChar(traffic);
+    ASSERT_EQ(expected.size(), 8u * 5u);
+
+    for (size_t chunkSize : {1, 2, 3, 7, 15, 16, 17, 31, 64, 333, 4096, 49152})
+    {
+        auto actual = parseByChunk(traffic, chunkSize);
+        ASSERT_EQ(expected, actual) << "chunk size " << chunkSize;
+    }
+}
+
+TEST(CORE_LILXML, ChunkParserDecodesEntities)
+{
+    std::string xml = "<a v='x &amp; y &lt;z&gt;'>1 &lt; 2 &amp; 3</a>";
+    LilXML *lp = newLilXML();
+    char ynot[1024];
+
+    XMLEle **nodes = parseXMLChunk(lp, &xml[0], int(xml.size()), ynot);
+    ASSERT_NE(nodes[0], nullptr);
+    EXPECT_STREQ(findXMLAttValu(nodes[0], "v"), "x & y <z>");
+    EXPECT_STREQ(pcdataXMLEle(nodes[0]), "1 < 2 & 3");
+    EXPECT_EQ(pcdatalenXMLEle(nodes[0]), 9);
+
+    delXMLEle(nodes[0]);
+    free(nodes);
+    delLilXML(lp);
+}
+
+TEST(CORE_LILXML, ChunkParserReportsErrors)
+{
+    std::string xml = "<a>text</b><c/>";
+    LilXML *lp = newLilXML();
+    char ynot[1024];
+
+    XMLEle **nodes = parseXMLChunk(lp, &xml[0], int(xml.size()), ynot);
+    EXPECT_NE(ynot[0], '\0');
+    ASSERT_NE(nodes[0], nullptr);
+    EXPECT_STREQ(tagXMLEle(nodes[0]), "c");
+    EXPECT_EQ(nodes[1], nullptr);
+
+    delXMLEle(nodes[0]);
+    free(nodes);
+    delLilXML(lp);
+}
+
+// Parsed trees live in an arena: pieces edited, removed or grown past the arena must still be released cleanly
+TEST(CORE_LILXML, ParsedTreeSurvivesEdits)
+{
+    std::string blob(100000, 'A');
+    std::string xml = "<a x='1' y='2'><b>text</b><c/><d>more</d></a>";
+    LilXML *lp = newLilXML();
+    char ynot[1024];
+
+    XMLEle **nodes = parseXMLChunk(lp, &xml[0], int(xml.size()), ynot);
+    ASSERT_NE(nodes[0], nullptr);
+    XMLEle *root = nodes[0];
+    free(nodes);
+
+    delXMLEle(findXMLEle(root, "c"));
+    rmXMLAtt(root, "x");
+    editXMLEle(findXMLEle(root, "b"), blob.c_str());
+    setXMLEleTag(findXMLEle(root, "d"), "renamed");
+    for (int i = 0; i < 20; i++)
+        addXMLEle(root, "e");
+
+    EXPECT_EQ(nXMLEle(root), 22);
+    EXPECT_EQ(nXMLAtt(root), 1);
+    EXPECT_EQ(pcdatalenXMLEle(findXMLEle(root, "b")), int(blob.size()));
+    EXPECT_NE(findXMLEle(root, "renamed"), nullptr);
+
+    delXMLEle(root);
+    delLilXML(lp);
+}
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+// Each edit frees the value it replaces, the arena does not keep them all
+TEST(CORE_LILXML, RepeatedEditsDoNotGrow)
+{
+    std::string xml = "<newNumberVector name='FOCUS'><oneNumber name='POSITION'>0</oneNumber></newNumberVector>";
+    LilXML *lp = newLilXML();
+    char ynot[1024];
+
+    XMLEle **nodes = parseXMLChunk(lp, &xml[0], int(xml.size()), ynot);
+    ASSERT_NE(nodes[0], nullptr);
+    XMLEle *root = nodes[0];
+    free(nodes);
+    XMLEle *member = findXMLEle(root, "oneNumber");
+    XMLAtt *name = findXMLAtt(root, "name");
+
+    char value[64];
+    for (int i = 0; i < 1000; i++)
+    {
+        snprintf(value, sizeof(value), "      %.20g\n", i * 0.1);
+        editXMLEle(member, value);
+        editXMLAtt(name, value);
+    }
+    size_t used = mallinfo2().uordblks;
+    for (int i = 0; i < 100000; i++)
+    {
+        snprintf(value, sizeof(value), "      %.20g\n", i * 0.1);
+        editXMLEle(member, value);
+        editXMLAtt(name, value);
+    }
+    EXPECT_LT(mallinfo2().uordblks, used + 4096);
+    EXPECT_STREQ(pcdataXMLEle(member), value);
+    EXPECT_STREQ(valuXMLAtt(name), value);
+
+    delXMLEle(root);
+    delLilXML(lp);
+}
+#endif
+
+static int replaceB(void *self, XMLEle *source, XMLEle **replace)
+{
+    if (strcmp(tagXMLEle(source), "b"))
+        return 0;
+    *replace = shallowCloneXMLEle(source);
+    editXMLEle(*replace, static_cast<const char *>(self));
+    return 1;
+}
+
+TEST(CORE_LILXML, CloneWithReplacement)
+{
+    std::string xml = "<a x='1'><b n='b1'>old</b><c>keep &amp; this</c></a>";
+    LilXML *lp = newLilXML();
+    char ynot[1024];
+
+    XMLEle **nodes = parseXMLChunk(lp, &xml[0], int(xml.size()), ynot);
+    ASSERT_NE(nodes[0], nullptr);
+    XMLEle *clone = cloneXMLEle(nodes[0], replaceB, (void *)"new");
+
+    // The clone does not depend on the source tree
+    delXMLEle(nodes[0]);
+    free(nodes);
+
+    EXPECT_EQ(print(clone), "<a x=\"1\">\n    <b n=\"b1\">\nnew\n    </b>\n    <c>\nkeep &amp; this\n    </c>\n</a>\n");
+
+    delXMLEle(clone);
+    delLilXML(lp);
+}
+
+TEST(CORE_LILXML, DecodesBLOBsWhileParsing)
+{
+    const int len = 100000;
+    std::vector<unsigned char> raw(len);
+    for (int i = 0; i < len; i++)
+        raw[i] = (unsigned char)(i * 7 + i / 256);
+
+    std::vector<char> b64(4 * len / 3 + 4);
+    int b64len = to64frombits_s(reinterpret_cast<unsigned char *>(b64.data()), raw.data(), len, b64.size());
+    std::string content;
+    for (int i = 0; i < b64len; i += 72)
+        content += std::string(b64.data() + i, std::min(72, b64len - i)) + "\n";
+
+    for (bool withEnclen : {true, false})
+    {
+        std::string xml = "<newBLOBVector device='CCD' name='UPLOAD'>\n  <oneBLOB name='FLAT' size='" + std::to_string(len) +
+                          "' format='.fits'" + (withEnclen ? " enclen='" + std::to_string(b64len) + "'" : "") + ">\n" +
+                          content + "  </oneBLOB>\n  <oneBLOB name='EMPTY' size='0' format='.fits' attached='true'/>\n</newBLOBVector>\n";
+
+        for (size_t chunkSize : {1, 7, 4096, 49152})
+        {
+            LilXML *lp = newLilXML();
+            decodeXMLBLOBs(lp, malloc, realloc, free);
+            char ynot[1024];
+            XMLEle *root = nullptr;
+
+            for (size_t offset = 0; offset < xml.size(); offset += chunkSize)
+            {
+                std::string chunk = xml.substr(offset, chunkSize);
+                XMLEle **nodes = parseXMLChunk(lp, &chunk[0], int(chunk.size()), ynot);
+                ASSERT_EQ(ynot[0], '\0') << ynot;
+                if (nodes[0])
+                    root = nodes[0];
+                free(nodes);
+            }
+            ASSERT_NE(root, nullptr);
+
+            XMLEle *blob = findXMLEle(root, "oneBLOB");
+            ASSERT_NE(blob, nullptr);
+            EXPECT_EQ(pcdatalenXMLEle(blob), 0);
+
+            int blobLen = 0;
+            char *data  = static_cast<char *>(takeBlobXMLEle(blob, &blobLen));
+            ASSERT_NE(data, nullptr);
+            ASSERT_EQ(blobLen, len) << "chunk size " << chunkSize;
+            EXPECT_EQ(memcmp(data, raw.data(), len), 0) << "chunk size " << chunkSize;
+            free(data);
+
+            // attached blobs have no content to decode
+            int attachedLen = -1;
+            EXPECT_EQ(takeBlobXMLEle(nextXMLEle(root, 0), &attachedLen), nullptr);
+
+            delXMLEle(root);
+            delLilXML(lp);
+        }
+    }
+}
@@ -0,0 +1,231 @@
+/*******************************************************************************
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Library General Public
+ License version 2 as published by the Free Software Foundation.
+ .
+ This library is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ Library General Public License for more details.
+ .
+ You should have received a copy of the GNU Library General Public License
+ along with this library; see the file COPYING.LIB.  If not, write to
+ the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ Boston, MA 02110-1301, USA.
+*******************************************************************************/
+
+// The tty read functions and TTYBase against a pseudo terminal standing in for a device
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+#include "indicom.h"
+#include "ttybase.h"
+
+struct Pty
+{
+    int device {-1}; // The end the device writes to
+    int port {-1};   // The end the driver reads from
+
+    Pty()
+    {
+        device = posix_openpt(O_RDWR | O_NOCTTY);
+        if (device < 0 || grantpt(device) != 0 || unlockpt(device) != 0)
+            perror("posix_openpt");
+        port = open(ptsname(device), O_RDWR | O_NOCTTY);
+
+        struct termios raw;
+        tcgetattr(port, &raw);
+        cfmakeraw(&raw);
+        tcsetattr(port, TCSANOW, &raw);
+    }
+    ~Pty()
+    {
+        close(port);
+        close(device);
+    }
+    void send(const std::string &data)
+    {
+        if (write(device, data.data(), data.size()) != ssize_t(data.size()))
+            perror("write");
+        // Until the port has it all
+        tcdrain(device);
+        usleep(10000);
+    }
+};
+
+static std::string readSection(int fd, char stop, int *result = nullptr)
+{
+    char buffer[256] = {0};
+    int nbytes = 0;
+    int rc = tty_read_section_expanded(fd, buffer, stop, 0, 200000, &nbytes);
+    if (result)
+        *result = rc;
+    return std::string(buffer, nbytes);
+}
+
+TEST(TTY, SectionsAreReadByteByByteByDefault)
+{
+    Pty pty;
+    ASSERT_GE(pty.port, 0);
+
+    // What follows the stop character stays in the port, for tcflush, FIONREAD and read
+    pty.send("abc#def#gh");
+    EXPECT_EQ(readSection(pty.port, '#'), "abc#");
+    int pending = 0;
+    ASSERT_EQ(ioctl(pty.port, FIONREAD, &pending), 0);
+    EXPECT_EQ(pending, 6);
+    char buffer[8] = {0};
+    ASSERT_EQ(read(pty.port, buffer, 4), 4);
+    EXPECT_EQ(std::string(buffer, 4), "def#");
+
+    ASSERT_EQ(tcflush(pty.port, TCIFLUSH), 0);
+    pty.send("i#");
+    EXPECT_EQ(readSection(pty.port, '#'), "i#");
+}
+
+TEST(TTY, SectionsCarryOver)
+{
+    Pty pty;
+    ASSERT_GE(pty.port, 0);
+    ASSERT_EQ(tty_set_buffered(pty.port, 1), 0);
+
+    pty.send("abc#def#gh");
+    EXPECT_EQ(readSection(pty.port, '#'), "abc#");
+    EXPECT_EQ(readSection(pty.port, '#'), "def#");
+
+    // Plain reads take what the section reads left over first
+    char buffer[8] = {0};
+    int nbytes = 0;
+    pty.send("ij");
+    ASSERT_EQ(tty_read_expanded(pty.port, buffer, 4, 0, 200000, &nbytes), TTY_OK);
+    EXPECT_EQ(std::string(buffer, nbytes), "ghij");
+
+    int rc = TTY_OK;
+    EXPECT_EQ(readSection(pty.port, '#', &rc), "");
+    EXPECT_EQ(rc, TTY_TIME_OUT);
+
+    // Nothing is kept once buffering ends
+    pty.send("kl#mn");
+    EXPECT_EQ(readSection(pty.port, '#'), "kl#");
+    ASSERT_EQ(tty_set_buffered(pty.port, 0), 0);
+    pty.send("#");
+    EXPECT_EQ(readSection(pty.port, '#'), "#");
+}
+
+TEST(TTY, SectionsOverflow)
+{
+    Pty pty;
+    ASSERT_GE(pty.port, 0);
+    ASSERT_EQ(tty_set_buffered(pty.port, 1), 0);
+
+    char buffer[8];
+    int nbytes = 0;
+    pty.send("12345678#");
+    EXPECT_EQ(tty_nread_section_expanded(pty.port, buffer, 4, '#', 0, 200000, &nbytes), TTY_OVERFLOW);
+    EXPECT_EQ(std::string(buffer, nbytes), "1234");
+    EXPECT_EQ(tty_nread_section_expanded(pty.port, buffer, 8, '#', 0, 200000, &nbytes), TTY_OK);
+    EXPECT_EQ(std::string(buffer, nbytes), "5678#");
+
+    // The stop character fits exactly
+    pty.send("abc#");
+    EXPECT_EQ(tty_nread_section_expanded(pty.port, buffer, 4, '#', 0, 200000, &nbytes), TTY_OK);
+    EXPECT_EQ(std::string(buffer, nbytes), "abc#");
+}
+
+TEST(TTY, FlushDropsWhatWasReadAhead)
+{
+    Pty pty;
+    ASSERT_GE(pty.port, 0);
+    ASSERT_EQ(tty_set_buffered(pty.port, 1), 0);
+
+    pty.send("a#stale");
+    EXPECT_EQ(readSection(pty.port, '#'), "a#");
+    EXPECT_EQ(tty_flush(pty.port, TCIOFLUSH), 0);
+    pty.send("b#");
+    EXPECT_EQ(readSection(pty.port, '#'), "b#");
+
+    // Output only flushes leave the input alone
+    pty.send("c#kept#");
+    EXPECT_EQ(readSection(pty.port, '#'), "c#");
+    EXPECT_EQ(tty_flush(pty.port, TCOFLUSH), 0);
+    EXPECT_EQ(readSection(pty.port, '#'), "kept#");
+}
+
+TEST(TTY, ReusedDescriptorStartsEmpty)
+{
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    int port = -1;
+    {
+        Pty pty;
+        ASSERT_GE(pty.port, 0);
+        ASSERT_EQ(tty_set_buffered(pty.port, 1), 0);
+        pty.send("a#left over");
+        EXPECT_EQ(readSection(pty.port, '#'), "a#");
+        port = pty.port;
+    }
+
+    // Another file gets the same descriptor, without tty_disconnect, and is not buffered
+    ASSERT_EQ(dup2(fds[0], port), port);
+    ASSERT_EQ(write(fds[1], "z#y", 3), 3);
+    EXPECT_EQ(readSection(port, '#'), "z#");
+    char rest = 0;
+    ASSERT_EQ(read(port, &rest, 1), 1);
+    EXPECT_EQ(rest, 'y');
+
+    close(port);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(TTY, ClearsLeadingLineFeed)
+{
+    Pty pty;
+    ASSERT_GE(pty.port, 0);
+    ASSERT_EQ(tty_set_buffered(pty.port, 1), 0);
+
+    tty_clr_trailing_read_lf(1);
+    pty.send("abc\r\ndef\r\n");
+    EXPECT_EQ(readSection(pty.port, '\r'), "abc\r");
+    EXPECT_EQ(readSection(pty.port, '\r'), "def\r");
+    tty_clr_trailing_read_lf(0);
+    EXPECT_EQ(readSection(pty.port, '\n'), "\n");
+}
+
+TEST(TTYBase, SectionsCarryOver)
+{
+    Pty pty;
+    ASSERT_GE(pty.port, 0);
+
+    TTYBase tty("test_tty");
+    ASSERT_EQ(tty.connect(ptsname(pty.device), 9600, 8, 0, 1), TTYBase::TTY_OK);
+    tty.setBuffered(true);
+
+    uint8_t buffer[16];
+    uint32_t nbytes = 0;
+    pty.send("ab#cdefgh#ijk");
+    ASSERT_EQ(tty.readSection(buffer, sizeof(buffer), '#', 1, &nbytes), TTYBase::TTY_OK);
+    EXPECT_EQ(std::string(reinterpret_cast<char *>(buffer), nbytes), "ab#");
+    ASSERT_EQ(tty.readSection(buffer, 3, '#', 1, &nbytes), TTYBase::TTY_OVERFLOW);
+    EXPECT_EQ(std::string(reinterpret_cast<char *>(buffer), nbytes), "cde");
+    ASSERT_EQ(tty.read(buffer, 4, 1, &nbytes), TTYBase::TTY_OK);
+    EXPECT_EQ(std::string(reinterpret_cast<char *>(buffer), nbytes), "fgh#");
+
+    // What was read ahead goes with the flush
+    ASSERT_EQ(tty.readSection(buffer, 1, 'i', 1, &nbytes), TTYBase::TTY_OK);
+    EXPECT_EQ(tty.flush(), TTYBase::TTY_OK);
+    pty.send("l#");
+    ASSERT_EQ(tty.readSection(buffer, sizeof(buffer), '#', 1, &nbytes), TTYBase::TTY_OK);
+    EXPECT_EQ(std::string(reinterpret_cast<char *>(buffer), nbytes), "l#");
+}
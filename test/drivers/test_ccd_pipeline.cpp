@@ -0,0 +1,146 @@
+#include "indiccdpipeline.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using INDI::CCDPipeline;
+
+TEST(CCDPipeline, ProcessesFramesInTicketOrder)
+{
+    std::vector<int> processed;
+    {
+        CCDPipeline pipeline([&processed](CCDPipeline::Frame & frame)
+        {
+            processed.push_back(frame.width);
+        });
+
+        uint64_t first = pipeline.reserve();
+        uint64_t second = pipeline.reserve();
+        uint64_t third = pipeline.reserve();
+
+        auto frame = pipeline.acquire(third, true);
+        frame->width = 3;
+        pipeline.submit(third, std::move(frame));
+        pipeline.skip(second);
+
+        frame = pipeline.acquire(first, true);
+        frame->width = 1;
+        pipeline.submit(first, std::move(frame));
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (pipeline.pending() > 0 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(processed, std::vector<int>({1, 3}));
+}
+
+TEST(CCDPipeline, DropsOrWaitsWhenFull)
+{
+    std::atomic<bool> hold {true};
+    CCDPipeline pipeline([&hold](CCDPipeline::Frame &)
+    {
+        while (hold)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }, 2);
+
+    for (int i = 0; i < 2; i++)
+    {
+        uint64_t ticket = pipeline.reserve();
+        pipeline.submit(ticket, pipeline.acquire(ticket, true));
+    }
+    EXPECT_EQ(pipeline.pending(), 2u);
+
+    // Full: a rapid exposure loses its frame
+    uint64_t dropped = pipeline.reserve();
+    EXPECT_EQ(pipeline.acquire(dropped, false), nullptr);
+    EXPECT_EQ(pipeline.dropped(), 1u);
+    pipeline.skip(dropped);
+
+    // Others wait for a frame to be released
+    std::thread release([&hold]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        hold = false;
+    });
+    uint64_t ticket = pipeline.reserve();
+    auto frame = pipeline.acquire(ticket, true);
+    release.join();
+
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(pipeline.stalled(), 1u);
+    pipeline.skip(ticket, std::move(frame));
+}
+
+TEST(CCDPipeline, FramesGoToTicketsInOrder)
+{
+    std::vector<int> processed;
+    {
+        CCDPipeline pipeline([&processed](CCDPipeline::Frame & frame)
+        {
+            processed.push_back(frame.width);
+        }, 1);
+
+        uint64_t first = pipeline.reserve();
+        uint64_t second = pipeline.reserve();
+
+        // The later ticket asks first, and must not take the only frame
+        std::unique_ptr<CCDPipeline::Frame> later;
+        std::thread waiting([&]()
+        {
+            later = pipeline.acquire(second, true);
+            later->width = 2;
+            pipeline.submit(second, std::move(later));
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_EQ(pipeline.pending(), 0u);
+
+        auto frame = pipeline.acquire(first, true);
+        ASSERT_NE(frame, nullptr);
+        frame->width = 1;
+        pipeline.submit(first, std::move(frame));
+        waiting.join();
+
+        // Nor may it be dropped for a frame the earlier ticket holds
+        uint64_t third = pipeline.reserve();
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (pipeline.pending() > 0 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        frame = pipeline.acquire(third, false);
+        ASSERT_NE(frame, nullptr);
+        frame->width = 3;
+        pipeline.submit(third, std::move(frame));
+
+        deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (pipeline.pending() > 0 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(processed, std::vector<int>({1, 2, 3}));
+}
+
+TEST(CCDPipeline, ProcessesQueuedFramesBeforeQuitting)
+{
+    std::vector<int> processed;
+    {
+        CCDPipeline pipeline([&processed](CCDPipeline::Frame & frame)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            processed.push_back(frame.width);
+        });
+
+        for (int i = 1; i <= 3; i++)
+        {
+            uint64_t ticket = pipeline.reserve();
+            auto frame = pipeline.acquire(ticket, true);
+            frame->width = i;
+            pipeline.submit(ticket, std::move(frame));
+        }
+    }
+
+    EXPECT_EQ(processed, std::vector<int>({1, 2, 3}));
+}
@@ -0,0 +1,125 @@
+#include "stream/ccvt.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+static int sat(int c)
+{
+    return c < 0 ? 0 : c > 255 ? 255 : c;
+}
+
+// Scalar formulas of the original ccvt functions, RGB24 output
+static std::vector<uint8_t> referenceYUYV(const std::vector<uint8_t> &yuyv, int width, int height)
+{
+    std::vector<uint8_t> rgb(width * height * 3);
+    for (int i = 0; i < width * height / 2; i++)
+    {
+        const uint8_t *s = &yuyv[4 * i];
+        int cb = ((s[1] - 128) * 454) >> 8;
+        int cr = ((s[3] - 128) * 359) >> 8;
+        int cg = ((s[1] - 128) * 88 + (s[3] - 128) * 183) >> 8;
+        for (int k = 0; k < 2; k++)
+        {
+            rgb[6 * i + 3 * k] = sat(s[2 * k] + cr);
+            rgb[6 * i + 3 * k + 1] = sat(s[2 * k] - cg);
+            rgb[6 * i + 3 * k + 2] = sat(s[2 * k] + cb);
+        }
+    }
+    return rgb;
+}
+
+static std::vector<uint8_t> randomBytes(size_t size)
+{
+    std::vector<uint8_t> data(size);
+    uint32_t seed = 3;
+    for (auto &value : data)
+    {
+        seed = seed * 1103515245 + 12345;
+        value = seed >> 24;
+    }
+    return data;
+}
+
+TEST(CCVTYUV, YUYVToRGB)
+{
+    // Not a multiple of the vector width, to go through the scalar tail too
+    const int width = 70, height = 5;
+    auto yuyv = randomBytes(width * height * 2);
+    auto expected = referenceYUYV(yuyv, width, height);
+
+    std::vector<uint8_t> rgb(width * height * 3), planar(width * height * 3);
+    ccvt_yuyv_rgb(width, height, yuyv.data(), rgb.data(), 0);
+    ccvt_yuyv_rgb(width, height, yuyv.data(), planar.data(), 1);
+
+    EXPECT_EQ(rgb, expected);
+    for (int i = 0; i < width * height; i++)
+        for (int c = 0; c < 3; c++)
+            ASSERT_EQ(planar[c * width * height + i], expected[3 * i + c]) << "pixel " << i;
+}
+
+TEST(CCVTYUV, YUV420ToRGB)
+{
+    const int width = 70, height = 6;
+    auto yuv = randomBytes(width * height * 3 / 2);
+    const uint8_t *y = yuv.data(), *u = y + width * height, *v = u + width * height / 4;
+
+    // Same pixels as packed 4:2:2, chroma shared by two rows
+    std::vector<uint8_t> yuyv(width * height * 2);
+    for (int row = 0; row < height; row++)
+        for (int i = 0; i < width / 2; i++)
+        {
+            uint8_t *d = &yuyv[(row * width / 2 + i) * 4];
+            d[0] = y[row * width + 2 * i];
+            d[1] = u[(row / 2) * width / 2 + i];
+            d[2] = y[row * width + 2 * i + 1];
+            d[3] = v[(row / 2) * width / 2 + i];
+        }
+
+    std::vector<uint8_t> rgb(width * height * 3);
+    ccvt_420p_rgb24(width, height, yuv.data(), rgb.data());
+    EXPECT_EQ(rgb, referenceYUYV(yuyv, width, height));
+}
+
+TEST(CCVTYUV, ReorderAndCrop)
+{
+    const int width = 40, height = 3, stride = 100;
+    auto frame = randomBytes(stride * height);
+
+    // Offsets of Y0, U, Y1 and V for each order
+    const int offsets[4][4] = {{0, 1, 2, 3}, {1, 0, 3, 2}, {0, 3, 2, 1}, {1, 2, 3, 0}};
+    for (int order = CCVT_422_YUYV; order <= CCVT_422_VYUY; order++)
+    {
+        std::vector<uint8_t> yuyv(width * height * 2);
+        ccvt_422_yuyv(width, height, frame.data() + 8, stride, ccvt_422_order(order), yuyv.data());
+
+        for (int row = 0; row < height; row++)
+            for (int i = 0; i < width / 2; i++)
+                for (int k = 0; k < 4; k++)
+                    ASSERT_EQ(yuyv[row * width * 2 + 4 * i + k], frame[8 + row * stride + 4 * i + offsets[order][k]])
+                            << "order " << order << " row " << row << " pair " << i;
+    }
+
+    std::vector<uint8_t> yuyv(width * height * 2), y(width * height);
+    ccvt_422_yuyv(width, height, frame.data(), stride, CCVT_422_YUYV, yuyv.data());
+    ccvt_yuyv_y(width, height, yuyv.data(), y.data());
+    for (int i = 0; i < width * height; i++)
+        ASSERT_EQ(y[i], yuyv[2 * i]);
+}
+
+TEST(CCVTYUV, Y16Copy)
+{
+    const int width = 21, height = 3, stride = 50;
+    auto frame = randomBytes(stride * height);
+
+    std::vector<uint8_t> copy(width * height * 2), swapped(width * height * 2);
+    ccvt_y16_copy(width, height, frame.data() + 4, stride, 0, copy.data());
+    ccvt_y16_copy(width, height, frame.data() + 4, stride, 1, swapped.data());
+
+    for (int row = 0; row < height; row++)
+        for (int i = 0; i < width * 2; i++)
+        {
+            ASSERT_EQ(copy[row * width * 2 + i], frame[4 + row * stride + i]);
+            ASSERT_EQ(swapped[row * width * 2 + i], frame[4 + row * stride + (i ^ 1)]);
+        }
+}
@@ -0,0 +1,129 @@
+#include "stream/ccvt.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+
+// Plain reference: mirrored borders, floor averages
+static std::vector<int> reference(const std::vector<uint16_t> &raw, long width, long height, ccvt_cfa cfa, bool vng)
+{
+    static const int redRow[] = {0, 1, 0, 1}, redCol[] = {0, 1, 1, 0};
+    auto at = [&](long x, long y)
+    {
+        x = x < 0 ? 1 : x >= width ? width - 2 : x;
+        y = y < 0 ? 1 : y >= height ? height - 2 : y;
+        return int(raw[y * width + x]);
+    };
+    auto color = [&](long x, long y)
+    {
+        bool redLine = (y & 1) == redRow[cfa], redPixel = (x & 1) == redCol[cfa];
+        return redLine == redPixel ? (redLine ? 0 : 2) : 1;
+    };
+
+    std::vector<int> rgb(width * height * 3);
+    for (long y = 0; y < height; y++)
+        for (long x = 0; x < width; x++)
+        {
+            int *out = &rgb[(y * width + x) * 3];
+            int h = at(x - 1, y) + at(x + 1, y), v = at(x, y - 1) + at(x, y + 1);
+            int d = at(x - 1, y - 1) + at(x + 1, y - 1) + at(x - 1, y + 1) + at(x + 1, y + 1);
+            int c = color(x, y);
+            if (c == 1)
+            {
+                out[1] = at(x, y);
+                out[color(x + 1, y)] = h / 2;
+                out[color(x, y + 1)] = v / 2;
+            }
+            else
+            {
+                int dh = std::abs(at(x - 1, y) - at(x + 1, y)), dv = std::abs(at(x, y - 1) - at(x, y + 1));
+                out[c] = at(x, y);
+                out[1] = !vng || dh == dv ? (h + v) / 4 : dh < dv ? h / 2 : v / 2;
+                out[2 - c] = d / 4;
+            }
+        }
+    return rgb;
+}
+
+class DebayerTest : public ::testing::TestWithParam<std::tuple<ccvt_cfa, ccvt_debayer_method, int, unsigned>>
+{
+};
+
+TEST_P(DebayerTest, MatchesReference)
+{
+    ccvt_cfa cfa = std::get<0>(GetParam());
+    ccvt_debayer_method method = std::get<1>(GetParam());
+    int depth = std::get<2>(GetParam());
+    unsigned threads = std::get<3>(GetParam());
+
+    for (long width : {2L, 3L, 35L, 131L})
+    {
+        const long height = 37;
+        std::vector<uint16_t> raw(width * height);
+        uint32_t seed = 7;
+        for (auto &value : raw)
+        {
+            seed = seed * 1103515245 + 12345;
+            value = (seed >> 8) & ((1 << depth) - 1);
+            // Flat patches so the gradients are sometimes equal
+            if ((seed >> 28) == 0)
+                value = 0;
+        }
+        std::vector<uint8_t> raw8(raw.begin(), raw.end());
+        const void *src = depth == 8 ? static_cast<const void *>(raw8.data()) : raw.data();
+        auto expected = reference(raw, width, height, cfa, method == CCVT_DEBAYER_VNG_LITE);
+
+        std::vector<uint16_t> rgb16(width * height * 3);
+        ASSERT_EQ(ccvt_debayer(rgb16.data(), src, width, height, depth, 16, cfa, method, CCVT_DEBAYER_INTERLEAVED,
+                               threads), 0);
+        std::vector<uint16_t> planar16(width * height * 3);
+        ASSERT_EQ(ccvt_debayer(planar16.data(), src, width, height, depth, 16, cfa, method, CCVT_DEBAYER_PLANAR,
+                               threads), 0);
+        std::vector<uint8_t> rgb8(width * height * 3);
+        ASSERT_EQ(ccvt_debayer(rgb8.data(), src, width, height, depth, 8, cfa, method, CCVT_DEBAYER_INTERLEAVED,
+                               threads), 0);
+
+        for (long i = 0; i < width * height; i++)
+            for (int c = 0; c < 3; c++)
+            {
+                int value = expected[i * 3 + c];
+                ASSERT_EQ(rgb16[i * 3 + c], value << (16 - depth)) << "width " << width << " pixel " << i << " color " << c;
+                ASSERT_EQ(planar16[c * width * height + i], value << (16 - depth)) << "width " << width << " pixel " << i;
+                ASSERT_EQ(rgb8[i * 3 + c], value >> (depth - 8)) << "width " << width << " pixel " << i;
+            }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Debayer, DebayerTest,
+                         ::testing::Combine(::testing::Values(CCVT_CFA_RGGB, CCVT_CFA_BGGR, CCVT_CFA_GRBG, CCVT_CFA_GBRG),
+                                            ::testing::Values(CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_VNG_LITE),
+                                            ::testing::Values(8, 12, 16), ::testing::Values(1u, 3u)));
+
+TEST(Debayer, FlatColor)
+{
+    // RGGB mosaic of a uniform color
+    const long width = 64, height = 16;
+    std::vector<uint8_t> raw(width * height), rgb(width * height * 3);
+    for (long y = 0; y < height; y++)
+        for (long x = 0; x < width; x++)
+            raw[y * width + x] = (y & 1) == 0 ? ((x & 1) == 0 ? 200 : 100) : ((x & 1) == 0 ? 100 : 50);
+
+    ASSERT_EQ(ccvt_debayer(rgb.data(), raw.data(), width, height, 8, 8, CCVT_CFA_RGGB, CCVT_DEBAYER_BILINEAR,
+                           CCVT_DEBAYER_INTERLEAVED, 0), 0);
+    for (long i = 0; i < width * height; i++)
+    {
+        EXPECT_EQ(rgb[i * 3], 200);
+        EXPECT_EQ(rgb[i * 3 + 1], 100);
+        EXPECT_EQ(rgb[i * 3 + 2], 50);
+    }
+}
+
+TEST(Debayer, RejectsInvalidArguments)
+{
+    uint8_t raw[4] = {0}, rgb[12];
+    EXPECT_EQ(ccvt_debayer(rgb, raw, 1, 4, 8, 8, CCVT_CFA_RGGB, CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_INTERLEAVED, 1), -1);
+    EXPECT_EQ(ccvt_debayer(rgb, raw, 2, 2, 7, 8, CCVT_CFA_RGGB, CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_INTERLEAVED, 1), -1);
+    EXPECT_EQ(ccvt_debayer(rgb, raw, 2, 2, 8, 12, CCVT_CFA_RGGB, CCVT_DEBAYER_BILINEAR, CCVT_DEBAYER_INTERLEAVED, 1), -1);
+}
@@ -0,0 +1,173 @@
+#include "indifileindex.h"
+#include "indifilewriter.h"
+
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using INDI::FileIndex;
+using INDI::FileWriter;
+
+class TemporaryDirectory
+{
+    public:
+        TemporaryDirectory()
+        {
+            char name[] = "/tmp/indi_test_XXXXXX";
+            path = mkdtemp(name);
+        }
+        ~TemporaryDirectory()
+        {
+            std::string command = "rm -rf " + path;
+            if (system(command.c_str()) != 0)
+                perror(command.c_str());
+        }
+
+        void touch(const std::string &name) const
+        {
+            std::ofstream(path + "/" + name) << name;
+        }
+
+        std::string path;
+};
+
+static std::string readFile(const std::string &path)
+{
+    std::ifstream file(path);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+TEST(FileIndex, ExpandsPatterns)
+{
+    EXPECT_EQ(FileIndex::expand("M31_ISO8601_XXX", "2024-01-01T22-10-05.123", 7), "M31_2024-01-01T22-10-05.123_007");
+    EXPECT_EQ(FileIndex::expand("Light_XXX", "", 1234), "Light_1234");
+    EXPECT_EQ(FileIndex::expand("Flat", "", 3), "Flat");
+    EXPECT_EQ(FileIndex::stem("M31_ISO8601_XXX"), "M31");
+    EXPECT_EQ(FileIndex::stem("IMAGE_XXX"), "IMAGE");
+}
+
+TEST(FileIndex, ContinuesFromTheDirectory)
+{
+    TemporaryDirectory dir;
+    dir.touch("IMAGE_001.fits");
+    dir.touch("IMAGE_017.fits");
+    dir.touch("IMAGE_009.fits");
+    dir.touch("DARK_123.fits");
+
+    FileIndex index;
+    EXPECT_FALSE(index.contains(dir.path, "IMAGE_XXX"));
+    EXPECT_EQ(index.next(dir.path, "IMAGE_XXX"), 18);
+    EXPECT_TRUE(index.contains(dir.path, "IMAGE_XXX"));
+
+    // Later files are counted in memory, the directory is not read again
+    dir.touch("IMAGE_050.fits");
+    EXPECT_EQ(index.next(dir.path, "IMAGE_XXX"), 19);
+
+    EXPECT_EQ(index.next(dir.path, "DARK_XXX"), 124);
+    EXPECT_EQ(index.next(dir.path, "FLAT_XXX"), 1);
+
+    index.reset();
+    EXPECT_EQ(index.next(dir.path, "IMAGE_XXX"), 51);
+}
+
+TEST(FileIndex, FailsOnMissingDirectory)
+{
+    FileIndex index;
+    EXPECT_EQ(index.next("/nonexistent/indi/directory", "IMAGE_XXX"), -1);
+    EXPECT_FALSE(index.contains("/nonexistent/indi/directory", "IMAGE_XXX"));
+}
+
+TEST(FileWriter, WritesFilesInOrder)
+{
+    TemporaryDirectory dir;
+    std::mutex lock;
+    std::vector<std::string> completed;
+
+    {
+        FileWriter writer;
+        writer.setCompletionHandler([&](const std::string & path, int error)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            EXPECT_EQ(error, 0);
+            completed.push_back(path);
+        });
+
+        std::vector<char> data(100000);
+        for (int i = 0; i < 10; i++)
+        {
+            std::fill(data.begin(), data.end(), 'a' + i);
+            writer.write(dir.path + "/frame_" + std::to_string(i), data.data(), data.size());
+        }
+
+        writer.flush();
+        EXPECT_EQ(writer.pending(), 0u);
+        EXPECT_EQ(writer.failed(), 0u);
+    }
+
+    ASSERT_EQ(completed.size(), 10u);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(completed[i], dir.path + "/frame_" + std::to_string(i));
+        EXPECT_EQ(readFile(completed[i]), std::string(100000, 'a' + i));
+    }
+}
+
+TEST(FileWriter, ReportsErrors)
+{
+    TemporaryDirectory dir;
+    std::vector<int> errors;
+
+    FileWriter writer;
+    writer.setCompletionHandler([&](const std::string &, int error)
+    {
+        errors.push_back(error);
+    });
+
+    // Each file also reports to its own caller
+    std::vector<int> done;
+    writer.write(dir.path + "/missing/frame", "data", 4, [&](int error)
+    {
+        done.push_back(error);
+    });
+    writer.write(dir.path + "/frame", "data", 4, [&](int error)
+    {
+        done.push_back(error);
+    });
+    writer.flush();
+
+    EXPECT_EQ(errors, std::vector<int>({ENOENT, 0}));
+    EXPECT_EQ(done, errors);
+    EXPECT_EQ(writer.failed(), 1u);
+    EXPECT_EQ(readFile(dir.path + "/frame"), "data");
+}
+
+TEST(FileWriter, WaitsWhenTheQueueIsFull)
+{
+    TemporaryDirectory dir;
+
+    // Only one file fits in the queue at a time, each write waits for the previous one
+    FileWriter writer(1000);
+    std::vector<char> data(800, 'x');
+    for (int i = 0; i < 20; i++)
+    {
+        writer.write(dir.path + "/frame_" + std::to_string(i), data.data(), data.size());
+        EXPECT_LE(writer.pending(), 1u);
+    }
+
+    // Larger than the limit still goes through
+    std::vector<char> large(5000, 'y');
+    writer.write(dir.path + "/large", large.data(), large.size());
+    writer.flush();
+
+    EXPECT_EQ(readFile(dir.path + "/frame_19"), std::string(800, 'x'));
+    EXPECT_EQ(readFile(dir.path + "/large"), std::string(5000, 'y'));
+}
@@ -0,0 +1,194 @@
+#include "indiframebinning.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using INDI::FrameBinning;
+
+template <typename T>
+static std::vector<T> makeFrame(uint32_t width, uint32_t height, uint32_t range)
+{
+    std::vector<T> frame(size_t(width) * height);
+    uint32_t seed = 3;
+    for (auto &value : frame)
+    {
+        seed = seed * 1103515245 + 12345;
+        value = T((seed >> 8) % range);
+    }
+    return frame;
+}
+
+// One pixel at a time, as in the definition: each input pixel is added to the output pixel it maps to
+template <typename T>
+static std::vector<T> reference(const std::vector<T> &frame, uint32_t width, uint32_t height, uint32_t binX, uint32_t binY,
+                                FrameBinning::Mode mode, bool bayer)
+{
+    uint32_t outWidth = width / binX, outHeight = height / binY;
+    std::vector<double> sums(size_t(outWidth) * outHeight, 0);
+    std::vector<uint32_t> counts(sums.size(), 0);
+
+    for (uint32_t y = 0; y < height; y++)
+        for (uint32_t x = 0; x < width; x++)
+        {
+            uint32_t ox = bayer ? ((x / binX) & ~1u) + (x & 1u) : x / binX;
+            uint32_t oy = bayer ? ((y / binY) & ~1u) + (y & 1u) : y / binY;
+            if (ox >= outWidth || oy >= outHeight)
+                continue;
+            sums[size_t(oy) * outWidth + ox] += frame[size_t(y) * width + x];
+            counts[size_t(oy) * outWidth + ox]++;
+        }
+
+    std::vector<T> result(sums.size());
+    for (size_t i = 0; i < sums.size(); i++)
+    {
+        double value = sums[i];
+        if (mode == FrameBinning::AVERAGE)
+            value = std::numeric_limits<T>::is_integer ? double(uint64_t(value) / counts[i]) : value / counts[i];
+        if (std::numeric_limits<T>::is_integer)
+            value = std::min<double>(value, std::numeric_limits<T>::max());
+        result[i] = T(value);
+    }
+    return result;
+}
+
+template <typename T>
+static void checkAgainstReference(int bpp, uint32_t range)
+{
+    // Sizes that do and do not divide by the binning
+    for (uint32_t width : {64u, 67u})
+        for (uint32_t height : {48u, 53u})
+            for (uint32_t binX : {1u, 2u, 3u, 4u})
+                for (uint32_t binY : {1u, 2u, 3u})
+                    for (auto mode : {FrameBinning::SUM, FrameBinning::AVERAGE})
+                        for (bool bayer : {false, true})
+                        {
+                            auto frame = makeFrame<T>(width, height, range);
+                            auto expected = reference(frame, width, height, binX, binY, mode, bayer);
+                            std::vector<T> binned(expected.size());
+
+                            ASSERT_TRUE(FrameBinning::bin(frame.data(), binned.data(), bpp, width, height, binX, binY, mode, bayer, 1));
+                            EXPECT_EQ(binned, expected) << width << "x" << height << " bin " << binX << "x" << binY
+                                                        << " mode " << mode << " bayer " << bayer;
+                        }
+}
+
+TEST(FrameBinning, MatchesReference8Bit)
+{
+    checkAgainstReference<uint8_t>(8, 256);
+}
+
+TEST(FrameBinning, MatchesReference16Bit)
+{
+    // Sums saturate
+    checkAgainstReference<uint16_t>(16, 65536);
+}
+
+TEST(FrameBinning, MatchesReference32Bit)
+{
+    checkAgainstReference<uint32_t>(32, 1u << 31);
+}
+
+TEST(FrameBinning, MatchesReferenceFloat)
+{
+    // Whole values, so the order of the additions does not matter
+    checkAgainstReference<float>(-32, 4096);
+}
+
+// Previous CCDChip::binFrame for 16 bit frames
+static std::vector<uint16_t> legacyBin16(const std::vector<uint16_t> &frame, uint32_t SubW, uint32_t SubH, int BinX)
+{
+    std::vector<uint16_t> result(frame.size(), 0);
+    uint16_t *bin_buf = result.data();
+    const uint16_t *RawFrame16 = frame.data();
+
+    for (uint32_t i = 0; i < SubH; i += BinX)
+        for (uint32_t j = 0; j < SubW; j += BinX)
+        {
+            for (int k = 0; k < BinX; k++)
+                for (int l = 0; l < BinX; l++)
+                {
+                    uint16_t val = *(RawFrame16 + j + (i + k) * SubW + l);
+                    if (val + *bin_buf > UINT16_MAX)
+                        *bin_buf = UINT16_MAX;
+                    else
+                        *bin_buf += val;
+                }
+            bin_buf++;
+        }
+
+    result.resize((SubW / BinX) * (SubH / BinX));
+    return result;
+}
+
+// Previous CCDChip::binBayerFrame for 16 bit frames
+static std::vector<uint16_t> legacyBinBayer16(const std::vector<uint16_t> &frame, uint32_t SubW, uint32_t SubH,
+        uint32_t BinX, uint32_t BinY)
+{
+    std::vector<uint16_t> result(frame.size(), 0);
+    uint32_t BinW = SubW / BinX;
+    uint32_t RawOffset = 0;
+
+    for (uint32_t i = 0; i < SubH; i++)
+    {
+        uint32_t BinOffsetH = (((i / BinY) & 0xFFFFFFFE) + (i & 0x00000001)) * BinW;
+        for (uint32_t j = 0; j < SubW; j++)
+        {
+            uint32_t BinFrameOffset = BinOffsetH + ((j / BinX) & 0xFFFFFFFE) + (j & 0x00000001);
+            uint32_t val = result[BinFrameOffset];
+            val += frame[RawOffset];
+            if (val > UINT16_MAX)
+                val = UINT16_MAX;
+            result[BinFrameOffset] = (uint16_t)val;
+            RawOffset++;
+        }
+    }
+
+    result.resize((SubW / BinX) * (SubH / BinY));
+    return result;
+}
+
+TEST(FrameBinning, SameAsLegacySum)
+{
+    for (uint32_t bin : {2u, 3u, 4u})
+    {
+        // Sizes the previous code handled: multiples of twice the binning
+        uint32_t width = 48 * bin, height = 24 * bin;
+        auto frame = makeFrame<uint16_t>(width, height, 40000);
+        std::vector<uint16_t> binned((width / bin) * (height / bin));
+
+        ASSERT_TRUE(FrameBinning::bin(frame.data(), binned.data(), 16, width, height, bin, bin, FrameBinning::SUM, false, 1));
+        EXPECT_EQ(binned, legacyBin16(frame, width, height, bin)) << "bin " << bin;
+
+        ASSERT_TRUE(FrameBinning::bin(frame.data(), binned.data(), 16, width, height, bin, bin, FrameBinning::SUM, true, 1));
+        EXPECT_EQ(binned, legacyBinBayer16(frame, width, height, bin, bin)) << "bayer bin " << bin;
+    }
+}
+
+TEST(FrameBinning, SameResultOnSeveralThreads)
+{
+    // Large enough to be split in bands
+    uint32_t width = 2048, height = 1536;
+    auto frame = makeFrame<uint16_t>(width, height, 4096);
+    std::vector<uint16_t> single((width / 2) * (height / 3)), multi(single.size());
+
+    for (bool bayer : {false, true})
+    {
+        ASSERT_TRUE(FrameBinning::bin(frame.data(), single.data(), 16, width, height, 2, 3, FrameBinning::SUM, bayer, 1));
+        ASSERT_TRUE(FrameBinning::bin(frame.data(), multi.data(), 16, width, height, 2, 3, FrameBinning::SUM, bayer, 4));
+        EXPECT_EQ(single, multi);
+    }
+}
+
+TEST(FrameBinning, RejectsUnsupportedDepth)
+{
+    std::vector<uint8_t> frame(64), binned(64);
+    EXPECT_FALSE(FrameBinning::bin(frame.data(), binned.data(), 12, 8, 8, 2, 2, FrameBinning::SUM));
+    EXPECT_FALSE(FrameBinning::bin(frame.data(), binned.data(), 8, 8, 8, 0, 2, FrameBinning::SUM));
+    // Binning larger than the frame leaves nothing to bin
+    EXPECT_FALSE(FrameBinning::bin(frame.data(), binned.data(), 8, 8, 8, 16, 2, FrameBinning::SUM));
+    EXPECT_FALSE(FrameBinning::bin(frame.data(), binned.data(), 8, 8, 8, 2, 9, FrameBinning::SUM));
+}
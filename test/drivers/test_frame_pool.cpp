@@ -0,0 +1,116 @@
+#include "stream/framepool.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using INDI::FramePool;
+
+TEST(FramePool, RecyclesReleasedBuffers)
+{
+    FramePool pool(1024 * 1024);
+
+    uint8_t *first;
+    {
+        auto frame = pool.acquire(1000);
+        ASSERT_TRUE(frame);
+        first = frame->data();
+        EXPECT_EQ(frame->size(), 1000u);
+        EXPECT_EQ(pool.usedBuffers(), 1u);
+        EXPECT_EQ(pool.usedBytes(), 1000u);
+    }
+    EXPECT_EQ(pool.usedBuffers(), 0u);
+
+    // Same or smaller frames reuse the buffer
+    auto frame = pool.acquire(800);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(frame->data(), first);
+    EXPECT_EQ(frame->size(), 800u);
+}
+
+TEST(FramePool, SharedReferencesKeepTheBuffer)
+{
+    FramePool pool(1024 * 1024);
+
+    auto frame = pool.acquire(1000);
+    auto preview = frame;
+    frame.reset();
+    EXPECT_EQ(pool.usedBuffers(), 1u);
+
+    preview.reset();
+    EXPECT_EQ(pool.usedBuffers(), 0u);
+}
+
+TEST(FramePool, DropsWhenFull)
+{
+    FramePool pool(3000);
+
+    auto a = pool.acquire(1000);
+    auto b = pool.acquire(1000);
+    auto c = pool.acquire(1000);
+    ASSERT_TRUE(a && b && c);
+
+    EXPECT_FALSE(pool.acquire(1000));
+    EXPECT_EQ(pool.dropped(), 1u);
+
+    // Idle buffers that are too small make room for larger ones
+    a.reset();
+    b.reset();
+    EXPECT_TRUE(pool.acquire(2000));
+    EXPECT_EQ(pool.dropped(), 1u);
+
+    pool.resetDropped();
+    EXPECT_EQ(pool.dropped(), 0u);
+}
+
+TEST(FramePool, SharedBuffersAreNotRecycled)
+{
+    FramePool pool(1024 * 1024);
+
+    {
+        auto frame = pool.acquire(1000);
+        frame->setShared();
+    }
+
+    auto frame = pool.acquire(1000);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(pool.usedBuffers(), 1u);
+    EXPECT_EQ(pool.usedBytes(), 1000u);
+}
+
+TEST(FramePool, BuffersOutliveThePool)
+{
+    FramePool::BufferPtr frame;
+    {
+        FramePool pool(1024 * 1024);
+        frame = pool.acquire(1000);
+    }
+    ASSERT_TRUE(frame);
+    frame->data()[999] = 1;
+}
+
+TEST(FramePool, ReleaseFromOtherThreads)
+{
+    FramePool pool(64 * 1024 * 1024);
+
+    for (int round = 0; round < 20; round++)
+    {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; i++)
+        {
+            auto frame = pool.acquire(1 << 20);
+            ASSERT_TRUE(frame);
+            threads.emplace_back([frame]() mutable
+            {
+                frame->data()[0] = 1;
+                frame.reset();
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    EXPECT_EQ(pool.usedBuffers(), 0u);
+    EXPECT_EQ(pool.dropped(), 0u);
+}
@@ -0,0 +1,98 @@
+#include "indiframestatistics.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using INDI::FrameStatistics;
+
+template <typename T>
+static std::vector<T> makeFrame(size_t count, uint32_t range)
+{
+    std::vector<T> frame(count);
+    uint32_t seed = 7;
+    for (auto &value : frame)
+    {
+        seed = seed * 1103515245 + 12345;
+        value = T((seed >> 8) % range);
+    }
+    return frame;
+}
+
+template <typename T>
+static void checkAgainstNaive(const std::vector<T> &frame, FrameStatistics::SampleType type, unsigned threads)
+{
+    auto stats = FrameStatistics::compute(frame.data(), type, frame.size(), 256, threads);
+
+    auto sorted = frame;
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0, sumSquares = 0;
+    for (auto value : frame)
+    {
+        sum += value;
+        sumSquares += double(value) * value;
+    }
+    double mean = sum / frame.size();
+
+    EXPECT_EQ(stats.count, frame.size());
+    EXPECT_EQ(stats.min, sorted.front());
+    EXPECT_EQ(stats.max, sorted.back());
+    EXPECT_NEAR(stats.mean, mean, 1e-6 * std::max(1.0, mean));
+    EXPECT_NEAR(stats.stddev, std::sqrt(sumSquares / frame.size() - mean * mean), 1e-3 * std::max(1.0, mean));
+
+    uint64_t total = 0;
+    for (auto bin : stats.histogram)
+        total += bin;
+    EXPECT_EQ(total, frame.size());
+    EXPECT_EQ(stats.histogram.size(), 256u);
+}
+
+TEST(FrameStatistics, ExactFor16Bit)
+{
+    // Large enough to be split in bands
+    auto frame = makeFrame<uint16_t>(3 * 1024 * 1024 + 5, 65536);
+    for (unsigned threads : {1u, 4u})
+    {
+        checkAgainstNaive(frame, FrameStatistics::UINT16, threads);
+
+        auto sorted = frame;
+        std::sort(sorted.begin(), sorted.end());
+        double median = (double(sorted[(sorted.size() - 1) / 2]) + sorted[sorted.size() / 2]) / 2;
+        EXPECT_EQ(FrameStatistics::compute(frame.data(), FrameStatistics::UINT16, frame.size(), 256, threads).median, median);
+    }
+}
+
+TEST(FrameStatistics, ExactFor8Bit)
+{
+    auto frame = makeFrame<uint8_t>(1000, 200);
+    checkAgainstNaive(frame, FrameStatistics::UINT8, 1);
+}
+
+TEST(FrameStatistics, BinnedFor32BitAndFloat)
+{
+    checkAgainstNaive(makeFrame<uint32_t>(2 * 1024 * 1024 + 3, 1u << 31), FrameStatistics::UINT32, 3);
+    checkAgainstNaive(makeFrame<float>(100000, 50000), FrameStatistics::FLOAT32, 1);
+}
+
+TEST(FrameStatistics, ConstantFrame)
+{
+    std::vector<uint16_t> frame(1000, 42);
+    auto stats = FrameStatistics::compute(frame.data(), FrameStatistics::UINT16, frame.size());
+
+    EXPECT_EQ(stats.min, 42);
+    EXPECT_EQ(stats.max, 42);
+    EXPECT_EQ(stats.mean, 42);
+    EXPECT_EQ(stats.stddev, 0);
+    EXPECT_EQ(stats.median, 42);
+    EXPECT_EQ(stats.histogram[0], 1000u);
+}
+
+TEST(FrameStatistics, EmptyFrame)
+{
+    auto stats = FrameStatistics::compute(nullptr, FrameStatistics::UINT16, 0);
+    EXPECT_EQ(stats.count, 0u);
+    EXPECT_TRUE(stats.histogram.empty());
+}
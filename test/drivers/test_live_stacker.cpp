@@ -0,0 +1,269 @@
+#include "indilivestacker.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using INDI::FrameStatistics;
+using INDI::LiveStacker;
+
+static const uint32_t width = 256, height = 192;
+
+struct Random
+{
+    uint32_t seed;
+
+    // Uniform in [0, 1)
+    float next()
+    {
+        seed = seed * 1103515245 + 12345;
+        return ((seed >> 8) & 0xFFFF) / 65536.0f;
+    }
+};
+
+// Star field on a noisy background, every star moved by (dx, dy)
+static std::vector<uint16_t> starField(int dx, int dy, uint32_t noiseSeed)
+{
+    Random stars {42}, noise {noiseSeed};
+    std::vector<float> image(width * height);
+    for (auto &value : image)
+        value = 1000 + 20 * noise.next();
+
+    for (int s = 0; s < 25; s++)
+    {
+        float cx = 20 + stars.next() * (width - 40) + dx;
+        float cy = 20 + stars.next() * (height - 40) + dy;
+        float flux = 2000 + 20000 * stars.next();
+        for (int y = int(cy) - 6; y <= int(cy) + 6; y++)
+            for (int x = int(cx) - 6; x <= int(cx) + 6; x++)
+                if (x >= 0 && y >= 0 && x < int(width) && y < int(height))
+                    image[y * width + x] += flux * std::exp(-((x - cx) * (x - cx) + (y - cy) * (y - cy)) / 4.5f);
+    }
+
+    return std::vector<uint16_t>(image.begin(), image.end());
+}
+
+// Smooth texture with no point sources, moved by (dx, dy)
+static std::vector<float> texture(int dx, int dy)
+{
+    std::vector<float> image(width * height);
+    for (uint32_t y = 0; y < height; y++)
+        for (uint32_t x = 0; x < width; x++)
+        {
+            float u = float(x) - dx, v = float(y) - dy;
+            image[y * width + x] = std::sin(u * 0.11f) * std::cos(v * 0.07f) + std::sin((u + 2 * v) * 0.05f) +
+                                   0.5f * std::sin(u * v * 0.001f);
+        }
+    return image;
+}
+
+TEST(LiveStacker, MeanWithoutAlignment)
+{
+    LiveStacker stacker;
+    stacker.setAlignment(LiveStacker::ALIGN_NONE);
+
+    std::vector<uint8_t> frame(width * height);
+    for (uint8_t value : {10, 20, 40})
+    {
+        std::fill(frame.begin(), frame.end(), value);
+        ASSERT_TRUE(stacker.addFrame(frame.data(), FrameStatistics::UINT8, width, height));
+    }
+    EXPECT_EQ(stacker.getFrameCount(), 3u);
+
+    std::vector<float> mean(width * height);
+    ASSERT_TRUE(stacker.getStack(mean.data(), FrameStatistics::FLOAT32));
+    EXPECT_NEAR(mean[0], 70 / 3.0, 1e-4);
+    EXPECT_NEAR(mean[width * height - 1], 70 / 3.0, 1e-4);
+
+    // Rounded when stored as integers
+    std::vector<uint16_t> rounded(width * height);
+    ASSERT_TRUE(stacker.getStack(rounded.data(), FrameStatistics::UINT16));
+    EXPECT_EQ(rounded[100], 23);
+
+    stacker.reset();
+    EXPECT_EQ(stacker.getFrameCount(), 0u);
+    EXPECT_FALSE(stacker.getStack(rounded.data(), FrameStatistics::UINT16));
+}
+
+TEST(LiveStacker, SigmaClippingRejectsOutliers)
+{
+    LiveStacker mean, clipped;
+    mean.setAlignment(LiveStacker::ALIGN_NONE);
+    clipped.setAlignment(LiveStacker::ALIGN_NONE);
+    clipped.setRejection(LiveStacker::REJECT_SIGMA, 3);
+
+    Random noise {7};
+    std::vector<float> frame(width * height);
+    for (int i = 0; i < 20; i++)
+    {
+        for (auto &value : frame)
+            value = 100 + 4 * noise.next();
+        // A satellite crossing the middle row on one frame
+        if (i == 12)
+            std::fill(frame.begin() + width * 96, frame.begin() + width * 97, 5000.0f);
+
+        mean.addFrame(frame.data(), FrameStatistics::FLOAT32, width, height);
+        clipped.addFrame(frame.data(), FrameStatistics::FLOAT32, width, height);
+    }
+
+    std::vector<float> a(width * height), b(width * height);
+    mean.getStack(a.data(), FrameStatistics::FLOAT32);
+    clipped.getStack(b.data(), FrameStatistics::FLOAT32);
+
+    EXPECT_GT(a[width * 96 + 10], 300);
+    EXPECT_NEAR(b[width * 96 + 10], 102, 2);
+    EXPECT_NEAR(b[10], 102, 2);
+}
+
+TEST(LiveStacker, AlignsOnStars)
+{
+    LiveStacker stacker;
+    stacker.setAlignment(LiveStacker::ALIGN_STARS);
+    stacker.setThreads(1);
+
+    const int offsets[][2] = {{0, 0}, {5, -3}, {-7, 4}, {2, 9}};
+    uint32_t seed = 1;
+    for (const auto &offset : offsets)
+    {
+        auto frame = starField(offset[0], offset[1], seed++);
+        ASSERT_TRUE(stacker.addFrame(frame.data(), FrameStatistics::UINT16, width, height));
+
+        int dx, dy;
+        stacker.getOffset(dx, dy);
+        EXPECT_EQ(dx, offset[0]);
+        EXPECT_EQ(dy, offset[1]);
+    }
+
+    // The stack is as sharp as the reference
+    auto reference = starField(0, 0, 100);
+    std::vector<uint16_t> stack(width * height);
+    stacker.getStack(stack.data(), FrameStatistics::UINT16);
+    for (size_t i = 0; i < stack.size(); i++)
+        ASSERT_NEAR(stack[i], reference[i], 25) << "pixel " << i % width << "," << i / width;
+}
+
+TEST(LiveStacker, RejectsFramesWithoutMatchingStars)
+{
+    LiveStacker stacker;
+    auto frame = starField(0, 0, 1);
+    ASSERT_TRUE(stacker.addFrame(frame.data(), FrameStatistics::UINT16, width, height));
+
+    std::vector<uint16_t> clouds(width * height, 1000);
+    EXPECT_FALSE(stacker.addFrame(clouds.data(), FrameStatistics::UINT16, width, height));
+    EXPECT_EQ(stacker.getFrameCount(), 1u);
+    EXPECT_EQ(stacker.getRejectedCount(), 1u);
+}
+
+TEST(LiveStacker, AlignsByPhaseCorrelation)
+{
+    LiveStacker stacker;
+    stacker.setAlignment(LiveStacker::ALIGN_PHASE);
+
+    const int offsets[][2] = {{0, 0}, {3, 1}, {-11, -6}};
+    for (const auto &offset : offsets)
+    {
+        auto frame = texture(offset[0], offset[1]);
+        ASSERT_TRUE(stacker.addFrame(frame.data(), FrameStatistics::FLOAT32, width, height));
+
+        int dx, dy;
+        stacker.getOffset(dx, dy);
+        EXPECT_EQ(dx, offset[0]);
+        EXPECT_EQ(dy, offset[1]);
+    }
+}
+
+TEST(LiveStacker, BayerOffsetsAreEven)
+{
+    LiveStacker stacker;
+    stacker.setBayer(true);
+
+    auto frame = starField(0, 0, 1);
+    ASSERT_TRUE(stacker.addFrame(frame.data(), FrameStatistics::UINT16, width, height));
+    frame = starField(3, -4, 2);
+    ASSERT_TRUE(stacker.addFrame(frame.data(), FrameStatistics::UINT16, width, height));
+
+    int dx, dy;
+    stacker.getOffset(dx, dy);
+    EXPECT_EQ(dx % 2, 0);
+    EXPECT_EQ(dy, -4);
+}
+
+TEST(LiveStacker, ColorLayouts)
+{
+    for (bool planar : {false, true})
+    {
+        LiveStacker stacker;
+        stacker.setAlignment(LiveStacker::ALIGN_NONE);
+
+        // Red is 30, green 60 and blue 90 in one frame, double in the other
+        std::vector<uint8_t> frame(3 * width * height);
+        for (uint8_t scale : {1, 2})
+        {
+            for (size_t i = 0; i < width * height; i++)
+                for (size_t c = 0; c < 3; c++)
+                    frame[planar ? c * width * height + i : 3 * i + c] = 30 * (c + 1) * scale;
+            ASSERT_TRUE(stacker.addFrame(frame.data(), FrameStatistics::UINT8, width, height, 3, planar));
+        }
+
+        std::vector<uint8_t> stack(3 * width * height);
+        stacker.getStack(stack.data(), FrameStatistics::UINT8);
+        for (size_t c = 0; c < 3; c++)
+        {
+            size_t i = 1234;
+            EXPECT_EQ(stack[planar ? c * width * height + i : 3 * i + c], 45 * (c + 1)) << "planar " << planar;
+        }
+    }
+}
+
+TEST(LiveStacker, StacksEveryChannelOfBGRFrames)
+{
+    ASSERT_EQ(LiveStacker::channels(INDI_BGR), 3u);
+    EXPECT_EQ(LiveStacker::channels(INDI_RGB), 3u);
+    EXPECT_EQ(LiveStacker::channels(INDI_MONO), 1u);
+    EXPECT_EQ(LiveStacker::channels(INDI_JPG), 0u);
+
+    LiveStacker stacker;
+    stacker.setAlignment(LiveStacker::ALIGN_NONE);
+
+    // Blue is 90, green 60 and red 30, interleaved
+    std::vector<uint8_t> frame(3 * width * height);
+    for (size_t i = 0; i < width * height; i++)
+        for (size_t c = 0; c < 3; c++)
+            frame[3 * i + c] = 90 - 30 * c;
+    ASSERT_TRUE(stacker.addFrame(frame.data(), FrameStatistics::UINT8, width, height, LiveStacker::channels(INDI_BGR)));
+
+    // The whole frame is written, not only the first plane
+    std::vector<uint8_t> stack(3 * width * height, 0xAA);
+    ASSERT_TRUE(stacker.getStack(stack.data(), FrameStatistics::UINT8));
+    EXPECT_EQ(stack, frame);
+}
+
+TEST(LiveStacker, ThreadsGiveTheSameStack)
+{
+    const uint32_t w = 1024, h = 1024;
+    std::vector<uint16_t> frame(w * h);
+    Random noise {3};
+
+    LiveStacker single, banded;
+    single.setAlignment(LiveStacker::ALIGN_NONE);
+    banded.setAlignment(LiveStacker::ALIGN_NONE);
+    single.setRejection(LiveStacker::REJECT_SIGMA);
+    banded.setRejection(LiveStacker::REJECT_SIGMA);
+    single.setThreads(1);
+    banded.setThreads(4);
+
+    for (int i = 0; i < 6; i++)
+    {
+        for (auto &value : frame)
+            value = uint16_t(1000 + 500 * noise.next());
+        single.addFrame(frame.data(), FrameStatistics::UINT16, w, h);
+        banded.addFrame(frame.data(), FrameStatistics::UINT16, w, h);
+    }
+
+    std::vector<float> a(w * h), b(w * h);
+    single.getStack(a.data(), FrameStatistics::FLOAT32);
+    banded.getStack(b.data(), FrameStatistics::FLOAT32);
+    EXPECT_EQ(a, b);
+}
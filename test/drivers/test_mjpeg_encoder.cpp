@@ -0,0 +1,143 @@
+#include "stream/encoder/mjpegencoder.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <jpeglib.h>
+
+using INDI::MJPEGEncoder;
+
+struct Image
+{
+    uint32_t width {0};
+    uint32_t height {0};
+    int components {0};
+    std::vector<uint8_t> pixels;
+};
+
+static Image decode(const INDI::WidgetViewBlob &blob)
+{
+    Image image;
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, static_cast<const unsigned char *>(blob.getBlob()), blob.getBlobLen());
+    jpeg_read_header(&cinfo, TRUE);
+    jpeg_start_decompress(&cinfo);
+
+    image.width = cinfo.output_width;
+    image.height = cinfo.output_height;
+    image.components = cinfo.output_components;
+    image.pixels.resize(size_t(image.width) * image.height * image.components);
+    while (cinfo.output_scanline < cinfo.output_height)
+    {
+        JSAMPROW row = image.pixels.data() + size_t(cinfo.output_scanline) * image.width * image.components;
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return image;
+}
+
+// Smooth gradients compress with little loss
+static std::vector<uint8_t> gradient(uint32_t width, uint32_t height, int components)
+{
+    std::vector<uint8_t> frame(size_t(width) * height * components);
+    for (uint32_t y = 0; y < height; y++)
+        for (uint32_t x = 0; x < width; x++)
+            for (int c = 0; c < components; c++)
+                frame[(size_t(y) * width + x) * components + c] = (x * 200 / width + y * 50 / height + 20 * c) & 0xFF;
+    return frame;
+}
+
+static Image encode(const std::vector<uint8_t> &frame, uint32_t width, uint32_t height, INDI_PIXEL_FORMAT format,
+                    uint16_t previewWidth, unsigned threads)
+{
+    MJPEGEncoder encoder;
+    encoder.setPixelFormat(format, 8);
+    encoder.setSize(width, height);
+    encoder.setPreview(previewWidth, 95);
+    encoder.setThreads(threads);
+
+    INDI::WidgetViewBlob blob;
+    EXPECT_TRUE(encoder.upload(&blob, frame.data(), frame.size()));
+    return decode(blob);
+}
+
+TEST(MJPEGEncoder, DownscalesToThePreviewWidth)
+{
+    const uint32_t width = 1920, height = 1080;
+    auto frame = gradient(width, height, 1);
+
+    // 1920 / 640 = 3
+    Image image = encode(frame, width, height, INDI_MONO, 640, 1);
+    ASSERT_EQ(image.width, 640u);
+    ASSERT_EQ(image.height, 360u);
+    ASSERT_EQ(image.components, 1);
+
+    for (uint32_t y = 0; y < image.height; y += 17)
+        for (uint32_t x = 0; x < image.width; x += 13)
+        {
+            int sum = 0;
+            for (uint32_t dy = 0; dy < 3; dy++)
+                for (uint32_t dx = 0; dx < 3; dx++)
+                    sum += frame[(3 * y + dy) * width + 3 * x + dx];
+            ASSERT_NEAR(image.pixels[y * image.width + x], sum / 9.0, 3) << x << "," << y;
+        }
+
+    // Not a multiple of the preview width, the factor is rounded up
+    image = encode(frame, width, height, INDI_MONO, 1000, 1);
+    EXPECT_EQ(image.width, 960u);
+    EXPECT_EQ(image.height, 540u);
+
+    // Full size
+    image = encode(frame, width, height, INDI_MONO, 0, 1);
+    EXPECT_EQ(image.width, width);
+    EXPECT_EQ(image.height, height);
+}
+
+TEST(MJPEGEncoder, SlicesDecodeLikeOneFrame)
+{
+    // Sizes that do not fall on MCU boundaries
+    const uint32_t width = 1003, height = 757;
+
+    for (INDI_PIXEL_FORMAT format : {INDI_MONO, INDI_RGB})
+    {
+        int components = format == INDI_RGB ? 3 : 1;
+        auto frame = gradient(width, height, components);
+
+        Image single = encode(frame, width, height, format, 0, 1);
+        Image sliced = encode(frame, width, height, format, 0, 5);
+
+        ASSERT_EQ(sliced.width, width);
+        ASSERT_EQ(sliced.height, height);
+        ASSERT_EQ(sliced.components, components);
+        EXPECT_TRUE(sliced.pixels == single.pixels) << "format " << format;
+    }
+}
+
+TEST(MJPEGEncoder, ReusesBuffersAcrossFrames)
+{
+    const uint32_t width = 640, height = 480;
+    MJPEGEncoder encoder;
+    encoder.setPixelFormat(INDI_RGB, 8);
+    encoder.setSize(width, height);
+    encoder.setThreads(4);
+
+    INDI::WidgetViewBlob blob;
+    auto frame = gradient(width, height, 3);
+    ASSERT_TRUE(encoder.upload(&blob, frame.data(), frame.size()));
+    void *first = blob.getBlob();
+    ASSERT_TRUE(encoder.upload(&blob, frame.data(), frame.size()));
+    EXPECT_EQ(blob.getBlob(), first);
+
+    Image image = decode(blob);
+    EXPECT_EQ(image.width, width);
+    EXPECT_EQ(image.height, height);
+}
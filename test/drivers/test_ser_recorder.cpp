@@ -0,0 +1,151 @@
+#include "stream/recorder/serrecorder.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using INDI::FramePool;
+using INDI::SER_Recorder;
+
+static const uint16_t width = 320, height = 240;
+static const size_t frameSize = width * height * 2;
+static const size_t headerSize = 178;
+
+static std::vector<uint8_t> readFile(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+static uint64_t readLE(const std::vector<uint8_t> &data, size_t offset, int bytes)
+{
+    uint64_t value = 0;
+    for (int i = bytes - 1; i >= 0; i--)
+        value = (value << 8) | data[offset + i];
+    return value;
+}
+
+// Checks a SER file holds count frames, frame i filled with i, stamped 1000 + i microseconds if it has timestamps
+static void checkFile(const std::vector<uint8_t> &data, uint32_t count, bool timestamps = true)
+{
+    ASSERT_GE(data.size(), headerSize + count * (frameSize + (timestamps ? 8 : 0)));
+    EXPECT_EQ(readLE(data, 38, 4), count);
+    EXPECT_EQ(readLE(data, 26, 4), width);
+    EXPECT_EQ(readLE(data, 30, 4), height);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const uint8_t *frame = data.data() + headerSize + i * frameSize;
+        EXPECT_EQ(frame[0], uint8_t(i)) << "frame " << i;
+        EXPECT_EQ(frame[frameSize - 1], uint8_t(i)) << "frame " << i;
+        if (timestamps)
+        {
+            EXPECT_EQ(readLE(data, headerSize + count * frameSize + i * 8, 8), (1000 + i) * 10) << "timestamp " << i;
+        }
+    }
+}
+
+class SERRecorderTest : public ::testing::TestWithParam<bool>
+{
+    protected:
+        void SetUp() override
+        {
+            path = std::string("test_ser_recorder_") + (GetParam() ? "direct" : "buffered") + ".ser";
+            recorder.setPixelFormat(INDI_MONO, 16);
+            recorder.setSize(width, height);
+            recorder.setDirectIO(GetParam());
+            recorder.setCheckpointInterval(std::chrono::milliseconds(20));
+
+            char errmsg[1024];
+            ASSERT_TRUE(recorder.open(path.c_str(), errmsg)) << errmsg;
+        }
+
+        void TearDown() override
+        {
+            recorder.close();
+            remove(path.c_str());
+        }
+
+        void writeFrames(uint32_t count)
+        {
+            std::vector<uint8_t> frame(frameSize);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                // Both entry points, copied and shared
+                if (i % 2)
+                {
+                    memset(frame.data(), i, frameSize);
+                    ASSERT_TRUE(recorder.writeFrame(frame.data(), frameSize, 1000 + i));
+                }
+                else
+                {
+                    auto buffer = pool.acquire(frameSize);
+                    memset(buffer->data(), i, frameSize);
+                    ASSERT_TRUE(recorder.writeFrame(buffer, 1000 + i));
+                }
+            }
+        }
+
+        std::string path;
+        SER_Recorder recorder;
+        FramePool pool;
+};
+
+TEST_P(SERRecorderTest, WritesAllFrames)
+{
+    writeFrames(40);
+    recorder.close();
+
+    auto data = readFile(path);
+    EXPECT_EQ(data.size(), headerSize + 40 * (frameSize + 8));
+    checkFile(data, 40);
+    EXPECT_EQ(recorder.getDroppedFrames(), 0u);
+}
+
+TEST_P(SERRecorderTest, ValidBeforeClose)
+{
+    writeFrames(40);
+
+    // A checkpoint writes the header as if the recording stopped here, the timestamps come on close
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    checkFile(readFile(path), 40, false);
+}
+
+TEST_P(SERRecorderTest, HeaderSurvivesFlushes)
+{
+    recorder.close();
+    recorder.setCheckpointInterval(std::chrono::milliseconds(300));
+
+    char errmsg[1024];
+    ASSERT_TRUE(recorder.open(path.c_str(), errmsg)) << errmsg;
+    writeFrames(10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+
+    // More than the staging buffer, written before the next checkpoint
+    writeFrames(60);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    checkFile(readFile(path), 10, false);
+}
+
+TEST_P(SERRecorderTest, DropsWhenQueueIsFull)
+{
+    recorder.close();
+    recorder.setMaxQueuedBytes(0);
+
+    char errmsg[1024];
+    ASSERT_TRUE(recorder.open(path.c_str(), errmsg));
+    writeFrames(4);
+    recorder.close();
+
+    EXPECT_EQ(recorder.getDroppedFrames(), 4u);
+    EXPECT_EQ(readLE(readFile(path), 38, 4), 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(SERRecorder, SERRecorderTest, ::testing::Values(false, true));